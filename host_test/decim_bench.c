@@ -0,0 +1,1112 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+/* sysconf() is POSIX, hidden under -std=c99 */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include <sched.h>
+#include "data_types.h"
+#include "host_clock.h"
+#include "cpu_features.h"
+#include "decim_coefs.h"
+#include "decim_dispatch.h"
+#include "pick_bits_cic.h"
+#include "pick_bits_cic_cfg.h"
+#include "pick_bits_cic_mc.h"
+#include "BlkFirDecim.h"
+#include "BlkFirDecimSimd.h"
+#include "BlkIir.h"
+#include "BlkIirSpec.h"
+#include "BlkIirMc.h"
+#include "BlkIirSs.h"
+#include "diggain.h"
+#include "diggain_simd.h"
+#include "pdm_fir.h"
+#include "BlkFirCascade.h"
+#include "decim_pipe.h"
+#include "decim_sched.h"
+#include "decim_pipe_mt.h"
+
+/* Kernel microbenchmark. */
+/* Times every CIC, FIR, IIR & digital gain kernel variant, the FIR cascade */
+/* & the whole pipeline on one thread, scheduler & stage threads over a grid of */
+/* frame length, FIR tap count, biquad count & channel count. */
+/* Frame length is in 32-bit words per "left" or "right" PDM buffer, */
+/* each kernel processes the samples of one frame at its rate in the 1.024 MHz chain: */
+/* CIC 64 kHz output, FIR & FIR cascade 64 kHz input (FIR1, worst case), */
+/* IIR, gain & pipeline 16 kHz. */
+/* Single-channel kernels run once per channel, each channel with own state. */
+/* Real-time factor is frame duration / time to process frame of all channels. */
+/* Usage: decim_bench [-k cic|fir|iir|gain|casc|pipe] [-t minMs] [-r reps] [-q] [-j jsonFile] [-l label] */
+
+#define BENCH_PDM_RATE      ( 1024000 ) /* PDM bit rate per channel (Hz) */
+#define BENCH_MAX_FRAME_LEN ( 640 )     /* maximum frame length, 32-bit words */
+#define BENCH_MAX_CH        ( CIC_MC_MAX_CH )
+#define BENCH_MAX_SAMPS     ( BENCH_MAX_FRAME_LEN*64/CIC_DF )
+#define BENCH_MAX_TAPS      ( 128 )
+#define BENCH_MAX_BIQUADS   ( IIR_MC_MAX_BIQUADS )
+#define BENCH_FIR_DLY_LEN   ( BLK_FIR_LIN_DLY_LEN(BENCH_MAX_TAPS) )
+#define BENCH_IIR_DLY_LEN   ( 4*BENCH_MAX_BIQUADS+1 )
+#define BENCH_COEF_IWL      ( 1 )       /* IIR coefficient integer wordlength */
+#define BENCH_IIR_GAIN      ( 0xC000 )  /* IIR input gain (U16Q16) */
+#define BENCH_DIGGAIN       ( 10*DIGGAIN_UNITY ) /* digital gain (U16Q8) */
+#define BENCH_EXP_COEF      ( 0xE000 )  /* exponential ramp coefficient (U0Q16) */
+#define BENCH_PDM_FIR_COEFS ( 256 )     /* pdmFirDecim() coefficients, decimation by CIC_DF */
+#define BENCH_PIPE_MAX_FRAME_LEN ( DECIM_PIPE_MAX_OUT_LEN*4*CIC_DF/64 )  /* frame length of largest pipeline output frame */
+#define BENCH_MT_OUT_FRAMES ( 4*DECIM_PIPE_MT_RING_LEN )    /* decimPipeMt output buffers, more than frames in flight */
+
+/* Kernels */
+#define BENCH_KERNEL_CIC    ( 0 )
+#define BENCH_KERNEL_FIR    ( 1 )
+#define BENCH_KERNEL_IIR    ( 2 )
+#define BENCH_KERNEL_GAIN   ( 3 )
+#define BENCH_KERNEL_CASC   ( 4 )
+#define BENCH_KERNEL_PIPE   ( 5 )
+#define BENCH_NUM_KERNELS   ( 6 )
+
+/* Variant flags */
+#define BENCH_NEED_HB       ( 0x0001 )  /* needs half-band coefficients */
+#define BENCH_NEED_SYM      ( 0x0002 )  /* needs symmetric coefficients */
+
+/* Parameter grid */
+static const Uint16 frameLenGrid[] = { 40, 80, 160, 320, 640 };
+static const Uint16 numTapsGrid[] = { 15, 58, 128 };
+static const Uint16 numBiquadsGrid[] = { 1, 2, 4, 8 };
+static const Uint16 numChGrid[] = { 1, 2, 8, 16 };
+#define GRID_LEN(grid)      ( sizeof(grid)/sizeof(grid[0]) )
+
+/* Quick grid, -q */
+static const Uint16 frameLenQuick[] = { 320 };
+static const Uint16 numChQuick[] = { 1, 8 };
+
+struct BenchCtx_s;
+
+/* Benchmark buffers & parameters of current grid point */
+typedef struct BenchCtx_s
+{
+    Uint32 lData[BENCH_MAX_CH][BENCH_MAX_FRAME_LEN];    /* "left" PDM words */
+    Uint32 rData[BENCH_MAX_CH][BENCH_MAX_FRAME_LEN];    /* "right" PDM words */
+    Int32 inSamps[BENCH_MAX_CH][BENCH_MAX_SAMPS];       /* S18Q16 input samples */
+    Int32 outSamps[BENCH_MAX_CH][BENCH_MAX_SAMPS];      /* S18Q16 output samples */
+    Int16 outSamps16[BENCH_MAX_CH][BENCH_MAX_SAMPS];    /* S16Q15 output samples */
+    Int32 cicState[BENCH_MAX_CH][2*CIC_MAX_NS];         /* CIC state */
+    Int32 firDlyBuf[BENCH_MAX_CH][BENCH_FIR_DLY_LEN];   /* FIR delay buffers */
+    Int32 iirDlyBuf[BENCH_MAX_CH][BENCH_IIR_DLY_LEN];   /* IIR delay buffers */
+    Uint32 *pLData[BENCH_MAX_CH];                       /* per-channel pointers, multi-channel kernels */
+    Uint32 *pRData[BENCH_MAX_CH];
+    Int32 *pInSamps[BENCH_MAX_CH];
+    Int32 *pOutSamps[BENCH_MAX_CH];
+    CicMcState cicMcState;                              /* multi-channel CIC state */
+    BlkIirMcState iirMcState;                           /* multi-channel IIR state */
+    BlkIirSsState iirSsState[BENCH_MAX_CH];             /* block state-space IIR state */
+    CicCfg cicCfg;                                      /* CIC R = 16, N = 4 */
+    Int16 firCoefs[BENCH_MAX_TAPS];                     /* FIR coefficients (S16Q15) */
+    Int16 firHbCoefs[BENCH_MAX_TAPS];                   /* half-band FIR coefficients (S16Q15) */
+    Int16 iirDf1Coefs[5*BENCH_MAX_BIQUADS];             /* IIR coefficients, blkIirDf1() order */
+    Int16 iirDf2Coefs[5*BENCH_MAX_BIQUADS];             /* IIR coefficients, blkIirDf2() order */
+    PdmFirTbl pdmFirTbl;                                /* pdmFirDecim() table, decimation by CIC_DF */
+    PdmFirState pdmFirState[BENCH_MAX_CH];              /* pdmFirDecim() input history */
+    DiggainState gainState[BENCH_MAX_CH];               /* ramped & AGC digital gain state */
+    BlkFirCascade casc[BENCH_MAX_CH];                   /* FIR1 & FIR2 cascade */
+    Int32 cascDlyBuf[BENCH_MAX_CH][2][DECIM_PIPE_FIR_DLY_LEN];   /* FIR cascade delay buffers */
+    DecimPipe pipe[BENCH_MAX_CH];                       /* IdleLoop chain pipelines */
+    DecimSched sched;                                   /* scheduler, one stream per channel */
+    DecimPipeMt mt;                                     /* stage threads, channels as frames of one stream */
+    Int16 mtOut[BENCH_MT_OUT_FRAMES][DECIM_PIPE_MAX_OUT_LEN];  /* decimPipeMt output frames */
+    Uint16 mtOutIdx;        /* next decimPipeMt output frame */
+    Uint16 rampFlip;        /* ramp target gain toggle */
+    Uint16 started;         /* frame function set up its state, cleared by benchReset() */
+    void (*stop)(struct BenchCtx_s *pCtx);  /* stops threads started by frame function, NULL if none */
+    Uint16 frameLen;        /* frame length, 32-bit words */
+    Uint16 numSamps;        /* samples per channel per frame */
+    Uint16 numTaps;         /* FIR number of coefficients */
+    Uint16 numBiquads;      /* IIR number of biquads */
+    Uint16 numCh;           /* number of channels */
+    Uint16 firFlags;        /* BENCH_NEED_xxx satisfied by FIR coefficients */
+} BenchCtx;
+
+/* Processes one frame of all channels */
+typedef void (*BenchRunFxn)(BenchCtx *pCtx);
+
+/* Kernel variant */
+typedef struct
+{
+    const char *name;       /* variant name */
+    Uint16 features;        /* required CPU_FEAT_xxx */
+    Uint16 flags;           /* BENCH_NEED_xxx */
+    BenchRunFxn run;        /* frame function */
+} BenchVariant;
+
+/* Kernel under test */
+typedef struct
+{
+    const char *name;       /* kernel name, -k argument */
+    const BenchVariant *variants;
+    Uint16 numVariants;
+    Uint32 sampRate;        /* kernel sample rate in 1.024 MHz chain (Hz) */
+    Uint16 gridTaps;        /* sweep FIR tap count */
+    Uint16 gridBiquads;     /* sweep IIR biquad count */
+    Uint16 maxFrameLen;     /* maximum frame length, 0 if any */
+} BenchKernel;
+
+/* Benchmark result */
+typedef struct
+{
+    Float64 nsPerFrame;     /* ns per frame of all channels */
+    Float64 nsPerSamp;      /* ns per sample */
+    Float64 sampsPerSec;    /* samples per second, all channels */
+    Float64 rtFactor;       /* real-time factor */
+} BenchResult;
+
+/* Defines frame function running single-channel CIC kernel on each channel */
+#define BENCH_CIC_RUN(runName, fxn)                                         \
+static void runName(BenchCtx *pCtx)                                         \
+{                                                                           \
+    Uint16 numOutSamps;                                                     \
+    Uint16 ch;                                                              \
+    for (ch = 0; ch < pCtx->numCh; ch++)                                    \
+    {                                                                       \
+        fxn(pCtx->lData[ch], pCtx->rData[ch], pCtx->frameLen,               \
+            pCtx->cicState[ch], pCtx->outSamps[ch], &numOutSamps);          \
+    }                                                                       \
+}
+
+/* Defines frame function running single-channel FIR kernel on each channel */
+#define BENCH_FIR_RUN(runName, fxn, coefs)                                  \
+static void runName(BenchCtx *pCtx)                                         \
+{                                                                           \
+    Uint16 ch;                                                              \
+    for (ch = 0; ch < pCtx->numCh; ch++)                                    \
+    {                                                                       \
+        fxn(pCtx->inSamps[ch], pCtx->coefs, pCtx->outSamps[ch],             \
+            pCtx->firDlyBuf[ch], pCtx->numSamps, pCtx->numTaps);            \
+    }                                                                       \
+}
+
+/* Defines frame function running FIR kernel with digital gain on each channel */
+#define BENCH_FIR_GAIN_RUN(runName, fxn)                                    \
+static void runName(BenchCtx *pCtx)                                         \
+{                                                                           \
+    Uint16 ch;                                                              \
+    for (ch = 0; ch < pCtx->numCh; ch++)                                    \
+    {                                                                       \
+        fxn(pCtx->inSamps[ch], pCtx->firCoefs, pCtx->outSamps16[ch],        \
+            pCtx->firDlyBuf[ch], BENCH_DIGGAIN, pCtx->numSamps, pCtx->numTaps); \
+    }                                                                       \
+}
+
+/* Defines frame function running single-channel IIR kernel on each channel */
+#define BENCH_IIR_RUN(runName, fxn, coefs)                                  \
+static void runName(BenchCtx *pCtx)                                         \
+{                                                                           \
+    Uint16 ch;                                                              \
+    for (ch = 0; ch < pCtx->numCh; ch++)                                    \
+    {                                                                       \
+        fxn(pCtx->inSamps[ch], pCtx->coefs, pCtx->outSamps[ch],             \
+            pCtx->iirDlyBuf[ch], BENCH_IIR_GAIN, pCtx->numSamps,            \
+            pCtx->numBiquads, BENCH_COEF_IWL);                              \
+    }                                                                       \
+}
+
+/* Defines frame function running digital gain kernel on each channel */
+#define BENCH_GAIN_RUN(runName, fxn)                                        \
+static void runName(BenchCtx *pCtx)                                         \
+{                                                                           \
+    Uint16 ch;                                                              \
+    for (ch = 0; ch < pCtx->numCh; ch++)                                    \
+    {                                                                       \
+        fxn(pCtx->inSamps[ch], BENCH_DIGGAIN, pCtx->outSamps16[ch],         \
+            pCtx->numSamps);                                                \
+    }                                                                       \
+}
+
+/* CIC */
+BENCH_CIC_RUN(runPickBitsCic, pickBitsCic)
+BENCH_CIC_RUN(runPickBitsCicTbl, pickBitsCicTbl)
+BENCH_CIC_RUN(runCicCfg, pCtx->cicCfg.kernel)
+BENCH_CIC_RUN(runCicDispatch, decimKernels()->cic)
+
+static void runPickBitsCicMc(BenchCtx *pCtx)
+{
+    Uint16 numOutSamps;
+
+    pickBitsCicMc(pCtx->pLData, pCtx->pRData, pCtx->frameLen,
+        &pCtx->cicMcState, pCtx->pOutSamps, &numOutSamps);
+}
+
+/* FIR */
+BENCH_FIR_RUN(runBlkFirDecim2, blkFirDecim2, firCoefs)
+BENCH_FIR_RUN(runBlkFirDecim2Sym, blkFirDecim2Sym, firCoefs)
+BENCH_FIR_RUN(runBlkFirDecim2Hb, blkFirDecim2Hb, firHbCoefs)
+BENCH_FIR_RUN(runBlkFirDecim2Host, blkFirDecim2Host, firCoefs)
+BENCH_FIR_RUN(runBlkFirDecim2Lin, blkFirDecim2Lin, firCoefs)
+BENCH_FIR_RUN(runBlkFirDecim2LinSse41, blkFirDecim2LinSse41, firCoefs)
+BENCH_FIR_RUN(runBlkFirDecim2LinAvx2, blkFirDecim2LinAvx2, firCoefs)
+BENCH_FIR_RUN(runBlkFirDecim2LinAvx512, blkFirDecim2LinAvx512, firCoefs)
+BENCH_FIR_RUN(runBlkFirDecim2LinSimd, blkFirDecim2LinSimd, firCoefs)
+BENCH_FIR_RUN(runFirDispatch, decimKernels()->fir, firCoefs)
+BENCH_FIR_GAIN_RUN(runBlkFirDecim2Gain, blkFirDecim2Gain)
+BENCH_FIR_GAIN_RUN(runBlkFirDecim2GainHost, blkFirDecim2GainHost)
+
+static void runBlkFirDecimM(BenchCtx *pCtx)
+{
+    Uint16 ch;
+
+    for (ch = 0; ch < pCtx->numCh; ch++)
+    {
+        blkFirDecimM(pCtx->inSamps[ch], pCtx->firCoefs, pCtx->outSamps[ch],
+            pCtx->firDlyBuf[ch], pCtx->numSamps, pCtx->numTaps, 2);
+    }
+}
+
+/* IIR */
+BENCH_IIR_RUN(runBlkIirDf1, blkIirDf1, iirDf1Coefs)
+BENCH_IIR_RUN(runBlkIirDf1Host, blkIirDf1Host, iirDf1Coefs)
+BENCH_IIR_RUN(runBlkIirDf1Spec, blkIirDf1Spec, iirDf1Coefs)
+BENCH_IIR_RUN(runIirDf1Dispatch, decimKernels()->iirDf1, iirDf1Coefs)
+BENCH_IIR_RUN(runBlkIirDf2, blkIirDf2, iirDf2Coefs)
+BENCH_IIR_RUN(runBlkIirDf2Lin, blkIirDf2Lin, iirDf2Coefs)
+BENCH_IIR_RUN(runBlkIirDf2Host, blkIirDf2Host, iirDf2Coefs)
+BENCH_IIR_RUN(runBlkIirDf2Spec, blkIirDf2Spec, iirDf2Coefs)
+BENCH_IIR_RUN(runIirDf2Dispatch, decimKernels()->iirDf2, iirDf2Coefs)
+
+static void runBlkIirDf1Mc(BenchCtx *pCtx)
+{
+    blkIirDf1Mc(pCtx->pInSamps, pCtx->iirDf1Coefs, pCtx->pOutSamps,
+        &pCtx->iirMcState, BENCH_IIR_GAIN, pCtx->numSamps, BENCH_COEF_IWL);
+}
+
+static void runBlkIirDf2Mc(BenchCtx *pCtx)
+{
+    blkIirDf2Mc(pCtx->pInSamps, pCtx->iirDf2Coefs, pCtx->pOutSamps,
+        &pCtx->iirMcState, BENCH_IIR_GAIN, pCtx->numSamps, BENCH_COEF_IWL);
+}
+
+/* Block state-space IIR, state set up from DF1 or DF2 coefficients on first frame */
+static void runBlkIirSs(
+    BenchCtx *pCtx,         /* benchmark context */
+    Uint16 form             /* IIR_SS_DF1 or IIR_SS_DF2 */
+)
+{
+    Uint16 ch;
+
+    if (!pCtx->started)
+    {
+        for (ch = 0; ch < pCtx->numCh; ch++)
+        {
+            blkIirSsInit(&pCtx->iirSsState[ch], (form == IIR_SS_DF1) ? pCtx->iirDf1Coefs : pCtx->iirDf2Coefs,
+                pCtx->numBiquads, BENCH_COEF_IWL, BENCH_IIR_GAIN, form);
+        }
+        pCtx->started = 1;
+    }
+
+    for (ch = 0; ch < pCtx->numCh; ch++)
+    {
+        blkIirSs(pCtx->inSamps[ch], pCtx->outSamps[ch], &pCtx->iirSsState[ch], pCtx->numSamps);
+    }
+}
+
+static void runBlkIirSsDf1(BenchCtx *pCtx)
+{
+    runBlkIirSs(pCtx, IIR_SS_DF1);
+}
+
+static void runBlkIirSsDf2(BenchCtx *pCtx)
+{
+    runBlkIirSs(pCtx, IIR_SS_DF2);
+}
+
+/* Digital gain */
+BENCH_GAIN_RUN(runAppDiggain, appDiggain)
+BENCH_GAIN_RUN(runAppDiggainHost, appDiggainHost)
+BENCH_GAIN_RUN(runAppDiggainSse2, appDiggainSse2)
+BENCH_GAIN_RUN(runAppDiggainAvx2, appDiggainAvx2)
+BENCH_GAIN_RUN(runGainDispatch, decimKernels()->diggain)
+
+static void runPdmFirDecim(BenchCtx *pCtx)
+{
+    Uint16 numOutSamps;
+    Uint16 ch;
+
+    for (ch = 0; ch < pCtx->numCh; ch++)
+    {
+        pdmFirDecim(pCtx->lData[ch], pCtx->rData[ch], pCtx->frameLen, &pCtx->pdmFirTbl,
+            &pCtx->pdmFirState[ch], pCtx->outSamps[ch], &numOutSamps);
+    }
+}
+
+/* Ramped gain, target alternates every frame so every sample ramps */
+static void runDiggainRamp(
+    BenchCtx *pCtx,         /* benchmark context */
+    Uint16 rampMode         /* DIGGAIN_RAMP_LIN or DIGGAIN_RAMP_EXP */
+)
+{
+    Uint16 ch;
+
+    if (!pCtx->started)
+    {
+        for (ch = 0; ch < pCtx->numCh; ch++)
+        {
+            diggainInit(&pCtx->gainState[ch], BENCH_DIGGAIN, rampMode, pCtx->numSamps, BENCH_EXP_COEF, NULL);
+        }
+        pCtx->started = 1;
+    }
+
+    pCtx->rampFlip ^= 1;
+    for (ch = 0; ch < pCtx->numCh; ch++)
+    {
+        diggainSetGain(&pCtx->gainState[ch], pCtx->rampFlip ? BENCH_DIGGAIN/2 : BENCH_DIGGAIN);
+        diggainProcess(&pCtx->gainState[ch], pCtx->inSamps[ch], pCtx->outSamps16[ch], pCtx->numSamps);
+    }
+}
+
+static void runDiggainLin(BenchCtx *pCtx)
+{
+    runDiggainRamp(pCtx, DIGGAIN_RAMP_LIN);
+}
+
+static void runDiggainExp(BenchCtx *pCtx)
+{
+    runDiggainRamp(pCtx, DIGGAIN_RAMP_EXP);
+}
+
+/* AGC tracking frame peak, gain ramps linearly over frame */
+static void runDiggainAgc(BenchCtx *pCtx)
+{
+    Uint16 ch;
+
+    if (!pCtx->started)
+    {
+        for (ch = 0; ch < pCtx->numCh; ch++)
+        {
+            diggainInit(&pCtx->gainState[ch], BENCH_DIGGAIN, DIGGAIN_RAMP_LIN, pCtx->numSamps, 0, NULL);
+            diggainAgcConfig(&pCtx->gainState[ch], 1, 0x4000, DIGGAIN_UNITY, 32*DIGGAIN_UNITY, 1, 4);
+        }
+        pCtx->started = 1;
+    }
+
+    for (ch = 0; ch < pCtx->numCh; ch++)
+    {
+        diggainProcess(&pCtx->gainState[ch], pCtx->inSamps[ch], pCtx->outSamps16[ch], pCtx->numSamps);
+    }
+}
+
+/* FIR cascade */
+static void benchCascInit(BenchCtx *pCtx)
+{
+    Uint16 ch;
+
+    for (ch = 0; ch < pCtx->numCh; ch++)
+    {
+        blkFirCascadeInit(&pCtx->casc[ch], 2, BLK_FIR_CASC_MAX_TILE_LEN);
+        blkFirCascadeSetStage(&pCtx->casc[ch], 0, (Int16 *)decimFir1Coefs, DECIM_FIR1_NUM_COEFS,
+            pCtx->cascDlyBuf[ch][0], NULL);
+        blkFirCascadeSetStage(&pCtx->casc[ch], 1, (Int16 *)decimFir2Coefs, DECIM_FIR2_NUM_COEFS,
+            pCtx->cascDlyBuf[ch][1], NULL);
+        blkFirCascadeSetGain(&pCtx->casc[ch], BENCH_DIGGAIN, NULL);
+    }
+    pCtx->started = 1;
+}
+
+static void runBlkFirCascade(BenchCtx *pCtx)
+{
+    Uint16 ch;
+
+    if (!pCtx->started)
+    {
+        benchCascInit(pCtx);
+    }
+    for (ch = 0; ch < pCtx->numCh; ch++)
+    {
+        blkFirCascadeProcess(&pCtx->casc[ch], pCtx->inSamps[ch], pCtx->outSamps[ch], pCtx->numSamps);
+    }
+}
+
+static void runBlkFirCascadeGain(BenchCtx *pCtx)
+{
+    Uint16 ch;
+
+    if (!pCtx->started)
+    {
+        benchCascInit(pCtx);
+    }
+    for (ch = 0; ch < pCtx->numCh; ch++)
+    {
+        blkFirCascadeProcessGain(&pCtx->casc[ch], pCtx->inSamps[ch], pCtx->outSamps16[ch], pCtx->numSamps);
+    }
+}
+
+/* Pipeline */
+static void benchPipeInit(
+    BenchCtx *pCtx,         /* benchmark context */
+    Uint16 numPipes         /* number of pipelines */
+)
+{
+    DecimPipeCfg cfg;
+    Uint16 ch;
+
+    decimPipeCfgDefault(&cfg);
+    cfg.inFrameLen = pCtx->frameLen;
+    cfg.diggain = BENCH_DIGGAIN;
+    for (ch = 0; ch < numPipes; ch++)
+    {
+        decimPipeInit(&pCtx->pipe[ch], &cfg);
+    }
+    pCtx->started = 1;
+}
+
+static void benchSchedStop(BenchCtx *pCtx)
+{
+    decimSchedStop(&pCtx->sched);
+}
+
+static void benchMtStop(BenchCtx *pCtx)
+{
+    decimPipeMtStop(&pCtx->mt);
+}
+
+static void runDecimPipe(BenchCtx *pCtx)
+{
+    Uint16 numOutSamps;
+    Uint16 ch;
+
+    if (!pCtx->started)
+    {
+        benchPipeInit(pCtx, pCtx->numCh);
+    }
+    for (ch = 0; ch < pCtx->numCh; ch++)
+    {
+        decimPipeProcess(&pCtx->pipe[ch], pCtx->lData[ch], pCtx->rData[ch], pCtx->outSamps16[ch], &numOutSamps);
+    }
+}
+
+/* One stream per channel, one worker per channel up to number of CPUs, */
+/* frame of all channels submitted & drained */
+static void runDecimSched(BenchCtx *pCtx)
+{
+    Uint16 numWorkers;
+    long numCpus;
+    Uint16 ch;
+
+    if (!pCtx->started)
+    {
+        benchPipeInit(pCtx, pCtx->numCh);
+        numCpus = sysconf(_SC_NPROCESSORS_ONLN);
+        numWorkers = pCtx->numCh;
+        if ((numCpus > 0) && (numWorkers > numCpus))
+        {
+            numWorkers = (Uint16)numCpus;
+        }
+        decimSchedInit(&pCtx->sched, numWorkers);
+        for (ch = 0; ch < pCtx->numCh; ch++)
+        {
+            decimSchedAddStream(&pCtx->sched, ch, &pCtx->pipe[ch], NULL, NULL);
+        }
+        pCtx->stop = benchSchedStop;
+    }
+    for (ch = 0; ch < pCtx->numCh; ch++)
+    {
+        decimSchedSubmit(&pCtx->sched, ch, pCtx->lData[ch], pCtx->rData[ch], pCtx->outSamps16[ch]);
+    }
+    decimSchedDrain(&pCtx->sched);
+}
+
+/* Channel frames fed as consecutive frames of one stream, not drained per call, */
+/* so stages overlap across calls & result is streaming throughput */
+static void runDecimPipeMt(BenchCtx *pCtx)
+{
+    Uint16 ch;
+
+    if (!pCtx->started)
+    {
+        benchPipeInit(pCtx, 1);
+        decimPipeMtInit(&pCtx->mt, &pCtx->pipe[0], NULL, NULL);
+        pCtx->stop = benchMtStop;
+    }
+    for (ch = 0; ch < pCtx->numCh; ch++)
+    {
+        while (decimPipeMtSubmit(&pCtx->mt, pCtx->lData[ch], pCtx->rData[ch], pCtx->mtOut[pCtx->mtOutIdx]) != DECIM_PIPE_MT_OK)
+        {
+            sched_yield();  /* input ring full */
+        }
+        pCtx->mtOutIdx = (pCtx->mtOutIdx + 1) % BENCH_MT_OUT_FRAMES;
+    }
+}
+
+static const BenchVariant cicVariants[] =
+{
+    { "pickBitsCic", 0, 0, runPickBitsCic },
+    { "pickBitsCicTbl", 0, 0, runPickBitsCicTbl },
+    { "cicCfg_R16_N4", 0, 0, runCicCfg },
+    { "pickBitsCicMc", 0, 0, runPickBitsCicMc },
+    { "pdmFirDecim_256", 0, 0, runPdmFirDecim },
+    { "decimKernels", 0, 0, runCicDispatch }
+};
+
+static const BenchVariant firVariants[] =
+{
+    { "blkFirDecim2", 0, 0, runBlkFirDecim2 },
+    { "blkFirDecim2Sym", 0, BENCH_NEED_SYM, runBlkFirDecim2Sym },
+    { "blkFirDecim2Hb", 0, BENCH_NEED_HB, runBlkFirDecim2Hb },
+    { "blkFirDecim2Host", 0, 0, runBlkFirDecim2Host },
+    { "blkFirDecimM", 0, 0, runBlkFirDecimM },
+    { "blkFirDecim2Lin", 0, 0, runBlkFirDecim2Lin },
+    { "blkFirDecim2LinSse41", CPU_FEAT_SSE41, 0, runBlkFirDecim2LinSse41 },
+    { "blkFirDecim2LinAvx2", CPU_FEAT_AVX2, 0, runBlkFirDecim2LinAvx2 },
+    { "blkFirDecim2LinAvx512", CPU_FEAT_AVX512F, 0, runBlkFirDecim2LinAvx512 },
+    { "blkFirDecim2LinSimd", 0, 0, runBlkFirDecim2LinSimd },
+    { "blkFirDecim2Gain", 0, 0, runBlkFirDecim2Gain },
+    { "blkFirDecim2GainHost", 0, 0, runBlkFirDecim2GainHost },
+    { "decimKernels", 0, 0, runFirDispatch }
+};
+
+static const BenchVariant iirVariants[] =
+{
+    { "blkIirDf1", 0, 0, runBlkIirDf1 },
+    { "blkIirDf1Host", 0, 0, runBlkIirDf1Host },
+    { "blkIirDf1Spec", 0, 0, runBlkIirDf1Spec },
+    { "blkIirDf1Mc", 0, 0, runBlkIirDf1Mc },
+    { "blkIirSs_df1", 0, 0, runBlkIirSsDf1 },
+    { "decimKernels_df1", 0, 0, runIirDf1Dispatch },
+    { "blkIirDf2", 0, 0, runBlkIirDf2 },
+    { "blkIirDf2Lin", 0, 0, runBlkIirDf2Lin },
+    { "blkIirDf2Host", 0, 0, runBlkIirDf2Host },
+    { "blkIirDf2Spec", 0, 0, runBlkIirDf2Spec },
+    { "blkIirDf2Mc", 0, 0, runBlkIirDf2Mc },
+    { "blkIirSs_df2", 0, 0, runBlkIirSsDf2 },
+    { "decimKernels_df2", 0, 0, runIirDf2Dispatch }
+};
+
+static const BenchVariant gainVariants[] =
+{
+    { "appDiggain", 0, 0, runAppDiggain },
+    { "appDiggainHost", 0, 0, runAppDiggainHost },
+    { "appDiggainSse2", CPU_FEAT_SSE2, 0, runAppDiggainSse2 },
+    { "appDiggainAvx2", CPU_FEAT_AVX2, 0, runAppDiggainAvx2 },
+    { "decimKernels", 0, 0, runGainDispatch },
+    { "diggainProcess_lin", 0, 0, runDiggainLin },
+    { "diggainProcess_exp", 0, 0, runDiggainExp },
+    { "diggainProcess_agc", 0, 0, runDiggainAgc }
+};
+
+static const BenchVariant cascVariants[] =
+{
+    { "blkFirCascadeProcess", 0, 0, runBlkFirCascade },
+    { "blkFirCascadeProcessGain", 0, 0, runBlkFirCascadeGain }
+};
+
+static const BenchVariant pipeVariants[] =
+{
+    { "decimPipeProcess", 0, 0, runDecimPipe },
+    { "decimSched", 0, 0, runDecimSched },
+    { "decimPipeMt", 0, 0, runDecimPipeMt }
+};
+
+static const BenchKernel benchKernels[BENCH_NUM_KERNELS] =
+{
+    { "cic", cicVariants, GRID_LEN(cicVariants), BENCH_PDM_RATE/CIC_DF, 0, 0, 0 },
+    { "fir", firVariants, GRID_LEN(firVariants), BENCH_PDM_RATE/CIC_DF, 1, 0, 0 },
+    { "iir", iirVariants, GRID_LEN(iirVariants), BENCH_PDM_RATE/CIC_DF/4, 0, 1, 0 },
+    { "gain", gainVariants, GRID_LEN(gainVariants), BENCH_PDM_RATE/CIC_DF/4, 0, 0, 0 },
+    { "casc", cascVariants, GRID_LEN(cascVariants), BENCH_PDM_RATE/CIC_DF, 0, 0, 0 },
+    { "pipe", pipeVariants, GRID_LEN(pipeVariants), BENCH_PDM_RATE/CIC_DF/4, 0, 0, BENCH_PIPE_MAX_FRAME_LEN }
+};
+
+static BenchCtx benchCtx;
+
+/* xorshift32 */
+static Uint32 benchRand(Uint32 *pSeed)
+{
+    Uint32 x = *pSeed;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *pSeed = x;
+
+    return x;
+}
+
+/* Fills input buffers: random PDM words, S18Q16 noise at -12 dBFS */
+static void benchFillInput(BenchCtx *pCtx)
+{
+    Uint32 seed = 0x12345678;
+    Uint16 ch;
+    Uint16 i;
+
+    for (ch = 0; ch < BENCH_MAX_CH; ch++)
+    {
+        for (i = 0; i < BENCH_MAX_FRAME_LEN; i++)
+        {
+            pCtx->lData[ch][i] = benchRand(&seed);
+            pCtx->rData[ch][i] = benchRand(&seed);
+        }
+        for (i = 0; i < BENCH_MAX_SAMPS; i++)
+        {
+            pCtx->inSamps[ch][i] = (Int32)(benchRand(&seed) >> 17) - 16384;
+        }
+        pCtx->pLData[ch] = pCtx->lData[ch];
+        pCtx->pRData[ch] = pCtx->rData[ch];
+        pCtx->pInSamps[ch] = pCtx->inSamps[ch];
+        pCtx->pOutSamps[ch] = pCtx->outSamps[ch];
+    }
+}
+
+/* Designs numTaps windowed-sinc lowpass at 1/4 input rate (S16Q15). */
+/* Uses FIR1 & FIR2 coefficients for 15 & 58 taps. */
+static void benchFirCoefs(
+    Int16 *coefs,           /* FIR coefficients (S16Q15) */
+    Uint16 numTaps          /* number of coefficients */
+)
+{
+    const Float64 pi = 3.14159265358979323846;
+    Float64 t;
+    Float64 h;
+    Uint16 i;
+
+    if (numTaps == DECIM_FIR1_NUM_COEFS)
+    {
+        memcpy(coefs, decimFir1Coefs, sizeof(decimFir1Coefs));
+        return;
+    }
+    if (numTaps == DECIM_FIR2_NUM_COEFS)
+    {
+        memcpy(coefs, decimFir2Coefs, sizeof(decimFir2Coefs));
+        return;
+    }
+
+    for (i = 0; i < numTaps; i++)
+    {
+        t = i - (numTaps-1)/2.0;
+        h = (t == 0.0) ? 0.5 : sin(0.5*pi*t)/(pi*t);
+        h *= 0.54 - 0.46*cos(2.0*pi*i/(numTaps-1));     /* Hamming */
+        coefs[i] = (Int16)floor(h*32768.0 + 0.5);
+    }
+}
+
+/* Designs numBiquads cascade of 2nd-order lowpass sections, */
+/* DF1 & DF2 coefficient order, BENCH_COEF_IWL integer bits. */
+static void benchIirCoefs(
+    Int16 *df1Coefs,        /* coefficients, blkIirDf1() order: b0, b1, b2, a1, a2 */
+    Int16 *df2Coefs,        /* coefficients, blkIirDf2() order: a1, a2, b2, b0, b1 */
+    Uint16 numBiquads       /* number of biquads */
+)
+{
+    const Float64 pi = 3.14159265358979323846;
+    const Float64 scale = (Float64)(1 << (15-BENCH_COEF_IWL));
+    Float64 w0, alpha, a0;
+    Float64 b[3], a[2];
+    Uint16 j, k;
+
+    for (j = 0; j < numBiquads; j++)
+    {
+        /* Cutoff 2..5 kHz at 16 kHz, Q = 0.707 */
+        w0 = 2.0*pi*(2000.0 + 3000.0*j/BENCH_MAX_BIQUADS)/16000.0;
+        alpha = sin(w0)/(2.0*0.7071);
+        a0 = 1.0 + alpha;
+        b[0] = (1.0 - cos(w0))/2.0/a0;
+        b[1] = (1.0 - cos(w0))/a0;
+        b[2] = b[0];
+        a[0] = -2.0*cos(w0)/a0;
+        a[1] = (1.0 - alpha)/a0;
+
+        for (k = 0; k < 3; k++)
+        {
+            df1Coefs[5*j+k] = (Int16)floor(b[k]*scale + 0.5);
+        }
+        df1Coefs[5*j+3] = (Int16)floor(a[0]*scale + 0.5);
+        df1Coefs[5*j+4] = (Int16)floor(a[1]*scale + 0.5);
+
+        df2Coefs[5*j] = df1Coefs[5*j+3];
+        df2Coefs[5*j+1] = df1Coefs[5*j+4];
+        df2Coefs[5*j+2] = df1Coefs[5*j+2];
+        df2Coefs[5*j+3] = df1Coefs[5*j];
+        df2Coefs[5*j+4] = df1Coefs[5*j+1];
+    }
+}
+
+/* Stops threads of previous frame function, clears all kernel state */
+static void benchReset(BenchCtx *pCtx)
+{
+    Uint16 ch;
+
+    if (pCtx->stop != NULL)
+    {
+        pCtx->stop(pCtx);
+        pCtx->stop = NULL;
+    }
+    pCtx->started = 0;
+    for (ch = 0; ch < BENCH_MAX_CH; ch++)
+    {
+        pdmFirStateInit(&pCtx->pdmFirState[ch]);
+    }
+    memset(pCtx->cicState, 0, sizeof(pCtx->cicState));
+    memset(pCtx->firDlyBuf, 0, sizeof(pCtx->firDlyBuf));
+    memset(pCtx->iirDlyBuf, 0, sizeof(pCtx->iirDlyBuf));
+    pickBitsCicMcInit(&pCtx->cicMcState, pCtx->numCh);
+    blkIirMcInit(&pCtx->iirMcState, pCtx->numCh, pCtx->numBiquads);
+}
+
+/* Times frame function: repeats calls for at least minNs, best of numReps. */
+/* Returns ns per call. */
+static Float64 benchTime(
+    BenchCtx *pCtx,         /* benchmark context */
+    BenchRunFxn run,        /* frame function */
+    Uint64 minNs,           /* minimum time per repetition (ns) */
+    Uint16 numReps          /* number of repetitions */
+)
+{
+    Uint64 t0, dt;
+    Uint32 numIter;
+    Uint32 i;
+    Uint16 rep;
+    Float64 best;
+
+    benchReset(pCtx);
+    run(pCtx);  /* warm up caches & branch predictors */
+
+    /* Calibrate iteration count */
+    numIter = 1;
+    for (;;)
+    {
+        t0 = hostClockNowNs();
+        for (i = 0; i < numIter; i++)
+        {
+            run(pCtx);
+        }
+        dt = hostClockNowNs() - t0;
+        if ((dt >= minNs) || (numIter >= 0x40000000))
+        {
+            break;
+        }
+        numIter = (dt < minNs/64) ? numIter*64 : numIter*2;
+    }
+
+    best = (Float64)dt/numIter;
+    for (rep = 1; rep < numReps; rep++)
+    {
+        t0 = hostClockNowNs();
+        for (i = 0; i < numIter; i++)
+        {
+            run(pCtx);
+        }
+        dt = hostClockNowNs() - t0;
+        if ((Float64)dt/numIter < best)
+        {
+            best = (Float64)dt/numIter;
+        }
+    }
+
+    return best;
+}
+
+/* Writes JSON string, escaping quotes & backslashes */
+static void benchJsonString(
+    FILE *fp,               /* JSON file */
+    const char *str         /* string */
+)
+{
+    fputc('"', fp);
+    for (; *str != '\0'; str++)
+    {
+        if ((*str == '"') || (*str == '\\'))
+        {
+            fputc('\\', fp);
+        }
+        if ((Uint16)(unsigned char)*str >= 0x20)
+        {
+            fputc(*str, fp);
+        }
+    }
+    fputc('"', fp);
+}
+
+/* Writes one JSON result record */
+static void benchJsonRecord(
+    FILE *fp,               /* JSON file */
+    Uint16 first,           /* first record */
+    const BenchKernel *pKernel,
+    const BenchVariant *pVariant,
+    const BenchCtx *pCtx,
+    const BenchResult *pRes
+)
+{
+    fprintf(fp, "%s\n    { \"kernel\": \"%s\", \"variant\": \"%s\", \"frameLen\": %u, "
+        "\"taps\": %u, \"biquads\": %u, \"channels\": %u, \"samples\": %u, "
+        "\"nsPerFrame\": %.1f, \"nsPerSample\": %.4f, \"samplesPerSec\": %.0f, \"rtFactor\": %.2f }",
+        first ? "" : ",", pKernel->name, pVariant->name, pCtx->frameLen,
+        pKernel->gridTaps ? pCtx->numTaps : 0,
+        pKernel->gridBiquads ? pCtx->numBiquads : 0,
+        pCtx->numCh, pCtx->numSamps,
+        pRes->nsPerFrame, pRes->nsPerSamp, pRes->sampsPerSec, pRes->rtFactor);
+}
+
+static void usage(const char *name)
+{
+    fprintf(stderr, "Usage: %s [-k cic|fir|iir|gain|casc|pipe] [-t minMs] [-r reps] [-q] [-j jsonFile] [-l label]\n", name);
+}
+
+int main(int argc, char **argv)
+{
+    BenchCtx *pCtx = &benchCtx;
+    const BenchKernel *pKernel;
+    const BenchVariant *pVariant;
+    const Uint16 *frameLens;
+    const Uint16 *numChs;
+    Uint16 numFrameLens;
+    Uint16 numChLens;
+    Uint16 numParams;
+    const char *kernelName;
+    const char *jsonFileName;
+    const char *label;
+    Float64 minMs;
+    Uint16 numReps;
+    Uint16 quick;
+    Uint16 features;
+    Uint16 first;
+    BenchResult res;
+    Float64 frameSec;
+    Int16 pdmFirCoefs[BENCH_PDM_FIR_COEFS];
+    Uint16 pdmFirCoefQ;
+    char paramStr[8];
+    FILE *fp;
+    Uint16 k, v, f, p, c;
+    int arg;
+
+    kernelName = NULL;
+    jsonFileName = NULL;
+    label = "";
+    minMs = 5.0;
+    numReps = 3;
+    quick = 0;
+
+    for (arg = 1; arg < argc; arg++)
+    {
+        if (!strcmp(argv[arg], "-q"))
+        {
+            quick = 1;
+            continue;
+        }
+        if (arg+1 >= argc)
+        {
+            break;
+        }
+        if (!strcmp(argv[arg], "-k"))
+        {
+            kernelName = argv[++arg];
+        }
+        else if (!strcmp(argv[arg], "-t"))
+        {
+            minMs = atof(argv[++arg]);
+        }
+        else if (!strcmp(argv[arg], "-r"))
+        {
+            numReps = (Uint16)atoi(argv[++arg]);
+        }
+        else if (!strcmp(argv[arg], "-j"))
+        {
+            jsonFileName = argv[++arg];
+        }
+        else if (!strcmp(argv[arg], "-l"))
+        {
+            label = argv[++arg];
+        }
+        else
+        {
+            break;
+        }
+    }
+    if ((arg < argc) || (minMs <= 0.0) || (numReps < 1))
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    if (kernelName != NULL)
+    {
+        for (k = 0; k < BENCH_NUM_KERNELS; k++)
+        {
+            if (!strcmp(kernelName, benchKernels[k].name))
+            {
+                break;
+            }
+        }
+        if (k == BENCH_NUM_KERNELS)
+        {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    fp = NULL;
+    if (jsonFileName != NULL)
+    {
+        fp = fopen(jsonFileName, "w");
+        if (fp == NULL)
+        {
+            fprintf(stderr, "Cannot open %s\n", jsonFileName);
+            return 1;
+        }
+    }
+
+    frameLens = quick ? frameLenQuick : frameLenGrid;
+    numFrameLens = quick ? GRID_LEN(frameLenQuick) : GRID_LEN(frameLenGrid);
+    numChs = quick ? numChQuick : numChGrid;
+    numChLens = quick ? GRID_LEN(numChQuick) : GRID_LEN(numChGrid);
+
+    features = cpuFeatures();
+    decimDispatchInit();
+    cicCfgInit(&pCtx->cicCfg, CIC_DF, CIC_NS);
+    pickBitsCicTblInit();
+    benchFillInput(pCtx);
+    benchIirCoefs(pCtx->iirDf1Coefs, pCtx->iirDf2Coefs, BENCH_MAX_BIQUADS);
+    pdmFirDesign(pdmFirCoefs, BENCH_PDM_FIR_COEFS, 0.5/CIC_DF/2, &pdmFirCoefQ);
+    pdmFirTblInit(&pCtx->pdmFirTbl, pdmFirCoefs, BENCH_PDM_FIR_COEFS, pdmFirCoefQ, CIC_DF);
+
+    printf("PDM rate %u Hz, CPU features 0x%04x, dispatch ISA %s\n",
+        BENCH_PDM_RATE, features, decimIsaName(decimKernels()->isa));
+    printf("dispatch: cic %s, fir %s, iir df1 %s, iir df2 %s, gain %s\n",
+        decimKernelName(DECIM_KERNEL_CIC), decimKernelName(DECIM_KERNEL_FIR),
+        decimKernelName(DECIM_KERNEL_IIR_DF1), decimKernelName(DECIM_KERNEL_IIR_DF2),
+        decimKernelName(DECIM_KERNEL_DIGGAIN));
+    if (fp != NULL)
+    {
+        fprintf(fp, "{\n  \"label\": ");
+        benchJsonString(fp, label);
+        fprintf(fp, ",\n  \"pdmRate\": %u,\n  \"cpuFeatures\": %u,\n"
+            "  \"dispatchIsa\": \"%s\",\n  \"minMs\": %.1f,\n  \"reps\": %u,\n  \"results\": [",
+            BENCH_PDM_RATE, features, decimIsaName(decimKernels()->isa), minMs, numReps);
+    }
+    first = 1;
+
+    for (k = 0; k < BENCH_NUM_KERNELS; k++)
+    {
+        pKernel = &benchKernels[k];
+        if ((kernelName != NULL) && strcmp(kernelName, pKernel->name))
+        {
+            continue;
+        }
+
+        numParams = 1;
+        if (pKernel->gridTaps)
+        {
+            numParams = GRID_LEN(numTapsGrid);
+        }
+        else if (pKernel->gridBiquads)
+        {
+            numParams = GRID_LEN(numBiquadsGrid);
+        }
+
+        printf("\n%-24s %6s %6s %4s %10s %10s %9s\n", pKernel->name, "frame",
+            pKernel->gridTaps ? "taps" : (pKernel->gridBiquads ? "biquad" : ""),
+            "ch", "ns/samp", "Msamp/s", "RT");
+
+        for (p = 0; p < numParams; p++)
+        {
+            pCtx->numTaps = numTapsGrid[pKernel->gridTaps ? p : 0];
+            pCtx->numBiquads = numBiquadsGrid[pKernel->gridBiquads ? p : 0];
+
+            benchFirCoefs(pCtx->firCoefs, pCtx->numTaps);
+            pCtx->firFlags = 0;
+            if (blkFirCoefsSym(pCtx->firCoefs, pCtx->numTaps) == BLK_FIR_OK)
+            {
+                pCtx->firFlags |= BENCH_NEED_SYM;
+            }
+            if (blkFirHbCoefs(pCtx->firCoefs, pCtx->numTaps, pCtx->firHbCoefs) == BLK_FIR_OK)
+            {
+                pCtx->firFlags |= BENCH_NEED_HB;
+            }
+
+            for (v = 0; v < pKernel->numVariants; v++)
+            {
+                pVariant = &pKernel->variants[v];
+                if (((features & pVariant->features) != pVariant->features) ||
+                    ((pCtx->firFlags & pVariant->flags) != pVariant->flags))
+                {
+                    continue;
+                }
+
+                for (f = 0; f < numFrameLens; f++)
+                {
+                    if ((pKernel->maxFrameLen != 0) && (frameLens[f] > pKernel->maxFrameLen))
+                    {
+                        continue;
+                    }
+                    pCtx->frameLen = frameLens[f];
+                    pCtx->numSamps = (Uint16)((Uint32)pCtx->frameLen*64*pKernel->sampRate/BENCH_PDM_RATE);
+                    frameSec = (Float64)pCtx->frameLen*64/BENCH_PDM_RATE;
+
+                    for (c = 0; c < numChLens; c++)
+                    {
+                        pCtx->numCh = numChs[c];
+
+                        res.nsPerFrame = benchTime(pCtx, pVariant->run, (Uint64)(minMs*1e6), numReps);
+                        res.nsPerSamp = res.nsPerFrame/((Float64)pCtx->numSamps*pCtx->numCh);
+                        res.sampsPerSec = 1e9/res.nsPerSamp;
+                        res.rtFactor = frameSec*1e9/res.nsPerFrame;
+
+                        paramStr[0] = '\0';
+                        if (pKernel->gridTaps || pKernel->gridBiquads)
+                        {
+                            sprintf(paramStr, "%u", pKernel->gridTaps ? pCtx->numTaps : pCtx->numBiquads);
+                        }
+                        printf("%-24s %6u %6s %4u %10.3f %10.2f %9.1f\n", pVariant->name,
+                            pCtx->frameLen, paramStr, pCtx->numCh, res.nsPerSamp,
+                            res.sampsPerSec*1e-6, res.rtFactor);
+                        fflush(stdout);
+
+                        if (fp != NULL)
+                        {
+                            benchJsonRecord(fp, first, pKernel, pVariant, pCtx, &res);
+                            first = 0;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    benchReset(pCtx);
+
+    if (fp != NULL)
+    {
+        fprintf(fp, "\n  ]\n}\n");
+        fclose(fp);
+    }
+
+    return 0;
+}
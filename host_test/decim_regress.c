@@ -0,0 +1,2127 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "data_types.h"
+#include "cpu_features.h"
+#include "host_clock.h"
+#include "decim_coefs.h"
+#include "decim_dispatch.h"
+#include "decim_pipe.h"
+#include "decim_pipe_mt.h"
+#include "decim_sched.h"
+#include "pick_bits_cic.h"
+#include "pick_bits_cic_cfg.h"
+#include "pick_bits_cic_mc.h"
+#include "pdm_fir.h"
+#include "BlkAcc40.h"
+#include "BlkFirDecim.h"
+#include "BlkFirDecimSimd.h"
+#include "BlkFirCascade.h"
+#include "BlkIir.h"
+#include "BlkIirSpec.h"
+#include "BlkIirMc.h"
+#include "diggain.h"
+#include "diggain_simd.h"
+
+/* Bit-exactness regression test. */
+/* Runs every optimized CIC, FIR, IIR & digital gain kernel against its reference, */
+/* pickBitsCic(), blkFirDecim2(), blkIirDf1(), blkIirDf2() or appDiggain(), */
+/* on random & extreme inputs with random parameters. */
+/* Each check runs REG_NUM_FRAMES frames of random length, state carried across frames. */
+/* SIMD kernels not supported by host CPU are skipped. */
+/* Exits with 0 if all outputs match, 1 otherwise. */
+/* Usage: decim_regress [-s seed] [-n numTrials] */
+
+#define REG_NUM_FRAMES      ( 4 )       /* frames per check */
+#define REG_MAX_FRAME_LEN   ( 160 )     /* maximum frame length, 32-bit words */
+#define REG_MAX_SAMPS       ( REG_MAX_FRAME_LEN*64/8 )  /* CIC R = 8 output */
+#define REG_MAX_TAPS        ( 128 )
+#define REG_FIR_DLY_LEN     ( BLK_FIR_LIN_DLY_LEN(REG_MAX_TAPS) )   /* fits all FIR layouts */
+#define REG_MAX_BIQUADS     ( IIR_MC_MAX_BIQUADS )
+#define REG_IIR_DLY_LEN     ( 4*REG_MAX_BIQUADS+2 )     /* fits DF1 & DF2 layouts */
+#define REG_MAX_IWL         ( 2 )       /* maximum IIR coefficient integer wordlength */
+#define REG_MAX_CH          ( IIR_MC_MAX_CH )
+#define REG_MAX_FAILS_SHOWN ( 4 )       /* mismatches reported per check */
+#define REG_SCHED_STREAMS   ( 4 )       /* streams per scheduler check */
+#define REG_SCHED_FRAMES    ( 2*DECIM_SCHED_QUEUE_LEN )     /* frames per stream, overfills stream FIFO */
+#define REG_SCHED_WORKERS   ( 4 )       /* maximum number of scheduler workers */
+#define REG_MT_FRAMES       ( 8*DECIM_PIPE_MT_RING_LEN )    /* frames per pipeline-parallel check */
+#define REG_MAX_DONE        ( REG_SCHED_STREAMS*REG_SCHED_FRAMES )  /* completions logged per check */
+
+/* Completion gate, holds callback of one frame so a check can queue frames behind it */
+#define REG_GATE_OFF        ( 0 )       /* callbacks return at once */
+#define REG_GATE_ARMED      ( 1 )       /* callback of frame holdSeq holds */
+#define REG_GATE_HELD       ( 2 )       /* callback holding until gate set off */
+
+/* Input signals */
+#define REG_SIG_RAND        ( 0 )       /* random full scale, PDM random bits */
+#define REG_SIG_MAX         ( 1 )       /* positive full scale, PDM all ones */
+#define REG_SIG_MIN         ( 2 )       /* negative full scale, PDM all zeros */
+#define REG_SIG_ALT         ( 3 )       /* alternating full scale, PDM idle pattern */
+#define REG_SIG_SPARSE      ( 4 )       /* full-scale impulses, PDM bursts on idle pattern */
+#define REG_NUM_SIGS        ( 5 )
+
+#define REG_S18_MAX         ( ((Int32)1<<17)-1 )    /* S18Q16 positive full scale */
+#define REG_S18_MIN         ( -((Int32)1<<17) )     /* S18Q16 negative full scale */
+
+static const char *sigNames[REG_NUM_SIGS] = { "rand", "max", "min", "alt", "sparse" };
+
+/* Check result */
+typedef struct
+{
+    const char *name;       /* check name */
+    Uint32 numFrames;       /* frames compared */
+    Uint32 numFails;        /* frames with mismatch */
+    Uint16 sig;             /* current input signal */
+} RegResult;
+
+typedef void (*RegCheckFxn)(RegResult *pRes);
+
+/* Frame completion log, written by scheduler worker or stage threads */
+typedef struct
+{
+    pthread_mutex_t lock;   /* protects log & gate */
+    pthread_cond_t cond;    /* signaled on gate change */
+    Uint16 gate;            /* REG_GATE_xxx */
+    Uint32 holdSeq;         /* frame index held by armed gate */
+    Uint32 numDone;         /* number of completions */
+    Int32 stream[REG_MAX_DONE]; /* stream ID of each completion */
+    Int32 seq[REG_MAX_DONE];    /* frame index within stream of each completion */
+} RegDoneLog;
+
+/* Check */
+typedef struct
+{
+    const char *name;       /* check name */
+    Uint16 features;        /* required CPU_FEAT_xxx */
+    RegCheckFxn check;      /* check function */
+} RegCheck;
+
+/* Test buffers */
+typedef struct
+{
+    Uint32 lData[REG_MAX_CH][REG_MAX_FRAME_LEN];    /* "left" PDM words */
+    Uint32 rData[REG_MAX_CH][REG_MAX_FRAME_LEN];    /* "right" PDM words */
+    Int32 inSamps[REG_MAX_CH][REG_MAX_SAMPS];       /* input samples */
+    Int32 refOut[REG_MAX_CH][REG_MAX_SAMPS];        /* reference output */
+    Int32 out[REG_MAX_CH][REG_MAX_SAMPS];           /* output under test */
+    Int32 tmp[2][REG_MAX_SAMPS];                    /* reference intermediate frames */
+    Int16 refOut16[REG_MAX_SAMPS];                  /* reference S16Q15 output */
+    Int16 out16[REG_MAX_SAMPS];                     /* S16Q15 output under test */
+    Int32 refState[REG_MAX_CH][REG_IIR_DLY_LEN > REG_FIR_DLY_LEN ? REG_IIR_DLY_LEN : REG_FIR_DLY_LEN];
+    Int32 state[REG_MAX_CH][REG_IIR_DLY_LEN > REG_FIR_DLY_LEN ? REG_IIR_DLY_LEN : REG_FIR_DLY_LEN];
+    Int32 cascRefDly[BLK_FIR_CASC_MAX_STAGES][REG_FIR_DLY_LEN];
+    Int32 cascDly[BLK_FIR_CASC_MAX_STAGES][REG_FIR_DLY_LEN];
+    Int16 coefs[BLK_FIR_CASC_MAX_STAGES][PDM_FIR_MAX_COEFS];    /* FIR or IIR coefficients */
+    Int16 hbCoefs[REG_MAX_TAPS];                    /* half-band FIR coefficients */
+    Int16 df2Coefs[5*REG_MAX_BIQUADS];              /* IIR coefficients, blkIirDf2() order */
+    Uint32 *pLData[REG_MAX_CH];                     /* per-channel pointers, multi-channel kernels */
+    Uint32 *pRData[REG_MAX_CH];
+    Int32 *pInSamps[REG_MAX_CH];
+    Int32 *pOut[REG_MAX_CH];
+    Int32 pdmBits[REG_NUM_FRAMES*REG_MAX_FRAME_LEN*64 + PDM_FIR_MAX_COEFS];  /* +1/-1 PDM bit stream, pdmFirDecim() reference */
+    CicMcState cicMcState;
+    BlkIirMcState iirMcState;
+    PdmFirTbl pdmFirTbl;
+    PdmFirState pdmFirState;
+    BlkFirCascade casc;
+    DecimPipe pipe;
+    DecimPipe schedPipe[REG_SCHED_STREAMS];
+    DecimSched sched;
+    Uint32 schedLData[REG_SCHED_STREAMS][REG_SCHED_FRAMES][REG_MAX_FRAME_LEN];
+    Uint32 schedRData[REG_SCHED_STREAMS][REG_SCHED_FRAMES][REG_MAX_FRAME_LEN];
+    Int16 schedOut[REG_SCHED_STREAMS][REG_SCHED_FRAMES][DECIM_PIPE_MAX_OUT_LEN];
+    DecimPipe mtPipe;
+    DecimPipeMt mt;
+    Uint32 mtLData[REG_MT_FRAMES][REG_MAX_FRAME_LEN];
+    Uint32 mtRData[REG_MT_FRAMES][REG_MAX_FRAME_LEN];
+    Int16 mtOut[REG_MT_FRAMES][DECIM_PIPE_MAX_OUT_LEN];
+} RegCtx;
+
+static RegCtx regCtx;
+static RegDoneLog regDoneLog;
+static Uint32 regSeed;
+
+/* xorshift32 */
+static Uint32 regRand(void)
+{
+    Uint32 x = regSeed;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    regSeed = x;
+
+    return x;
+}
+
+/* Returns random value in lo->hi */
+static Int32 regRandRange(
+    Int32 lo,               /* lowest value */
+    Int32 hi                /* highest value */
+)
+{
+    return lo + (Int32)(regRand() % (Uint32)(hi - lo + 1));
+}
+
+/* Returns random frame length, multiple of mult, at most maxLen */
+static Uint16 regRandLen(
+    Uint16 mult,            /* length multiple */
+    Uint16 maxLen           /* maximum length */
+)
+{
+    return (Uint16)(mult * regRandRange(1, maxLen/mult));
+}
+
+/* Fills 32-bit packed PDM words */
+static void regFillPdm(
+    Uint32 *data,           /* PDM words */
+    Uint16 len,             /* number of words */
+    Uint16 sig              /* REG_SIG_xxx */
+)
+{
+    Uint16 i;
+
+    for (i = 0; i < len; i++)
+    {
+        switch (sig)
+        {
+        case REG_SIG_MAX:
+            data[i] = 0xFFFFFFFF;
+            break;
+        case REG_SIG_MIN:
+            data[i] = 0;
+            break;
+        case REG_SIG_ALT:
+            data[i] = 0x55555555;
+            break;
+        case REG_SIG_SPARSE:
+            data[i] = ((regRand() & 0x7) == 0) ? ((regRand() & 1) ? 0xFFFFFFFF : 0) : 0x55555555;
+            break;
+        default:
+            data[i] = regRand();
+            break;
+        }
+    }
+}
+
+/* Fills S18Q16 samples */
+static void regFillSamps(
+    Int32 *samps,           /* samples */
+    Uint16 len,             /* number of samples */
+    Uint16 sig              /* REG_SIG_xxx */
+)
+{
+    Uint16 i;
+
+    for (i = 0; i < len; i++)
+    {
+        switch (sig)
+        {
+        case REG_SIG_MAX:
+            samps[i] = REG_S18_MAX;
+            break;
+        case REG_SIG_MIN:
+            samps[i] = REG_S18_MIN;
+            break;
+        case REG_SIG_ALT:
+            samps[i] = (i & 1) ? REG_S18_MIN : REG_S18_MAX;
+            break;
+        case REG_SIG_SPARSE:
+            samps[i] = ((regRand() & 0xF) == 0) ? ((regRand() & 1) ? REG_S18_MAX : REG_S18_MIN) : 0;
+            break;
+        default:
+            samps[i] = regRandRange(REG_S18_MIN, REG_S18_MAX);
+            break;
+        }
+    }
+}
+
+/* Compares frame with reference, records result */
+static void regCmp32(
+    RegResult *pRes,        /* check result */
+    const Int32 *ref,       /* reference output */
+    const Int32 *out,       /* output under test */
+    Uint16 len,             /* number of samples */
+    const char *what        /* variant description */
+)
+{
+    Uint16 i;
+
+    pRes->numFrames++;
+    for (i = 0; i < len; i++)
+    {
+        if (ref[i] != out[i])
+        {
+            break;
+        }
+    }
+    if (i < len)
+    {
+        if (pRes->numFails < REG_MAX_FAILS_SHOWN)
+        {
+            printf("FAIL %s (%s, sig %s): sample %u of %u, ref %ld, out %ld\n", pRes->name, what,
+                sigNames[pRes->sig], i, len, (long)ref[i], (long)out[i]);
+        }
+        pRes->numFails++;
+    }
+}
+
+/* Compares S16Q15 frame with reference, records result */
+static void regCmp16(
+    RegResult *pRes,        /* check result */
+    const Int16 *ref,       /* reference output */
+    const Int16 *out,       /* output under test */
+    Uint16 len,             /* number of samples */
+    const char *what        /* variant description */
+)
+{
+    Int32 ref32[REG_MAX_SAMPS];
+    Int32 out32[REG_MAX_SAMPS];
+    Uint16 i;
+
+    for (i = 0; i < len; i++)
+    {
+        ref32[i] = ref[i];
+        out32[i] = out[i];
+    }
+    regCmp32(pRes, ref32, out32, len, what);
+}
+
+/* Random FIR coefficients (S16Q15), full 16-bit range */
+static void regFirCoefs(
+    Int16 *coefs,           /* filter coefficients */
+    Uint16 numCoefs,        /* number of coefficients */
+    Uint16 sym              /* non-zero for symmetric coefficients */
+)
+{
+    Uint16 i;
+
+    for (i = 0; i < numCoefs; i++)
+    {
+        coefs[i] = (Int16)regRand();
+    }
+    if (sym)
+    {
+        for (i = 0; i < numCoefs/2; i++)
+        {
+            coefs[numCoefs-1-i] = coefs[i];
+        }
+    }
+}
+
+/* Random stable biquad cascade, blkIirDf1() & blkIirDf2() order. */
+/* Poles inside radius 0.97, all coefficients fit coefIWL integer bits. */
+static void regIirCoefs(
+    Int16 *df1Coefs,        /* coefficients, blkIirDf1() order: b0, b1, b2, a1, a2 */
+    Int16 *df2Coefs,        /* coefficients, blkIirDf2() order: a1, a2, b2, b0, b1 */
+    Uint16 numBiquads,      /* number of biquads */
+    Uint16 coefIWL          /* coefficient integer wordlength */
+)
+{
+    Int32 coefMax;
+    Int32 r, c;
+    Int32 a1, a2;
+    Uint16 j, k;
+
+    /* |coef| < 2^coefIWL in S16Q(15-coefIWL) */
+    coefMax = 32767;
+    for (j = 0; j < numBiquads; j++)
+    {
+        /* Pole radius r & cos(theta) in Q15: a1 = -2*r*cos(theta), a2 = r^2 */
+        do
+        {
+            r = regRandRange(0, 31785);     /* 0.97 */
+            c = regRandRange(-32768, 32767);
+            a1 = -(Int32)(((Int64)2*r*c) >> (15+coefIWL));
+            a2 = (Int32)(((Int64)r*r) >> (15+coefIWL));
+        } while ((a1 > coefMax) || (a1 < -coefMax));
+
+        for (k = 0; k < 3; k++)
+        {
+            df1Coefs[5*j+k] = (Int16)regRandRange(-coefMax, coefMax);
+        }
+        df1Coefs[5*j+3] = (Int16)a1;
+        df1Coefs[5*j+4] = (Int16)a2;
+
+        df2Coefs[5*j] = df1Coefs[5*j+3];
+        df2Coefs[5*j+1] = df1Coefs[5*j+4];
+        df2Coefs[5*j+2] = df1Coefs[5*j+2];
+        df2Coefs[5*j+3] = df1Coefs[5*j];
+        df2Coefs[5*j+4] = df1Coefs[5*j+1];
+    }
+}
+
+/* Bit-serial N-stage CIC reference, decimation by R, */
+/* bit order & state layout as pickBitsCic(). */
+static void regCicRef(
+    Uint32 *lData,          /* "left" channel 32-bit packed input data */
+    Uint32 *rData,          /* "right" channel 32-bit packed input data */
+    Uint16 inDataLen,       /* length of "left" or "right" input data in 32-bit words */
+    Uint16 decimFact,       /* decimation factor R */
+    Uint16 numStages,       /* number of stages N */
+    Int32 *cicState,        /* CIC state, 2*N values */
+    Int32 *outSamps,        /* CIC output samples */
+    Uint16 *pNumOutSamps    /* CIC number of output samples */
+)
+{
+    Uint32 acc[CIC_MAX_NS];
+    Uint32 diffDly[CIC_MAX_NS];
+    Uint32 word;
+    Uint32 x, diff;
+    Uint16 bitCnt;
+    Uint16 numOut;
+    Uint16 i, j, w;
+    Int16 b;
+
+    for (j = 0; j < numStages; j++)
+    {
+        acc[j] = (Uint32)cicState[j];
+        diffDly[j] = (Uint32)cicState[numStages+j];
+    }
+
+    numOut = 0;
+    bitCnt = 0;
+    for (i = 0; i < inDataLen; i++)
+    {
+        for (w = 0; w < 2; w++)
+        {
+            word = (w == 0) ? lData[i] : rData[i];
+            for (b = 31; b >= 0; b--)
+            {
+                /* 0->-1, 1->+1 */
+                acc[0] += ((word >> b) & 1) ? 1 : (Uint32)-1;
+                for (j = 1; j < numStages; j++)
+                {
+                    acc[j] += acc[j-1];
+                }
+
+                if (++bitCnt == decimFact)
+                {
+                    bitCnt = 0;
+                    x = acc[numStages-1];
+                    for (j = 0; j < numStages; j++)
+                    {
+                        diff = x - diffDly[j];
+                        diffDly[j] = x;
+                        x = diff;
+                    }
+                    outSamps[numOut++] = (Int32)x;
+                }
+            }
+        }
+    }
+
+    for (j = 0; j < numStages; j++)
+    {
+        cicState[j] = (Int32)acc[j];
+        cicState[numStages+j] = (Int32)diffDly[j];
+    }
+    *pNumOutSamps = numOut;
+}
+
+/* pickBitsCicTbl() vs pickBitsCic() */
+static void checkCicTbl(RegResult *pRes)
+{
+    RegCtx *pCtx = &regCtx;
+    Uint16 len;
+    Uint16 numRef, numOut;
+    Uint16 f;
+
+    memset(pCtx->refState, 0, sizeof(pCtx->refState));
+    memset(pCtx->state, 0, sizeof(pCtx->state));
+    for (f = 0; f < REG_NUM_FRAMES; f++)
+    {
+        len = regRandLen(1, REG_MAX_FRAME_LEN);
+        regFillPdm(pCtx->lData[0], len, pRes->sig);
+        regFillPdm(pCtx->rData[0], len, pRes->sig);
+        pickBitsCic(pCtx->lData[0], pCtx->rData[0], len, pCtx->refState[0], pCtx->refOut[0], &numRef);
+        pickBitsCicTbl(pCtx->lData[0], pCtx->rData[0], len, pCtx->state[0], pCtx->out[0], &numOut);
+        regCmp32(pRes, pCtx->refOut[0], pCtx->out[0], numRef, "output");
+        regCmp32(pRes, pCtx->refState[0], pCtx->state[0], 2*CIC_NS, "state");
+    }
+}
+
+/* pickBitsCicMc() vs pickBitsCic() per channel */
+static void checkCicMc(RegResult *pRes)
+{
+    RegCtx *pCtx = &regCtx;
+    Uint16 numCh;
+    Uint16 len;
+    Uint16 numRef, numOut;
+    Uint16 f, ch;
+
+    numCh = (Uint16)regRandRange(1, CIC_MC_MAX_CH);
+    pickBitsCicMcInit(&pCtx->cicMcState, numCh);
+    memset(pCtx->refState, 0, sizeof(pCtx->refState));
+    for (f = 0; f < REG_NUM_FRAMES; f++)
+    {
+        len = regRandLen(1, REG_MAX_FRAME_LEN);
+        for (ch = 0; ch < numCh; ch++)
+        {
+            regFillPdm(pCtx->lData[ch], len, pRes->sig);
+            regFillPdm(pCtx->rData[ch], len, pRes->sig);
+            pickBitsCic(pCtx->lData[ch], pCtx->rData[ch], len, pCtx->refState[ch], pCtx->refOut[ch], &numRef);
+        }
+        pickBitsCicMc(pCtx->pLData, pCtx->pRData, len, &pCtx->cicMcState, pCtx->pOut, &numOut);
+        for (ch = 0; ch < numCh; ch++)
+        {
+            regCmp32(pRes, pCtx->refOut[ch], pCtx->out[ch], numRef, "output");
+        }
+    }
+}
+
+/* cicCfgProcess() vs pickBitsCic() (R = 16, N = 4) or bit-serial CIC, every (R, N) */
+static void checkCicCfg(RegResult *pRes)
+{
+    static const Uint16 decimFacts[] = { 8, 16, 32, 64 };
+    RegCtx *pCtx = &regCtx;
+    CicCfg cfg;
+    Uint16 decimFact, numStages;
+    Uint16 len;
+    Uint16 numRef, numOut;
+    Uint16 d, f;
+
+    for (d = 0; d < 4; d++)
+    {
+        decimFact = decimFacts[d];
+        for (numStages = CIC_CFG_MIN_NS; numStages <= CIC_CFG_MAX_NS; numStages++)
+        {
+            if (cicCfgInit(&cfg, decimFact, numStages) != CIC_CFG_OK)
+            {
+                continue;
+            }
+
+            memset(pCtx->refState, 0, sizeof(pCtx->refState));
+            memset(pCtx->state, 0, sizeof(pCtx->state));
+            for (f = 0; f < REG_NUM_FRAMES; f++)
+            {
+                len = regRandLen(1, REG_MAX_FRAME_LEN);
+                regFillPdm(pCtx->lData[0], len, pRes->sig);
+                regFillPdm(pCtx->rData[0], len, pRes->sig);
+                if ((decimFact == CIC_DF) && (numStages == CIC_NS))
+                {
+                    pickBitsCic(pCtx->lData[0], pCtx->rData[0], len, pCtx->refState[0], pCtx->refOut[0], &numRef);
+                }
+                else
+                {
+                    regCicRef(pCtx->lData[0], pCtx->rData[0], len, decimFact, numStages,
+                        pCtx->refState[0], pCtx->refOut[0], &numRef);
+                }
+                cicCfgProcess(&cfg, pCtx->lData[0], pCtx->rData[0], len, pCtx->state[0], pCtx->out[0], &numOut);
+                regCmp32(pRes, pCtx->refOut[0], pCtx->out[0], numRef, "output");
+                regCmp32(pRes, pCtx->refState[0], pCtx->state[0], 2*numStages, "state");
+            }
+        }
+    }
+}
+
+/* pdmFirDecim() vs direct convolution of +1/-1 bit stream */
+static void checkPdmFir(RegResult *pRes)
+{
+    static const Uint16 decimFacts[] = { 8, 16, 32, 64 };
+    RegCtx *pCtx = &regCtx;
+    Int16 *coefs;
+    Uint16 numCoefs;
+    Uint16 coefQ;
+    Uint16 decimFact;
+    Uint16 outShift;
+    Int32 *bits;
+    Uint32 numBits;
+    Uint32 n;
+    Int32 acc;
+    Uint16 len;
+    Uint16 numOut;
+    Uint16 f, i, k;
+    Int16 b;
+
+    coefs = pCtx->coefs[0];
+    decimFact = decimFacts[regRand() & 3];
+    if (regRand() & 1)
+    {
+        /* Designed filter, cutoff 16 kHz at 1.024 MHz */
+        numCoefs = 256;
+        pdmFirDesign(coefs, numCoefs, 0.015625, &coefQ);
+    }
+    else
+    {
+        numCoefs = regRandLen(PDM_FIR_BITS_PER_BYTE, PDM_FIR_MAX_COEFS);
+        coefQ = (Uint16)regRandRange(PDM_FIR_MIN_COEF_Q, PDM_FIR_MAX_COEF_Q);
+        regFirCoefs(coefs, numCoefs, 0);
+    }
+    pdmFirTblInit(&pCtx->pdmFirTbl, coefs, numCoefs, coefQ, decimFact);
+    pdmFirStateInit(&pCtx->pdmFirState);
+    outShift = coefQ - 16;
+
+    /* History before 1st input is idle pattern, most recent bit 1 */
+    bits = &pCtx->pdmBits[PDM_FIR_MAX_COEFS];
+    for (k = 1; k <= PDM_FIR_MAX_COEFS; k++)
+    {
+        bits[-(Int32)k] = (k & 1) ? 1 : -1;
+    }
+
+    numBits = 0;
+    for (f = 0; f < REG_NUM_FRAMES; f++)
+    {
+        len = regRandLen(1, REG_MAX_FRAME_LEN);
+        regFillPdm(pCtx->lData[0], len, pRes->sig);
+        regFillPdm(pCtx->rData[0], len, pRes->sig);
+
+        /* Reference: coefs[k] applies to bit n-k, n most recent */
+        numOut = 0;
+        for (i = 0; i < len; i++)
+        {
+            for (b = 63; b >= 0; b--)
+            {
+                n = numBits++;
+                bits[n] = (((b >= 32) ? (pCtx->lData[0][i] >> (b-32)) : (pCtx->rData[0][i] >> b)) & 1) ? 1 : -1;
+                if (numBits % decimFact == 0)
+                {
+                    acc = 0;
+                    for (k = 0; k < numCoefs; k++)
+                    {
+                        acc += coefs[k] * bits[(Int32)n-k];
+                    }
+                    pCtx->refOut[0][numOut++] = (acc + ((outShift > 0) ? (Int32)1<<(outShift-1) : 0)) >> outShift;
+                }
+            }
+        }
+
+        pdmFirDecim(pCtx->lData[0], pCtx->rData[0], len, &pCtx->pdmFirTbl, &pCtx->pdmFirState,
+            pCtx->out[0], &numOut);
+        regCmp32(pRes, pCtx->refOut[0], pCtx->out[0], numOut, "output");
+    }
+}
+
+/* Runs FIR kernel against blkFirDecim2() on REG_NUM_FRAMES frames */
+static void regFirRun(
+    RegResult *pRes,        /* check result */
+    BlkFirDecim2Fxn fxn,    /* kernel under test */
+    Int16 *coefs,           /* blkFirDecim2() coefficients */
+    Int16 *kernCoefs,       /* kernel coefficients */
+    Uint16 numCoefs,        /* number of coefficients */
+    Uint16 cmpState,        /* non-zero if kernel uses blkFirDecim2() delay buffer layout */
+    const char *what        /* variant description */
+)
+{
+    RegCtx *pCtx = &regCtx;
+    Uint16 len;
+    Uint16 f;
+
+    memset(pCtx->refState, 0, sizeof(pCtx->refState));
+    memset(pCtx->state, 0, sizeof(pCtx->state));
+    for (f = 0; f < REG_NUM_FRAMES; f++)
+    {
+        len = regRandLen(4, REG_MAX_SAMPS);
+        regFillSamps(pCtx->inSamps[0], len, pRes->sig);
+        blkFirDecim2(pCtx->inSamps[0], coefs, pCtx->refOut[0], pCtx->refState[0], len, numCoefs);
+        fxn(pCtx->inSamps[0], kernCoefs, pCtx->out[0], pCtx->state[0], len, numCoefs);
+        regCmp32(pRes, pCtx->refOut[0], pCtx->out[0], len/2, what);
+        if (cmpState)
+        {
+            regCmp32(pRes, pCtx->refState[0], pCtx->state[0], numCoefs+3, "state");
+        }
+    }
+}
+
+/* blkFirDecim2Sym() as BlkFirDecim2Fxn */
+static void regFirSym(
+    Int32 *inSamps, Int16 *coefs, Int32 *outSamps, Int32 *dlyBuf, Uint16 numInSamps, Uint16 numCoefs)
+{
+    blkFirDecim2Sym(inSamps, coefs, outSamps, dlyBuf, numInSamps, numCoefs);
+}
+
+/* blkFirDecimM() M = 2 as BlkFirDecim2Fxn */
+static void regFirM2(
+    Int32 *inSamps, Int16 *coefs, Int32 *outSamps, Int32 *dlyBuf, Uint16 numInSamps, Uint16 numCoefs)
+{
+    blkFirDecimM(inSamps, coefs, outSamps, dlyBuf, numInSamps, numCoefs, 2);
+}
+
+/* blkFirDecimMRef() M = 2 as BlkFirDecim2Fxn */
+static void regFirMRef2(
+    Int32 *inSamps, Int16 *coefs, Int32 *outSamps, Int32 *dlyBuf, Uint16 numInSamps, Uint16 numCoefs)
+{
+    blkFirDecimMRef(inSamps, coefs, outSamps, dlyBuf, numInSamps, numCoefs, 2);
+}
+
+/* Picks FIR length & coefficients: FIR1, FIR2 or random full-range */
+static Uint16 regFirPick(
+    Int16 *coefs,           /* filter coefficients */
+    Uint16 sym              /* non-zero for symmetric coefficients */
+)
+{
+    Uint16 numCoefs;
+
+    switch (regRand() % 4)
+    {
+    case 0:
+        numCoefs = DECIM_FIR1_NUM_COEFS;
+        memcpy(coefs, decimFir1Coefs, sizeof(decimFir1Coefs));
+        break;
+    case 1:
+        numCoefs = DECIM_FIR2_NUM_COEFS;
+        memcpy(coefs, decimFir2Coefs, sizeof(decimFir2Coefs));
+        break;
+    default:
+        numCoefs = (Uint16)regRandRange(2, REG_MAX_TAPS);
+        regFirCoefs(coefs, numCoefs, sym);
+        break;
+    }
+
+    return numCoefs;
+}
+
+/* blkFirDecim2Sym(), blkFirDecim2Lin(), blkFirDecim2Host(), blkFirDecimM() & blkFirDecimMRef() M = 2 */
+static void checkFir(RegResult *pRes)
+{
+    RegCtx *pCtx = &regCtx;
+    Int16 *coefs = pCtx->coefs[0];
+    Uint16 numCoefs;
+
+    numCoefs = regFirPick(coefs, 0);
+    regFirRun(pRes, blkFirDecim2Lin, coefs, coefs, numCoefs, 0, "blkFirDecim2Lin");
+    regFirRun(pRes, blkFirDecim2Host, coefs, coefs, numCoefs, 1, "blkFirDecim2Host");
+    regFirRun(pRes, regFirM2, coefs, coefs, numCoefs, 0, "blkFirDecimM");
+    regFirRun(pRes, regFirMRef2, coefs, coefs, numCoefs, 0, "blkFirDecimMRef");
+
+    numCoefs = regFirPick(coefs, 1);
+    regFirRun(pRes, regFirSym, coefs, coefs, numCoefs, 1, "blkFirDecim2Sym");
+}
+
+/* blkFirDecim2Hb() vs blkFirDecim2() on full half-band coefficient set */
+static void checkFirHb(RegResult *pRes)
+{
+    RegCtx *pCtx = &regCtx;
+    Int16 *coefs = pCtx->coefs[0];
+    Uint16 numCoefs;
+    Uint16 k, i;
+
+    if (regRand() & 1)
+    {
+        numCoefs = DECIM_FIR1_NUM_COEFS;
+        memcpy(coefs, decimFir1Coefs, sizeof(decimFir1Coefs));
+    }
+    else
+    {
+        /* 4K-1 taps, zero at even distance from center, center 0.5 or random */
+        k = (Uint16)regRandRange(1, (REG_MAX_TAPS+1)/4);
+        numCoefs = 4*k-1;
+        regFirCoefs(coefs, numCoefs, 1);
+        for (i = 1; i < numCoefs; i += 2)
+        {
+            coefs[i] = 0;
+        }
+        coefs[numCoefs/2] = (regRand() & 1) ? 16384 : (Int16)regRand();
+    }
+    blkFirHbCoefs(coefs, numCoefs, pCtx->hbCoefs);
+    regFirRun(pRes, blkFirDecim2Hb, coefs, pCtx->hbCoefs, numCoefs, 1, "blkFirDecim2Hb");
+}
+
+/* blkFirDecimM() vs blkFirDecimMRef(), M = 2..6 */
+static void checkFirM(RegResult *pRes)
+{
+    RegCtx *pCtx = &regCtx;
+    Int16 *coefs = pCtx->coefs[0];
+    Uint16 numCoefs;
+    Uint16 decimFact;
+    Uint16 len;
+    Uint16 f;
+
+    for (decimFact = 2; decimFact <= 6; decimFact++)
+    {
+        numCoefs = regFirPick(coefs, 0);
+        memset(pCtx->refState, 0, sizeof(pCtx->refState));
+        memset(pCtx->state, 0, sizeof(pCtx->state));
+        for (f = 0; f < REG_NUM_FRAMES; f++)
+        {
+            len = regRandLen(decimFact, REG_MAX_SAMPS);
+            regFillSamps(pCtx->inSamps[0], len, pRes->sig);
+            blkFirDecimMRef(pCtx->inSamps[0], coefs, pCtx->refOut[0], pCtx->refState[0], len, numCoefs, decimFact);
+            blkFirDecimM(pCtx->inSamps[0], coefs, pCtx->out[0], pCtx->state[0], len, numCoefs, decimFact);
+            regCmp32(pRes, pCtx->refOut[0], pCtx->out[0], len/decimFact, "output");
+            regCmp32(pRes, pCtx->refState[0], pCtx->state[0], BLK_FIR_M_DLY_LEN(numCoefs), "state");
+        }
+    }
+}
+
+/* SIMD FIR kernels vs blkFirDecim2() */
+static void checkFirSse41(RegResult *pRes)
+{
+    Int16 *coefs = regCtx.coefs[0];
+    Uint16 numCoefs = regFirPick(coefs, 0);
+
+    regFirRun(pRes, blkFirDecim2LinSse41, coefs, coefs, numCoefs, 0, "output");
+}
+
+static void checkFirAvx2(RegResult *pRes)
+{
+    Int16 *coefs = regCtx.coefs[0];
+    Uint16 numCoefs = regFirPick(coefs, 0);
+
+    regFirRun(pRes, blkFirDecim2LinAvx2, coefs, coefs, numCoefs, 0, "output");
+}
+
+static void checkFirAvx512(RegResult *pRes)
+{
+    Int16 *coefs = regCtx.coefs[0];
+    Uint16 numCoefs = regFirPick(coefs, 0);
+
+    regFirRun(pRes, blkFirDecim2LinAvx512, coefs, coefs, numCoefs, 0, "output");
+}
+
+/* Host FIR kernels vs blkFirDecim2(), inputs beyond S18Q16 push accumulator past 40 bits. */
+/* With ACC_WRAP_40B kernels wrap after rounding as C55x, expected output is */
+/* low 32 bits of unwrapped acc>>15 sign extended from bit 24. */
+static void checkFirAcc40(RegResult *pRes)
+{
+    RegCtx *pCtx = &regCtx;
+    Int16 *coefs = pCtx->coefs[0];
+    BlkFirDecim2Fxn kernels[5] = { blkFirDecim2Host, blkFirDecim2Lin,
+        blkFirDecim2LinSse41, blkFirDecim2LinAvx2, blkFirDecim2LinAvx512 };
+    Uint16 kernFeatures[5] = { 0, 0, CPU_FEAT_SSE41, CPU_FEAT_AVX2, CPU_FEAT_AVX512F };
+    const char *kernNames[5] = { "blkFirDecim2Host", "blkFirDecim2Lin",
+        "blkFirDecim2LinSse41", "blkFirDecim2LinAvx2", "blkFirDecim2LinAvx512" };
+    Uint16 features;
+    Uint16 diggain;
+    Uint16 len;
+    Uint16 f, i, v;
+
+    features = cpuFeatures();
+    regFirCoefs(coefs, REG_MAX_TAPS, 0);
+    diggain = (Uint16)regRand();
+
+    /* Kernels, then blkFirDecim2GainHost() */
+    for (v = 0; v <= 5; v++)
+    {
+        if ((v < 5) && ((features & kernFeatures[v]) != kernFeatures[v]))
+        {
+            continue;
+        }
+        memset(pCtx->refState, 0, sizeof(pCtx->refState));
+        memset(pCtx->state, 0, sizeof(pCtx->state));
+        for (f = 0; f < REG_NUM_FRAMES; f++)
+        {
+            len = regRandLen(4, REG_MAX_SAMPS);
+            regFillSamps(pCtx->inSamps[0], len, pRes->sig);
+            for (i = 0; i < len; i++)
+            {
+                pCtx->inSamps[0][i] = (Int32)((Uint32)pCtx->inSamps[0][i] << 6); /* S24Q16 */
+            }
+            blkFirDecim2(pCtx->inSamps[0], coefs, pCtx->refOut[0], pCtx->refState[0], len, REG_MAX_TAPS);
+#if (ACC_WRAP_40B == 1)
+            for (i = 0; i < len/2; i++)
+            {
+                pCtx->refOut[0][i] = (Int32)((Uint32)pCtx->refOut[0][i] << 7) >> 7;
+            }
+#endif
+            if (v < 5)
+            {
+                kernels[v](pCtx->inSamps[0], coefs, pCtx->out[0], pCtx->state[0], len, REG_MAX_TAPS);
+                regCmp32(pRes, pCtx->refOut[0], pCtx->out[0], len/2, kernNames[v]);
+            }
+            else
+            {
+                appDiggain(pCtx->refOut[0], diggain, pCtx->refOut16, len/2);
+                blkFirDecim2GainHost(pCtx->inSamps[0], coefs, pCtx->out16, pCtx->state[0], diggain, len, REG_MAX_TAPS);
+                regCmp16(pRes, pCtx->refOut16, pCtx->out16, len/2, "blkFirDecim2GainHost");
+            }
+        }
+    }
+}
+
+/* blkFirDecim2Gain() & blkFirDecim2GainHost() vs blkFirDecim2() + appDiggain() */
+static void checkFirGain(RegResult *pRes)
+{
+    RegCtx *pCtx = &regCtx;
+    Int16 *coefs = pCtx->coefs[0];
+    Uint16 numCoefs;
+    Uint16 diggain;
+    Uint16 len;
+    Uint16 f, v;
+
+    for (v = 0; v < 2; v++)
+    {
+        numCoefs = regFirPick(coefs, 0);
+        diggain = (Uint16)regRand();
+        memset(pCtx->refState, 0, sizeof(pCtx->refState));
+        memset(pCtx->state, 0, sizeof(pCtx->state));
+        for (f = 0; f < REG_NUM_FRAMES; f++)
+        {
+            len = regRandLen(4, REG_MAX_SAMPS);
+            regFillSamps(pCtx->inSamps[0], len, pRes->sig);
+            blkFirDecim2(pCtx->inSamps[0], coefs, pCtx->refOut[0], pCtx->refState[0], len, numCoefs);
+            appDiggain(pCtx->refOut[0], diggain, pCtx->refOut16, len/2);
+            if (v == 0)
+            {
+                blkFirDecim2Gain(pCtx->inSamps[0], coefs, pCtx->out16, pCtx->state[0], diggain, len, numCoefs);
+            }
+            else
+            {
+                blkFirDecim2GainHost(pCtx->inSamps[0], coefs, pCtx->out16, pCtx->state[0], diggain, len, numCoefs);
+            }
+            regCmp16(pRes, pCtx->refOut16, pCtx->out16, len/2, (v == 0) ? "blkFirDecim2Gain" : "blkFirDecim2GainHost");
+            regCmp32(pRes, pCtx->refState[0], pCtx->state[0], numCoefs+3, "state");
+        }
+    }
+}
+
+/* blkFirCascadeProcess() & blkFirCascadeProcessGain() vs whole-frame blkFirDecim2() stages. */
+/* Stage kernels blkFirDecim2(), blkFirDecim2Host() & blkFirDecim2Lin(), */
+/* so gain is fused into blkFirDecim2Gain(), blkFirDecim2GainHost() or run as epilogue. */
+static void checkFirCascade(RegResult *pRes)
+{
+    RegCtx *pCtx = &regCtx;
+    BlkFirCascade *pCasc = &pCtx->casc;
+    Uint16 numStages;
+    Uint16 lenMult;
+    Uint16 tileLen;
+    Uint16 numCoefs[BLK_FIR_CASC_MAX_STAGES];
+    BlkFirDecim2Fxn kernels[3] = { blkFirDecim2, blkFirDecim2Host, blkFirDecim2Lin };
+    Uint16 gain;
+    Uint16 diggain;
+    Uint16 len, stageLen;
+    Int32 *pIn, *pOut;
+    Uint16 f, j;
+
+    numStages = (Uint16)regRandRange(1, BLK_FIR_CASC_MAX_STAGES);
+    lenMult = 4<<(numStages-1);
+    tileLen = regRandLen(lenMult, BLK_FIR_CASC_MAX_TILE_LEN);
+    gain = regRand() & 1;
+    diggain = (Uint16)regRand();
+
+    blkFirCascadeInit(pCasc, numStages, tileLen);
+    for (j = 0; j < numStages; j++)
+    {
+        numCoefs[j] = regFirPick(pCtx->coefs[j], 0);
+        blkFirCascadeSetStage(pCasc, j, pCtx->coefs[j], numCoefs[j], pCtx->cascDly[j],
+            kernels[regRand() % 3]);
+    }
+    blkFirCascadeSetGain(pCasc, diggain, NULL);
+    memset(pCtx->cascRefDly, 0, sizeof(pCtx->cascRefDly));
+    memset(pCtx->cascDly, 0, sizeof(pCtx->cascDly));
+
+    for (f = 0; f < REG_NUM_FRAMES; f++)
+    {
+        len = regRandLen(lenMult, REG_MAX_SAMPS);
+        regFillSamps(pCtx->inSamps[0], len, pRes->sig);
+
+        pIn = pCtx->inSamps[0];
+        stageLen = len;
+        for (j = 0; j < numStages; j++)
+        {
+            pOut = (j == numStages-1) ? pCtx->refOut[0] : pCtx->tmp[j&1];
+            blkFirDecim2(pIn, pCtx->coefs[j], pOut, pCtx->cascRefDly[j], stageLen, numCoefs[j]);
+            pIn = pOut;
+            stageLen >>= 1;
+        }
+
+        if (gain)
+        {
+            appDiggain(pCtx->refOut[0], diggain, pCtx->refOut16, stageLen);
+            blkFirCascadeProcessGain(pCasc, pCtx->inSamps[0], pCtx->out16, len);
+            regCmp16(pRes, pCtx->refOut16, pCtx->out16, stageLen, "blkFirCascadeProcessGain");
+        }
+        else
+        {
+            blkFirCascadeProcess(pCasc, pCtx->inSamps[0], pCtx->out[0], len);
+            regCmp32(pRes, pCtx->refOut[0], pCtx->out[0], stageLen, "blkFirCascadeProcess");
+        }
+    }
+}
+
+/* Runs IIR kernel against reference on REG_NUM_FRAMES frames */
+static void regIirRun(
+    RegResult *pRes,        /* check result */
+    BlkIirFxn refFxn,       /* reference kernel */
+    BlkIirFxn fxn,          /* kernel under test */
+    Int16 *coefs,           /* filter coefficients */
+    Uint16 numBiquads,      /* number of biquads */
+    Uint16 coefIWL,         /* coefficient integer wordlength */
+    const char *what        /* variant description */
+)
+{
+    RegCtx *pCtx = &regCtx;
+    Uint16 inGain;
+    Uint16 len;
+    Uint16 f;
+
+    inGain = (Uint16)regRand();
+    memset(pCtx->refState, 0, sizeof(pCtx->refState));
+    memset(pCtx->state, 0, sizeof(pCtx->state));
+    for (f = 0; f < REG_NUM_FRAMES; f++)
+    {
+        len = regRandLen(1, REG_MAX_SAMPS);
+        regFillSamps(pCtx->inSamps[0], len, pRes->sig);
+        refFxn(pCtx->inSamps[0], coefs, pCtx->refOut[0], pCtx->refState[0], inGain, len, numBiquads, coefIWL);
+        fxn(pCtx->inSamps[0], coefs, pCtx->out[0], pCtx->state[0], inGain, len, numBiquads, coefIWL);
+        regCmp32(pRes, pCtx->refOut[0], pCtx->out[0], len, what);
+    }
+}
+
+/* blkIirDf1Host(), blkIirDf2Host() & blkIirDf2Lin() vs blkIirDf1() & blkIirDf2() */
+static void checkIir(RegResult *pRes)
+{
+    RegCtx *pCtx = &regCtx;
+    Uint16 numBiquads;
+    Uint16 coefIWL;
+
+    numBiquads = (Uint16)regRandRange(1, REG_MAX_BIQUADS);
+    coefIWL = (Uint16)regRandRange(0, REG_MAX_IWL);
+    regIirCoefs(pCtx->coefs[0], pCtx->df2Coefs, numBiquads, coefIWL);
+
+    regIirRun(pRes, blkIirDf1, blkIirDf1Host, pCtx->coefs[0], numBiquads, coefIWL, "blkIirDf1Host");
+    regIirRun(pRes, blkIirDf2, blkIirDf2Host, pCtx->df2Coefs, numBiquads, coefIWL, "blkIirDf2Host");
+    regIirRun(pRes, blkIirDf2, blkIirDf2Lin, pCtx->df2Coefs, numBiquads, coefIWL, "blkIirDf2Lin");
+}
+
+/* blkIirDf1Spec() & blkIirDf2Spec() vs blkIirDf1() & blkIirDf2() */
+static void checkIirSpec(RegResult *pRes)
+{
+    RegCtx *pCtx = &regCtx;
+    Uint16 numBiquads;
+    Uint16 coefIWL;
+
+    numBiquads = (Uint16)regRandRange(1, IIR_SPEC_MAX_BIQUADS);
+    coefIWL = (Uint16)regRandRange(0, IIR_SPEC_MAX_IWL);
+    regIirCoefs(pCtx->coefs[0], pCtx->df2Coefs, numBiquads, coefIWL);
+
+    regIirRun(pRes, blkIirDf1, blkIirDf1Spec, pCtx->coefs[0], numBiquads, coefIWL, "blkIirDf1Spec");
+    regIirRun(pRes, blkIirDf2, blkIirDf2Spec, pCtx->df2Coefs, numBiquads, coefIWL, "blkIirDf2Spec");
+}
+
+/* blkIirDf1Mc() & blkIirDf2Mc() vs blkIirDf1() & blkIirDf2() per channel */
+static void checkIirMc(RegResult *pRes)
+{
+    RegCtx *pCtx = &regCtx;
+    Uint16 numCh;
+    Uint16 numBiquads;
+    Uint16 coefIWL;
+    Uint16 inGain;
+    Uint16 len;
+    Uint16 f, ch, df;
+
+    for (df = 1; df <= 2; df++)
+    {
+        numCh = (Uint16)regRandRange(1, IIR_MC_MAX_CH);
+        numBiquads = (Uint16)regRandRange(1, REG_MAX_BIQUADS);
+        coefIWL = (Uint16)regRandRange(0, REG_MAX_IWL);
+        inGain = (Uint16)regRand();
+        regIirCoefs(pCtx->coefs[0], pCtx->df2Coefs, numBiquads, coefIWL);
+        blkIirMcInit(&pCtx->iirMcState, numCh, numBiquads);
+        memset(pCtx->refState, 0, sizeof(pCtx->refState));
+
+        for (f = 0; f < REG_NUM_FRAMES; f++)
+        {
+            len = regRandLen(1, REG_MAX_SAMPS);
+            for (ch = 0; ch < numCh; ch++)
+            {
+                regFillSamps(pCtx->inSamps[ch], len, pRes->sig);
+                if (df == 1)
+                {
+                    blkIirDf1(pCtx->inSamps[ch], pCtx->coefs[0], pCtx->refOut[ch], pCtx->refState[ch],
+                        inGain, len, numBiquads, coefIWL);
+                }
+                else
+                {
+                    blkIirDf2(pCtx->inSamps[ch], pCtx->df2Coefs, pCtx->refOut[ch], pCtx->refState[ch],
+                        inGain, len, numBiquads, coefIWL);
+                }
+            }
+            if (df == 1)
+            {
+                blkIirDf1Mc(pCtx->pInSamps, pCtx->coefs[0], pCtx->pOut, &pCtx->iirMcState, inGain, len, coefIWL);
+            }
+            else
+            {
+                blkIirDf2Mc(pCtx->pInSamps, pCtx->df2Coefs, pCtx->pOut, &pCtx->iirMcState, inGain, len, coefIWL);
+            }
+            for (ch = 0; ch < numCh; ch++)
+            {
+                regCmp32(pRes, pCtx->refOut[ch], pCtx->out[ch], len, (df == 1) ? "blkIirDf1Mc" : "blkIirDf2Mc");
+            }
+        }
+    }
+}
+
+/* Fills digital gain input: S18Q16 signal, random signal also over full 32-bit range */
+static void regFillGainIn(
+    Int32 *samps,           /* samples */
+    Uint16 len,             /* number of samples */
+    Uint16 sig              /* REG_SIG_xxx */
+)
+{
+    Uint16 i;
+
+    regFillSamps(samps, len, sig);
+    if ((sig == REG_SIG_RAND) && (regRand() & 1))
+    {
+        for (i = 0; i < len; i++)
+        {
+            samps[i] = (Int32)regRand();
+        }
+    }
+}
+
+/* Returns random digital gain, extremes included */
+static Uint16 regRandGain(void)
+{
+    switch (regRand() % 4)
+    {
+    case 0:
+        return 0;
+    case 1:
+        return 0xFFFF;
+    default:
+        return (Uint16)regRand();
+    }
+}
+
+/* Runs digital gain kernel against appDiggain() */
+static void regGainRun(
+    RegResult *pRes,        /* check result */
+    DiggainFxn fxn,         /* kernel under test */
+    const char *what        /* variant description */
+)
+{
+    RegCtx *pCtx = &regCtx;
+    Uint16 diggain;
+    Uint16 len;
+    Uint16 f;
+
+    for (f = 0; f < REG_NUM_FRAMES; f++)
+    {
+        diggain = regRandGain();
+        len = regRandLen(1, REG_MAX_SAMPS);
+        regFillGainIn(pCtx->inSamps[0], len, pRes->sig);
+        appDiggain(pCtx->inSamps[0], diggain, pCtx->refOut16, len);
+        fxn(pCtx->inSamps[0], diggain, pCtx->out16, len);
+        regCmp16(pRes, pCtx->refOut16, pCtx->out16, len, what);
+    }
+}
+
+/* appDiggainHost() & diggainProcess() at constant gain vs appDiggain() */
+static void checkGain(RegResult *pRes)
+{
+    RegCtx *pCtx = &regCtx;
+    DiggainState gainState;
+    Uint16 diggain;
+    Uint16 len;
+    Uint16 f;
+
+    regGainRun(pRes, appDiggainHost, "appDiggainHost");
+
+    /* Constant gain kernel & unity gain bypass */
+    diggain = (regRand() & 1) ? DIGGAIN_UNITY : regRandGain();
+    diggainInit(&gainState, diggain, DIGGAIN_RAMP_LIN, 0, 0, NULL);
+    for (f = 0; f < REG_NUM_FRAMES; f++)
+    {
+        len = regRandLen(1, REG_MAX_SAMPS);
+        regFillGainIn(pCtx->inSamps[0], len, pRes->sig);
+        appDiggain(pCtx->inSamps[0], diggain, pCtx->refOut16, len);
+        diggainProcess(&gainState, pCtx->inSamps[0], pCtx->out16, len);
+        regCmp16(pRes, pCtx->refOut16, pCtx->out16, len, "diggainProcess");
+    }
+}
+
+/* diggainProcess() reference model, per-sample gain as diggain_ramp.c documents */
+typedef struct
+{
+    Uint32 curGain;         /* current gain (U16Q24) */
+    Uint32 tgtGain;         /* target gain (U16Q24) */
+    Int32 rampStep;         /* linear ramp gain step per sample (S16Q24) */
+    Uint16 rampRem;         /* linear ramp remaining samples */
+    Uint16 rampMode;        /* DIGGAIN_RAMP_LIN or DIGGAIN_RAMP_EXP */
+    Uint16 rampLen;         /* linear ramp length in samples */
+    Uint16 expCoef;         /* exponential ramp coefficient (U0Q16) */
+} RegGainModel;
+
+/* Sets reference model target gain */
+static void regGainModelSetTgt(
+    RegGainModel *pM,       /* reference model */
+    Uint32 tgtGain          /* target gain (U16Q24) */
+)
+{
+    pM->tgtGain = tgtGain;
+    if (pM->rampMode == DIGGAIN_RAMP_LIN)
+    {
+        if (pM->rampLen == 0)
+        {
+            pM->curGain = tgtGain;
+            pM->rampRem = 0;
+            pM->rampStep = 0;
+        }
+        else
+        {
+            pM->rampRem = pM->rampLen;
+            pM->rampStep = (Int32)(((Int64)tgtGain - (Int64)pM->curGain) / pM->rampLen);
+        }
+    }
+}
+
+/* Runs reference model on one frame, sample by sample through appDiggain() */
+static void regGainModelRun(
+    RegGainModel *pM,       /* reference model */
+    Int32 *inSamps,         /* input samples (S18Q16) */
+    Int16 *outSamps,        /* output samples (S16Q15) */
+    Uint16 len              /* number of samples */
+)
+{
+    Uint32 segGain;
+    Uint32 sampGain;
+    Int64 gainErr;
+    Int32 segStep;
+    Uint16 segLen;
+    Uint16 i, j;
+
+    segGain = 0;
+    segStep = 0;
+    segLen = 0;
+    j = 0;
+    for (i = 0; i < len; i++)
+    {
+        if (pM->rampMode == DIGGAIN_RAMP_LIN)
+        {
+            if (pM->curGain != pM->tgtGain)
+            {
+                pM->curGain += (Uint32)pM->rampStep;
+                pM->rampRem--;
+            }
+            sampGain = pM->curGain;
+            if ((pM->rampRem == 0) && (pM->curGain != pM->tgtGain))
+            {
+                /* Ramp ends exactly on target, step truncation dropped */
+                pM->curGain = pM->tgtGain;
+            }
+        }
+        else
+        {
+            /* Exponential segments restart at each frame */
+            if ((j == segLen) && (pM->curGain != pM->tgtGain))
+            {
+                gainErr = (Int64)pM->tgtGain - (Int64)pM->curGain;
+                segGain = pM->tgtGain;
+                if ((gainErr >= ((Int64)1<<16)) || (gainErr <= -((Int64)1<<16)))
+                {
+                    segGain -= (Uint32)((gainErr * pM->expCoef) >> 16);
+                }
+                segStep = (Int32)(((Int64)segGain - (Int64)pM->curGain) / DIGGAIN_EXP_SEG_LEN);
+                segLen = (len - i < DIGGAIN_EXP_SEG_LEN) ? len - i : DIGGAIN_EXP_SEG_LEN;
+                j = 0;
+            }
+            if (j < segLen)
+            {
+                j++;
+                pM->curGain += (Uint32)segStep;
+                sampGain = pM->curGain;
+                if (j == DIGGAIN_EXP_SEG_LEN)
+                {
+                    pM->curGain = segGain;
+                }
+            }
+            else
+            {
+                sampGain = pM->curGain;
+            }
+        }
+        appDiggain(&inSamps[i], (Uint16)((sampGain + ((Uint32)1<<15)) >> 16), &outSamps[i], 1);
+    }
+}
+
+/* Compares diggainProcess() state with reference model, records result */
+static void regGainCmpState(
+    RegResult *pRes,        /* check result */
+    const DiggainState *pState, /* digital gain state */
+    const RegGainModel *pM, /* reference model */
+    const char *what        /* variant description */
+)
+{
+    Int32 ref[4];
+    Int32 out[4];
+
+    ref[0] = (Int32)pM->curGain;
+    ref[1] = (Int32)pM->tgtGain;
+    ref[2] = (pM->rampMode == DIGGAIN_RAMP_LIN) ? pM->rampStep : 0;
+    ref[3] = (pM->rampMode == DIGGAIN_RAMP_LIN) ? pM->rampRem : 0;
+    out[0] = (Int32)pState->curGain;
+    out[1] = (Int32)pState->tgtGain;
+    out[2] = (pM->rampMode == DIGGAIN_RAMP_LIN) ? pState->rampStep : 0;
+    out[3] = (pM->rampMode == DIGGAIN_RAMP_LIN) ? pState->rampRem : 0;
+    regCmp32(pRes, ref, out, 4, what);
+}
+
+/* diggainProcess() linear & exponential ramps vs per-sample model */
+static void checkGainRamp(RegResult *pRes)
+{
+    RegCtx *pCtx = &regCtx;
+    DiggainState gainState;
+    RegGainModel model;
+    Int32 ref[2];
+    Int32 out[2];
+    Uint32 lastErr;
+    Uint16 diggain;
+    Uint16 len, split;
+    Uint16 n, f;
+
+    memset(&model, 0, sizeof(model));
+    for (model.rampMode = DIGGAIN_RAMP_LIN; model.rampMode <= DIGGAIN_RAMP_EXP; model.rampMode++)
+    {
+        /* Random targets, unity bypass included, changed between & within frames mid-ramp */
+        model.rampLen = (regRand() & 1) ? (Uint16)regRandRange(0, 4*REG_MAX_SAMPS) : (Uint16)regRandRange(1, 64);
+        model.expCoef = (Uint16)regRand();
+        diggain = regRandGain();
+        diggainInit(&gainState, diggain, model.rampMode, model.rampLen, model.expCoef, NULL);
+        model.curGain = (Uint32)diggain << 16;
+        model.tgtGain = model.curGain;
+        model.rampStep = 0;
+        model.rampRem = 0;
+        for (f = 0; f < 4*REG_NUM_FRAMES; f++)
+        {
+            if (regRand() & 1)
+            {
+                diggain = (regRand() % 3 == 0) ? DIGGAIN_UNITY : regRandGain();
+                diggainSetGain(&gainState, diggain);
+                regGainModelSetTgt(&model, (Uint32)diggain << 16);
+            }
+            len = regRandLen(1, REG_MAX_SAMPS);
+            split = (Uint16)regRandRange(0, len);
+            regFillGainIn(pCtx->inSamps[0], len, pRes->sig);
+            regGainModelRun(&model, pCtx->inSamps[0], pCtx->refOut16, split);
+            diggainProcess(&gainState, pCtx->inSamps[0], pCtx->out16, split);
+            if (regRand() & 1)
+            {
+                diggain = (regRand() & 1) ? DIGGAIN_UNITY : regRandGain();
+                diggainSetGain(&gainState, diggain);
+                regGainModelSetTgt(&model, (Uint32)diggain << 16);
+            }
+            regGainModelRun(&model, &pCtx->inSamps[0][split], &pCtx->refOut16[split], len - split);
+            diggainProcess(&gainState, &pCtx->inSamps[0][split], &pCtx->out16[split], len - split);
+            regCmp16(pRes, pCtx->refOut16, pCtx->out16, len, "output");
+            regGainCmpState(pRes, &gainState, &model, "state");
+        }
+    }
+
+    /* Linear ramp over rampLen samples in random frames ends exactly on target */
+    model.rampLen = (Uint16)regRandRange(1, 4*REG_MAX_SAMPS);
+    diggainInit(&gainState, regRandGain(), DIGGAIN_RAMP_LIN, model.rampLen, 0, NULL);
+    do
+    {
+        diggain = regRandGain();
+    } while (((Uint32)diggain << 16) == gainState.curGain);
+    diggainSetGain(&gainState, diggain);
+    for (n = model.rampLen; n > 0; n -= len)
+    {
+        len = regRandLen(1, (n < REG_MAX_SAMPS) ? n : REG_MAX_SAMPS);
+        regFillGainIn(pCtx->inSamps[0], len, pRes->sig);
+        diggainProcess(&gainState, pCtx->inSamps[0], pCtx->out16, len);
+
+        /* Remaining samples & gain still short of target */
+        ref[0] = n - len;
+        ref[1] = (n == len) ? (Int32)gainState.tgtGain : (Int32)(gainState.tgtGain - (Uint32)gainState.rampStep*(n - len));
+        out[0] = gainState.rampRem;
+        out[1] = (Int32)gainState.curGain;
+        regCmp32(pRes, ref, out, (n == len) ? 2 : 1, "linear ramp end");
+    }
+
+    /* Exponential ramp error shrinks every segment & reaches target exactly */
+    model.expCoef = (Uint16)regRandRange(0, 0xE000);
+    diggainInit(&gainState, regRandGain(), DIGGAIN_RAMP_EXP, 0, model.expCoef, NULL);
+    diggainSetGain(&gainState, regRandGain());
+    lastErr = 0xFFFFFFFF;
+    for (f = 0; f < 256; f++)
+    {
+        regFillGainIn(pCtx->inSamps[0], DIGGAIN_EXP_SEG_LEN, pRes->sig);
+        diggainProcess(&gainState, pCtx->inSamps[0], pCtx->out16, DIGGAIN_EXP_SEG_LEN);
+        ref[0] = 0;
+        out[0] = 0;
+        if (gainState.curGain != gainState.tgtGain)
+        {
+            out[0] = ((gainState.curGain > gainState.tgtGain) ? gainState.curGain - gainState.tgtGain :
+                gainState.tgtGain - gainState.curGain) >= lastErr;
+            lastErr = (gainState.curGain > gainState.tgtGain) ? gainState.curGain - gainState.tgtGain :
+                gainState.tgtGain - gainState.curGain;
+        }
+        regCmp32(pRes, ref, out, 1, "exponential ramp error decrease");
+    }
+    ref[0] = (Int32)gainState.tgtGain;
+    out[0] = (Int32)gainState.curGain;
+    regCmp32(pRes, ref, out, 1, "exponential ramp end");
+}
+
+/* Fills AGC input frame, random samples within +/-peak, +peak reached */
+/* (one's complement frame peak of -peak is peak-1) */
+static void regFillAgcIn(
+    Int32 *samps,           /* samples */
+    Uint16 len,             /* number of samples */
+    Int32 peak              /* peak magnitude */
+)
+{
+    Uint16 i;
+
+    for (i = 0; i < len; i++)
+    {
+        samps[i] = regRandRange(-peak, peak);
+    }
+    samps[regRand() % len] = peak;
+}
+
+/* diggainProcess() AGC: gain limits, convergence, silence & full scale, ramp vs model */
+static void checkGainAgc(RegResult *pRes)
+{
+    RegCtx *pCtx = &regCtx;
+    DiggainState gainState;
+    RegGainModel model;
+    Int32 ref[3];
+    Int32 out[3];
+    Uint32 minGain, maxGain;
+    Uint64 peakGain;
+    Uint32 desGain;
+    Uint32 prevGain;
+    Uint32 smoothGain;
+    Uint16 tgtPeak;
+    Uint16 attack, release;
+    Int32 peak;
+    Uint16 phase;
+    Uint16 len;
+    Uint16 f;
+
+    memset(&model, 0, sizeof(model));
+    model.rampMode = DIGGAIN_RAMP_LIN;
+    model.rampLen = (Uint16)regRandRange(0, REG_MAX_SAMPS);
+    tgtPeak = (Uint16)regRandRange(0x1000, 0x7FFF);
+    minGain = (Uint32)regRandRange(0, 2*DIGGAIN_UNITY) << 16;
+    maxGain = (Uint32)regRandRange(minGain >> 16, 0xFFFF) << 16;
+
+    diggainInit(&gainState, DIGGAIN_UNITY, DIGGAIN_RAMP_LIN, model.rampLen, 0, NULL);
+    attack = (Uint16)regRandRange(0, 2);
+    release = (Uint16)regRandRange(2, 3);
+    diggainAgcConfig(&gainState, 1, tgtPeak, (Uint16)(minGain >> 16), (Uint16)(maxGain >> 16),
+        attack, release);
+    model.curGain = (Uint32)DIGGAIN_UNITY << 16;
+    model.tgtGain = model.curGain;
+
+    /* Phases: random peak, silence (gain to max), full scale (gain to min or below) */
+    for (phase = 0; phase < 3; phase++)
+    {
+        peak = (phase == 0) ? regRandRange(1, REG_S18_MAX) : (phase == 1) ? 0 : REG_S18_MAX;
+        peakGain = (peak == 0) ? maxGain : ((Uint64)tgtPeak << 25) / peak;
+        desGain = (peakGain > maxGain) ? maxGain : (Uint32)peakGain;
+        desGain = (desGain < minGain) ? minGain : desGain;
+        for (f = 0; f < 200; f++)
+        {
+            len = regRandLen(1, REG_MAX_SAMPS);
+            if (peak == 0)
+            {
+                memset(pCtx->inSamps[0], 0, len*sizeof(Int32));
+            }
+            else
+            {
+                regFillAgcIn(pCtx->inSamps[0], len, peak);
+            }
+            prevGain = gainState.agcGain;
+            diggainProcess(&gainState, pCtx->inSamps[0], pCtx->out16, len);
+
+            /* AGC target replaces ramp target, ramp output vs model */
+            if (gainState.tgtGain != model.tgtGain)
+            {
+                regGainModelSetTgt(&model, gainState.tgtGain);
+            }
+            regGainModelRun(&model, pCtx->inSamps[0], pCtx->refOut16, len);
+            regCmp16(pRes, pCtx->refOut16, pCtx->out16, len, "output");
+            regGainCmpState(pRes, &gainState, &model, "state");
+
+            /* Target within limits, moving monotonically towards frame gain, */
+            /* by attack shift when decreasing & release shift when increasing */
+            smoothGain = (desGain < prevGain) ? prevGain - ((prevGain - desGain) >> attack) :
+                prevGain + ((desGain - prevGain) >> release);
+            ref[0] = (gainState.tgtGain < minGain) ? (Int32)minGain :
+                (gainState.tgtGain > maxGain) ? (Int32)maxGain : (Int32)gainState.tgtGain;
+            ref[1] = 0;
+            out[0] = (Int32)gainState.tgtGain;
+            out[1] = ((prevGain <= desGain) && (gainState.tgtGain < prevGain)) ||
+                ((prevGain >= desGain) && (gainState.tgtGain > prevGain)) ||
+                ((prevGain <= desGain) != (gainState.tgtGain <= desGain) && (gainState.tgtGain != desGain));
+            ref[2] = (Int32)smoothGain;
+            out[2] = (Int32)gainState.agcGain;
+            regCmp32(pRes, ref, out, 3, "AGC gain limits & smoothing");
+        }
+
+        /* Converged to within smoothing shift truncation of frame gain */
+        ref[0] = 0;
+        out[0] = ((gainState.tgtGain > desGain) ? gainState.tgtGain - desGain : desGain - gainState.tgtGain) >
+            ((Uint32)1 << 4);
+        regCmp32(pRes, ref, out, 1, "AGC convergence");
+    }
+}
+
+static void checkGainSse2(RegResult *pRes)
+{
+    regGainRun(pRes, appDiggainSse2, "output");
+}
+
+static void checkGainAvx2(RegResult *pRes)
+{
+    regGainRun(pRes, appDiggainAvx2, "output");
+}
+
+/* decimKernels() slots at every ISA level vs reference kernels */
+static void checkDispatch(RegResult *pRes)
+{
+    RegCtx *pCtx = &regCtx;
+    const DecimKernels *pK;
+    Int16 *coefs = pCtx->coefs[0];
+    Uint16 numCoefs;
+    Uint16 numBiquads;
+    Uint16 coefIWL;
+    Uint16 isa;
+    Uint16 len;
+    Uint16 numRef, numOut;
+    Uint16 f;
+
+    for (isa = 0; isa < DECIM_NUM_ISA; isa++)
+    {
+        decimDispatchSetIsa(isa);
+        pK = decimKernels();
+
+        /* CIC */
+        memset(pCtx->refState, 0, sizeof(pCtx->refState));
+        memset(pCtx->state, 0, sizeof(pCtx->state));
+        for (f = 0; f < REG_NUM_FRAMES; f++)
+        {
+            len = regRandLen(1, REG_MAX_FRAME_LEN);
+            regFillPdm(pCtx->lData[0], len, pRes->sig);
+            regFillPdm(pCtx->rData[0], len, pRes->sig);
+            pickBitsCic(pCtx->lData[0], pCtx->rData[0], len, pCtx->refState[0], pCtx->refOut[0], &numRef);
+            pK->cic(pCtx->lData[0], pCtx->rData[0], len, pCtx->state[0], pCtx->out[0], &numOut);
+            regCmp32(pRes, pCtx->refOut[0], pCtx->out[0], numRef, pK->name[DECIM_KERNEL_CIC]);
+        }
+
+        /* FIR, IIR & digital gain */
+        numCoefs = regFirPick(coefs, 0);
+        regFirRun(pRes, pK->fir, coefs, coefs, numCoefs, 0, pK->name[DECIM_KERNEL_FIR]);
+
+        numBiquads = (Uint16)regRandRange(1, REG_MAX_BIQUADS);
+        coefIWL = (Uint16)regRandRange(0, REG_MAX_IWL);
+        regIirCoefs(coefs, pCtx->df2Coefs, numBiquads, coefIWL);
+        regIirRun(pRes, blkIirDf1, pK->iirDf1, coefs, numBiquads, coefIWL, pK->name[DECIM_KERNEL_IIR_DF1]);
+        regIirRun(pRes, blkIirDf2, pK->iirDf2, pCtx->df2Coefs, numBiquads, coefIWL, pK->name[DECIM_KERNEL_IIR_DF2]);
+
+        regGainRun(pRes, pK->diggain, pK->name[DECIM_KERNEL_DIGGAIN]);
+    }
+
+    decimDispatchInit();
+}
+
+/* decimPipeProcess() vs IdleLoop baseline chain: */
+/* whole-frame pickBitsCic(), blkFirDecim2() FIR1 & FIR2, appDiggain() */
+static void checkPipe(RegResult *pRes)
+{
+    RegCtx *pCtx = &regCtx;
+    DecimPipeCfg cfg;
+    Int32 *cicState = pCtx->refState[0];
+    Int32 *fir1Dly = pCtx->cascRefDly[0];
+    Int32 *fir2Dly = pCtx->cascRefDly[1];
+    Uint16 numCicSamps;
+    Uint16 numOut;
+    Uint16 f;
+
+    decimPipeCfgDefault(&cfg);
+    cfg.inFrameLen = (Uint16)(16*regRandRange(1, REG_MAX_FRAME_LEN/16));
+    cfg.diggain = regRandGain();
+    switch (regRand() % 3)
+    {
+    case 0:
+        cfg.cicKernel = pickBitsCic;
+        cfg.firKernel = blkFirDecim2Host;
+        cfg.gainKernel = appDiggainHost;
+        break;
+    case 1:
+        cfg.firKernel = blkFirDecim2Lin;
+        break;
+    default:
+        break;
+    }
+    decimPipeInit(&pCtx->pipe, &cfg);
+
+    memset(pCtx->refState, 0, sizeof(pCtx->refState));
+    memset(pCtx->cascRefDly, 0, sizeof(pCtx->cascRefDly));
+    for (f = 0; f < REG_NUM_FRAMES; f++)
+    {
+        regFillPdm(pCtx->lData[0], cfg.inFrameLen, pRes->sig);
+        regFillPdm(pCtx->rData[0], cfg.inFrameLen, pRes->sig);
+
+        pickBitsCic(pCtx->lData[0], pCtx->rData[0], cfg.inFrameLen, cicState, pCtx->tmp[0], &numCicSamps);
+        blkFirDecim2(pCtx->tmp[0], (Int16 *)decimFir1Coefs, pCtx->tmp[1], fir1Dly, numCicSamps, DECIM_FIR1_NUM_COEFS);
+        blkFirDecim2(pCtx->tmp[1], (Int16 *)decimFir2Coefs, pCtx->refOut[0], fir2Dly, numCicSamps/2, DECIM_FIR2_NUM_COEFS);
+        appDiggain(pCtx->refOut[0], cfg.diggain, pCtx->refOut16, numCicSamps/4);
+
+        decimPipeProcess(&pCtx->pipe, pCtx->lData[0], pCtx->rData[0], pCtx->out16, &numOut);
+        regCmp16(pRes, pCtx->refOut16, pCtx->out16, numCicSamps/4, "output");
+    }
+}
+
+/* Clears completion log & sets gate */
+static void regDoneReset(
+    Uint16 gate,            /* REG_GATE_xxx */
+    Uint32 holdSeq          /* frame index held by armed gate */
+)
+{
+    RegDoneLog *pLog = &regDoneLog;
+
+    pthread_mutex_lock(&pLog->lock);
+    pLog->numDone = 0;
+    pLog->gate = gate;
+    pLog->holdSeq = holdSeq;
+    pthread_mutex_unlock(&pLog->lock);
+}
+
+/* Logs completion, holds caller while gate is armed or held */
+static void regDoneAdd(
+    Uint16 streamId,        /* stream ID */
+    Uint32 seq              /* frame index within stream */
+)
+{
+    RegDoneLog *pLog = &regDoneLog;
+
+    pthread_mutex_lock(&pLog->lock);
+    if (pLog->numDone < REG_MAX_DONE)
+    {
+        pLog->stream[pLog->numDone] = streamId;
+        pLog->seq[pLog->numDone] = (Int32)seq;
+    }
+    pLog->numDone++;
+    if ((pLog->gate == REG_GATE_ARMED) && (seq == pLog->holdSeq))
+    {
+        pLog->gate = REG_GATE_HELD;
+        pthread_cond_broadcast(&pLog->cond);
+        while (pLog->gate == REG_GATE_HELD)
+        {
+            pthread_cond_wait(&pLog->cond, &pLog->lock);
+        }
+    }
+    pthread_mutex_unlock(&pLog->lock);
+}
+
+/* Waits until gated callback holds */
+static void regGateWaitHeld(void)
+{
+    RegDoneLog *pLog = &regDoneLog;
+
+    pthread_mutex_lock(&pLog->lock);
+    while (pLog->gate != REG_GATE_HELD)
+    {
+        pthread_cond_wait(&pLog->cond, &pLog->lock);
+    }
+    pthread_mutex_unlock(&pLog->lock);
+}
+
+/* Releases gated callback */
+static void regGateOpen(void)
+{
+    RegDoneLog *pLog = &regDoneLog;
+
+    pthread_mutex_lock(&pLog->lock);
+    pLog->gate = REG_GATE_OFF;
+    pthread_cond_broadcast(&pLog->cond);
+    pthread_mutex_unlock(&pLog->lock);
+}
+
+/* Scheduler completion callback, frame index from output buffer */
+static void regSchedDone(
+    void *pArg,             /* test buffers */
+    Uint16 streamId,        /* stream ID */
+    Int16 *outSamps,        /* output samples (S16Q15) */
+    Uint16 numOutSamps      /* number of output samples */
+)
+{
+    RegCtx *pCtx = (RegCtx *)pArg;
+
+    (void)numOutSamps;
+    regDoneAdd(streamId, (Uint32)((outSamps - pCtx->schedOut[streamId][0]) / DECIM_PIPE_MAX_OUT_LEN));
+}
+
+/* decimSchedDrain() caller, sets drained flag on return */
+static void *regSchedDrainThread(
+    void *pArg              /* drained flag */
+)
+{
+    decimSchedDrain(&regCtx.sched);
+    __atomic_store_n((Int32 *)pArg, 1, __ATOMIC_RELEASE);
+
+    return NULL;
+}
+
+/* decimPipeMtDrain() caller, sets drained flag on return */
+static void *regMtDrainThread(
+    void *pArg              /* drained flag */
+)
+{
+    decimPipeMtDrain(&regCtx.mt);
+    __atomic_store_n((Int32 *)pArg, 1, __ATOMIC_RELEASE);
+
+    return NULL;
+}
+
+/* Initializes stream pipelines & fills input frames */
+static void regSchedSetup(
+    RegResult *pRes,        /* check result */
+    DecimPipeCfg *pCfg      /* pipeline configuration */
+)
+{
+    RegCtx *pCtx = &regCtx;
+    Uint16 s, f;
+
+    decimPipeCfgDefault(pCfg);
+    pCfg->inFrameLen = (Uint16)(16*regRandRange(1, REG_MAX_FRAME_LEN/16));
+    pCfg->diggain = regRandGain();
+    for (s = 0; s < REG_SCHED_STREAMS; s++)
+    {
+        decimPipeInit(&pCtx->schedPipe[s], pCfg);
+        for (f = 0; f < REG_SCHED_FRAMES; f++)
+        {
+            regFillPdm(pCtx->schedLData[s][f], pCfg->inFrameLen, pRes->sig);
+            regFillPdm(pCtx->schedRData[s][f], pCfg->inFrameLen, pRes->sig);
+        }
+    }
+}
+
+/* Compares first numFrames outputs of stream with decimPipeProcess() on one thread */
+static void regSchedCmpOut(
+    RegResult *pRes,        /* check result */
+    DecimPipeCfg *pCfg,     /* pipeline configuration */
+    Uint16 streamId,        /* stream ID */
+    Uint16 numFrames        /* number of frames */
+)
+{
+    RegCtx *pCtx = &regCtx;
+    Uint16 numOut;
+    Uint16 f;
+
+    decimPipeInit(&pCtx->pipe, pCfg);
+    for (f = 0; f < numFrames; f++)
+    {
+        decimPipeProcess(&pCtx->pipe, pCtx->schedLData[streamId][f], pCtx->schedRData[streamId][f],
+            pCtx->refOut16, &numOut);
+        regCmp16(pRes, pCtx->refOut16, pCtx->schedOut[streamId][f], numOut, "output");
+    }
+}
+
+/* decimSched: fairness between streams of one worker, drain, */
+/* per-stream frame order & output vs decimPipeProcess() */
+static void checkSched(RegResult *pRes)
+{
+    RegCtx *pCtx = &regCtx;
+    RegDoneLog *pLog = &regDoneLog;
+    DecimSched *pSched = &pCtx->sched;
+    DecimSchedStats stats;
+    DecimPipeCfg cfg;
+    pthread_t drainThread;
+    Int32 drained;
+    Int32 ref[REG_MAX_DONE];
+    Int32 got[REG_MAX_DONE];
+    Uint16 next[REG_SCHED_STREAMS];
+    Uint16 numWorkers;
+    Uint16 pending;
+    Uint32 total;
+    Uint32 i, n;
+    Uint16 s, f;
+    Int16 status;
+
+    regSchedSetup(pRes, &cfg);
+
+    /* One worker: stream 0 held in callback of its 1st frame, while it holds */
+    /* stream 0 fills its FIFO & stream 1 queues one frame. */
+    /* Yield after stream 0 frame must run stream 1 next, not stream 0 again. */
+    decimSchedInit(pSched, 1);
+    decimSchedAddStream(pSched, 0, &pCtx->schedPipe[0], regSchedDone, pCtx);
+    decimSchedAddStream(pSched, 1, &pCtx->schedPipe[1], regSchedDone, pCtx);
+    regDoneReset(REG_GATE_ARMED, 0);
+    decimSchedSubmit(pSched, 0, pCtx->schedLData[0][0], pCtx->schedRData[0][0], pCtx->schedOut[0][0]);
+    regGateWaitHeld();
+    for (f = 1; f < DECIM_SCHED_QUEUE_LEN; f++)
+    {
+        decimSchedSubmit(pSched, 0, pCtx->schedLData[0][f], pCtx->schedRData[0][f], pCtx->schedOut[0][f]);
+    }
+    decimSchedSubmit(pSched, 1, pCtx->schedLData[1][0], pCtx->schedRData[1][0], pCtx->schedOut[1][0]);
+
+    /* Drain must wait for held frame */
+    drained = 0;
+    pthread_create(&drainThread, NULL, regSchedDrainThread, &drained);
+    hostClockSleepNs(1000000);
+    ref[0] = 0;
+    got[0] = __atomic_load_n(&drained, __ATOMIC_ACQUIRE);
+    regCmp32(pRes, ref, got, 1, "drain before completion");
+    regGateOpen();
+    pthread_join(drainThread, NULL);
+
+    /* Completion order: stream 0, stream 1, rest of stream 0 */
+    total = DECIM_SCHED_QUEUE_LEN + 1;
+    ref[0] = (Int32)total;
+    got[0] = (Int32)pLog->numDone;
+    regCmp32(pRes, ref, got, 1, "completions after drain");
+    for (i = 0; i < total; i++)
+    {
+        ref[i] = (i == 1) ? 1 : 0;
+    }
+    regCmp32(pRes, ref, pLog->stream, (Uint16)total, "fairness");
+    regSchedCmpOut(pRes, &cfg, 0, DECIM_SCHED_QUEUE_LEN);
+    regSchedCmpOut(pRes, &cfg, 1, 1);
+    decimSchedStop(pSched);
+
+    /* Random workers, all streams submitted round robin, full FIFOs retried */
+    regSchedSetup(pRes, &cfg);
+    numWorkers = (Uint16)regRandRange(1, REG_SCHED_WORKERS);
+    decimSchedInit(pSched, numWorkers);
+    for (s = 0; s < REG_SCHED_STREAMS; s++)
+    {
+        decimSchedAddStream(pSched, s, &pCtx->schedPipe[s], regSchedDone, pCtx);
+        next[s] = 0;
+    }
+    regDoneReset(REG_GATE_OFF, 0);
+    do
+    {
+        pending = 0;
+        for (s = 0; s < REG_SCHED_STREAMS; s++)
+        {
+            if (next[s] == REG_SCHED_FRAMES)
+            {
+                continue;
+            }
+            f = next[s];
+            status = decimSchedSubmit(pSched, s, pCtx->schedLData[s][f], pCtx->schedRData[s][f], pCtx->schedOut[s][f]);
+            if (status == DECIM_SCHED_OK)
+            {
+                next[s]++;
+            }
+            pending |= (next[s] < REG_SCHED_FRAMES);
+        }
+        if (pending)
+        {
+            hostClockSleepNs(10000);
+        }
+    } while (pending);
+    decimSchedDrain(pSched);
+
+    /* Drained: every frame completed & counted */
+    total = REG_SCHED_STREAMS*REG_SCHED_FRAMES;
+    decimSchedGetStats(pSched, &stats);
+    ref[0] = (Int32)total;
+    ref[1] = 0;
+    ref[2] = (Int32)total;
+    got[0] = (Int32)pLog->numDone;
+    got[1] = (Int32)stats.curDepth;
+    got[2] = (Int32)stats.numFrames;
+    regCmp32(pRes, ref, got, 3, "completions, depth & frames after drain");
+
+    /* Frames of each stream complete in submission order */
+    for (s = 0; s < REG_SCHED_STREAMS; s++)
+    {
+        n = 0;
+        for (i = 0; (i < pLog->numDone) && (i < REG_MAX_DONE); i++)
+        {
+            if (pLog->stream[i] == s)
+            {
+                ref[n] = (Int32)n;
+                got[n] = pLog->seq[i];
+                n++;
+            }
+        }
+        regCmp32(pRes, ref, got, (Uint16)n, "stream frame order");
+        regSchedCmpOut(pRes, &cfg, s, REG_SCHED_FRAMES);
+    }
+    decimSchedStop(pSched);
+}
+
+/* Pipeline-parallel completion callback */
+static void regMtDone(
+    void *pArg,             /* unused */
+    Uint32 seq,             /* frame sequence number */
+    Int16 *outSamps,        /* output samples (S16Q15) */
+    Uint16 numOutSamps      /* number of output samples */
+)
+{
+    (void)pArg;
+    (void)outSamps;
+    (void)numOutSamps;
+    regDoneAdd(0, seq);
+}
+
+/* decimPipeMt: output vs decimPipeProcess() with gain change taken mid-run, */
+/* full input ring, drain & stop */
+static void checkPipeMt(RegResult *pRes)
+{
+    RegCtx *pCtx = &regCtx;
+    RegDoneLog *pLog = &regDoneLog;
+    DecimPipeMt *pMt = &pCtx->mt;
+    DecimPipeMtStats stats;
+    DecimPipeCfg cfg;
+    pthread_t drainThread;
+    Int32 drained;
+    Int32 ref[REG_MT_FRAMES];
+    Int32 got[REG_MT_FRAMES];
+    Uint16 holdSeq;
+    Uint16 newGain;
+    Uint16 numSubmitted;
+    Uint16 numOut;
+    Uint16 f, i;
+    Int16 status;
+
+    decimPipeCfgDefault(&cfg);
+    cfg.inFrameLen = (Uint16)(16*regRandRange(1, REG_MAX_FRAME_LEN/16));
+    cfg.diggain = regRandGain();
+    cfg.rampMode = (regRand() & 1) ? DIGGAIN_RAMP_EXP : DIGGAIN_RAMP_LIN;
+    cfg.rampLen = (Uint16)regRandRange(1, 4*DECIM_PIPE_MAX_OUT_LEN);
+    cfg.expCoef = (Uint16)regRandRange(0, 0xFFFF);
+    newGain = regRandGain();
+    for (f = 0; f < REG_MT_FRAMES; f++)
+    {
+        regFillPdm(pCtx->mtLData[f], cfg.inFrameLen, pRes->sig);
+        regFillPdm(pCtx->mtRData[f], cfg.inFrameLen, pRes->sig);
+    }
+
+    /* Gain stage held in callback of frame holdSeq, gain change taken by frame holdSeq+1 */
+    holdSeq = (Uint16)regRandRange(0, REG_MT_FRAMES - 3*DECIM_PIPE_MT_RING_LEN - 2);
+    regDoneReset(REG_GATE_ARMED, holdSeq);
+    decimPipeInit(&pCtx->mtPipe, &cfg);
+    decimPipeMtInit(pMt, &pCtx->mtPipe, regMtDone, NULL);
+
+    /* Submit until input ring full, all rings fill behind held gain stage */
+    numSubmitted = 0;
+    do
+    {
+        status = decimPipeMtSubmit(pMt, pCtx->mtLData[numSubmitted], pCtx->mtRData[numSubmitted],
+            pCtx->mtOut[numSubmitted]);
+        if (status == DECIM_PIPE_MT_OK)
+        {
+            numSubmitted++;
+        }
+        if (numSubmitted <= holdSeq)
+        {
+            status = DECIM_PIPE_MT_OK;
+        }
+    } while ((status == DECIM_PIPE_MT_OK) && (numSubmitted < REG_MT_FRAMES));
+    regGateWaitHeld();
+
+    /* Input ring full before every frame submitted, at most held frame & 3 rings in flight */
+    ref[0] = DECIM_PIPE_MT_ERR_FULL;
+    ref[1] = 1;
+    got[0] = status;
+    got[1] = (numSubmitted - holdSeq <= 3*DECIM_PIPE_MT_RING_LEN + 1);
+    regCmp32(pRes, ref, got, 2, "backpressure");
+
+    /* Drain must wait for held frame */
+    decimPipeMtSetGain(pMt, newGain);
+    drained = 0;
+    pthread_create(&drainThread, NULL, regMtDrainThread, &drained);
+    hostClockSleepNs(1000000);
+    ref[0] = 0;
+    got[0] = __atomic_load_n(&drained, __ATOMIC_ACQUIRE);
+    regCmp32(pRes, ref, got, 1, "drain before completion");
+    regGateOpen();
+    pthread_join(drainThread, NULL);
+    decimPipeMtGetStats(pMt, &stats);
+    ref[0] = numSubmitted;
+    ref[1] = numSubmitted;
+    got[0] = (Int32)pLog->numDone;
+    got[1] = (Int32)stats.numDone;
+    regCmp32(pRes, ref, got, 2, "completions after drain");
+
+    /* Remaining frames, stop drains */
+    while (numSubmitted < REG_MT_FRAMES)
+    {
+        if (decimPipeMtSubmit(pMt, pCtx->mtLData[numSubmitted], pCtx->mtRData[numSubmitted],
+            pCtx->mtOut[numSubmitted]) == DECIM_PIPE_MT_OK)
+        {
+            numSubmitted++;
+        }
+        else
+        {
+            hostClockSleepNs(10000);
+        }
+    }
+    decimPipeMtStop(pMt);
+    decimPipeMtGetStats(pMt, &stats);
+    ref[0] = REG_MT_FRAMES;
+    ref[1] = REG_MT_FRAMES;
+    ref[2] = 0;
+    got[0] = (Int32)pLog->numDone;
+    got[1] = (Int32)stats.numFrames[DECIM_PIPE_MT_STAGE_GAIN];
+    got[2] = stats.ringDepth[DECIM_PIPE_MT_STAGE_CIC] + stats.ringDepth[DECIM_PIPE_MT_STAGE_FIR] +
+        stats.ringDepth[DECIM_PIPE_MT_STAGE_GAIN];
+    regCmp32(pRes, ref, got, 3, "completions & ring depth after stop");
+
+    /* Frames complete in submission order */
+    for (i = 0; i < REG_MT_FRAMES; i++)
+    {
+        ref[i] = i;
+    }
+    regCmp32(pRes, ref, pLog->seq, REG_MT_FRAMES, "frame order");
+
+    /* Reference: one thread, gain change before frame holdSeq+1 */
+    decimPipeInit(&pCtx->pipe, &cfg);
+    for (f = 0; f < REG_MT_FRAMES; f++)
+    {
+        if (f == holdSeq+1)
+        {
+            decimPipeSetGain(&pCtx->pipe, newGain);
+        }
+        decimPipeProcess(&pCtx->pipe, pCtx->mtLData[f], pCtx->mtRData[f], pCtx->refOut16, &numOut);
+        regCmp16(pRes, pCtx->refOut16, pCtx->mtOut[f], numOut, "output");
+    }
+}
+
+static const RegCheck regChecks[] =
+{
+    { "pickBitsCicTbl", 0, checkCicTbl },
+    { "pickBitsCicMc", 0, checkCicMc },
+    { "cicCfgProcess", 0, checkCicCfg },
+    { "pdmFirDecim", 0, checkPdmFir },
+    { "blkFirDecim2 variants", 0, checkFir },
+    { "blkFirDecim2Hb", 0, checkFirHb },
+    { "blkFirDecimM", 0, checkFirM },
+    { "blkFirDecim2LinSse41", CPU_FEAT_SSE41, checkFirSse41 },
+    { "blkFirDecim2LinAvx2", CPU_FEAT_AVX2, checkFirAvx2 },
+    { "blkFirDecim2LinAvx512", CPU_FEAT_AVX512F, checkFirAvx512 },
+    { "blkFirDecim2 acc40", 0, checkFirAcc40 },
+    { "blkFirDecim2Gain", 0, checkFirGain },
+    { "blkFirCascade", 0, checkFirCascade },
+    { "blkIir variants", 0, checkIir },
+    { "blkIirSpec", 0, checkIirSpec },
+    { "blkIirMc", 0, checkIirMc },
+    { "appDiggain variants", 0, checkGain },
+    { "diggainProcess ramp", 0, checkGainRamp },
+    { "diggainProcess AGC", 0, checkGainAgc },
+    { "appDiggainSse2", CPU_FEAT_SSE2, checkGainSse2 },
+    { "appDiggainAvx2", CPU_FEAT_AVX2, checkGainAvx2 },
+    { "decimKernels", 0, checkDispatch },
+    { "decimPipe", 0, checkPipe },
+    { "decimSched", 0, checkSched },
+    { "decimPipeMt", 0, checkPipeMt }
+};
+#define REG_NUM_CHECKS      ( sizeof(regChecks)/sizeof(regChecks[0]) )
+
+static void usage(const char *name)
+{
+    fprintf(stderr, "Usage: %s [-s seed] [-n numTrials]\n", name);
+}
+
+int main(int argc, char **argv)
+{
+    RegCtx *pCtx = &regCtx;
+    RegResult res[REG_NUM_CHECKS];
+    Uint32 numTrials;
+    Uint32 numFails;
+    Uint16 features;
+    Uint32 t;
+    Uint16 c, ch;
+    int arg;
+
+    regSeed = 1;
+    numTrials = 50;
+
+    for (arg = 1; arg+1 < argc; arg++)
+    {
+        if (!strcmp(argv[arg], "-s"))
+        {
+            regSeed = (Uint32)strtoul(argv[++arg], NULL, 0);
+        }
+        else if (!strcmp(argv[arg], "-n"))
+        {
+            numTrials = (Uint32)strtoul(argv[++arg], NULL, 0);
+        }
+        else
+        {
+            break;
+        }
+    }
+    if ((arg < argc) || (regSeed == 0))
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    features = cpuFeatures();
+    pthread_mutex_init(&regDoneLog.lock, NULL);
+    pthread_cond_init(&regDoneLog.cond, NULL);
+    pickBitsCicTblInit();
+    decimDispatchInit();
+    for (ch = 0; ch < REG_MAX_CH; ch++)
+    {
+        pCtx->pLData[ch] = pCtx->lData[ch];
+        pCtx->pRData[ch] = pCtx->rData[ch];
+        pCtx->pInSamps[ch] = pCtx->inSamps[ch];
+        pCtx->pOut[ch] = pCtx->out[ch];
+    }
+    printf("seed %lu, %lu trials, CPU features 0x%04x\n", (unsigned long)regSeed, (unsigned long)numTrials, features);
+
+    for (c = 0; c < REG_NUM_CHECKS; c++)
+    {
+        res[c].name = regChecks[c].name;
+        res[c].numFrames = 0;
+        res[c].numFails = 0;
+    }
+
+    /* Every trial runs every check, input signal cycles through REG_SIG_xxx */
+    for (t = 0; t < numTrials; t++)
+    {
+        for (c = 0; c < REG_NUM_CHECKS; c++)
+        {
+            if ((features & regChecks[c].features) != regChecks[c].features)
+            {
+                continue;
+            }
+            res[c].sig = (Uint16)(t % REG_NUM_SIGS);
+            regChecks[c].check(&res[c]);
+        }
+    }
+
+    numFails = 0;
+    for (c = 0; c < REG_NUM_CHECKS; c++)
+    {
+        if ((features & regChecks[c].features) != regChecks[c].features)
+        {
+            printf("%-24s skipped, not supported by CPU\n", res[c].name);
+            continue;
+        }
+        printf("%-24s %6lu frames %s\n", res[c].name, (unsigned long)res[c].numFrames,
+            (res[c].numFails == 0) ? "ok" : "FAILED");
+        numFails += res[c].numFails;
+    }
+    printf("%s\n", (numFails == 0) ? "PASS" : "FAIL");
+
+    return (numFails == 0) ? 0 : 1;
+}
@@ -0,0 +1,439 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <pthread.h>
+#include "data_types.h"
+#include "host_clock.h"
+#include "i2s_dma_sim.h"
+
+#define ATOMIC_LOAD(p)          __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define ATOMIC_STORE(p, v)      __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+
+/* Fills frame from synthetic tone, bits in "left" word then "right" word order */
+static void i2sDmaSimSynthFill(
+    I2sDmaSim *pSim,        /* simulator */
+    Uint32 *lData,          /* "left" channel 32-bit packed data */
+    Uint32 *rData,          /* "right" channel 32-bit packed data */
+    Uint16 frameLen         /* number of words per channel */
+)
+{
+    pdmGenProcess(pSim->pGen, &lData, &rData, frameLen);
+}
+
+/* Fills frame from file of interleaved "left" & "right" words. */
+/* Returns 0 at end of file. */
+static Uint16 i2sDmaSimFileFill(
+    I2sDmaSim *pSim,        /* simulator */
+    Uint32 *lData,          /* "left" channel 32-bit packed data */
+    Uint32 *rData,          /* "right" channel 32-bit packed data */
+    Uint16 frameLen         /* number of words per channel */
+)
+{
+    size_t numWords;
+    Uint16 i;
+
+    numWords = fread(pSim->fileBuf, sizeof(Uint32), 2*frameLen, pSim->fp);
+    if ((numWords < 2u*frameLen) && pSim->cfg.fileLoop)
+    {
+        rewind(pSim->fp);
+        numWords += fread(&pSim->fileBuf[numWords], sizeof(Uint32), 2*frameLen - numWords, pSim->fp);
+    }
+    if (numWords < 2u*frameLen)
+    {
+        /* Partial last frame dropped */
+        return 0;
+    }
+
+    for (i = 0; i < frameLen; i++)
+    {
+        lData[i] = pSim->fileBuf[2*i];
+        rData[i] = pSim->fileBuf[2*i+1];
+    }
+
+    return 1;
+}
+
+/* Signals DMA completion to waiting consumer */
+static void i2sDmaSimIrq(
+    I2sDmaSim *pSim         /* simulator */
+)
+{
+    pthread_mutex_lock(&pSim->irqLock);
+    pSim->irqCount++;
+    pthread_cond_broadcast(&pSim->irqCond);
+    pthread_mutex_unlock(&pSim->irqLock);
+}
+
+/* Producer thread: DMA fills next buffer during frame period, completes at period end */
+static void *i2sDmaSimProducer(
+    void *pArg              /* I2sDmaSim */
+)
+{
+    I2sDmaSim *pSim;
+    I2sDmaSimCfg *pCfg;
+    Uint32 *lData;
+    Uint32 *rData;
+    Uint64 dueNs;
+    Uint64 nowNs;
+    Uint64 lateNs;
+    Uint32 timestamp;
+    Uint32 offset;
+    Uint32 seq;
+
+    pSim = (I2sDmaSim *)pArg;
+    pCfg = &pSim->cfg;
+
+    for (seq = 0; (pCfg->numFrames == 0) || (seq < pCfg->numFrames); seq++)
+    {
+        if (ATOMIC_LOAD(&pSim->stop))
+        {
+            break;
+        }
+
+        /* Buffer in auto-reload order, may still be in use by late consumer */
+        offset = (seq % pCfg->numBufs) * (Uint32)pCfg->frameLen;
+        lData = &pCfg->bufLeft[offset];
+        rData = &pCfg->bufRight[offset];
+        if (pCfg->srcType == I2S_DMA_SIM_SRC_FILE)
+        {
+            if (!i2sDmaSimFileFill(pSim, lData, rData, pCfg->frameLen))
+            {
+                break;
+            }
+        }
+        else if (pCfg->srcType == I2S_DMA_SIM_SRC_USER)
+        {
+            pCfg->fill(pCfg->fillArg, lData, rData, pCfg->frameLen, seq);
+        }
+        else
+        {
+            i2sDmaSimSynthFill(pSim, lData, rData, pCfg->frameLen);
+        }
+
+        /* Absolute deadlines, no drift from fill time */
+        lateNs = 0;
+        if (pSim->periodNs != 0)
+        {
+            dueNs = pSim->startNs + (Uint64)(seq + 1) * pSim->periodNs;
+            hostClockSleepUntilNs(dueNs);
+            nowNs = hostClockNowNs();
+            lateNs = (nowNs > dueNs) ? nowNs - dueNs : 0;
+        }
+        else
+        {
+            /* Free running: frame seq completion lets DMA overwrite frame seq+1-numBufs, */
+            /* wait until consumer recorded it instead of running ahead of consumer */
+            if (seq + 1 >= pCfg->numBufs)
+            {
+                pthread_mutex_lock(&pSim->irqLock);
+                while ((pSim->numProcessed < seq + 2 - pCfg->numBufs) && !ATOMIC_LOAD(&pSim->stop))
+                {
+                    pthread_cond_wait(&pSim->recCond, &pSim->irqLock);
+                }
+                pthread_mutex_unlock(&pSim->irqLock);
+            }
+            nowNs = hostClockNowNs();
+        }
+        pSim->jitSumNs += (Float64)lateNs;
+        pSim->jitSumSqNs += (Float64)lateNs * (Float64)lateNs;
+        if (lateNs > pSim->jitMaxNs)
+        {
+            pSim->jitMaxNs = lateNs;
+        }
+
+        /* Raise DMA complete, one interrupt per channel if split */
+        timestamp = (Uint32)((nowNs - pSim->startNs) / 1000);
+        ATOMIC_STORE(&pSim->numProduced, seq + 1);
+        if (pCfg->splitChans)
+        {
+            pCfg->done(pCfg->doneArg, I2S_DMA_SIM_CHAN_LEFT, timestamp);
+            i2sDmaSimIrq(pSim);
+            pCfg->done(pCfg->doneArg, I2S_DMA_SIM_CHAN_RIGHT, timestamp);
+        }
+        else
+        {
+            pCfg->done(pCfg->doneArg, I2S_DMA_SIM_CHAN_LEFT | I2S_DMA_SIM_CHAN_RIGHT, timestamp);
+        }
+        i2sDmaSimIrq(pSim);
+    }
+
+    pthread_mutex_lock(&pSim->irqLock);
+    pSim->finished = 1;
+    pthread_cond_broadcast(&pSim->irqCond);
+    pthread_mutex_unlock(&pSim->irqLock);
+
+    return NULL;
+}
+
+/* Fills configuration: 1.024 MHz PDM, 20 ms ping/pong frames, real time, */
+/* synthetic 4th order 1 kHz tone at -26 dBFS, -6 dBFS after default 20 dB digital gain. */
+void i2sDmaSimCfgDefault(
+    I2sDmaSimCfg *pCfg      /* simulator configuration */
+)
+{
+    pCfg->pdmRate = 1024000;
+    pCfg->frameLen = 320;
+    pCfg->numBufs = 2;
+    pCfg->bufLeft = NULL;
+    pCfg->bufRight = NULL;
+    pCfg->speed = 1.0;
+    pCfg->numFrames = 0;
+    pCfg->srcType = I2S_DMA_SIM_SRC_SYNTH;
+    pCfg->fileName = NULL;
+    pCfg->fileLoop = 0;
+    pCfg->toneHz = 1000.0;
+    pCfg->toneAmp = 0.05;
+    pCfg->sdOrder = 4;
+    pCfg->fill = NULL;
+    pCfg->fillArg = NULL;
+    pCfg->splitChans = 1;
+    pCfg->done = NULL;
+    pCfg->doneArg = NULL;
+}
+
+/* Starts producer thread. */
+Int16 i2sDmaSimStart(
+    I2sDmaSim *pSim,        /* simulator */
+    const I2sDmaSimCfg *pCfg    /* simulator configuration */
+)
+{
+    PdmGenCfg genCfg;
+
+    if ((pCfg->pdmRate == 0) || (pCfg->frameLen == 0) || (pCfg->numBufs < 2) ||
+        (pCfg->bufLeft == NULL) || (pCfg->bufRight == NULL) || (pCfg->done == NULL) ||
+        (pCfg->speed < 0.0) || ((pCfg->srcType == I2S_DMA_SIM_SRC_USER) && (pCfg->fill == NULL)))
+    {
+        return I2S_DMA_SIM_ERR_CFG;
+    }
+
+    pSim->cfg = *pCfg;
+    pSim->running = 0;
+    pSim->fp = NULL;
+    pSim->fileBuf = NULL;
+    pSim->pGen = NULL;
+    if (pCfg->srcType == I2S_DMA_SIM_SRC_FILE)
+    {
+        pSim->fp = (pCfg->fileName != NULL) ? fopen(pCfg->fileName, "rb") : NULL;
+        pSim->fileBuf = (Uint32 *)malloc(2*pCfg->frameLen*sizeof(Uint32));
+        if ((pSim->fp == NULL) || (pSim->fileBuf == NULL))
+        {
+            i2sDmaSimStop(pSim);
+            return I2S_DMA_SIM_ERR_FILE;
+        }
+    }
+
+    else if (pCfg->srcType == I2S_DMA_SIM_SRC_SYNTH)
+    {
+        pdmGenCfgDefault(&genCfg);
+        genCfg.pdmRate = pCfg->pdmRate;
+        genCfg.order = pCfg->sdOrder;
+        genCfg.amp = pCfg->toneAmp;
+        genCfg.freq = pCfg->toneHz;
+        if (pdmGenInit(&pSim->gen, &genCfg) != PDM_GEN_OK)
+        {
+            return I2S_DMA_SIM_ERR_CFG;
+        }
+        pSim->pGen = &pSim->gen;
+    }
+
+    /* Frame period scaled by speed */
+    pSim->periodNs = 0;
+    if (pCfg->speed > 0.0)
+    {
+        pSim->periodNs = (Uint64)((Float64)pCfg->frameLen * I2S_DMA_SIM_PDM_BITS_PER_WORD * 1e9 /
+            pCfg->pdmRate / pCfg->speed + 0.5);
+    }
+
+    pSim->stop = 0;
+    pSim->finished = 0;
+    pSim->irqCount = 0;
+    pSim->irqSeen = 0;
+    pSim->numProduced = 0;
+    pSim->jitSumNs = 0.0;
+    pSim->jitSumSqNs = 0.0;
+    pSim->jitMaxNs = 0;
+    pSim->numProcessed = 0;
+    pSim->numMisses = 0;
+    pSim->busySumNs = 0;
+    pSim->busyMaxNs = 0;
+    pSim->latSumNs = 0;
+    pSim->latMaxNs = 0;
+    pthread_mutex_init(&pSim->irqLock, NULL);
+    pthread_cond_init(&pSim->irqCond, NULL);
+    pthread_cond_init(&pSim->recCond, NULL);
+
+    pSim->startNs = hostClockNowNs();
+    pSim->stopNs = pSim->startNs;
+    if (pthread_create(&pSim->thread, NULL, i2sDmaSimProducer, pSim) != 0)
+    {
+        i2sDmaSimStop(pSim);
+        return I2S_DMA_SIM_ERR_THREAD;
+    }
+    pSim->running = 1;
+
+    return I2S_DMA_SIM_OK;
+}
+
+/* Waits for next DMA completion, like CPU idle woken by DMA interrupt. */
+Uint16 i2sDmaSimWait(
+    I2sDmaSim *pSim         /* simulator */
+)
+{
+    Uint16 woken;
+
+    pthread_mutex_lock(&pSim->irqLock);
+    while ((pSim->irqCount == pSim->irqSeen) && !pSim->finished)
+    {
+        pthread_cond_wait(&pSim->irqCond, &pSim->irqLock);
+    }
+    woken = (pSim->irqCount != pSim->irqSeen);
+    pSim->irqSeen = pSim->irqCount;
+    pthread_mutex_unlock(&pSim->irqLock);
+
+    return woken;
+}
+
+/* Records processed frame. Consumer only. */
+void i2sDmaSimRecord(
+    I2sDmaSim *pSim,        /* simulator */
+    Uint32 seq,             /* frame sequence number */
+    Uint64 startNs,         /* processing start time (ns) */
+    Uint64 endNs            /* processing end time (ns) */
+)
+{
+    Uint64 busyNs;
+    Uint64 doneNs;
+    Uint64 latNs;
+
+    busyNs = endNs - startNs;
+    pSim->busySumNs += busyNs;
+    if (busyNs > pSim->busyMaxNs)
+    {
+        pSim->busyMaxNs = busyNs;
+    }
+
+    /* Frame due at end of its period, buffer reused numBufs-1 periods later */
+    if (pSim->periodNs != 0)
+    {
+        doneNs = pSim->startNs + (Uint64)(seq + 1) * pSim->periodNs;
+        latNs = (endNs > doneNs) ? endNs - doneNs : 0;
+        pSim->latSumNs += latNs;
+        if (latNs > pSim->latMaxNs)
+        {
+            pSim->latMaxNs = latNs;
+        }
+        if (latNs > (Uint64)(pSim->cfg.numBufs - 1) * pSim->periodNs)
+        {
+            pSim->numMisses++;
+        }
+    }
+
+    pthread_mutex_lock(&pSim->irqLock);
+    pSim->numProcessed++;
+    pthread_cond_broadcast(&pSim->recCond);
+    pthread_mutex_unlock(&pSim->irqLock);
+}
+
+/* Stops & joins producer thread, closes source file, frees generator. */
+void i2sDmaSimStop(
+    I2sDmaSim *pSim         /* simulator */
+)
+{
+    if (pSim->running)
+    {
+        /* Wake producer waiting for consumer */
+        pthread_mutex_lock(&pSim->irqLock);
+        ATOMIC_STORE(&pSim->stop, 1);
+        pthread_cond_broadcast(&pSim->recCond);
+        pthread_mutex_unlock(&pSim->irqLock);
+        pthread_join(pSim->thread, NULL);
+        pthread_mutex_destroy(&pSim->irqLock);
+        pthread_cond_destroy(&pSim->irqCond);
+        pthread_cond_destroy(&pSim->recCond);
+        pSim->running = 0;
+        pSim->stopNs = hostClockNowNs();
+    }
+    if (pSim->fp != NULL)
+    {
+        fclose(pSim->fp);
+        pSim->fp = NULL;
+    }
+    free(pSim->fileBuf);
+    pSim->fileBuf = NULL;
+    if (pSim->pGen != NULL)
+    {
+        pdmGenFree(pSim->pGen);
+        pSim->pGen = NULL;
+    }
+}
+
+/* Reads statistics, after i2sDmaSimStop(). */
+void i2sDmaSimGetStats(
+    I2sDmaSim *pSim,        /* simulator */
+    I2sDmaSimStats *pStats  /* statistics */
+)
+{
+    Float64 numProduced;
+    Float64 numProcessed;
+    Float64 periodUs;
+    Float64 jitMean;
+    Float64 jitVar;
+
+    numProduced = (pSim->numProduced > 0) ? pSim->numProduced : 1;
+    numProcessed = (pSim->numProcessed > 0) ? pSim->numProcessed : 1;
+    periodUs = (Float64)pSim->periodNs / 1000.0;
+    jitMean = pSim->jitSumNs / numProduced;
+    jitVar = pSim->jitSumSqNs / numProduced - jitMean*jitMean;
+
+    pStats->numProduced = pSim->numProduced;
+    pStats->numProcessed = pSim->numProcessed;
+    pStats->numMisses = pSim->numMisses;
+    pStats->periodUs = periodUs;
+    pStats->jitterMeanUs = jitMean / 1000.0;
+    pStats->jitterStdUs = (jitVar > 0.0) ? sqrt(jitVar) / 1000.0 : 0.0;
+    pStats->jitterMaxUs = (Float64)pSim->jitMaxNs / 1000.0;
+    pStats->busyMeanUs = (Float64)pSim->busySumNs / numProcessed / 1000.0;
+    pStats->busyMaxUs = (Float64)pSim->busyMaxNs / 1000.0;
+    pStats->latMeanUs = (Float64)pSim->latSumNs / numProcessed / 1000.0;
+    pStats->latMaxUs = (Float64)pSim->latMaxNs / 1000.0;
+    pStats->headroomMean = 0.0;
+    pStats->headroomMin = 0.0;
+    if (periodUs > 0.0)
+    {
+        pStats->headroomMean = 1.0 - pStats->busyMeanUs / periodUs;
+        pStats->headroomMin = 1.0 - pStats->busyMaxUs / periodUs;
+    }
+    pStats->elapsedSec = (Float64)(pSim->stopNs - pSim->startNs) / 1e9;
+}
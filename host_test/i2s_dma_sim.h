@@ -0,0 +1,192 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+#ifndef __I2S_DMA_SIM_H__
+#define __I2S_DMA_SIM_H__
+
+#include <stdio.h>
+#include <pthread.h>
+#include "data_types.h"
+#include "pdm_gen.h"
+
+/* Host stand-in for I2S & DMA ping/pong front end (I2sDmaInit, DmaIsr). */
+/* Producer thread fills "left" & "right" DMA frame buffers in auto-reload */
+/* order from file or synthetic source, & raises DMA complete callbacks */
+/* at real-time or accelerated frame rate. */
+/* Consumer records processed frames to measure deadline misses, */
+/* DMA callback jitter & processing headroom. */
+
+#define I2S_DMA_SIM_SRC_SYNTH       ( 0 )   /* synthetic sigma-delta tone, pdmGen */
+#define I2S_DMA_SIM_SRC_FILE        ( 1 )   /* file of interleaved "left" & "right" 32-bit words */
+#define I2S_DMA_SIM_SRC_USER        ( 2 )   /* user fill function */
+
+#define I2S_DMA_SIM_CHAN_LEFT       ( 0x1 ) /* "left" channel DMA transfer complete */
+#define I2S_DMA_SIM_CHAN_RIGHT      ( 0x2 ) /* "right" channel DMA transfer complete */
+
+#define I2S_DMA_SIM_PDM_BITS_PER_WORD   ( 64 )  /* PDM bits in one "left" & "right" 32-bit word pair */
+
+#define I2S_DMA_SIM_OK              ( 0 )   /* success */
+#define I2S_DMA_SIM_ERR_CFG         ( -1 )  /* invalid configuration */
+#define I2S_DMA_SIM_ERR_FILE        ( -2 )  /* cannot open source file */
+#define I2S_DMA_SIM_ERR_THREAD      ( -3 )  /* thread creation failed */
+
+/* Fills one frame of both channels */
+typedef void (*I2sDmaSimFillFxn)(
+    void *pArg,             /* fill argument */
+    Uint32 *lData,          /* "left" channel 32-bit packed data */
+    Uint32 *rData,          /* "right" channel 32-bit packed data */
+    Uint16 frameLen,        /* number of words per channel */
+    Uint32 seq              /* frame sequence number */
+);
+
+/* DMA complete callback, called on producer thread */
+typedef void (*I2sDmaSimDoneFxn)(
+    void *pArg,             /* callback argument */
+    Uint16 chanMask,        /* I2S_DMA_SIM_CHAN_xxx completed */
+    Uint32 timestamp        /* completion time (us since start) */
+);
+
+/* Simulator configuration */
+typedef struct
+{
+    Uint32 pdmRate;         /* PDM bit rate (Hz) */
+    Uint16 frameLen;        /* number of words per channel per frame */
+    Uint16 numBufs;         /* number of DMA frame buffers per channel, 2 for ping/pong */
+    Uint32 *bufLeft;        /* "left" channel DMA frame buffers, numBufs*frameLen words */
+    Uint32 *bufRight;       /* "right" channel DMA frame buffers, numBufs*frameLen words */
+    Float64 speed;          /* 1.0 real time, >1.0 accelerated, 0.0 free running with backpressure */
+    Uint32 numFrames;       /* number of frames, 0 until stopped or end of file */
+    Uint16 srcType;         /* I2S_DMA_SIM_SRC_xxx */
+    const char *fileName;   /* source file name */
+    Uint16 fileLoop;        /* 1 rewinds source file at end */
+    Float64 toneHz;         /* synthetic tone frequency (Hz) */
+    Float64 toneAmp;        /* synthetic tone amplitude, full scale 1.0 */
+    Uint16 sdOrder;         /* synthetic sigma-delta modulator order, 1 to PDM_GEN_MAX_ORDER */
+    I2sDmaSimFillFxn fill;  /* user fill function */
+    void *fillArg;          /* user fill argument */
+    Uint16 splitChans;      /* 1 raises "left" & "right" completions separately, like two DMA channels */
+    I2sDmaSimDoneFxn done;  /* DMA complete callback */
+    void *doneArg;          /* DMA complete callback argument */
+} I2sDmaSimCfg;
+
+/* Simulator statistics */
+typedef struct
+{
+    Uint32 numProduced;     /* number of frames produced */
+    Uint32 numProcessed;    /* number of frames recorded by consumer */
+    Uint32 numMisses;       /* number of frames finished after DMA reused buffer */
+    Float64 periodUs;       /* simulated frame period (us) */
+    Float64 jitterMeanUs;   /* mean DMA callback lateness (us) */
+    Float64 jitterStdUs;    /* DMA callback lateness standard deviation (us) */
+    Float64 jitterMaxUs;    /* maximum DMA callback lateness (us) */
+    Float64 busyMeanUs;     /* mean frame processing time (us) */
+    Float64 busyMaxUs;      /* maximum frame processing time (us) */
+    Float64 latMeanUs;      /* mean DMA complete to processing end latency (us) */
+    Float64 latMaxUs;       /* maximum DMA complete to processing end latency (us) */
+    Float64 headroomMean;   /* 1 - mean processing time / period */
+    Float64 headroomMin;    /* 1 - maximum processing time / period */
+    Float64 elapsedSec;     /* run time (s) */
+} I2sDmaSimStats;
+
+/* Simulator */
+typedef struct
+{
+    I2sDmaSimCfg cfg;       /* configuration */
+    FILE *fp;               /* source file */
+    Uint32 *fileBuf;        /* interleaved words of one file frame */
+    PdmGen gen;             /* synthetic source generator */
+    PdmGen *pGen;           /* &gen once initialized, NULL otherwise */
+    Uint64 periodNs;        /* frame period (ns), 0 when free running */
+    Uint64 startNs;         /* start time (ns) */
+    Uint64 stopNs;          /* stop time (ns) */
+    pthread_t thread;       /* producer thread */
+    Uint32 running;         /* producer thread running */
+    Uint32 stop;            /* set to stop producer thread */
+    Uint32 finished;        /* producer thread finished */
+    pthread_mutex_t irqLock;    /* protects irqCount */
+    pthread_cond_t irqCond;     /* signalled on DMA completion */
+    pthread_cond_t recCond;     /* signalled on recorded frame, wakes free running producer */
+    Uint32 irqCount;        /* number of DMA completions signalled */
+    Uint32 irqSeen;         /* number of DMA completions seen by consumer */
+    Uint32 numProduced;     /* number of frames produced */
+    Float64 jitSumNs;       /* sum of DMA callback lateness (ns), producer only */
+    Float64 jitSumSqNs;     /* sum of squared DMA callback lateness, producer only */
+    Uint64 jitMaxNs;        /* maximum DMA callback lateness (ns), producer only */
+    Uint32 numProcessed;    /* number of frames recorded, written by consumer under irqLock */
+    Uint32 numMisses;       /* number of deadline misses, consumer only */
+    Uint64 busySumNs;       /* sum of processing times (ns), consumer only */
+    Uint64 busyMaxNs;       /* maximum processing time (ns), consumer only */
+    Uint64 latSumNs;        /* sum of latencies (ns), consumer only */
+    Uint64 latMaxNs;        /* maximum latency (ns), consumer only */
+} I2sDmaSim;
+
+/* Fills configuration: 1.024 MHz PDM, 20 ms ping/pong frames, real time, */
+/* synthetic 4th order 1 kHz tone at -26 dBFS, -6 dBFS after default 20 dB digital gain. */
+void i2sDmaSimCfgDefault(
+    I2sDmaSimCfg *pCfg      /* simulator configuration */
+);
+
+/* Starts producer thread. */
+Int16 i2sDmaSimStart(
+    I2sDmaSim *pSim,        /* simulator */
+    const I2sDmaSimCfg *pCfg    /* simulator configuration */
+);
+
+/* Waits for next DMA completion, like CPU idle woken by DMA interrupt. */
+/* Returns 0 once producer finished & no completion pending. */
+Uint16 i2sDmaSimWait(
+    I2sDmaSim *pSim         /* simulator */
+);
+
+/* Records processed frame. Consumer only. */
+/* Free running, producer completes no frame whose buffer reuse would */
+/* overwrite an unrecorded frame, so every frame must be recorded, */
+/* after its frame buffer is released. */
+void i2sDmaSimRecord(
+    I2sDmaSim *pSim,        /* simulator */
+    Uint32 seq,             /* frame sequence number */
+    Uint64 startNs,         /* processing start time (ns) */
+    Uint64 endNs            /* processing end time (ns) */
+);
+
+/* Stops & joins producer thread, closes source file, frees generator. */
+void i2sDmaSimStop(
+    I2sDmaSim *pSim         /* simulator */
+);
+
+/* Reads statistics, after i2sDmaSimStop(). */
+void i2sDmaSimGetStats(
+    I2sDmaSim *pSim,        /* simulator */
+    I2sDmaSimStats *pStats  /* statistics */
+);
+
+#endif /* __I2S_DMA_SIM_H__ */
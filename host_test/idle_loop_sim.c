@@ -0,0 +1,301 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "data_types.h"
+#include "pick_bits_cic.h"
+#include "decim_pipe.h"
+#include "frame_ring.h"
+#include "idle_frame.h"
+#include "decim_prof.h"
+#include "i2s_dma_sim.h"
+#include "host_clock.h"
+#include "decim_dispatch.h"
+
+/* Host load test of IdleLoop processing schedule. */
+/* I2S/DMA front end replaced by i2s_dma_sim, DmaIsr mirrors IdleLoop.c, */
+/* UserAlgorithm shares its frame schedule through idleFrameNext(), */
+/* idle instruction replaced by i2sDmaSimWait(). */
+/* -k runs pipelines with fastest host kernels from decim_dispatch. */
+/* Usage: idle_loop_sim [-f pdmFile] [-l] [-k] [-s speed] [-n numFrames] [-c numPipes] */
+/*                      [-t toneHz] [-a toneAmp] [-m sdOrder] [-o outFile] */
+
+#define IN_FRAME_LEN_PER_CH     ( 320 )     /* 20 ms at 1.024 MHz PDM */
+#define I2S_DMA_BUF_LEN         ( IN_FRAME_LEN_PER_CH*2 )
+#define MAX_PIPES               ( 64 )      /* maximum number of pipelines sharing input */
+
+static Uint32 i2sDmaReadBufLeft[I2S_DMA_BUF_LEN];
+static Uint32 i2sDmaReadBufRight[I2S_DMA_BUF_LEN];
+static FrameRing dmaFrameRing;
+static DecimPipe decimPipe[MAX_PIPES];
+#ifdef DECIM_PROF_ENABLE
+static DecimProf decimProf;    /* profile of pipeline 0 */
+#endif
+static Int16 digGainOutFrame[DECIM_PIPE_MAX_OUT_LEN];
+
+/* DMA ISR: frame queued once both channels complete it */
+static void DmaIsr(
+    void *pArg,             /* frame ring */
+    Uint16 chanMask,        /* I2S_DMA_SIM_CHAN_xxx completed */
+    Uint32 timestamp        /* completion time (us) */
+)
+{
+    frameRingDmaDone((FrameRing *)pArg, chanMask, timestamp);
+}
+
+/* User algorithm: drains frame ring, numPipes pipelines per frame */
+static void UserAlgorithm(
+    I2sDmaSim *pSim,        /* simulator */
+    Uint16 numPipes,        /* number of pipelines */
+    FILE *fpOut             /* output file, may be NULL */
+)
+{
+    FrameDesc frame;
+    Uint64 startNs;
+    Uint64 endNs;
+    Uint16 numOutSamps;
+    Uint16 status;
+
+    for (;;)
+    {
+        startNs = hostClockNowNs();
+        status = idleFrameNext(&dmaFrameRing, decimPipe, numPipes, digGainOutFrame, &numOutSamps, &frame);
+        if (status == IDLE_FRAME_NONE)
+        {
+            break;
+        }
+        endNs = hostClockNowNs();
+
+        /* Output of stale frame dropped as on target */
+        if ((status == IDLE_FRAME_OK) && (fpOut != NULL))
+        {
+            fwrite(digGainOutFrame, sizeof(Int16), numOutSamps, fpOut);
+        }
+
+        /* Released before recorded, free running DMA may reuse buffer once recorded */
+        i2sDmaSimRecord(pSim, frame.seq, startNs, endNs);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    static I2sDmaSim sim;
+    I2sDmaSimCfg simCfg;
+    I2sDmaSimStats stats;
+    DecimPipeCfg pipeCfg;
+    const char *outFileName;
+    FILE *fpOut;
+    Uint32 numFrames, numOverruns, numStale;
+    Uint16 numPipes;
+    Uint16 useDispatch;
+    Uint16 i;
+    int arg;
+
+    i2sDmaSimCfgDefault(&simCfg);
+    simCfg.frameLen = IN_FRAME_LEN_PER_CH;
+    simCfg.numFrames = 500;
+    outFileName = NULL;
+    numPipes = 1;
+    useDispatch = 0;
+
+    for (arg = 1; arg < argc; arg++)
+    {
+        if (!strcmp(argv[arg], "-l"))
+        {
+            simCfg.fileLoop = 1;
+        }
+        else if (!strcmp(argv[arg], "-k"))
+        {
+            useDispatch = 1;
+        }
+        else if (arg+1 >= argc)
+        {
+            break;
+        }
+        else if (!strcmp(argv[arg], "-f"))
+        {
+            simCfg.srcType = I2S_DMA_SIM_SRC_FILE;
+            simCfg.fileName = argv[++arg];
+        }
+        else if (!strcmp(argv[arg], "-s"))
+        {
+            simCfg.speed = atof(argv[++arg]);
+        }
+        else if (!strcmp(argv[arg], "-n"))
+        {
+            simCfg.numFrames = (Uint32)strtoul(argv[++arg], NULL, 0);
+        }
+        else if (!strcmp(argv[arg], "-c"))
+        {
+            numPipes = (Uint16)atoi(argv[++arg]);
+        }
+        else if (!strcmp(argv[arg], "-t"))
+        {
+            simCfg.toneHz = atof(argv[++arg]);
+        }
+        else if (!strcmp(argv[arg], "-a"))
+        {
+            simCfg.toneAmp = atof(argv[++arg]);
+        }
+        else if (!strcmp(argv[arg], "-m"))
+        {
+            simCfg.sdOrder = (Uint16)atoi(argv[++arg]);
+        }
+        else if (!strcmp(argv[arg], "-o"))
+        {
+            outFileName = argv[++arg];
+        }
+        else
+        {
+            break;
+        }
+    }
+    if ((arg < argc) || (numPipes < 1) || (numPipes > MAX_PIPES))
+    {
+        printf("Usage: %s [-f pdmFile] [-l] [-k] [-s speed] [-n numFrames] [-c numPipes] "
+            "[-t toneHz] [-a toneAmp] [-m sdOrder] [-o outFile]\n", argv[0]);
+        return 1;
+    }
+
+    /* Initialize decimation pipelines as IdleLoop */
+    decimPipeCfgDefault(&pipeCfg);
+    pipeCfg.inFrameLen = IN_FRAME_LEN_PER_CH;
+    pipeCfg.cicKernel = pickBitsCic;
+    if (useDispatch != 0)
+    {
+        /* Fastest host kernels, selected before I2S & DMA thread starts */
+        decimDispatchInit();
+        decimDispatchPipeCfg(&pipeCfg);
+        printf("Kernels: CIC %s, FIR %s, gain %s\n", decimKernelName(DECIM_KERNEL_CIC),
+            decimKernelName(DECIM_KERNEL_FIR), decimKernelName(DECIM_KERNEL_DIGGAIN));
+    }
+    for (i = 0; i < numPipes; i++)
+    {
+        if (decimPipeInit(&decimPipe[i], &pipeCfg) != DECIM_PIPE_OK)
+        {
+            printf("ERROR: Unable to initialize decimation pipeline\n");
+            return 1;
+        }
+    }
+#ifdef DECIM_PROF_ENABLE
+    decimProfReset(&decimProf);
+    decimPipeSetProf(&decimPipe[0], &decimProf);
+#endif
+
+    if (frameRingInit(&dmaFrameRing, i2sDmaReadBufLeft, i2sDmaReadBufRight, IN_FRAME_LEN_PER_CH, 2) != FRAME_RING_OK)
+    {
+        printf("ERROR: Unable to initialize DMA frame ring\n");
+        return 1;
+    }
+
+    fpOut = NULL;
+    if (outFileName != NULL)
+    {
+        fpOut = fopen(outFileName, "wb");
+        if (fpOut == NULL)
+        {
+            printf("ERROR: Unable to open %s\n", outFileName);
+            return 1;
+        }
+    }
+
+    DECIM_PROF_INIT();
+
+    /* Start simulated I2S & DMA */
+    simCfg.bufLeft = i2sDmaReadBufLeft;
+    simCfg.bufRight = i2sDmaReadBufRight;
+    simCfg.done = DmaIsr;
+    simCfg.doneArg = &dmaFrameRing;
+    if (i2sDmaSimStart(&sim, &simCfg) != I2S_DMA_SIM_OK)
+    {
+        printf("ERROR: Unable to start I2S/DMA simulation\n");
+        return 1;
+    }
+
+    /* Idle loop, woken by DMA completions */
+    while (i2sDmaSimWait(&sim))
+    {
+        UserAlgorithm(&sim, numPipes, fpOut);
+    }
+    UserAlgorithm(&sim, numPipes, fpOut);
+
+    i2sDmaSimStop(&sim);
+    i2sDmaSimGetStats(&sim, &stats);
+    frameRingGetStats(&dmaFrameRing, &numFrames, &numOverruns, &numStale);
+    if (fpOut != NULL)
+    {
+        fclose(fpOut);
+    }
+
+    printf("frames: produced %u, processed %u, overruns %u, stale %u, deadline misses %u\n",
+        stats.numProduced, numFrames, numOverruns, numStale, stats.numMisses);
+    printf("period %.1f us, DMA jitter mean %.1f std %.1f max %.1f us\n",
+        stats.periodUs, stats.jitterMeanUs, stats.jitterStdUs, stats.jitterMaxUs);
+    printf("processing mean %.1f max %.1f us, latency mean %.1f max %.1f us\n",
+        stats.busyMeanUs, stats.busyMaxUs, stats.latMeanUs, stats.latMaxUs);
+    printf("headroom mean %.1f%% min %.1f%%, elapsed %.2f s\n",
+        100.0*stats.headroomMean, 100.0*stats.headroomMin, stats.elapsedSec);
+
+#ifdef DECIM_PROF_ENABLE
+    {
+        static const char *stageNames[DECIM_PROF_NUM_STAGES] =
+            { "CIC", "FIR1", "FIR2", "FIR3", "FIR4", "GAIN", "IIR", "FRAME" };
+        DecimProfStats prof;
+        DecimProfWorst worst;
+
+        printf("stage   frames        min       mean        p99        max (%s)\n", decimProfUnit());
+        for (i = 0; i < DECIM_PROF_NUM_STAGES; i++)
+        {
+            decimProfGetStats(&decimProf, i, &prof);
+            if (prof.numFrames > 0)
+            {
+                printf("%-5s %8u %10u %10u %10u %10u\n", stageNames[i], prof.numFrames,
+                    prof.minTime, prof.meanTime, prof.p99Time, prof.maxTime);
+            }
+        }
+        decimProfGetWorst(&decimProf, &worst);
+        printf("worst frame %u:", worst.frame);
+        for (i = 0; i < DECIM_PROF_NUM_STAGES; i++)
+        {
+            if (worst.time[i] > 0)
+            {
+                printf(" %s %u", stageNames[i], worst.time[i]);
+            }
+        }
+        printf("\n");
+    }
+#endif
+
+    return 0;
+}
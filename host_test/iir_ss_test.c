@@ -0,0 +1,420 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "data_types.h"
+#include "BlkIir.h"
+#include "BlkIirSs.h"
+
+/* blkIirSs() error bound test. */
+/* Runs blkIirSs() against blkIirDf1() & blkIirDf2() from zero state on random */
+/* stable biquad cascades & random inputs, frames of random length. */
+/* Numerators are scaled so cascade gain (sum of |impulse response|) stays below */
+/* SS_MAX_GAIN, so every trial finds an input amplitude of at least SS_MIN_AMP. */
+/* Checks every output is within blkIirSsErrBound() of reference output. */
+/* Input is scaled down until floating-point output of quantized filter */
+/* stays below 2^14 LSBs, so DF2 reference output never wraps & DF2 bound holds. */
+/* Checks blkIirSsErrBound() returns -1 for filters with poles on unit circle. */
+/* Exits with 0 if all checks pass, 1 otherwise. */
+/* Usage: iir_ss_test [-s seed] [-n numTrials] */
+
+#define SS_SIG_LEN          ( 2048 )    /* samples per trial */
+#define SS_MAX_FRAME_LEN    ( 4*IIR_SS_BLK_LEN+3 )  /* maximum frame length, exercises partial blocks */
+#define SS_MAX_IWL          ( 2 )       /* maximum coefficient integer wordlength */
+#define SS_DLY_LEN          ( 4*IIR_SS_MAX_BIQUADS+2 )  /* fits DF1 & DF2 layouts */
+#define SS_Y_MAX            ( (Float64)(1<<14) )    /* unwrapped output limit (LSBs), half of DF2 wrap */
+#define SS_MIN_AMP          ( 16 )      /* smallest input amplitude tried (LSBs) */
+#define SS_MAX_GAIN         ( SS_Y_MAX/(2*SS_MIN_AMP) ) /* cascade gain limit, amplitude halving overshoots SS_MIN_AMP by < 2 */
+
+static Int32 inSamps[SS_SIG_LEN];       /* input samples */
+static Int32 refOut[SS_SIG_LEN];        /* reference output */
+static Int32 ssOut[SS_SIG_LEN];         /* blkIirSs() output */
+static Int32 dlyBuf[SS_DLY_LEN];        /* reference delay buffer */
+static Int16 df1Coefs[5*IIR_SS_MAX_BIQUADS];    /* blkIirDf1() order: b0, b1, b2, a1, a2 */
+static Int16 df2Coefs[5*IIR_SS_MAX_BIQUADS];    /* blkIirDf2() order: a1, a2, b2, b0, b1 */
+static BlkIirSsState ssState;
+static Uint32 ssSeed;
+
+/* xorshift32 */
+static Uint32 ssRand(void)
+{
+    Uint32 x = ssSeed;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    ssSeed = x;
+
+    return x;
+}
+
+/* Returns random value in lo->hi */
+static Int32 ssRandRange(
+    Int32 lo,               /* lowest value */
+    Int32 hi                /* highest value */
+)
+{
+    return lo + (Int32)(ssRand() % (Uint32)(hi - lo + 1));
+}
+
+/* Returns sum of |impulse response| over SS_SIG_LEN samples of quantized biquad. */
+/* Bounds |output|/|input| of biquad over a trial, product bounds cascade. */
+static Float64 ssBiquadGain(
+    Int16 *c,               /* coefficients, blkIirDf1() order: b0, b1, b2, a1, a2 */
+    Uint16 coefIWL          /* coefficient integer wordlength */
+)
+{
+    Float64 scale;
+    Float64 y, y1, y2;
+    Float64 gain;
+    Uint16 i;
+
+    scale = 1.0 / (Float64)(1 << (15-coefIWL));
+    y1 = 0;
+    y2 = 0;
+    gain = 0;
+    for (i = 0; i < SS_SIG_LEN; i++)
+    {
+        y = scale*((i == 0 ? c[0] : 0) + (i == 1 ? c[1] : 0) + (i == 2 ? c[2] : 0) - c[3]*y1 - c[4]*y2);
+        y2 = y1;
+        y1 = y;
+        gain += fabs(y);
+    }
+
+    return gain;
+}
+
+/* Random stable biquad cascade, blkIirDf1() & blkIirDf2() order. */
+/* Poles inside radius 0.97, all coefficients fit coefIWL integer bits. */
+/* Each biquad numerator is scaled down until its gain is at most SS_MAX_GAIN^(1/numBiquads). */
+static void ssIirCoefs(
+    Uint16 numBiquads,      /* number of biquads */
+    Uint16 coefIWL          /* coefficient integer wordlength */
+)
+{
+    Int32 r, c;
+    Int32 a1, a2;
+    Float64 maxGain, gain;
+    Uint16 j, k;
+
+    maxGain = pow(SS_MAX_GAIN, 1.0/numBiquads);
+
+    for (j = 0; j < numBiquads; j++)
+    {
+        /* Pole radius r & cos(theta) in Q15: a1 = -2*r*cos(theta), a2 = r^2 */
+        do
+        {
+            r = ssRandRange(0, 31785);      /* 0.97 */
+            c = ssRandRange(-32768, 32767);
+            a1 = -(Int32)(((Int64)2*r*c) >> (15+coefIWL));
+            a2 = (Int32)(((Int64)r*r) >> (15+coefIWL));
+        } while ((a1 > 32767) || (a1 < -32767));
+
+        for (k = 0; k < 3; k++)
+        {
+            df1Coefs[5*j+k] = (Int16)ssRandRange(-32767, 32767);
+        }
+        df1Coefs[5*j+3] = (Int16)a1;
+        df1Coefs[5*j+4] = (Int16)a2;
+
+        /* Rounding may leave gain slightly high, scale again with margin */
+        while ((gain = ssBiquadGain(&df1Coefs[5*j], coefIWL)) > maxGain)
+        {
+            for (k = 0; k < 3; k++)
+            {
+                df1Coefs[5*j+k] = (Int16)floor(df1Coefs[5*j+k] * (0.99*maxGain/gain) + 0.5);
+            }
+        }
+
+        df2Coefs[5*j] = df1Coefs[5*j+3];
+        df2Coefs[5*j+1] = df1Coefs[5*j+4];
+        df2Coefs[5*j+2] = df1Coefs[5*j+2];
+        df2Coefs[5*j+3] = df1Coefs[5*j];
+        df2Coefs[5*j+4] = df1Coefs[5*j+1];
+    }
+}
+
+/* Runs quantized DF2 biquad cascade in 64-bit floating point from zero state. */
+/* Returns maximum |output| (LSBs), no wrap. */
+static Float64 ssRunFloat(
+    Uint16 numBiquads,      /* number of biquads */
+    Uint16 coefIWL,         /* coefficient integer wordlength */
+    Uint16 inGain           /* input gain (U16Q16) */
+)
+{
+    Float64 d[IIR_SS_MAX_BIQUADS][2];
+    Float64 scale;
+    Float64 x, dn, yMax;
+    Int16 *c;
+    Uint16 i, j;
+
+    scale = 1.0 / (Float64)(1 << (15-coefIWL));
+    memset(d, 0, sizeof(d));
+    yMax = 0;
+    for (i = 0; i < SS_SIG_LEN; i++)
+    {
+        x = inSamps[i] * (inGain / 65536.0);
+        for (j = 0; j < numBiquads; j++)
+        {
+            c = &df2Coefs[5*j];
+            dn = x - scale*(c[0]*d[j][0] + c[1]*d[j][1]);
+            x = scale*(c[3]*dn + c[4]*d[j][0] + c[2]*d[j][1]);
+            d[j][1] = d[j][0];
+            d[j][0] = dn;
+        }
+        if (fabs(x) > yMax)
+        {
+            yMax = fabs(x);
+        }
+    }
+
+    return yMax;
+}
+
+/* Runs reference kernel from zero state in random-length frames. */
+static void ssRunRef(
+    Uint16 form,            /* IIR_SS_DF1 or IIR_SS_DF2 */
+    Int16 *coefs,           /* filter coefficients */
+    Uint16 numBiquads,      /* number of biquads */
+    Uint16 coefIWL,         /* coefficient integer wordlength */
+    Uint16 inGain           /* input gain (U16Q16) */
+)
+{
+    Uint16 len;
+    Uint16 i;
+
+    memset(dlyBuf, 0, sizeof(dlyBuf));
+    for (i = 0; i < SS_SIG_LEN; i += len)
+    {
+        len = (Uint16)ssRandRange(1, SS_MAX_FRAME_LEN);
+        if (len > SS_SIG_LEN - i)
+        {
+            len = SS_SIG_LEN - i;
+        }
+        if (form == IIR_SS_DF1)
+        {
+            blkIirDf1(&inSamps[i], coefs, &refOut[i], dlyBuf, inGain, len, numBiquads, coefIWL);
+        }
+        else
+        {
+            blkIirDf2(&inSamps[i], coefs, &refOut[i], dlyBuf, inGain, len, numBiquads, coefIWL);
+        }
+    }
+}
+
+/* Runs blkIirSs() against reference on random filter & input. */
+/* Returns 0 if all outputs within bound, 1 otherwise. */
+static Uint16 ssTrial(
+    Uint16 form,            /* IIR_SS_DF1 or IIR_SS_DF2 */
+    Float64 *pMaxRatio      /* in/out: largest error/bound ratio seen */
+)
+{
+    Int16 *coefs;
+    Uint16 numBiquads;
+    Uint16 coefIWL;
+    Uint16 inGain;
+    Int32 amp;
+    Float64 bound, err;
+    Uint16 len;
+    Uint16 i;
+
+    numBiquads = (Uint16)ssRandRange(1, IIR_SS_MAX_BIQUADS);
+    coefIWL = (Uint16)ssRandRange(0, SS_MAX_IWL);
+    inGain = (Uint16)ssRandRange(1, 65535);
+    ssIirCoefs(numBiquads, coefIWL);
+    coefs = (form == IIR_SS_DF1) ? df1Coefs : df2Coefs;
+
+    /* Halve input amplitude until output stays in range */
+    for (amp = ((Int32)1<<17)-1; amp >= SS_MIN_AMP; amp >>= 1)
+    {
+        for (i = 0; i < SS_SIG_LEN; i++)
+        {
+            inSamps[i] = ssRandRange(-amp, amp);
+        }
+        if (ssRunFloat(numBiquads, coefIWL, inGain) < SS_Y_MAX)
+        {
+            break;
+        }
+    }
+    if (amp < SS_MIN_AMP)
+    {
+        printf("%s: filter gain above SS_MAX_GAIN, %u biquads, IWL %u\n",
+            (form == IIR_SS_DF1) ? "DF1" : "DF2", numBiquads, coefIWL);
+        return 1;
+    }
+    ssRunRef(form, coefs, numBiquads, coefIWL, inGain);
+
+    if (blkIirSsInit(&ssState, coefs, numBiquads, coefIWL, inGain, form) != IIR_SS_OK)
+    {
+        printf("%s: blkIirSsInit() failed, %u biquads\n", (form == IIR_SS_DF1) ? "DF1" : "DF2", numBiquads);
+        return 1;
+    }
+    bound = blkIirSsErrBound(&ssState);
+    if (bound < 0)
+    {
+        printf("%s: no error bound for stable filter, %u biquads, IWL %u\n",
+            (form == IIR_SS_DF1) ? "DF1" : "DF2", numBiquads, coefIWL);
+        return 1;
+    }
+
+    for (i = 0; i < SS_SIG_LEN; i += len)
+    {
+        len = (Uint16)ssRandRange(1, SS_MAX_FRAME_LEN);
+        if (len > SS_SIG_LEN - i)
+        {
+            len = SS_SIG_LEN - i;
+        }
+        blkIirSs(&inSamps[i], &ssOut[i], &ssState, len);
+    }
+
+    for (i = 0; i < SS_SIG_LEN; i++)
+    {
+        err = (Float64)labs(ssOut[i] - refOut[i]);
+        if (err > bound)
+        {
+            printf("%s: sample %u error %.0f > bound %.3f, %u biquads, IWL %u, gain 0x%04x, amp %ld\n",
+                (form == IIR_SS_DF1) ? "DF1" : "DF2", i, err, bound, numBiquads, coefIWL, inGain, (long)amp);
+            return 1;
+        }
+        if ((bound > 0) && (err/bound > *pMaxRatio))
+        {
+            *pMaxRatio = err/bound;
+        }
+    }
+
+    return 0;
+}
+
+/* Checks blkIirSsErrBound() returns -1 for biquad with poles on unit circle. */
+/* Returns 0 if so, 1 otherwise. */
+static Uint16 ssCheckNoDecay(
+    Int16 a1,               /* a1, S16Q13 */
+    Int16 a2,               /* a2, S16Q13 */
+    const char *what        /* filter description */
+)
+{
+    Uint16 coefIWL = 2;
+    Uint16 form;
+    Float64 bound;
+
+    /* b0 = 1, b1 = b2 = 0 */
+    df1Coefs[0] = 1<<13;
+    df1Coefs[1] = 0;
+    df1Coefs[2] = 0;
+    df1Coefs[3] = a1;
+    df1Coefs[4] = a2;
+    df2Coefs[0] = a1;
+    df2Coefs[1] = a2;
+    df2Coefs[2] = 0;
+    df2Coefs[3] = 1<<13;
+    df2Coefs[4] = 0;
+
+    for (form = IIR_SS_DF1; form <= IIR_SS_DF2; form++)
+    {
+        if (blkIirSsInit(&ssState, (form == IIR_SS_DF1) ? df1Coefs : df2Coefs, 1, coefIWL, 0xFFFF, form) != IIR_SS_OK)
+        {
+            printf("%s: blkIirSsInit() failed, %s\n", (form == IIR_SS_DF1) ? "DF1" : "DF2", what);
+            return 1;
+        }
+        bound = blkIirSsErrBound(&ssState);
+        if (bound != -1)
+        {
+            printf("%s: bound %.3f for %s, expected -1\n", (form == IIR_SS_DF1) ? "DF1" : "DF2", bound, what);
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+static void usage(const char *name)
+{
+    fprintf(stderr, "Usage: %s [-s seed] [-n numTrials]\n", name);
+}
+
+int main(int argc, char **argv)
+{
+    Uint32 numTrials;
+    Uint32 numFails;
+    Float64 maxRatio[2];
+    Uint32 t;
+    Uint16 form;
+    int arg;
+
+    ssSeed = 1;
+    numTrials = 200;
+
+    for (arg = 1; arg+1 < argc; arg++)
+    {
+        if (!strcmp(argv[arg], "-s"))
+        {
+            ssSeed = (Uint32)strtoul(argv[++arg], NULL, 0);
+        }
+        else if (!strcmp(argv[arg], "-n"))
+        {
+            numTrials = (Uint32)strtoul(argv[++arg], NULL, 0);
+        }
+        else
+        {
+            break;
+        }
+    }
+    if ((arg < argc) || (ssSeed == 0))
+    {
+        usage(argv[0]);
+        return 1;
+    }
+    printf("seed %lu, %lu trials\n", (unsigned long)ssSeed, (unsigned long)numTrials);
+
+    numFails = 0;
+    for (form = IIR_SS_DF1; form <= IIR_SS_DF2; form++)
+    {
+        maxRatio[form] = 0;
+        for (t = 0; t < numTrials; t++)
+        {
+            numFails += ssTrial(form, &maxRatio[form]);
+        }
+        printf("%s vs %-12s max error/bound %.3f\n", "blkIirSs", (form == IIR_SS_DF1) ? "blkIirDf1" : "blkIirDf2",
+            maxRatio[form]);
+    }
+
+    /* Poles at +/-j (a1 = 0, a2 = 1) & double pole at z = 1 (a1 = -2, a2 = 1) */
+    numFails += ssCheckNoDecay(0, 1<<13, "poles at +/-j");
+    numFails += ssCheckNoDecay(-(2<<13), 1<<13, "double pole at z = 1");
+    printf("%s\n", (numFails == 0) ? "PASS" : "FAIL");
+
+    return (numFails == 0) ? 0 : 1;
+}
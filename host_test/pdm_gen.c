@@ -0,0 +1,536 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+#include <stdlib.h>
+#include <math.h>
+#include "data_types.h"
+#include "pdm_gen.h"
+
+#define PI                      ( 3.14159265358979323846 )
+#define PDM_GEN_NTF_GRID_LEN    ( 1024 )    /* frequencies evaluated for max |NTF| */
+#define PDM_GEN_NTF_ITERS       ( 60 )      /* cutoff bisection iterations */
+#define PDM_GEN_STATE_LIM       ( 1.0e3 )   /* state magnitude treated as unstable */
+
+/* Designs NTF for highpass cutoff wc. Returns max |NTF| on unit circle. */
+static Float64 pdmGenNtfDesign(
+    Uint16 order,           /* modulator order */
+    Float64 wc,             /* highpass cutoff (rad/sample) */
+    Float64 *b,             /* NTF numerator, order+1 coefficients */
+    Float64 *a              /* NTF denominator, order+1 coefficients */
+)
+{
+    Float64 aRe[PDM_GEN_MAX_ORDER+1];
+    Float64 aIm[PDM_GEN_MAX_ORDER+1];
+    Float64 wp, th;
+    Float64 sRe, sIm, d;
+    Float64 pRe, pIm;
+    Float64 nRe, nIm, dRe, dIm;
+    Float64 cw, sw, gain, maxGain;
+    Uint16 i, k;
+
+    /* Butterworth highpass poles, same as lowpass poles, zeros at DC, */
+    /* bilinear transform with prewarped cutoff */
+    wp = tan(wc/2.0);
+    for (k = 0; k <= order; k++)
+    {
+        aRe[k] = (k == 0) ? 1.0 : 0.0;
+        aIm[k] = 0.0;
+    }
+    for (k = 0; k < order; k++)
+    {
+        th = PI/2.0 + PI*(2*k + 1)/(2.0*order);
+        sRe = wp*cos(th);
+        sIm = wp*sin(th);
+
+        /* p = (1 + s)/(1 - s) */
+        d = (1.0 - sRe)*(1.0 - sRe) + sIm*sIm;
+        pRe = ((1.0 + sRe)*(1.0 - sRe) - sIm*sIm) / d;
+        pIm = ((1.0 + sRe)*sIm + sIm*(1.0 - sRe)) / d;
+
+        /* A(z) *= (1 - p z^-1) */
+        for (i = k+1; i > 0; i--)
+        {
+            aRe[i] -= pRe*aRe[i-1] - pIm*aIm[i-1];
+            aIm[i] -= pRe*aIm[i-1] + pIm*aRe[i-1];
+        }
+    }
+
+    /* B(z) = (1 - z^-1)^order, NTF monic so h[0] = 1 */
+    b[0] = 1.0;
+    for (k = 1; k <= order; k++)
+    {
+        b[k] = -b[k-1]*(order - k + 1)/k;
+    }
+    for (k = 0; k <= order; k++)
+    {
+        a[k] = aRe[k];
+    }
+
+    maxGain = 0.0;
+    for (i = 0; i <= PDM_GEN_NTF_GRID_LEN; i++)
+    {
+        nRe = nIm = dRe = dIm = 0.0;
+        for (k = 0; k <= order; k++)
+        {
+            cw = cos(PI*i*k/PDM_GEN_NTF_GRID_LEN);
+            sw = -sin(PI*i*k/PDM_GEN_NTF_GRID_LEN);
+            nRe += b[k]*cw;
+            nIm += b[k]*sw;
+            dRe += a[k]*cw;
+            dIm += a[k]*sw;
+        }
+        gain = sqrt((nRe*nRe + nIm*nIm) / (dRe*dRe + dIm*dIm));
+        if (gain > maxGain)
+        {
+            maxGain = gain;
+        }
+    }
+
+    return maxGain;
+}
+
+/* Fills modulator input for one word pair from tone or sweep phasors */
+static void pdmGenTone(
+    PdmGen *pGen            /* generator */
+)
+{
+    Uint16 numChans;
+    Float64 amp;
+    Float64 *x;
+    Float64 *toneRe, *toneIm, *rotRe, *rotIm;
+    Float64 re, mag;
+    Uint16 b, c;
+
+    numChans = pGen->cfg.numChans;
+    amp = pGen->cfg.amp;
+    toneRe = pGen->toneRe;
+    toneIm = pGen->toneIm;
+    rotRe = pGen->rotRe;
+    rotIm = pGen->rotIm;
+
+    for (b = 0; b < PDM_GEN_BITS_PER_WORD; b++)
+    {
+        x = &pGen->x[b*numChans];
+        for (c = 0; c < numChans; c++)
+        {
+            x[c] = amp*toneIm[c];
+            re = toneRe[c]*rotRe[c] - toneIm[c]*rotIm[c];
+            toneIm[c] = toneRe[c]*rotIm[c] + toneIm[c]*rotRe[c];
+            toneRe[c] = re;
+        }
+    }
+
+    /* Renormalize phasors, rounding error grows with rotations */
+    for (c = 0; c < numChans; c++)
+    {
+        mag = sqrt(toneRe[c]*toneRe[c] + toneIm[c]*toneIm[c]);
+        toneRe[c] /= mag;
+        toneIm[c] /= mag;
+    }
+}
+
+/* Sets phasor rotations for instantaneous sweep frequency, frequency constant over word pair */
+static void pdmGenSweepStep(
+    PdmGen *pGen            /* generator */
+)
+{
+    PdmGenCfg *pCfg;
+    Float64 f, t, w;
+    Uint16 c;
+
+    pCfg = &pGen->cfg;
+    t = pGen->sweepPos / pCfg->sweepSec;
+    if (pCfg->sweepLog)
+    {
+        f = pCfg->freq * pow(pCfg->freqEnd / pCfg->freq, t);
+    }
+    else
+    {
+        f = pCfg->freq + (pCfg->freqEnd - pCfg->freq)*t;
+    }
+
+    for (c = 0; c < pCfg->numChans; c++)
+    {
+        w = 2.0*PI*(f + c*pCfg->freqStep) / pCfg->pdmRate;
+        pGen->rotRe[c] = cos(w);
+        pGen->rotIm[c] = sin(w);
+    }
+
+    pGen->sweepPos += (Float64)PDM_GEN_BITS_PER_WORD / pCfg->pdmRate;
+    if (pGen->sweepPos >= pCfg->sweepSec)
+    {
+        pGen->sweepPos -= pCfg->sweepSec;
+    }
+}
+
+/* Fills modulator input for one word pair from xorshift32 noise */
+static void pdmGenNoise(
+    PdmGen *pGen            /* generator */
+)
+{
+    Uint16 numChans;
+    Float64 scale;
+    Float64 *x;
+    Uint32 *rnd;
+    Uint32 r;
+    Uint16 b, c;
+
+    numChans = pGen->cfg.numChans;
+    scale = pGen->cfg.amp / 2147483648.0;
+    rnd = pGen->rnd;
+
+    for (b = 0; b < PDM_GEN_BITS_PER_WORD; b++)
+    {
+        x = &pGen->x[b*numChans];
+        for (c = 0; c < numChans; c++)
+        {
+            r = rnd[c];
+            r ^= r << 13;
+            r ^= r >> 17;
+            r ^= r << 5;
+            rnd[c] = r;
+            x[c] = scale*(Int32)r;
+        }
+    }
+}
+
+/* Fills modulator input for one word pair from linearly interpolated PCM */
+static void pdmGenPcm(
+    PdmGen *pGen            /* generator */
+)
+{
+    PdmGenCfg *pCfg;
+    Uint16 numChans;
+    Float64 scale, step, frac;
+    const Int16 *s0;
+    const Int16 *s1;
+    Float64 *x;
+    Uint32 idx;
+    Uint16 b, c;
+
+    pCfg = &pGen->cfg;
+    numChans = pCfg->numChans;
+    scale = pCfg->amp / 32768.0;
+    step = (Float64)pCfg->pcmRate / pCfg->pdmRate;
+
+    for (b = 0; b < PDM_GEN_BITS_PER_WORD; b++)
+    {
+        /* PCM repeats at end */
+        idx = (Uint32)pGen->pcmPos;
+        frac = pGen->pcmPos - idx;
+        s0 = &pCfg->pcm[(Uint64)idx*numChans];
+        s1 = &pCfg->pcm[(Uint64)((idx + 1) % pCfg->pcmLen)*numChans];
+
+        x = &pGen->x[b*numChans];
+        for (c = 0; c < numChans; c++)
+        {
+            x[c] = scale*(s0[c] + frac*(s1[c] - s0[c]));
+        }
+
+        pGen->pcmPos += step;
+        if (pGen->pcmPos >= pCfg->pcmLen)
+        {
+            pGen->pcmPos -= pCfg->pcmLen;
+        }
+    }
+}
+
+/* Returns seed of channel, never 0 */
+static Uint32 pdmGenSeed(
+    Uint32 seed,            /* generator seed */
+    Uint16 chan             /* channel */
+)
+{
+    Uint32 z;
+
+    /* splitmix32 style mixing of seed & channel */
+    z = seed + 0x9E3779B9u*(chan + 1);
+    z = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+    z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+    z ^= z >> 16;
+
+    return (z != 0) ? z : 0x6D2B79F5u;
+}
+
+/* Fills configuration: 1.024 MHz PDM, 1 channel, 4th order, */
+/* 1 kHz tone at -26 dBFS. */
+void pdmGenCfgDefault(
+    PdmGenCfg *pCfg         /* generator configuration */
+)
+{
+    pCfg->pdmRate = 1024000;
+    pCfg->numChans = 1;
+    pCfg->order = 4;
+    pCfg->ntfGain = 1.5;
+    pCfg->srcType = PDM_GEN_SRC_TONE;
+    pCfg->amp = 0.05;
+    pCfg->freq = 1000.0;
+    pCfg->freqStep = 0.0;
+    pCfg->freqEnd = 8000.0;
+    pCfg->sweepSec = 1.0;
+    pCfg->sweepLog = 1;
+    pCfg->seed = 1;
+    pCfg->pcm = NULL;
+    pCfg->pcmLen = 0;
+    pCfg->pcmRate = 16000;
+}
+
+/* Designs NTF & allocates generator state. */
+Int16 pdmGenInit(
+    PdmGen *pGen,           /* generator */
+    const PdmGenCfg *pCfg   /* generator configuration */
+)
+{
+    Uint16 numChans;
+    Uint16 order;
+    Float64 lo, hi, wc;
+    Float64 w;
+    Uint16 c, i;
+
+    numChans = pCfg->numChans;
+    order = pCfg->order;
+    if ((pCfg->pdmRate == 0) || (numChans == 0) || (numChans > PDM_GEN_MAX_CHANS) ||
+        (order < 1) || (order > PDM_GEN_MAX_ORDER) || (pCfg->srcType > PDM_GEN_SRC_PCM) ||
+        ((pCfg->srcType == PDM_GEN_SRC_SWEEP) && ((pCfg->sweepSec <= 0.0) || (pCfg->freq <= 0.0) || (pCfg->freqEnd <= 0.0))) ||
+        ((pCfg->srcType == PDM_GEN_SRC_PCM) && ((pCfg->pcm == NULL) || (pCfg->pcmLen == 0) || (pCfg->pcmRate == 0))))
+    {
+        return PDM_GEN_ERR_CFG;
+    }
+
+    pGen->cfg = *pCfg;
+    pGen->state = NULL;
+    pGen->x = NULL;
+    pGen->err = NULL;
+    pGen->fbOut = NULL;
+    pGen->toneRe = NULL;
+    pGen->toneIm = NULL;
+    pGen->rotRe = NULL;
+    pGen->rotIm = NULL;
+    pGen->rnd = NULL;
+    pGen->word = NULL;
+
+    /* Max |NTF| grows with cutoff, bisect cutoff for target gain */
+    lo = 1.0e-6;
+    hi = PI*0.999;
+    if ((pCfg->ntfGain <= pdmGenNtfDesign(order, lo, pGen->ntfB, pGen->ntfA)) ||
+        (pCfg->ntfGain >= pdmGenNtfDesign(order, hi, pGen->ntfB, pGen->ntfA)))
+    {
+        return PDM_GEN_ERR_NTF;
+    }
+    for (i = 0; i < PDM_GEN_NTF_ITERS; i++)
+    {
+        wc = 0.5*(lo + hi);
+        if (pdmGenNtfDesign(order, wc, pGen->ntfB, pGen->ntfA) > pCfg->ntfGain)
+        {
+            hi = wc;
+        }
+        else
+        {
+            lo = wc;
+        }
+    }
+    pGen->cutoff = lo;
+    pdmGenNtfDesign(order, lo, pGen->ntfB, pGen->ntfA);
+
+    pGen->state = (Float64 *)calloc((size_t)order*numChans, sizeof(Float64));
+    pGen->x = (Float64 *)calloc((size_t)PDM_GEN_BITS_PER_WORD*numChans, sizeof(Float64));
+    pGen->err = (Float64 *)calloc(numChans, sizeof(Float64));
+    pGen->fbOut = (Float64 *)calloc(numChans, sizeof(Float64));
+    pGen->toneRe = (Float64 *)calloc(numChans, sizeof(Float64));
+    pGen->toneIm = (Float64 *)calloc(numChans, sizeof(Float64));
+    pGen->rotRe = (Float64 *)calloc(numChans, sizeof(Float64));
+    pGen->rotIm = (Float64 *)calloc(numChans, sizeof(Float64));
+    pGen->rnd = (Uint32 *)calloc(numChans, sizeof(Uint32));
+    pGen->word = (Uint32 *)calloc(numChans, sizeof(Uint32));
+    if ((pGen->state == NULL) || (pGen->x == NULL) || (pGen->err == NULL) || (pGen->fbOut == NULL) ||
+        (pGen->toneRe == NULL) || (pGen->toneIm == NULL) || (pGen->rotRe == NULL) ||
+        (pGen->rotIm == NULL) || (pGen->rnd == NULL) || (pGen->word == NULL))
+    {
+        pdmGenFree(pGen);
+        return PDM_GEN_ERR_MEM;
+    }
+
+    for (c = 0; c < numChans; c++)
+    {
+        w = 2.0*PI*(pCfg->freq + c*pCfg->freqStep) / pCfg->pdmRate;
+        pGen->toneRe[c] = 1.0;
+        pGen->toneIm[c] = 0.0;
+        pGen->rotRe[c] = cos(w);
+        pGen->rotIm[c] = sin(w);
+        pGen->rnd[c] = pdmGenSeed(pCfg->seed, c);
+    }
+    pGen->sweepPos = 0.0;
+    pGen->pcmPos = 0.0;
+    pGen->numSamps = 0;
+    pGen->numResets = 0;
+
+    return PDM_GEN_OK;
+}
+
+/* Generates numWords "left" & "right" word pairs per channel. */
+void pdmGenProcess(
+    PdmGen *pGen,           /* generator */
+    Uint32 **lData,         /* "left" channel 32-bit packed data per channel */
+    Uint32 **rData,         /* "right" channel 32-bit packed data per channel */
+    Uint32 numWords         /* number of word pairs per channel */
+)
+{
+    Uint16 numChans;
+    Uint16 order;
+    Float64 ck, ak;
+    Float64 *x;
+    Float64 *s0;
+    Float64 *sk;
+    Float64 *err;
+    Float64 *fbOut;
+    Uint32 *word;
+    Float64 u, y;
+    Uint32 w;
+    Uint16 b, c, k;
+
+    numChans = pGen->cfg.numChans;
+    order = pGen->cfg.order;
+    s0 = pGen->state;
+    err = pGen->err;
+    fbOut = pGen->fbOut;
+    word = pGen->word;
+
+    for (w = 0; w < numWords; w++)
+    {
+        switch (pGen->cfg.srcType)
+        {
+        case PDM_GEN_SRC_NOISE:
+            pdmGenNoise(pGen);
+            break;
+        case PDM_GEN_SRC_SWEEP:
+            pdmGenSweepStep(pGen);
+            pdmGenTone(pGen);
+            break;
+        case PDM_GEN_SRC_PCM:
+            pdmGenPcm(pGen);
+            break;
+        default:
+            pdmGenTone(pGen);
+            break;
+        }
+
+        for (b = 0; b < PDM_GEN_BITS_PER_WORD; b++)
+        {
+            /* Quantize: y = x + NTF*e, error fed back through NTF-1 */
+            x = &pGen->x[b*numChans];
+            for (c = 0; c < numChans; c++)
+            {
+                u = x[c] + s0[c];
+                y = (u >= 0.0) ? 1.0 : -1.0;
+                err[c] = y - u;
+                fbOut[c] = s0[c];
+                word[c] = (word[c] << 1) | (u >= 0.0);
+            }
+
+            /* Error feedback filter (B-A)/A, transposed direct form II, state row per order */
+            for (k = 1; k <= order; k++)
+            {
+                ck = pGen->ntfB[k] - pGen->ntfA[k];
+                ak = pGen->ntfA[k];
+                sk = &pGen->state[(k-1)*numChans];
+                if (k < order)
+                {
+                    for (c = 0; c < numChans; c++)
+                    {
+                        sk[c] = sk[c + numChans] + ck*err[c] - ak*fbOut[c];
+                    }
+                }
+                else
+                {
+                    for (c = 0; c < numChans; c++)
+                    {
+                        sk[c] = ck*err[c] - ak*fbOut[c];
+                    }
+                }
+            }
+
+            if (b == 31)
+            {
+                for (c = 0; c < numChans; c++)
+                {
+                    lData[c][w] = word[c];
+                }
+            }
+        }
+        for (c = 0; c < numChans; c++)
+        {
+            rData[c][w] = word[c];
+        }
+
+        /* Reset overloaded modulators */
+        for (c = 0; c < numChans; c++)
+        {
+            if (fabs(s0[c]) > PDM_GEN_STATE_LIM)
+            {
+                for (k = 0; k < order; k++)
+                {
+                    pGen->state[k*numChans + c] = 0.0;
+                }
+                pGen->numResets++;
+            }
+        }
+    }
+
+    pGen->numSamps += (Uint64)numWords*PDM_GEN_BITS_PER_WORD;
+}
+
+/* Frees generator state. */
+void pdmGenFree(
+    PdmGen *pGen            /* generator */
+)
+{
+    free(pGen->state);
+    free(pGen->x);
+    free(pGen->err);
+    free(pGen->fbOut);
+    free(pGen->toneRe);
+    free(pGen->toneIm);
+    free(pGen->rotRe);
+    free(pGen->rotIm);
+    free(pGen->rnd);
+    free(pGen->word);
+    pGen->state = NULL;
+    pGen->x = NULL;
+    pGen->err = NULL;
+    pGen->fbOut = NULL;
+    pGen->toneRe = NULL;
+    pGen->toneIm = NULL;
+    pGen->rotRe = NULL;
+    pGen->rotIm = NULL;
+    pGen->rnd = NULL;
+    pGen->word = NULL;
+}
@@ -0,0 +1,129 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+#ifndef __PDM_GEN_H__
+#define __PDM_GEN_H__
+
+#include "data_types.h"
+
+/* Sigma-delta PDM stimulus generator. Host only. */
+/* 1-bit error feedback modulator, order 1 to 5, noise transfer function */
+/* NTF(z) = (1-z^-1)^N / A(z), A from Butterworth highpass with cutoff */
+/* chosen so max |NTF| equals configured gain (1.5 by default, Lee's rule). */
+/* Channels kept in SoA layout so per sample loops vectorize across channels. */
+/* Bits packed as pickBitsCic expects: per word pair, 32 bits MS bit first */
+/* in "left" word, then 32 bits MS bit first in "right" word. */
+
+#define PDM_GEN_MAX_ORDER       ( 5 )       /* maximum modulator order */
+#define PDM_GEN_MAX_CHANS       ( 1024 )    /* maximum number of channels */
+#define PDM_GEN_BITS_PER_WORD   ( 64 )      /* PDM bits in one "left" & "right" 32-bit word pair */
+
+#define PDM_GEN_SRC_TONE        ( 0 )   /* sine tone */
+#define PDM_GEN_SRC_NOISE       ( 1 )   /* uniform white noise */
+#define PDM_GEN_SRC_SWEEP       ( 2 )   /* sine sweep */
+#define PDM_GEN_SRC_PCM         ( 3 )   /* 16-bit PCM, linearly interpolated */
+
+#define PDM_GEN_OK              ( 0 )   /* success */
+#define PDM_GEN_ERR_CFG         ( -1 )  /* invalid configuration */
+#define PDM_GEN_ERR_NTF         ( -2 )  /* NTF design failed */
+#define PDM_GEN_ERR_MEM         ( -3 )  /* allocation failed */
+
+/* Generator configuration */
+typedef struct
+{
+    Uint32 pdmRate;         /* PDM bit rate (Hz) */
+    Uint16 numChans;        /* number of channels */
+    Uint16 order;           /* modulator order, 1 to PDM_GEN_MAX_ORDER */
+    Float64 ntfGain;        /* max |NTF|, 1.5 typical */
+    Uint16 srcType;         /* PDM_GEN_SRC_xxx */
+    Float64 amp;            /* signal amplitude, full scale 1.0 */
+    Float64 freq;           /* tone frequency, sweep start frequency (Hz) */
+    Float64 freqStep;       /* frequency increment per channel (Hz) */
+    Float64 freqEnd;        /* sweep end frequency (Hz) */
+    Float64 sweepSec;       /* sweep duration (s), sweep repeats */
+    Uint16 sweepLog;        /* 1 for logarithmic sweep */
+    Uint32 seed;            /* noise & dither seed */
+    const Int16 *pcm;       /* PCM samples, numChans interleaved */
+    Uint32 pcmLen;          /* number of PCM samples per channel */
+    Uint32 pcmRate;         /* PCM sample rate (Hz) */
+} PdmGenCfg;
+
+/* Generator */
+typedef struct
+{
+    PdmGenCfg cfg;          /* configuration */
+    Float64 ntfB[PDM_GEN_MAX_ORDER+1];  /* NTF numerator */
+    Float64 ntfA[PDM_GEN_MAX_ORDER+1];  /* NTF denominator */
+    Float64 cutoff;         /* NTF highpass cutoff (rad/sample) */
+    Float64 *state;         /* error feedback filter state [order][numChans] */
+    Float64 *x;             /* modulator input [PDM_GEN_BITS_PER_WORD][numChans] */
+    Float64 *err;           /* quantization error [numChans] */
+    Float64 *fbOut;         /* error feedback filter output [numChans] */
+    Float64 *toneRe;        /* tone phasor [numChans] */
+    Float64 *toneIm;
+    Float64 *rotRe;         /* tone phasor rotation per sample [numChans] */
+    Float64 *rotIm;
+    Uint32 *rnd;            /* xorshift32 state [numChans] */
+    Uint32 *word;           /* packed bits [numChans] */
+    Float64 sweepPos;       /* sweep position (s) */
+    Float64 pcmPos;         /* PCM position (samples) */
+    Uint64 numSamps;        /* number of PDM samples generated per channel */
+    Uint32 numResets;       /* number of modulator resets on instability */
+} PdmGen;
+
+/* Fills configuration: 1.024 MHz PDM, 1 channel, 4th order, */
+/* 1 kHz tone at -26 dBFS. */
+void pdmGenCfgDefault(
+    PdmGenCfg *pCfg         /* generator configuration */
+);
+
+/* Designs NTF & allocates generator state. */
+Int16 pdmGenInit(
+    PdmGen *pGen,           /* generator */
+    const PdmGenCfg *pCfg   /* generator configuration */
+);
+
+/* Generates numWords "left" & "right" word pairs per channel. */
+/* Channel c written to lData[c][0..numWords-1] & rData[c][0..numWords-1]. */
+void pdmGenProcess(
+    PdmGen *pGen,           /* generator */
+    Uint32 **lData,         /* "left" channel 32-bit packed data per channel */
+    Uint32 **rData,         /* "right" channel 32-bit packed data per channel */
+    Uint32 numWords         /* number of word pairs per channel */
+);
+
+/* Frees generator state. */
+void pdmGenFree(
+    PdmGen *pGen            /* generator */
+);
+
+#endif /* __PDM_GEN_H__ */
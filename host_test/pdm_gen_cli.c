@@ -0,0 +1,308 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "data_types.h"
+#include "pdm_gen.h"
+
+/* PDM stimulus generator command line. */
+/* Output: raw 32-bit words, per word pair index, per channel, "left" then "right" word. */
+/* One channel output is read by i2s_dma_sim file source. */
+/* Usage: pdm_gen -o outFile [-c numChans] [-r pdmRate] [-d seconds | -w numWordPairs] */
+/*                [-m order] [-g ntfGain] [-s tone|noise|sweep|pcm] [-a amp] [-f freq] */
+/*                [-k freqStep] [-F freqEnd] [-T sweepSec] [-L] [-S seed] [-p pcmFile] [-R pcmRate] */
+
+#define BLK_LEN     ( 1024 )    /* word pairs per channel per block */
+
+static void usage(const char *name)
+{
+    fprintf(stderr, "Usage: %s -o outFile [-c numChans] [-r pdmRate] [-d seconds | -w numWordPairs]\n"
+        "    [-m order] [-g ntfGain] [-s tone|noise|sweep|pcm] [-a amp] [-f freq]\n"
+        "    [-k freqStep] [-F freqEnd] [-T sweepSec] [-L] [-S seed] [-p pcmFile] [-R pcmRate]\n", name);
+}
+
+/* Reads raw 16-bit PCM file. Returns number of samples per channel, 0 on error. */
+static Uint32 readPcm(
+    const char *fileName,   /* PCM file name */
+    Uint16 numChans,        /* number of interleaved channels */
+    Int16 **pPcm            /* allocated PCM samples */
+)
+{
+    FILE *fp;
+    long len;
+    Uint32 pcmLen;
+
+    fp = fopen(fileName, "rb");
+    if (fp == NULL)
+    {
+        return 0;
+    }
+    fseek(fp, 0, SEEK_END);
+    len = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+
+    pcmLen = (len > 0) ? (Uint32)(len / sizeof(Int16) / numChans) : 0;
+    *pPcm = (pcmLen > 0) ? (Int16 *)malloc((size_t)pcmLen*numChans*sizeof(Int16)) : NULL;
+    if ((*pPcm == NULL) || (fread(*pPcm, sizeof(Int16)*numChans, pcmLen, fp) != pcmLen))
+    {
+        pcmLen = 0;
+    }
+    fclose(fp);
+
+    return pcmLen;
+}
+
+int main(int argc, char **argv)
+{
+    static PdmGen gen;
+    PdmGenCfg cfg;
+    const char *outFileName;
+    const char *pcmFileName;
+    Float64 seconds;
+    Uint64 numWords;
+    Uint64 w;
+    Uint32 blkLen;
+    Int16 *pcm;
+    Uint32 **lData;
+    Uint32 **rData;
+    Uint32 *outBuf;
+    FILE *fp;
+    Uint16 ampSet;
+    Uint16 c;
+    Uint32 i;
+    int arg;
+
+    pdmGenCfgDefault(&cfg);
+    outFileName = NULL;
+    pcmFileName = NULL;
+    seconds = 1.0;
+    numWords = 0;
+    ampSet = 0;
+
+    for (arg = 1; arg < argc; arg++)
+    {
+        if (!strcmp(argv[arg], "-L"))
+        {
+            cfg.sweepLog = 0;
+            continue;
+        }
+        if (arg+1 >= argc)
+        {
+            break;
+        }
+        if (!strcmp(argv[arg], "-o"))
+        {
+            outFileName = argv[++arg];
+        }
+        else if (!strcmp(argv[arg], "-c"))
+        {
+            cfg.numChans = (Uint16)atoi(argv[++arg]);
+        }
+        else if (!strcmp(argv[arg], "-r"))
+        {
+            cfg.pdmRate = (Uint32)strtoul(argv[++arg], NULL, 0);
+        }
+        else if (!strcmp(argv[arg], "-d"))
+        {
+            seconds = atof(argv[++arg]);
+        }
+        else if (!strcmp(argv[arg], "-w"))
+        {
+            numWords = strtoull(argv[++arg], NULL, 0);
+        }
+        else if (!strcmp(argv[arg], "-m"))
+        {
+            cfg.order = (Uint16)atoi(argv[++arg]);
+        }
+        else if (!strcmp(argv[arg], "-g"))
+        {
+            cfg.ntfGain = atof(argv[++arg]);
+        }
+        else if (!strcmp(argv[arg], "-s"))
+        {
+            arg++;
+            if (!strcmp(argv[arg], "tone"))
+            {
+                cfg.srcType = PDM_GEN_SRC_TONE;
+            }
+            else if (!strcmp(argv[arg], "noise"))
+            {
+                cfg.srcType = PDM_GEN_SRC_NOISE;
+            }
+            else if (!strcmp(argv[arg], "sweep"))
+            {
+                cfg.srcType = PDM_GEN_SRC_SWEEP;
+            }
+            else if (!strcmp(argv[arg], "pcm"))
+            {
+                cfg.srcType = PDM_GEN_SRC_PCM;
+            }
+            else
+            {
+                break;
+            }
+        }
+        else if (!strcmp(argv[arg], "-a"))
+        {
+            cfg.amp = atof(argv[++arg]);
+            ampSet = 1;
+        }
+        else if (!strcmp(argv[arg], "-f"))
+        {
+            cfg.freq = atof(argv[++arg]);
+        }
+        else if (!strcmp(argv[arg], "-k"))
+        {
+            cfg.freqStep = atof(argv[++arg]);
+        }
+        else if (!strcmp(argv[arg], "-F"))
+        {
+            cfg.freqEnd = atof(argv[++arg]);
+        }
+        else if (!strcmp(argv[arg], "-T"))
+        {
+            cfg.sweepSec = atof(argv[++arg]);
+        }
+        else if (!strcmp(argv[arg], "-S"))
+        {
+            cfg.seed = (Uint32)strtoul(argv[++arg], NULL, 0);
+        }
+        else if (!strcmp(argv[arg], "-p"))
+        {
+            pcmFileName = argv[++arg];
+        }
+        else if (!strcmp(argv[arg], "-R"))
+        {
+            cfg.pcmRate = (Uint32)strtoul(argv[++arg], NULL, 0);
+        }
+        else
+        {
+            break;
+        }
+    }
+    if ((arg < argc) || (outFileName == NULL) || (cfg.numChans == 0))
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    /* PCM played at recorded level unless amplitude given */
+    pcm = NULL;
+    if (cfg.srcType == PDM_GEN_SRC_PCM)
+    {
+        if (pcmFileName == NULL)
+        {
+            usage(argv[0]);
+            return 1;
+        }
+        cfg.pcmLen = readPcm(pcmFileName, cfg.numChans, &pcm);
+        cfg.pcm = pcm;
+        if (!ampSet)
+        {
+            cfg.amp = 1.0;
+        }
+    }
+
+    if (pdmGenInit(&gen, &cfg) != PDM_GEN_OK)
+    {
+        fprintf(stderr, "ERROR: Unable to initialize PDM generator\n");
+        return 1;
+    }
+
+    if (numWords == 0)
+    {
+        numWords = (Uint64)(seconds*cfg.pdmRate/PDM_GEN_BITS_PER_WORD + 0.5);
+    }
+
+    fp = strcmp(outFileName, "-") ? fopen(outFileName, "wb") : stdout;
+    lData = (Uint32 **)malloc(cfg.numChans*sizeof(Uint32 *));
+    rData = (Uint32 **)malloc(cfg.numChans*sizeof(Uint32 *));
+    outBuf = (Uint32 *)malloc((size_t)2*BLK_LEN*cfg.numChans*sizeof(Uint32));
+    if ((fp == NULL) || (lData == NULL) || (rData == NULL) || (outBuf == NULL))
+    {
+        fprintf(stderr, "ERROR: Unable to open %s\n", outFileName);
+        return 1;
+    }
+    for (c = 0; c < cfg.numChans; c++)
+    {
+        lData[c] = (Uint32 *)malloc(BLK_LEN*sizeof(Uint32));
+        rData[c] = (Uint32 *)malloc(BLK_LEN*sizeof(Uint32));
+        if ((lData[c] == NULL) || (rData[c] == NULL))
+        {
+            fprintf(stderr, "ERROR: Out of memory\n");
+            return 1;
+        }
+    }
+
+    /* Generate & write block by block, output size not limited by memory */
+    for (w = 0; w < numWords; w += blkLen)
+    {
+        blkLen = (numWords - w < BLK_LEN) ? (Uint32)(numWords - w) : BLK_LEN;
+        pdmGenProcess(&gen, lData, rData, blkLen);
+
+        for (i = 0; i < blkLen; i++)
+        {
+            for (c = 0; c < cfg.numChans; c++)
+            {
+                outBuf[2*(i*cfg.numChans + c)] = lData[c][i];
+                outBuf[2*(i*cfg.numChans + c) + 1] = rData[c][i];
+            }
+        }
+        if (fwrite(outBuf, 2*sizeof(Uint32)*cfg.numChans, blkLen, fp) != blkLen)
+        {
+            fprintf(stderr, "ERROR: Write failed\n");
+            return 1;
+        }
+    }
+
+    if (fp != stdout)
+    {
+        fclose(fp);
+    }
+    fprintf(stderr, "%llu word pairs x %u channels, order %u, NTF cutoff %.4f rad, %u modulator resets\n",
+        (unsigned long long)numWords, cfg.numChans, cfg.order, gen.cutoff, gen.numResets);
+
+    for (c = 0; c < cfg.numChans; c++)
+    {
+        free(lData[c]);
+        free(rData[c]);
+    }
+    free(lData);
+    free(rData);
+    free(outBuf);
+    free(pcm);
+    pdmGenFree(&gen);
+
+    return 0;
+}
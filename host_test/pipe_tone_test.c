@@ -0,0 +1,258 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "data_types.h"
+#include "decim_pipe.h"
+#include "pdm_gen.h"
+
+/* Decimation pipeline tone test. */
+/* Feeds pdmGen sigma-delta tone of each modulator order through decimPipeProcess() */
+/* with IdleLoop chain configuration, tone on random DFT bin of 1 to 6 kHz. */
+/* After TONE_SETTLE_FRAMES frames, Hann-windowed TONE_DFT_LEN-point spectrum */
+/* of output must peak at tone bin, & signal to noise plus distortion ratio */
+/* (tone bins vs all others except DC) must reach toneMinSnr[order-1]. */
+/* Exits with 0 if all checks pass, 1 otherwise. */
+/* Usage: pipe_tone_test [-s seed] [-n numTrials] */
+
+#define TONE_PDM_RATE       ( 1024000 ) /* PDM bit rate (Hz) */
+#define TONE_OUT_RATE       ( 16000 )   /* pipeline output rate (Hz) */
+#define TONE_DFT_LEN        ( 4096 )    /* output samples analysed */
+#define TONE_SETTLE_FRAMES  ( 4 )       /* frames dropped while filters settle */
+#define TONE_AMP            ( 0.05 )    /* tone amplitude, -26 dBFS, -6 dBFS after 20 dB gain */
+#define TONE_MIN_HZ         ( 1000.0 )  /* lowest tone frequency (Hz) */
+#define TONE_MAX_HZ         ( 6000.0 )  /* highest tone frequency (Hz) */
+#define TONE_SIG_BINS       ( 2 )       /* Hann main lobe half width (bins) */
+#define TONE_DC_BINS        ( 2 )       /* bins around DC excluded from noise */
+
+/* Minimum SNR (dB) per modulator order, about 3 dB below lowest of 360 trials. */
+static const Float64 toneMinSnr[PDM_GEN_MAX_ORDER] = { 15.0, 42.0, 58.0, 68.0, 71.0 };
+
+static Int16 toneOut[TONE_DFT_LEN + DECIM_PIPE_MAX_OUT_LEN];    /* pipeline output */
+static Float64 tonePow[TONE_DFT_LEN/2+1];   /* power spectrum */
+static DecimPipe tonePipe;
+static Uint32 toneSeed;
+
+/* xorshift32 */
+static Uint32 toneRand(void)
+{
+    Uint32 x = toneSeed;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    toneSeed = x;
+
+    return x;
+}
+
+/* Hann-windowed power spectrum of toneOut[0..TONE_DFT_LEN-1], Goertzel per bin */
+static void toneSpectrum(void)
+{
+    const Float64 pi = 3.14159265358979323846;
+    Float64 win[TONE_DFT_LEN];
+    Float64 coef, s0, s1, s2;
+    Uint16 i, k;
+
+    for (i = 0; i < TONE_DFT_LEN; i++)
+    {
+        win[i] = (0.5 - 0.5*cos(2.0*pi*i/TONE_DFT_LEN)) * toneOut[i];
+    }
+    for (k = 0; k <= TONE_DFT_LEN/2; k++)
+    {
+        coef = 2.0*cos(2.0*pi*k/TONE_DFT_LEN);
+        s1 = 0;
+        s2 = 0;
+        for (i = 0; i < TONE_DFT_LEN; i++)
+        {
+            s0 = win[i] + coef*s1 - s2;
+            s2 = s1;
+            s1 = s0;
+        }
+        tonePow[k] = s1*s1 + s2*s2 - coef*s1*s2;
+    }
+}
+
+/* Runs tone of one modulator order through pipeline. */
+/* Returns 0 if spectrum peaks at tone bin with SNR at least toneMinSnr, 1 otherwise. */
+static Uint16 toneTrial(
+    Uint16 order,           /* modulator order */
+    Float64 *pMinSnr        /* in/out: lowest SNR seen (dB) */
+)
+{
+    PdmGenCfg genCfg;
+    PdmGen gen;
+    DecimPipeCfg pipeCfg;
+    Uint32 lData[DECIM_PIPE_MAX_OUT_LEN];
+    Uint32 rData[DECIM_PIPE_MAX_OUT_LEN];
+    Uint32 *pL, *pR;
+    Uint16 numOut;
+    Uint16 toneBin, peakBin;
+    Float64 sigPow, noisePow;
+    Float64 snr;
+    Uint32 numSamps;
+    Uint16 f, k;
+
+    toneBin = (Uint16)(TONE_MIN_HZ*TONE_DFT_LEN/TONE_OUT_RATE) +
+        (Uint16)(toneRand() % (Uint32)((TONE_MAX_HZ - TONE_MIN_HZ)*TONE_DFT_LEN/TONE_OUT_RATE + 1));
+
+    pdmGenCfgDefault(&genCfg);
+    genCfg.pdmRate = TONE_PDM_RATE;
+    genCfg.order = order;
+    genCfg.amp = TONE_AMP;
+    genCfg.freq = (Float64)toneBin*TONE_OUT_RATE/TONE_DFT_LEN;
+    genCfg.seed = toneRand();
+    if (pdmGenInit(&gen, &genCfg) != PDM_GEN_OK)
+    {
+        printf("order %u: pdmGenInit() failed\n", order);
+        return 1;
+    }
+
+    decimPipeCfgDefault(&pipeCfg);
+    pipeCfg.pdmRate = TONE_PDM_RATE;
+    if (decimPipeInit(&tonePipe, &pipeCfg) != DECIM_PIPE_OK)
+    {
+        printf("order %u: decimPipeInit() failed\n", order);
+        pdmGenFree(&gen);
+        return 1;
+    }
+
+    pL = lData;
+    pR = rData;
+    numSamps = 0;
+    for (f = 0; numSamps < TONE_DFT_LEN; f++)
+    {
+        pdmGenProcess(&gen, &pL, &pR, pipeCfg.inFrameLen);
+        decimPipeProcess(&tonePipe, lData, rData, &toneOut[numSamps], &numOut);
+        if (f >= TONE_SETTLE_FRAMES)
+        {
+            numSamps += numOut;
+        }
+    }
+    pdmGenFree(&gen);
+
+    toneSpectrum();
+    peakBin = TONE_DC_BINS+1;
+    sigPow = 0;
+    noisePow = 0;
+    for (k = TONE_DC_BINS+1; k <= TONE_DFT_LEN/2; k++)
+    {
+        if (tonePow[k] > tonePow[peakBin])
+        {
+            peakBin = k;
+        }
+        if ((k + TONE_SIG_BINS >= toneBin) && (k <= toneBin + TONE_SIG_BINS))
+        {
+            sigPow += tonePow[k];
+        }
+        else
+        {
+            noisePow += tonePow[k];
+        }
+    }
+    snr = 10.0*log10(sigPow / ((noisePow > 0) ? noisePow : 1e-30));
+    if (snr < *pMinSnr)
+    {
+        *pMinSnr = snr;
+    }
+
+    if (peakBin != toneBin)
+    {
+        printf("order %u: %.1f Hz tone, spectrum peak at %.1f Hz\n", order,
+            genCfg.freq, (Float64)peakBin*TONE_OUT_RATE/TONE_DFT_LEN);
+        return 1;
+    }
+    if (snr < toneMinSnr[order-1])
+    {
+        printf("order %u: %.1f Hz tone, SNR %.1f dB < %.1f dB\n", order, genCfg.freq, snr, toneMinSnr[order-1]);
+        return 1;
+    }
+
+    return 0;
+}
+
+static void usage(const char *name)
+{
+    fprintf(stderr, "Usage: %s [-s seed] [-n numTrials]\n", name);
+}
+
+int main(int argc, char **argv)
+{
+    Uint32 numTrials;
+    Uint32 numFails;
+    Float64 minSnr;
+    Uint32 t;
+    Uint16 order;
+    int arg;
+
+    toneSeed = 1;
+    numTrials = 8;
+
+    for (arg = 1; arg+1 < argc; arg++)
+    {
+        if (!strcmp(argv[arg], "-s"))
+        {
+            toneSeed = (Uint32)strtoul(argv[++arg], NULL, 0);
+        }
+        else if (!strcmp(argv[arg], "-n"))
+        {
+            numTrials = (Uint32)strtoul(argv[++arg], NULL, 0);
+        }
+        else
+        {
+            break;
+        }
+    }
+    if ((arg < argc) || (toneSeed == 0))
+    {
+        usage(argv[0]);
+        return 1;
+    }
+    printf("seed %lu, %lu trials\n", (unsigned long)toneSeed, (unsigned long)numTrials);
+
+    numFails = 0;
+    for (order = 1; order <= PDM_GEN_MAX_ORDER; order++)
+    {
+        minSnr = 1e9;
+        for (t = 0; t < numTrials; t++)
+        {
+            numFails += toneTrial(order, &minSnr);
+        }
+        printf("order %u: min SNR %.1f dB, limit %.1f dB\n", order, minSnr, toneMinSnr[order-1]);
+    }
+    printf("%s\n", (numFails == 0) ? "PASS" : "FAIL");
+
+    return (numFails == 0) ? 0 : 1;
+}
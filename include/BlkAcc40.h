@@ -0,0 +1,54 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+#ifndef __BLK_ACC40_H__
+#define __BLK_ACC40_H__
+
+#include "data_types.h"
+
+/* Host build: 1 wraps accumulators to 40 bits as C55x Int40, */
+/* 0 keeps 64-bit accumulators. */
+/* Wrap is applied after rounding, as rounding constant is added in accumulator. */
+/* May be set from build, e.g. -DACC_WRAP_40B=1. */
+#ifndef ACC_WRAP_40B
+#define ACC_WRAP_40B        ( 0 )
+#endif
+
+#if defined(__TMS320C55X__)
+#define ACC40(acc)          ( acc )     /* Int64 accumulator is 40 bits on target */
+#elif (ACC_WRAP_40B == 1)
+#define ACC40(acc)          ( (Int64)((Uint64)(acc) << 24) >> 24 )
+#else
+#define ACC40(acc)          ( acc )
+#endif
+
+#endif /* __BLK_ACC40_H__ */
@@ -0,0 +1,148 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+#ifndef __BLK_FIR_CASCADE_H__
+#define __BLK_FIR_CASCADE_H__
+
+#include "data_types.h"
+#include "diggain.h"
+#include "decim_prof.h"
+
+#define BLK_FIR_CASC_MAX_STAGES     ( 4 )   /* maximum number of FIR stages */
+#define BLK_FIR_CASC_MAX_TILE_LEN   ( 128 ) /* maximum number of input samples per tile */
+
+#define BLK_FIR_CASC_OK             ( 0 )   /* success */
+#define BLK_FIR_CASC_ERR_NS         ( -1 )  /* invalid number of stages or stage index */
+#define BLK_FIR_CASC_ERR_TILE       ( -2 )  /* invalid tile length */
+#define BLK_FIR_CASC_ERR_LEN        ( -3 )  /* invalid number of input samples */
+
+/* Decimate-by-2 FIR kernel, same calling convention as blkFirDecim2() */
+typedef void (*BlkFirDecim2Fxn)(
+    Int32   *inSamps,       /* input samples (S18Q16) */
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Int32   *outSamps,      /* output samples (S18Q16) */
+    Int32   *dlyBuf,        /* delay buffer */
+    Uint16  numInSamps,     /* number of input samples */
+    Uint16  numCoefs        /* number of coefficients */
+);
+
+/* Decimate-by-2 FIR kernel with digital gain, same calling convention as blkFirDecim2Gain() */
+typedef void (*BlkFirDecim2GainFxn)(
+    Int32   *inSamps,       /* input samples (S18Q16) */
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Int16   *outSamps,      /* output samples (S16Q15) */
+    Int32   *dlyBuf,        /* delay buffer */
+    Uint16  diggain,        /* digital gain (U16Q8) */
+    Uint16  numInSamps,     /* number of input samples */
+    Uint16  numCoefs        /* number of coefficients */
+);
+
+/* FIR stage */
+typedef struct
+{
+    Int16 *coefs;           /* filter coefficients (S16Q15) */
+    Uint16 numCoefs;        /* number of coefficients */
+    Int32 *dlyBuf;          /* delay buffer, layout as required by kernel */
+    BlkFirDecim2Fxn kernel; /* stage kernel */
+} BlkFirStage;
+
+/* FIR cascade */
+typedef struct
+{
+    BlkFirStage stage[BLK_FIR_CASC_MAX_STAGES];
+    Uint16 numStages;       /* number of stages */
+    Uint16 tileLen;         /* number of 1st stage input samples per tile */
+    Uint16 diggain;         /* digital gain of output epilogue (U16Q8) */
+    DiggainFxn gainKernel;  /* digital gain kernel of output epilogue */
+    DecimProf *pProf;       /* stage profiling state, NULL if not profiled */
+    Int32 tileBuf[2][BLK_FIR_CASC_MAX_TILE_LEN/2]; /* inter-stage ping-pong tile buffers */
+} BlkFirCascade;
+
+/* Initializes cascade of numStages decimate-by-2 FIR stages. */
+/* Tile length must be multiple of 4*2^(numStages-1), */
+/* so every stage computes even number of outputs per tile. */
+/* Returns BLK_FIR_CASC_OK or BLK_FIR_CASC_ERR_xxx. */
+Int16 blkFirCascadeInit(
+    BlkFirCascade *pCasc,   /* FIR cascade */
+    Uint16 numStages,       /* number of stages */
+    Uint16 tileLen          /* number of 1st stage input samples per tile */
+);
+
+/* Sets FIR stage. */
+/* Kernel NULL selects blkFirDecim2(). */
+/* Returns BLK_FIR_CASC_OK or BLK_FIR_CASC_ERR_NS. */
+Int16 blkFirCascadeSetStage(
+    BlkFirCascade *pCasc,   /* FIR cascade */
+    Uint16 stageIdx,        /* stage index */
+    Int16 *coefs,           /* filter coefficients (S16Q15) */
+    Uint16 numCoefs,        /* number of coefficients */
+    Int32 *dlyBuf,          /* delay buffer */
+    BlkFirDecim2Fxn kernel  /* stage kernel */
+);
+
+/* Sets digital gain applied by blkFirCascadeProcessGain(). */
+/* Kernel NULL selects appDiggain(). */
+void blkFirCascadeSetGain(
+    BlkFirCascade *pCasc,   /* FIR cascade */
+    Uint16 diggain,         /* digital gain (U16Q8) */
+    DiggainFxn gainKernel   /* digital gain kernel */
+);
+
+/* Runs all FIR stages tile by tile, */
+/* each tile passes through every stage before next tile is read, */
+/* so intermediate stage outputs are never written to frame buffers. */
+/* Number of output samples is numInSamps/2^numStages. */
+/* Output bit-exact with running stage kernels on whole frames. */
+/* Returns BLK_FIR_CASC_OK or BLK_FIR_CASC_ERR_LEN if numInSamps not multiple of 4*2^(numStages-1). */
+Int16 blkFirCascadeProcess(
+    BlkFirCascade *pCasc,   /* FIR cascade */
+    Int32 *inSamps,         /* input samples (S18Q16) */
+    Int32 *outSamps,        /* output samples (S18Q16) */
+    Uint16 numInSamps       /* number of input samples */
+);
+
+/* Runs all FIR stages tile by tile as blkFirCascadeProcess(), */
+/* digital gain & saturation applied to each last stage output tile, */
+/* so last stage output is never written to frame buffer. */
+/* On host, last stage kernel blkFirDecim2() or blkFirDecim2Host() is replaced by fused */
+/* blkFirDecim2Gain() or blkFirDecim2GainHost(), gain kernel not used. */
+/* On target, last stage asm kernel is followed by gain kernel. */
+/* Output bit-exact with blkFirCascadeProcess() followed by gain kernel. */
+/* Returns BLK_FIR_CASC_OK or BLK_FIR_CASC_ERR_LEN if numInSamps not multiple of 4*2^(numStages-1). */
+Int16 blkFirCascadeProcessGain(
+    BlkFirCascade *pCasc,   /* FIR cascade */
+    Int32 *inSamps,         /* input samples (S18Q16) */
+    Int16 *outSamps,        /* output samples (S16Q15) */
+    Uint16 numInSamps       /* number of input samples */
+);
+
+#endif /* __BLK_FIR_CASCADE_H__ */
@@ -49,4 +49,184 @@ void blkFirDecim2(
     Uint16  numCoefs        /* number of coefficients */
 );
 
+#define BLK_FIR_OK              ( 0 )   /* success */
+#define BLK_FIR_ERR_NOT_SYM     ( -1 )  /* coefficients not symmetric */
+#define BLK_FIR_ERR_NOT_HB      ( -2 )  /* coefficients not half-band */
+#define BLK_FIR_ERR_DF          ( -3 )  /* invalid decimation factor */
+
+/* Checks coefficients for even symmetry, coefs[i] == coefs[numCoefs-1-i]. */
+/* Returns BLK_FIR_OK or BLK_FIR_ERR_NOT_SYM. */
+Int16 blkFirCoefsSym(
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Uint16  numCoefs        /* number of coefficients */
+);
+
+/* Block decimating FIR, symmetric (linear-phase) coefficients, */
+/* S18Q16 input and output data, */
+/* S16Q15 coefficients. */
+/* Decimation factor fixed at 2. */
+/* Computes two outputs per inner loop (assumes even number of outputs). */
+/* Pre-adds mirrored delay line samples, one multiply per coefficient pair. */
+/* Delay buffer layout and output bit-exact with blkFirDecim2(). */
+/* Returns BLK_FIR_ERR_NOT_SYM without processing if coefficients are not symmetric. */
+Int16 blkFirDecim2Sym(
+    Int32   *inSamps,       /* input samples (S18Q16) */
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Int32   *outSamps,      /* output samples (S18Q16) */
+    Int32   *dlyBuf,        /* delay buffer */
+    Uint16  numInSamps,     /* number of input samples */
+    Uint16  numCoefs        /* number of coefficients */
+);
+
+/* Extracts half-band coefficients from full coefficient set. */
+/* Full set must have numCoefs = 4K-1, be symmetric, and be zero at */
+/* every even distance from the center tap except the center itself. */
+/* hbCoefs[m] = coefs[2m], m = 0..K-1, hbCoefs[K] = center coefficient. */
+/* Returns BLK_FIR_OK or BLK_FIR_ERR_NOT_HB. */
+Int16 blkFirHbCoefs(
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Uint16  numCoefs,       /* number of coefficients */
+    Int16   *hbCoefs        /* half-band coefficients (S16Q15), K+1 values */
+);
+
+/* Block decimating half-band FIR, */
+/* S18Q16 input and output data, */
+/* S16Q15 coefficients. */
+/* Decimation factor fixed at 2. */
+/* Computes two outputs per inner loop (assumes even number of outputs). */
+/* Skips zero taps and pre-adds mirrored samples: K+1 multiplies per output. */
+/* Center tap is multiplied, or applied as a shift only if exactly 0.5 (16384). */
+/* Delay buffer layout and output bit-exact with blkFirDecim2() on full coefficient set. */
+void blkFirDecim2Hb(
+    Int32   *inSamps,       /* input samples (S18Q16) */
+    Int16   *hbCoefs,       /* half-band coefficients (S16Q15), from blkFirHbCoefs() */
+    Int32   *outSamps,      /* output samples (S18Q16) */
+    Int32   *dlyBuf,        /* delay buffer, sized as for blkFirDecim2() */
+    Uint16  numInSamps,     /* number of input samples */
+    Uint16  numCoefs        /* number of coefficients of full set, 4K-1 */
+);
+
+/* Linear (mirrored) delay buffer length for blkFirDecim2Lin(): */
+/* index of newest sample + two copies of numCoefs+2 samples. */
+#define BLK_FIR_LIN_DLY_LEN(numCoefs)   ( 2*((numCoefs)+2)+1 )
+
+/* Converts blkFirDecim2() delay buffer to blkFirDecim2Lin() delay buffer. */
+void blkFirDlyToLin(
+    Int32   *dlyBuf,        /* delay buffer, blkFirDecim2() layout */
+    Int32   *linDlyBuf,     /* delay buffer, blkFirDecim2Lin() layout, BLK_FIR_LIN_DLY_LEN(numCoefs) */
+    Uint16  numCoefs        /* number of coefficients */
+);
+
+/* Converts blkFirDecim2Lin() delay buffer to blkFirDecim2() delay buffer. */
+void blkFirLinToDly(
+    Int32   *linDlyBuf,     /* delay buffer, blkFirDecim2Lin() layout */
+    Int32   *dlyBuf,        /* delay buffer, blkFirDecim2() layout */
+    Uint16  numCoefs        /* number of coefficients */
+);
+
+/* Block decimating FIR, linear delay buffer, */
+/* S18Q16 input and output data, */
+/* S16Q15 coefficients. */
+/* Decimation factor fixed at 2. */
+/* Computes two outputs per inner loop (assumes even number of outputs). */
+/* Delay line is stored twice, so each output's taps are contiguous */
+/* and the tap loop has no wrap checks. */
+/* Output bit-exact with blkFirDecim2(). */
+void blkFirDecim2Lin(
+    Int32   *inSamps,       /* input samples (S18Q16) */
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Int32   *outSamps,      /* output samples (S18Q16) */
+    Int32   *dlyBuf,        /* delay buffer, BLK_FIR_LIN_DLY_LEN(numCoefs) */
+    Uint16  numInSamps,     /* number of input samples */
+    Uint16  numCoefs        /* number of coefficients */
+);
+
+/* Delay buffer length for blkFirDecimM() and blkFirDecimMRef(): */
+/* index of newest sample + two copies of numCoefs samples. */
+#define BLK_FIR_M_DLY_LEN(numCoefs)     ( 2*(numCoefs)+1 )
+
+/* Block decimating FIR, reference, */
+/* S18Q16 input and output data, */
+/* S16Q15 coefficients. */
+/* Arbitrary integer decimation factor M, y(m) = sum h(k)*x(M*m-k). */
+/* Output bit-exact with blkFirDecim2() for M=2. */
+/* Number of input samples must be multiple of M. */
+/* Returns BLK_FIR_ERR_DF without processing if M invalid. */
+Int16 blkFirDecimMRef(
+    Int32   *inSamps,       /* input samples (S18Q16) */
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Int32   *outSamps,      /* output samples (S18Q16) */
+    Int32   *dlyBuf,        /* delay buffer, BLK_FIR_M_DLY_LEN(numCoefs) */
+    Uint16  numInSamps,     /* number of input samples */
+    Uint16  numCoefs,       /* number of coefficients */
+    Uint16  decimFact       /* decimation factor M */
+);
+
+/* Block decimating FIR, */
+/* S18Q16 input and output data, */
+/* S16Q15 coefficients. */
+/* Arbitrary integer decimation factor M. */
+/* Delay line is stored twice so taps are contiguous, tap loop unrolled by 4. */
+/* Delay buffer layout and output bit-exact with blkFirDecimMRef(). */
+Int16 blkFirDecimM(
+    Int32   *inSamps,       /* input samples (S18Q16) */
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Int32   *outSamps,      /* output samples (S18Q16) */
+    Int32   *dlyBuf,        /* delay buffer, BLK_FIR_M_DLY_LEN(numCoefs) */
+    Uint16  numInSamps,     /* number of input samples */
+    Uint16  numCoefs,       /* number of coefficients */
+    Uint16  decimFact       /* decimation factor M */
+);
+
+/* Block decimating FIR, host native multiply, */
+/* S18Q16 input and output data, */
+/* S16Q15 coefficients. */
+/* Decimation factor fixed at 2. */
+/* Computes two outputs per inner loop (assumes even number of outputs). */
+/* One 32x16 multiply per tap, 64-bit accumulator, tap loop split at delay buffer wrap. */
+/* Delay buffer layout and output bit-exact with blkFirDecim2(). */
+void blkFirDecim2Host(
+    Int32   *inSamps,       /* input samples (S18Q16) */
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Int32   *outSamps,      /* output samples (S18Q16) */
+    Int32   *dlyBuf,        /* delay buffer */
+    Uint16  numInSamps,     /* number of input samples */
+    Uint16  numCoefs        /* number of coefficients */
+);
+
+/* Block decimating FIR with digital gain & saturation applied to output, */
+/* S18Q16 input data, S16Q15 output data, */
+/* S16Q15 coefficients, U16Q8 digital gain. */
+/* Decimation factor fixed at 2. */
+/* Computes two outputs per inner loop (assumes even number of outputs). */
+/* Each output rounded to S18Q16 as blkFirDecim2(), then gain applied to rounded */
+/* output in output epilogue, no intermediate S18Q16 frame. */
+/* Delay buffer layout as blkFirDecim2(), */
+/* output bit-exact with blkFirDecim2() followed by appDiggain(). */
+void blkFirDecim2Gain(
+    Int32   *inSamps,       /* input samples (S18Q16) */
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Int16   *outSamps,      /* output samples (S16Q15) */
+    Int32   *dlyBuf,        /* delay buffer */
+    Uint16  diggain,        /* digital gain (U16Q8) */
+    Uint16  numInSamps,     /* number of input samples */
+    Uint16  numCoefs        /* number of coefficients */
+);
+
+#ifndef __TMS320C55X__
+/* Block decimating FIR with digital gain & saturation applied to output, */
+/* host native multiply, not built on target. */
+/* Delay buffer layout as blkFirDecim2(), */
+/* output bit-exact with blkFirDecim2() followed by appDiggain(). */
+void blkFirDecim2GainHost(
+    Int32   *inSamps,       /* input samples (S18Q16) */
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Int16   *outSamps,      /* output samples (S16Q15) */
+    Int32   *dlyBuf,        /* delay buffer */
+    Uint16  diggain,        /* digital gain (U16Q8) */
+    Uint16  numInSamps,     /* number of input samples */
+    Uint16  numCoefs        /* number of coefficients */
+);
+#endif
+
 #endif /* __BLK_FIR_DECIM_H__ */
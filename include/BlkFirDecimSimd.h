@@ -0,0 +1,92 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+#ifndef __BLK_FIR_DECIM_SIMD_H__
+#define __BLK_FIR_DECIM_SIMD_H__
+
+#include "data_types.h"
+
+/* SIMD block decimating FIR kernels, */
+/* S18Q16 input and output data, */
+/* S16Q15 coefficients. */
+/* Decimation factor fixed at 2. */
+/* Assumes even number of outputs as blkFirDecim2Lin(). */
+/* Consecutive outputs across vector lanes, 64-bit lane accumulators: */
+/* even 32-bit lanes of one load hold one tap of each output, */
+/* so inner loop is load, multiply & add per tap without lane reduction. */
+/* Filters longer than 256 coefficients run blkFirDecim2Lin(). */
+/* Delay buffer layout (BLK_FIR_LIN_DLY_LEN(numCoefs)) and output bit-exact with blkFirDecim2Lin(). */
+/* Kernels must only be called if cpuFeatures() reports required ISA, */
+/* on non-x86-64 builds they run blkFirDecim2Lin(). */
+
+/* SSE4.1, 2 outputs per vector */
+void blkFirDecim2LinSse41(
+    Int32   *inSamps,       /* input samples (S18Q16) */
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Int32   *outSamps,      /* output samples (S18Q16) */
+    Int32   *dlyBuf,        /* delay buffer, BLK_FIR_LIN_DLY_LEN(numCoefs) */
+    Uint16  numInSamps,     /* number of input samples */
+    Uint16  numCoefs        /* number of coefficients */
+);
+
+/* AVX2, 4 outputs per vector */
+void blkFirDecim2LinAvx2(
+    Int32   *inSamps,       /* input samples (S18Q16) */
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Int32   *outSamps,      /* output samples (S18Q16) */
+    Int32   *dlyBuf,        /* delay buffer, BLK_FIR_LIN_DLY_LEN(numCoefs) */
+    Uint16  numInSamps,     /* number of input samples */
+    Uint16  numCoefs        /* number of coefficients */
+);
+
+/* AVX-512F, 8 outputs per vector */
+void blkFirDecim2LinAvx512(
+    Int32   *inSamps,       /* input samples (S18Q16) */
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Int32   *outSamps,      /* output samples (S18Q16) */
+    Int32   *dlyBuf,        /* delay buffer, BLK_FIR_LIN_DLY_LEN(numCoefs) */
+    Uint16  numInSamps,     /* number of input samples */
+    Uint16  numCoefs        /* number of coefficients */
+);
+
+/* Runs widest kernel supported by host CPU, */
+/* blkFirDecim2Lin() if no SIMD kernel supported. */
+void blkFirDecim2LinSimd(
+    Int32   *inSamps,       /* input samples (S18Q16) */
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Int32   *outSamps,      /* output samples (S18Q16) */
+    Int32   *dlyBuf,        /* delay buffer, BLK_FIR_LIN_DLY_LEN(numCoefs) */
+    Uint16  numInSamps,     /* number of input samples */
+    Uint16  numCoefs        /* number of coefficients */
+);
+
+#endif /* __BLK_FIR_DECIM_SIMD_H__ */
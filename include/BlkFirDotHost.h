@@ -0,0 +1,77 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+#ifndef __BLK_FIR_DOT_HOST_H__
+#define __BLK_FIR_DOT_HOST_H__
+
+#include "data_types.h"
+
+/* Computes sum of products of numCoefs delay buffer samples & coefficients, */
+/* starting at 1-based index dlyBufIdx, increasing with wrap at numDlySamps. */
+/* Tap loop split at wrap point, native 32x16 multiplies. */
+/* Shared by blkFirDecim2Host() & blkFirDecim2GainHost(). */
+static inline Int64 blkFirDotHost(
+    Int32   *dlyBuf,        /* delay buffer */
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Uint16  dlyBufIdx,      /* index of 1st tap */
+    Uint16  numDlySamps,    /* number of delay buffer samples */
+    Uint16  numCoefs        /* number of coefficients */
+)
+{
+    Int32 *pDly;
+    Uint16 numCoefs1;       // number of taps before wrap
+    Int64 acc_40b;
+    Uint16 i;
+
+    numCoefs1 = numDlySamps - dlyBufIdx + 1;
+    if (numCoefs1 > numCoefs)
+    {
+        numCoefs1 = numCoefs;
+    }
+
+    acc_40b = 0;
+    pDly = &dlyBuf[dlyBufIdx];
+    for (i = 0; i < numCoefs1; i++)
+    {
+        /* S18Q16 * S16Q15 = S34Q31, S40Q31 + S34Q31 = S40Q31 */
+        acc_40b += (Int64)pDly[i] * coefs[i];
+    }
+    pDly = &dlyBuf[1];
+    for ( ; i < numCoefs; i++)
+    {
+        acc_40b += (Int64)pDly[i-numCoefs1] * coefs[i];
+    }
+
+    return acc_40b;
+}
+
+#endif /* __BLK_FIR_DOT_HOST_H__ */
@@ -65,4 +65,83 @@ void blkIirDf1(
     Uint16  coefIWL         /* coefficient integer wordlength */
 );
 
+/* Converts blkIirDf2() delay buffer to blkIirDf2Lin() delay buffer. */
+/* Both buffers are 2*numBiquads+1 long. */
+void blkIirDf2DlyToLin(
+    Int32   *dlyBuf,        /* delay buffer, blkIirDf2() layout */
+    Int32   *linDlyBuf,     /* delay buffer, blkIirDf2Lin() layout */
+    Uint16  numBiquads      /* number of biquads */
+);
+
+/* Converts blkIirDf2Lin() delay buffer to blkIirDf2() delay buffer. */
+void blkIirDf2LinToDly(
+    Int32   *linDlyBuf,     /* delay buffer, blkIirDf2Lin() layout */
+    Int32   *dlyBuf,        /* delay buffer, blkIirDf2() layout */
+    Uint16  numBiquads      /* number of biquads */
+);
+
+/* Block IIR, Direct Form II, linear delay buffer */
+/* S18Q16 input and output data */
+/* Fixed-point format of coefficients determined by coefficient integer wordlength parameter */
+/* Input gain applied to input signal */
+/* Delay buffer holds d(n-1), d(n-2) of each biquad at fixed locations */
+/* (dlyBuf[2j+1], dlyBuf[2j+2]), no circular index. */
+/* Output bit-exact with blkIirDf2(). */
+void blkIirDf2Lin(
+    Int32   *inSamps,       /* input samples (S18Q16) */
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Int32   *outSamps,      /* output samples (S18Q16) */
+    Int32   *dlyBuf,        /* delay buffer */
+    Uint16  inGain,         /* input gain (U16Q16) */
+    Uint16  numInSamps,     /* number of input samples */
+    Uint16  numBiquads,     /* number of biquads */
+    Uint16  coefIWL         /* coefficient integer wordlength */
+);
+
+/* Block IIR, Direct Form II, host native multiply */
+/* S18Q16 input and output data */
+/* Fixed-point format of coefficients determined by coefficient integer wordlength parameter */
+/* Input gain applied to input signal */
+/* One 32x16 multiply per coefficient, 64-bit accumulator. */
+/* Delay buffer layout and output bit-exact with blkIirDf2(). */
+void blkIirDf2Host(
+    Int32   *inSamps,       /* input samples (S18Q16) */
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Int32   *outSamps,      /* output samples (S18Q16) */
+    Int32   *dlyBuf,        /* delay buffer */
+    Uint16  inGain,         /* input gain (U16Q16) */
+    Uint16  numInSamps,     /* number of input samples */
+    Uint16  numBiquads,     /* number of biquads */
+    Uint16  coefIWL         /* coefficient integer wordlength */
+);
+
+/* Block IIR, Direct Form I, host native multiply */
+/* S18Q16 input and output data */
+/* Fixed-point format of coefficients determined by coefficient integer wordlength parameter */
+/* Input gain applied to input signal */
+/* One 32x16 multiply per coefficient, 64-bit accumulator. */
+/* Delay buffer layout and output bit-exact with blkIirDf1(). */
+void blkIirDf1Host(
+    Int32   *inSamps,       /* input samples (S18Q16) */
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Int32   *outSamps,      /* output samples (S18Q16) */
+    Int32   *dlyBuf,        /* delay buffer */
+    Uint16  inGain,         /* input gain (U16Q16) */
+    Uint16  numInSamps,     /* number of input samples */
+    Uint16  numBiquads,     /* number of biquads */
+    Uint16  coefIWL         /* coefficient integer wordlength */
+);
+
+/* IIR kernel, same calling convention as blkIirDf1() & blkIirDf2() */
+typedef void (*BlkIirFxn)(
+    Int32   *inSamps,       /* input samples (S18Q16) */
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Int32   *outSamps,      /* output samples (S18Q16) */
+    Int32   *dlyBuf,        /* delay buffer */
+    Uint16  inGain,         /* input gain (U16Q16) */
+    Uint16  numInSamps,     /* number of input samples */
+    Uint16  numBiquads,     /* number of biquads */
+    Uint16  coefIWL         /* coefficient integer wordlength */
+);
+
 #endif /* __BLK_IIR_H__ */
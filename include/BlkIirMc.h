@@ -0,0 +1,104 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+#ifndef __BLK_IIR_MC_H__
+#define __BLK_IIR_MC_H__
+
+#include "data_types.h"
+
+#define IIR_MC_MAX_CH       ( 32 )  /* maximum number of channels */
+#define IIR_MC_MAX_BIQUADS  ( 8 )   /* maximum number of biquads */
+
+#define IIR_MC_OK           ( 0 )   /* success */
+#define IIR_MC_ERR_CH       ( -1 )  /* number of channels out of range */
+#define IIR_MC_ERR_BIQUADS  ( -2 )  /* number of biquads out of range */
+
+/* Delay slots per biquad */
+#define IIR_MC_D1           ( 0 )   /* DF2 d(n-1), DF1 x(n-1) */
+#define IIR_MC_D2           ( 1 )   /* DF2 d(n-2), DF1 x(n-2) */
+#define IIR_MC_Y1           ( 2 )   /* DF1 y(n-1) */
+#define IIR_MC_Y2           ( 3 )   /* DF1 y(n-2) */
+#define IIR_MC_NUM_SLOTS    ( 4 )
+
+/* Multi-channel biquad cascade state, structure-of-arrays: */
+/* one row per biquad & delay slot, one column per channel. */
+typedef struct
+{
+    Int32 dly[IIR_MC_MAX_BIQUADS][IIR_MC_NUM_SLOTS][IIR_MC_MAX_CH]; /* delay buffer */
+    Uint16 numCh;           /* number of channels */
+    Uint16 numBiquads;      /* number of biquads */
+} BlkIirMcState;
+
+/* Initializes multi-channel biquad cascade state. */
+/* Clears delay buffer. Same state serves blkIirDf1Mc() or blkIirDf2Mc(). */
+/* Returns IIR_MC_OK or IIR_MC_ERR_xxx. */
+Int16 blkIirMcInit(
+    BlkIirMcState *pState,  /* multi-channel biquad state */
+    Uint16 numCh,           /* number of channels, 1..IIR_MC_MAX_CH */
+    Uint16 numBiquads       /* number of biquads, 1..IIR_MC_MAX_BIQUADS */
+);
+
+/* Multi-channel blkIirDf2(), all channels share coefficients. */
+/* S18Q16 input and output data */
+/* Fixed-point format of coefficients determined by coefficient integer wordlength parameter */
+/* Input gain applied to input signal */
+/* Channels are processed in AVX2 lanes (8 per group) if host CPU supports AVX2, */
+/* remaining channels are scalar. */
+/* Output of each channel is bit-exact with blkIirDf2(). */
+void blkIirDf2Mc(
+    Int32   **inSamps,      /* per-channel input samples (S18Q16) */
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Int32   **outSamps,     /* per-channel output samples (S18Q16) */
+    BlkIirMcState *pState,  /* multi-channel biquad state */
+    Uint16  inGain,         /* input gain (U16Q16) */
+    Uint16  numInSamps,     /* number of input samples per channel */
+    Uint16  coefIWL         /* coefficient integer wordlength */
+);
+
+/* Multi-channel blkIirDf1(), all channels share coefficients. */
+/* S18Q16 input and output data */
+/* Fixed-point format of coefficients determined by coefficient integer wordlength parameter */
+/* Input gain applied to input signal */
+/* Channels are processed in AVX2 lanes (8 per group) if host CPU supports AVX2, */
+/* remaining channels are scalar. */
+/* Output of each channel is bit-exact with blkIirDf1(). */
+void blkIirDf1Mc(
+    Int32   **inSamps,      /* per-channel input samples (S18Q16) */
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Int32   **outSamps,     /* per-channel output samples (S18Q16) */
+    BlkIirMcState *pState,  /* multi-channel biquad state */
+    Uint16  inGain,         /* input gain (U16Q16) */
+    Uint16  numInSamps,     /* number of input samples per channel */
+    Uint16  coefIWL         /* coefficient integer wordlength */
+);
+
+#endif /* __BLK_IIR_MC_H__ */
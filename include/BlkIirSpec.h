@@ -0,0 +1,86 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+#ifndef __BLK_IIR_SPEC_H__
+#define __BLK_IIR_SPEC_H__
+
+#include "data_types.h"
+#include "BlkIir.h"
+
+#define IIR_SPEC_MAX_BIQUADS    ( 4 )   /* maximum number of biquads of specialized kernels */
+#define IIR_SPEC_MAX_IWL        ( 2 )   /* maximum coefficient integer wordlength of specialized kernels */
+
+/* Returns DF2 kernel specialized for (numBiquads, coefIWL), */
+/* blkIirDf2() if no specialized kernel exists. */
+/* Specialized kernels keep delay line in registers, */
+/* delay buffer layout and output bit-exact with blkIirDf2(). */
+BlkIirFxn blkIirDf2Select(
+    Uint16  numBiquads,     /* number of biquads */
+    Uint16  coefIWL         /* coefficient integer wordlength */
+);
+
+/* Returns DF1 kernel specialized for (numBiquads, coefIWL), */
+/* blkIirDf1() if no specialized kernel exists. */
+/* Specialized kernels keep delay line in registers, */
+/* delay buffer layout and output bit-exact with blkIirDf1(). */
+BlkIirFxn blkIirDf1Select(
+    Uint16  numBiquads,     /* number of biquads */
+    Uint16  coefIWL         /* coefficient integer wordlength */
+);
+
+/* Block IIR, Direct Form II, runs kernel specialized for (numBiquads, coefIWL). */
+/* Same arguments, delay buffer layout and output as blkIirDf2(). */
+void blkIirDf2Spec(
+    Int32   *inSamps,       /* input samples (S18Q16) */
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Int32   *outSamps,      /* output samples (S18Q16) */
+    Int32   *dlyBuf,        /* delay buffer */
+    Uint16  inGain,         /* input gain (U16Q16) */
+    Uint16  numInSamps,     /* number of input samples */
+    Uint16  numBiquads,     /* number of biquads */
+    Uint16  coefIWL         /* coefficient integer wordlength */
+);
+
+/* Block IIR, Direct Form I, runs kernel specialized for (numBiquads, coefIWL). */
+/* Same arguments, delay buffer layout and output as blkIirDf1(). */
+void blkIirDf1Spec(
+    Int32   *inSamps,       /* input samples (S18Q16) */
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Int32   *outSamps,      /* output samples (S18Q16) */
+    Int32   *dlyBuf,        /* delay buffer */
+    Uint16  inGain,         /* input gain (U16Q16) */
+    Uint16  numInSamps,     /* number of input samples */
+    Uint16  numBiquads,     /* number of biquads */
+    Uint16  coefIWL         /* coefficient integer wordlength */
+);
+
+#endif /* __BLK_IIR_SPEC_H__ */
@@ -0,0 +1,108 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+#ifndef __BLK_IIR_SS_H__
+#define __BLK_IIR_SS_H__
+
+#include "data_types.h"
+
+#define IIR_SS_BLK_LEN      ( 4 )   /* outputs per block */
+#define IIR_SS_MAX_BIQUADS  ( 8 )   /* maximum number of biquads */
+#define IIR_SS_MAX_IMP_LEN  ( 65536 ) /* maximum impulse response length for error bound */
+
+#define IIR_SS_DF1          ( 0 )   /* blkIirDf1() coefficient order & quantization */
+#define IIR_SS_DF2          ( 1 )   /* blkIirDf2() coefficient order & quantization */
+
+#define IIR_SS_OK           ( 0 )   /* success */
+#define IIR_SS_ERR_BIQUADS  ( -1 )  /* number of biquads out of range */
+#define IIR_SS_ERR_FORM     ( -2 )  /* unknown form */
+
+/* Biquad as block state-space system, IIR_SS_BLK_LEN samples per step: */
+/* s(n+L) = A^L s(n) + sum B_j u(n+j), y(n+k) = C_k s(n) + sum D_kj u(n+j). */
+/* State is DF2 d(n-1), d(n-2) in S18Q16 LSB units. */
+typedef struct
+{
+    Float64 a[2][2];                        /* A^L */
+    Float64 b[2][IIR_SS_BLK_LEN];           /* A^(L-1-j) B */
+    Float64 c[IIR_SS_BLK_LEN][2];           /* C A^k */
+    Float64 d[IIR_SS_BLK_LEN][IIR_SS_BLK_LEN]; /* impulse response h(k-j), lower triangular */
+    Float64 a1, a2, b0, b1, b2;             /* biquad coefficients */
+    Float64 s[2];                           /* state */
+} BlkIirSsBiquad;
+
+/* Block state-space IIR state */
+typedef struct
+{
+    BlkIirSsBiquad bq[IIR_SS_MAX_BIQUADS];
+    Uint16 numBiquads;      /* number of biquads */
+    Uint16 form;            /* IIR_SS_DF1 or IIR_SS_DF2 */
+    Uint16 inGain;          /* input gain (U16Q16) */
+} BlkIirSsState;
+
+/* Initializes block state-space IIR from blkIirDf1() or blkIirDf2() coefficients. */
+/* Clears state. */
+/* Returns IIR_SS_OK or IIR_SS_ERR_xxx. */
+Int16 blkIirSsInit(
+    BlkIirSsState *pState,  /* block state-space IIR state */
+    Int16   *coefs,         /* filter coefficients, blkIirDf1() or blkIirDf2() order */
+    Uint16  numBiquads,     /* number of biquads, 1..IIR_SS_MAX_BIQUADS */
+    Uint16  coefIWL,        /* coefficient integer wordlength */
+    Uint16  inGain,         /* input gain (U16Q16) */
+    Uint16  form            /* IIR_SS_DF1 or IIR_SS_DF2 */
+);
+
+/* Block IIR, block state-space (look-ahead) form, 64-bit floating-point. */
+/* S18Q16 input and output data. */
+/* Each biquad computes IIR_SS_BLK_LEN outputs per step as independent MAC chains, */
+/* remaining samples sample by sample. */
+/* Output rounding as blkIirDf1() (round to nearest) or blkIirDf2() (+1/4 LSB, 16-bit wrap). */
+/* Not bit-exact, output differs from blkIirDf1()/blkIirDf2() by at most blkIirSsErrBound(). */
+void blkIirSs(
+    Int32   *inSamps,       /* input samples (S18Q16) */
+    Int32   *outSamps,      /* output samples (S18Q16) */
+    BlkIirSsState *pState,  /* block state-space IIR state */
+    Uint16  numInSamps      /* number of input samples */
+);
+
+/* Returns bound on |blkIirSs() output - reference output| in S18Q16 LSBs, */
+/* for same input from zero state. */
+/* Reference rounds d(n) (DF2) or each biquad output (DF1) to 1/2 LSB, */
+/* blkIirSs() does not, so bound is sum over rounding points of */
+/* 1/2 * l1 norm of impulse response from rounding point to output, */
+/* plus floating-point margin, plus output rounding. */
+/* DF2 bound holds while reference output does not wrap, |y| < 2^15 LSBs. */
+/* Returns -1 if impulse responses do not decay within IIR_SS_MAX_IMP_LEN (unstable or near-unstable). */
+Float64 blkIirSsErrBound(
+    BlkIirSsState *pState   /* block state-space IIR state */
+);
+
+#endif /* __BLK_IIR_SS_H__ */
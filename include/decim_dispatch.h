@@ -0,0 +1,115 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+#ifndef __DECIM_DISPATCH_H__
+#define __DECIM_DISPATCH_H__
+
+#include "data_types.h"
+#include "pick_bits_cic_cfg.h"
+#include "BlkFirCascade.h"
+#include "BlkIir.h"
+#include "diggain.h"
+#include "decim_pipe.h"
+
+/* ISA levels, each level may use kernels of all lower levels */
+#define DECIM_ISA_REF       ( 0 )   /* C55x-emulating reference kernels */
+#define DECIM_ISA_SCALAR    ( 1 )   /* host-native scalar kernels */
+#define DECIM_ISA_SSE2      ( 2 )   /* SSE2 */
+#define DECIM_ISA_SSE41     ( 3 )   /* SSE4.1 */
+#define DECIM_ISA_AVX2      ( 4 )   /* AVX2 */
+#define DECIM_ISA_AVX512    ( 5 )   /* AVX-512F */
+#define DECIM_NUM_ISA       ( 6 )
+
+/* Environment variable capping ISA level: ref, scalar, sse2, sse4.1, avx2 or avx512 */
+#define DECIM_ISA_ENV       "DECIM_ISA"
+
+/* Kernel slots */
+#define DECIM_KERNEL_CIC        ( 0 )   /* CIC, pickBitsCic() convention */
+#define DECIM_KERNEL_FIR        ( 1 )   /* decimate-by-2 FIR, blkFirDecim2Lin() convention */
+#define DECIM_KERNEL_IIR_DF1    ( 2 )   /* IIR DF1, blkIirDf1() convention */
+#define DECIM_KERNEL_IIR_DF2    ( 3 )   /* IIR DF2, blkIirDf2() convention */
+#define DECIM_KERNEL_DIGGAIN    ( 4 )   /* digital gain, appDiggain() convention */
+#define DECIM_NUM_KERNELS       ( 5 )
+
+/* Selected kernels, all bit-exact with reference kernels. */
+/* FIR slot uses linear delay buffer, BLK_FIR_LIN_DLY_LEN(numCoefs). */
+/* Below SSE4.1 FIR slot keeps C55x-emulating blkFirDecim2Lin() (16x16 partial products): */
+/* host-native blkFirDecim2Host() uses blkFirDecim2() circular delay buffer layout, */
+/* so it cannot share delay buffer or pipeline configuration with SIMD FIR variants. */
+/* CIC & IIR slots have no SIMD variants: the integrator & biquad recursions */
+/* of one stream are serial, SIMD CIC & IIR run across channels instead */
+/* (pickBitsCicMc(), blkIirDf1Mc(), blkIirDf2Mc()). */
+typedef struct
+{
+    CicKernelFxn cic;       /* CIC, DF = 16 & NS = 4 */
+    BlkFirDecim2Fxn fir;    /* decimate-by-2 FIR, linear delay buffer */
+    BlkIirFxn iirDf1;       /* IIR DF1 */
+    BlkIirFxn iirDf2;       /* IIR DF2 */
+    DiggainFxn diggain;     /* digital gain */
+    Uint16 isa;             /* ISA level used for selection */
+    const char *name[DECIM_NUM_KERNELS]; /* selected variant names */
+} DecimKernels;
+
+/* Selects kernels for host CPU, capped by DECIM_ISA_ENV if set. */
+/* Call before starting threads that use selected kernels, */
+/* or leave selection to first decimKernels() call. */
+/* Returns ISA level used for selection. */
+Uint16 decimDispatchInit(void);
+
+/* Selects kernels for ISA level, capped by host CPU. */
+/* Must not be called while other threads use selected kernels. */
+/* Returns ISA level used for selection. */
+Uint16 decimDispatchSetIsa(
+    Uint16 isa              /* ISA level, DECIM_ISA_xxx */
+);
+
+/* Returns selected kernels, calls decimDispatchInit() on first use. */
+/* Thread-safe, first use selection runs once. */
+const DecimKernels *decimKernels(void);
+
+/* Sets CIC, FIR & constant gain kernels of pipeline configuration to selected kernels. */
+/* FIR kernel uses linear delay buffer layout, so constant gain is not fused into FIR. */
+void decimDispatchPipeCfg(
+    DecimPipeCfg *pCfg      /* pipeline configuration */
+);
+
+/* Returns name of selected variant for kernel slot, NULL if invalid slot. */
+const char *decimKernelName(
+    Uint16 kernelId         /* kernel slot, DECIM_KERNEL_xxx */
+);
+
+/* Returns name of ISA level, NULL if invalid level. */
+const char *decimIsaName(
+    Uint16 isa              /* ISA level, DECIM_ISA_xxx */
+);
+
+#endif /* __DECIM_DISPATCH_H__ */
@@ -0,0 +1,137 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+#ifndef __DECIM_PIPE_H__
+#define __DECIM_PIPE_H__
+
+#include "data_types.h"
+#include "pick_bits_cic_cfg.h"
+#include "BlkFirDecim.h"
+#include "BlkFirCascade.h"
+#include "diggain.h"
+
+#define DECIM_PIPE_MAX_COEFS        ( 128 ) /* maximum number of coefficients per FIR stage */
+#define DECIM_PIPE_CIC_BUF_LEN      ( BLK_FIR_CASC_MAX_TILE_LEN )   /* CIC output samples per chunk */
+#ifdef __TMS320C55X__
+/* Sized for IdleLoop 20 ms frame at 16 kHz, DecimPipe must fit in DARAM_3 */
+#define DECIM_PIPE_MAX_OUT_LEN      ( 320 ) /* maximum number of output samples per frame */
+#else
+#define DECIM_PIPE_MAX_OUT_LEN      ( 512 ) /* maximum number of output samples per frame */
+#endif
+#define DECIM_PIPE_FIR_DLY_LEN      ( BLK_FIR_LIN_DLY_LEN(DECIM_PIPE_MAX_COEFS) )   /* FIR delay buffer length, fits both layouts */
+
+#define DECIM_PIPE_OK               ( 0 )   /* success */
+#define DECIM_PIPE_ERR_CIC          ( -1 )  /* unsupported CIC decimation factor or number of stages */
+#define DECIM_PIPE_ERR_FIR          ( -2 )  /* invalid number of FIR stages or coefficients */
+#define DECIM_PIPE_ERR_LEN          ( -3 )  /* invalid frame length */
+
+/* Decimation pipeline configuration */
+typedef struct
+{
+    Uint32 pdmRate;         /* PDM bit rate per channel (Hz) */
+    Uint16 inFrameLen;      /* input frame length per channel in 32-bit words */
+    Uint16 cicDecimFact;    /* CIC decimation factor R */
+    Uint16 cicNumStages;    /* CIC number of stages N */
+    CicKernelFxn cicKernel; /* CIC kernel for R & N, NULL selects kernel bound by cicCfgInit() (host only) */
+    Uint16 numFirStages;    /* number of decimate-by-2 FIR stages */
+    const Int16 *firCoefs[BLK_FIR_CASC_MAX_STAGES]; /* FIR stage coefficients (S16Q15), shared */
+    Uint16 firNumCoefs[BLK_FIR_CASC_MAX_STAGES];    /* FIR stage number of coefficients */
+    BlkFirDecim2Fxn firKernel;  /* FIR kernel, blkFirDecim2() or blkFirDecim2Lin() layout, NULL selects blkFirDecim2() */
+    Uint16 diggain;         /* digital gain (U16Q8) */
+    Uint16 rampMode;        /* DIGGAIN_RAMP_LIN or DIGGAIN_RAMP_EXP */
+    Uint16 rampLen;         /* linear gain ramp length in samples */
+    Uint16 expCoef;         /* exponential gain ramp coefficient (U0Q16) */
+    DiggainFxn gainKernel;  /* constant gain kernel, NULL selects appDiggain() */
+} DecimPipeCfg;
+
+/* Decimation pipeline instance, all mutable state of one stream. */
+/* Coefficients are referenced, not copied, so tables are shared by instances. */
+typedef struct
+{
+    CicCfg cic;             /* CIC configuration */
+    Int32 cicState[2*CIC_MAX_NS];   /* CIC state */
+    BlkFirCascade fir;      /* FIR cascade */
+    Int32 firDlyBuf[BLK_FIR_CASC_MAX_STAGES][DECIM_PIPE_FIR_DLY_LEN]; /* FIR delay buffers */
+    DiggainState gain;      /* digital gain state */
+    Uint16 inFrameLen;      /* input frame length per channel in 32-bit words */
+    Uint16 chunkLen;        /* input words per channel per CIC chunk */
+    Uint16 outFrameLen;     /* output frame length */
+    Uint32 outRate;         /* output sample rate (Hz) */
+    Int32 cicBuf[DECIM_PIPE_CIC_BUF_LEN];   /* CIC output chunk */
+    Int32 firOutBuf[DECIM_PIPE_MAX_OUT_LEN];    /* FIR output frame, used while gain ramps */
+    DecimProf *pProf;       /* profiling state, NULL if not profiled */
+} DecimPipe;
+
+/* Fills configuration of IdleLoop chain: */
+/* 1.024 MHz PDM, 20 ms frames, CIC R = 16 & N = 4, */
+/* FIR1 & FIR2 decimate-by-2 with shared tables, 16 kHz output, 20 dB gain. */
+void decimPipeCfgDefault(
+    DecimPipeCfg *pCfg      /* pipeline configuration */
+);
+
+/* Initializes pipeline instance from configuration, clears all state. */
+/* Per-byte CIC table built only if no CIC kernel supplied. */
+/* CIC output of inFrameLen words must be multiple of 4*2^(numFirStages-1) samples. */
+/* Returns DECIM_PIPE_OK or DECIM_PIPE_ERR_xxx. */
+Int16 decimPipeInit(
+    DecimPipe *pPipe,       /* pipeline instance */
+    const DecimPipeCfg *pCfg    /* pipeline configuration */
+);
+
+/* Sets target digital gain, gain ramps as configured. */
+void decimPipeSetGain(
+    DecimPipe *pPipe,       /* pipeline instance */
+    Uint16 diggain          /* digital gain (U16Q8) */
+);
+
+/* Attaches profiling state recording stage & frame times of this instance, */
+/* NULL detaches. State must be used by one pipeline only. */
+/* Set after decimPipeInit(), which detaches. */
+void decimPipeSetProf(
+    DecimPipe *pPipe,       /* pipeline instance */
+    DecimProf *pProf        /* profiling state, may be NULL */
+);
+
+/* Processes one frame: CIC, FIR cascade & digital gain. */
+/* Input processed in chunks of DECIM_PIPE_CIC_BUF_LEN CIC output samples, */
+/* each chunk passes through all FIR stages before next chunk. */
+/* At constant gain, gain is applied in FIR cascade output epilogue, */
+/* while ramping or with AGC enabled, by diggainProcess() on whole frame. */
+void decimPipeProcess(
+    DecimPipe *pPipe,       /* pipeline instance */
+    Uint32 *lData,          /* "left" channel 32-bit packed input data */
+    Uint32 *rData,          /* "right" channel 32-bit packed input data */
+    Int16 *outSamps,        /* output samples (S16Q15) */
+    Uint16 *pNumOutSamps    /* number of output samples */
+);
+
+#endif /* __DECIM_PIPE_H__ */
@@ -0,0 +1,183 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+#ifndef __DECIM_PIPE_MT_H__
+#define __DECIM_PIPE_MT_H__
+
+#include <pthread.h>
+#include "data_types.h"
+#include "decim_pipe.h"
+
+/* Pipeline-parallel execution of one decimation pipeline instance. */
+/* Host only (POSIX threads). */
+/* CIC, FIR cascade & digital gain stages of one DecimPipe run on */
+/* separate threads, connected by lock-free single-producer/single-consumer */
+/* rings of frames. A full ring stalls its producer stage (backpressure), */
+/* so at most DECIM_PIPE_MT_RING_LEN frames wait between two stages */
+/* and frame latency stays bounded. */
+/* Stages touch disjoint parts of DecimPipe: CIC state, FIR cascade, gain state. */
+
+#define DECIM_PIPE_MT_RING_LEN      ( 4 )       /* frames per ring, power of 2 */
+#define DECIM_PIPE_MT_MAX_CIC_LEN   ( 4096 )    /* maximum number of CIC output samples per frame */
+
+#define DECIM_PIPE_MT_STAGE_CIC     ( 0 )   /* CIC stage */
+#define DECIM_PIPE_MT_STAGE_FIR     ( 1 )   /* FIR cascade stage */
+#define DECIM_PIPE_MT_STAGE_GAIN    ( 2 )   /* digital gain stage */
+#define DECIM_PIPE_MT_NUM_STAGES    ( 3 )
+
+#define DECIM_PIPE_MT_OK            ( 0 )   /* success */
+#define DECIM_PIPE_MT_ERR_LEN       ( -1 )  /* CIC frame too long */
+#define DECIM_PIPE_MT_ERR_FULL      ( -2 )  /* input ring full */
+#define DECIM_PIPE_MT_ERR_THREAD    ( -3 )  /* thread creation failed */
+
+/* Frame completion callback, called on gain stage thread */
+typedef void (*DecimPipeMtDoneFxn)(
+    void *pArg,             /* callback argument */
+    Uint32 seq,             /* frame sequence number */
+    Int16 *outSamps,        /* output samples (S16Q15) */
+    Uint16 numOutSamps      /* number of output samples */
+);
+
+/* Frame descriptor passed between stages */
+typedef struct
+{
+    Uint32 *lData;          /* "left" channel 32-bit packed input data */
+    Uint32 *rData;          /* "right" channel 32-bit packed input data */
+    Int16 *outSamps;        /* output samples (S16Q15) */
+    Uint16 numSamps;        /* number of samples in stage output buffer */
+    Uint32 seq;             /* frame sequence number */
+    Uint64 submitNs;        /* submit time (ns) */
+} DecimPipeMtFrame;
+
+/* SPSC ring, head written by producer only, tail by consumer only, */
+/* kept on separate cache lines */
+typedef struct
+{
+    Uint32 head;            /* number of frames published */
+    Uint32 padHead[15];
+    Uint32 tail;            /* number of frames released */
+    Uint32 padTail[15];
+    DecimPipeMtFrame frame[DECIM_PIPE_MT_RING_LEN];
+} DecimPipeMtRing;
+
+/* Stage, counters written by stage thread only */
+typedef struct
+{
+    struct DecimPipeMt_s *pMt;  /* owning pipeline-parallel instance */
+    Uint16 stageId;         /* DECIM_PIPE_MT_STAGE_xxx */
+    Uint32 numFrames;       /* number of frames processed */
+    Uint64 busyNs;          /* time processing frames (ns) */
+    Uint64 starveNs;        /* time waiting for input frame (ns) */
+    Uint64 blockNs;         /* time waiting for free output slot, backpressure (ns) */
+} DecimPipeMtStage;
+
+/* Pipeline-parallel instance */
+typedef struct DecimPipeMt_s
+{
+    DecimPipe *pPipe;       /* pipeline instance */
+    DecimPipeMtDoneFxn done;    /* frame completion callback, may be NULL */
+    void *pArg;             /* callback argument */
+    DecimPipeMtRing ring[DECIM_PIPE_MT_NUM_STAGES]; /* input of each stage */
+    Int32 cicBuf[DECIM_PIPE_MT_RING_LEN][DECIM_PIPE_MT_MAX_CIC_LEN];  /* CIC output, one per FIR ring slot */
+    Int32 firBuf[DECIM_PIPE_MT_RING_LEN][DECIM_PIPE_MAX_OUT_LEN];     /* FIR output, one per gain ring slot */
+    DecimPipeMtStage stage[DECIM_PIPE_MT_NUM_STAGES];
+    pthread_t thread[DECIM_PIPE_MT_NUM_STAGES];
+    Uint16 numThreads;      /* number of running stage threads */
+    Uint32 stop;            /* set to stop stage threads */
+    Uint32 pendGain;        /* pending target digital gain, bit 16 set if pending */
+    Uint32 numSubmitted;    /* number of frames submitted */
+    Uint32 numDone;         /* number of frames completed */
+    Uint64 latSumNs;        /* sum of submit to completion latencies (ns) */
+    Uint64 latMaxNs;        /* maximum submit to completion latency (ns) */
+    Uint64 startNs;         /* start time (ns) */
+} DecimPipeMt;
+
+/* Pipeline-parallel statistics */
+typedef struct
+{
+    Uint32 numSubmitted;    /* number of frames submitted */
+    Uint32 numDone;         /* number of frames completed */
+    Uint32 numFrames[DECIM_PIPE_MT_NUM_STAGES];     /* frames processed per stage */
+    Float64 busy[DECIM_PIPE_MT_NUM_STAGES];         /* busy fraction per stage */
+    Float64 starve[DECIM_PIPE_MT_NUM_STAGES];       /* input starved fraction per stage */
+    Float64 block[DECIM_PIPE_MT_NUM_STAGES];        /* backpressure blocked fraction per stage */
+    Uint16 ringDepth[DECIM_PIPE_MT_NUM_STAGES];     /* frames waiting in each stage input ring */
+    Float64 latMeanUs;      /* mean submit to completion latency (us) */
+    Float64 latMaxUs;       /* maximum submit to completion latency (us) */
+    Float64 elapsedSec;     /* time since decimPipeMtInit() (s) */
+} DecimPipeMtStats;
+
+/* Starts stage threads running initialized pipeline instance pPipe. */
+/* Detaches pPipe profiling state: stages overlap different frames, */
+/* per stage busy time in DecimPipeMtStats instead. */
+/* Instance is large, allocate statically or on heap. */
+/* Returns DECIM_PIPE_MT_OK or DECIM_PIPE_MT_ERR_xxx. */
+Int16 decimPipeMtInit(
+    DecimPipeMt *pMt,       /* pipeline-parallel instance */
+    DecimPipe *pPipe,       /* pipeline instance */
+    DecimPipeMtDoneFxn done,    /* frame completion callback, may be NULL */
+    void *pArg              /* callback argument */
+);
+
+/* Submits frame, returns immediately. Single submitting thread only. */
+/* Buffers must stay valid until completion callback. */
+/* Returns DECIM_PIPE_MT_OK or DECIM_PIPE_MT_ERR_FULL if input ring full. */
+Int16 decimPipeMtSubmit(
+    DecimPipeMt *pMt,       /* pipeline-parallel instance */
+    Uint32 *lData,          /* "left" channel 32-bit packed input data */
+    Uint32 *rData,          /* "right" channel 32-bit packed input data */
+    Int16 *outSamps         /* output samples (S16Q15) */
+);
+
+/* Sets target digital gain, applied by gain stage from next frame. */
+void decimPipeMtSetGain(
+    DecimPipeMt *pMt,       /* pipeline-parallel instance */
+    Uint16 diggain          /* digital gain (U16Q8) */
+);
+
+/* Waits until all submitted frames are completed. */
+void decimPipeMtDrain(
+    DecimPipeMt *pMt        /* pipeline-parallel instance */
+);
+
+/* Reads statistics. */
+void decimPipeMtGetStats(
+    DecimPipeMt *pMt,       /* pipeline-parallel instance */
+    DecimPipeMtStats *pStats    /* statistics */
+);
+
+/* Drains & stops stage threads. */
+void decimPipeMtStop(
+    DecimPipeMt *pMt        /* pipeline-parallel instance */
+);
+
+#endif /* __DECIM_PIPE_MT_H__ */
@@ -0,0 +1,147 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+#ifndef __DECIM_PROF_H__
+#define __DECIM_PROF_H__
+
+#include "data_types.h"
+
+/* Per-stage cycle/latency profiling of decimation chain. */
+/* Compiled in only when DECIM_PROF_ENABLE is defined, macros expand to nothing otherwise. */
+/* Stage times are accumulated over a frame & recorded at frame end, */
+/* giving per-frame min/mean/p99/max & worst frame breakdown. */
+/* Time base: GPT0 on C55x (CPU cycles), TSC on x86 host, clock_gettime (ns) elsewhere. */
+/* State is per instance: each DecimPipe records into DecimProf attached by decimPipeSetProf(), */
+/* so pipelines run by different threads never share state. */
+/* Instance used by one thread at a time, NULL instance records nothing. */
+
+#define DECIM_PROF_STAGE_CIC        ( 0 )   /* CIC */
+#define DECIM_PROF_STAGE_FIR1       ( 1 )   /* FIR cascade stage 1, stage j at FIR1+j */
+#define DECIM_PROF_STAGE_FIR2       ( 2 )   /* FIR cascade stage 2 */
+#define DECIM_PROF_STAGE_FIR3       ( 3 )   /* FIR cascade stage 3 */
+#define DECIM_PROF_STAGE_FIR4       ( 4 )   /* FIR cascade stage 4 */
+#define DECIM_PROF_STAGE_GAIN       ( 5 )   /* digital gain */
+#define DECIM_PROF_STAGE_IIR        ( 6 )   /* block IIR, profiled by caller */
+#define DECIM_PROF_STAGE_FRAME      ( 7 )   /* whole frame */
+#define DECIM_PROF_NUM_STAGES       ( 8 )
+
+#define DECIM_PROF_HIST_SUB_BINS    ( 8 )   /* histogram bins per octave */
+#define DECIM_PROF_HIST_OCTAVES     ( 24 )  /* histogram octaves above 8 */
+#define DECIM_PROF_HIST_LEN         ( DECIM_PROF_HIST_SUB_BINS*(DECIM_PROF_HIST_OCTAVES+1) )
+
+/* Stage statistics */
+typedef struct
+{
+    Uint32 numFrames;       /* number of frames with stage */
+    Uint32 minTime;         /* minimum time per frame */
+    Uint32 meanTime;        /* mean time per frame */
+    Uint32 p99Time;         /* 99th percentile time per frame, histogram bin upper edge */
+    Uint32 maxTime;         /* maximum time per frame */
+    Uint32 maxFrame;        /* frame number of maximum time */
+} DecimProfStats;
+
+/* Worst frame, largest DECIM_PROF_STAGE_FRAME time */
+typedef struct
+{
+    Uint32 frame;           /* frame number */
+    Uint32 time[DECIM_PROF_NUM_STAGES]; /* time of each stage in frame */
+} DecimProfWorst;
+
+/* Profiling state */
+typedef struct
+{
+    Uint32 frame;           /* current frame number */
+    Uint32 cur[DECIM_PROF_NUM_STAGES];      /* current frame time per stage */
+    Uint16 used[DECIM_PROF_NUM_STAGES];     /* stage used in current frame */
+    Uint32 numFrames[DECIM_PROF_NUM_STAGES];
+    Uint32 minTime[DECIM_PROF_NUM_STAGES];
+    Uint32 maxTime[DECIM_PROF_NUM_STAGES];
+    Uint32 maxFrame[DECIM_PROF_NUM_STAGES];
+    Uint64 sumTime[DECIM_PROF_NUM_STAGES];
+    Uint32 hist[DECIM_PROF_NUM_STAGES][DECIM_PROF_HIST_LEN];
+    DecimProfWorst worst;   /* worst frame */
+} DecimProf;
+
+/* Starts time base, shared by all instances. */
+void decimProfInit(void);
+
+/* Clears statistics. */
+void decimProfReset(
+    DecimProf *pProf        /* profiling state */
+);
+
+/* Returns current time, up counting, wraps at 2^32. */
+Uint32 decimProfNow(void);
+
+/* Adds time to stage in current frame. */
+void decimProfAdd(
+    DecimProf *pProf,       /* profiling state, may be NULL */
+    Uint16 stage,           /* DECIM_PROF_STAGE_xxx */
+    Uint32 ticks            /* elapsed time base ticks */
+);
+
+/* Records current frame stage times & starts next frame. */
+void decimProfFrameEnd(
+    DecimProf *pProf        /* profiling state, may be NULL */
+);
+
+/* Reads stage statistics. */
+void decimProfGetStats(
+    DecimProf *pProf,       /* profiling state */
+    Uint16 stage,           /* DECIM_PROF_STAGE_xxx */
+    DecimProfStats *pStats  /* stage statistics */
+);
+
+/* Reads worst frame. */
+void decimProfGetWorst(
+    DecimProf *pProf,       /* profiling state */
+    DecimProfWorst *pWorst  /* worst frame */
+);
+
+/* Returns time unit name: "cycles", "tsc" or "ns". */
+const char *decimProfUnit(void);
+
+#ifdef DECIM_PROF_ENABLE
+#define DECIM_PROF_INIT()               decimProfInit()
+#define DECIM_PROF_DECL(t)              Uint32 t;
+#define DECIM_PROF_START(t)             ( (t) = decimProfNow() )
+#define DECIM_PROF_STOP(pProf, stage, t)    decimProfAdd((pProf), (stage), decimProfNow() - (t))
+#define DECIM_PROF_FRAME_END(pProf)     decimProfFrameEnd(pProf)
+#else
+#define DECIM_PROF_INIT()
+#define DECIM_PROF_DECL(t)
+#define DECIM_PROF_START(t)
+#define DECIM_PROF_STOP(pProf, stage, t)
+#define DECIM_PROF_FRAME_END(pProf)
+#endif
+
+#endif /* __DECIM_PROF_H__ */
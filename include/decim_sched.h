@@ -0,0 +1,190 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+#ifndef __DECIM_SCHED_H__
+#define __DECIM_SCHED_H__
+
+#include <pthread.h>
+#include "data_types.h"
+#include "decim_pipe.h"
+
+/* Work-stealing scheduler running decimation pipelines of many streams */
+/* on a pool of worker threads. Host only (POSIX threads). */
+/* Each stream has a frame FIFO & a scheduled flag: a stream with pending */
+/* frames sits in exactly one worker deque or is run by exactly one worker, */
+/* so frames of a stream are processed in submission order, */
+/* while different streams run in parallel. */
+
+#define DECIM_SCHED_MAX_WORKERS     ( 64 )      /* maximum number of worker threads */
+#define DECIM_SCHED_MAX_STREAMS     ( 1024 )    /* maximum number of streams */
+#define DECIM_SCHED_QUEUE_LEN       ( 8 )       /* frame FIFO length per stream */
+
+#define DECIM_SCHED_OK              ( 0 )   /* success */
+#define DECIM_SCHED_ERR_WORKERS     ( -1 )  /* invalid number of workers */
+#define DECIM_SCHED_ERR_STREAM      ( -2 )  /* invalid or unused stream ID */
+#define DECIM_SCHED_ERR_FULL        ( -3 )  /* stream frame FIFO full */
+#define DECIM_SCHED_ERR_THREAD      ( -4 )  /* thread creation failed */
+
+/* Frame completion callback, called on worker thread after frame is processed */
+typedef void (*DecimSchedDoneFxn)(
+    void *pArg,             /* stream callback argument */
+    Uint16 streamId,        /* stream ID */
+    Int16 *outSamps,        /* output samples (S16Q15) */
+    Uint16 numOutSamps      /* number of output samples */
+);
+
+/* Frame of one stream */
+typedef struct
+{
+    Uint32 *lData;          /* "left" channel 32-bit packed input data */
+    Uint32 *rData;          /* "right" channel 32-bit packed input data */
+    Int16 *outSamps;        /* output samples (S16Q15) */
+} DecimSchedFrame;
+
+/* Stream */
+typedef struct
+{
+    DecimPipe *pPipe;       /* pipeline instance, NULL if stream unused */
+    DecimSchedDoneFxn done; /* frame completion callback, may be NULL */
+    void *pArg;             /* callback argument */
+    pthread_mutex_t lock;   /* protects FIFO & scheduled flag */
+    DecimSchedFrame fifo[DECIM_SCHED_QUEUE_LEN];    /* frame FIFO */
+    Uint16 head;            /* FIFO index of oldest frame */
+    Uint16 count;           /* number of frames in FIFO */
+    Uint16 scheduled;       /* 1 if stream is in a worker deque or running */
+    Uint32 numFrames;       /* number of frames processed */
+} DecimSchedStream;
+
+/* Worker deque of ready stream IDs, pushed at bottom, popped at top by owner & thieves */
+typedef struct
+{
+    pthread_mutex_t lock;   /* protects deque */
+    Uint16 ids[DECIM_SCHED_MAX_STREAMS];    /* ring of stream IDs */
+    Uint16 top;             /* ring index of top entry */
+    Uint16 count;           /* number of entries */
+} DecimSchedDeque;
+
+/* Worker */
+typedef struct
+{
+    struct DecimSched_s *pSched;    /* scheduler */
+    Uint16 workerId;        /* worker index */
+    pthread_t thread;       /* worker thread */
+    DecimSchedDeque deque;  /* ready streams */
+    Uint32 numFrames;       /* number of frames processed */
+    Uint32 numSteals;       /* number of streams stolen from other workers */
+    Uint64 busyNs;          /* time spent processing frames (ns) */
+} DecimSchedWorker;
+
+/* Scheduler */
+typedef struct DecimSched_s
+{
+    DecimSchedWorker worker[DECIM_SCHED_MAX_WORKERS];
+    DecimSchedStream stream[DECIM_SCHED_MAX_STREAMS];
+    Uint16 numWorkers;      /* number of worker threads */
+    Uint16 stop;            /* set to stop workers */
+    Uint32 numReady;        /* number of streams in worker deques */
+    Uint32 curDepth;        /* number of submitted, unfinished frames */
+    Uint32 maxDepth;        /* maximum of curDepth */
+    Uint32 numSubmitted;    /* number of frames submitted */
+    Uint32 numRejected;     /* number of frames rejected, FIFO full */
+    pthread_mutex_t idleLock;   /* protects sleeping & draining */
+    pthread_cond_t workCond;    /* signaled when stream becomes ready */
+    pthread_cond_t drainCond;   /* signaled when curDepth drops to 0 */
+    Uint64 startNs;         /* start time (ns) */
+} DecimSched;
+
+/* Scheduler statistics */
+typedef struct
+{
+    Uint32 numFrames;       /* number of frames processed */
+    Uint32 numSubmitted;    /* number of frames submitted */
+    Uint32 numRejected;     /* number of frames rejected, FIFO full */
+    Uint32 numSteals;       /* number of streams stolen */
+    Uint32 curDepth;        /* number of submitted, unfinished frames */
+    Uint32 maxDepth;        /* maximum number of submitted, unfinished frames */
+    Uint32 numReady;        /* number of streams waiting in worker deques */
+    Float64 elapsedSec;     /* time since decimSchedInit() (s) */
+    Float64 framesPerSec;   /* processed frames per second */
+    Float64 outSampsPerSec; /* output samples per second */
+    Float64 utilization;    /* mean worker busy fraction */
+} DecimSchedStats;
+
+/* Initializes scheduler & starts numWorkers worker threads. */
+/* Scheduler is large, allocate statically or on heap. */
+/* Returns DECIM_SCHED_OK or DECIM_SCHED_ERR_xxx. */
+Int16 decimSchedInit(
+    DecimSched *pSched,     /* scheduler */
+    Uint16 numWorkers       /* number of worker threads */
+);
+
+/* Adds stream running initialized pipeline instance pPipe. */
+/* Profiling state attached by decimPipeSetProf() must be per stream, */
+/* one worker at a time runs a stream. */
+/* Returns DECIM_SCHED_OK or DECIM_SCHED_ERR_STREAM. */
+Int16 decimSchedAddStream(
+    DecimSched *pSched,     /* scheduler */
+    Uint16 streamId,        /* stream ID, 0->DECIM_SCHED_MAX_STREAMS-1 */
+    DecimPipe *pPipe,       /* pipeline instance */
+    DecimSchedDoneFxn done, /* frame completion callback, may be NULL */
+    void *pArg              /* callback argument */
+);
+
+/* Submits frame of stream, returns immediately. */
+/* Buffers must stay valid until completion callback. */
+/* Returns DECIM_SCHED_OK, DECIM_SCHED_ERR_STREAM, */
+/* or DECIM_SCHED_ERR_FULL if stream has DECIM_SCHED_QUEUE_LEN frames pending. */
+Int16 decimSchedSubmit(
+    DecimSched *pSched,     /* scheduler */
+    Uint16 streamId,        /* stream ID */
+    Uint32 *lData,          /* "left" channel 32-bit packed input data */
+    Uint32 *rData,          /* "right" channel 32-bit packed input data */
+    Int16 *outSamps         /* output samples (S16Q15) */
+);
+
+/* Waits until all submitted frames are processed. */
+void decimSchedDrain(
+    DecimSched *pSched      /* scheduler */
+);
+
+/* Reads scheduler statistics. */
+void decimSchedGetStats(
+    DecimSched *pSched,     /* scheduler */
+    DecimSchedStats *pStats /* statistics */
+);
+
+/* Drains scheduler & stops worker threads. */
+void decimSchedStop(
+    DecimSched *pSched      /* scheduler */
+);
+
+#endif /* __DECIM_SCHED_H__ */
@@ -45,4 +45,92 @@ void appDiggain(
     Uint16  numInSamps  /* number of input samples */
 );
 
+/* Applies digital gain and saturates output, host 32-bit arithmetic. */
+/* S18Q16 input data, S16Q15 output data. */
+/* U16Q8 digital gain. */
+/* Output bit-exact with appDiggain(). */
+void appDiggainHost(
+    Int32   *inSamps,   /* input samples (S18Q16) */
+    Uint16  diggain,    /* digital gain (U16Q8) */
+    Int16   *outSamps,  /* output samples (S16Q15) */
+    Uint16  numInSamps  /* number of input samples */
+);
+
+/* Digital gain kernel, same calling convention as appDiggain() */
+typedef void (*DiggainFxn)(
+    Int32   *inSamps,       /* input samples (S18Q16) */
+    Uint16  diggain,        /* digital gain (U16Q8) */
+    Int16   *outSamps,      /* output samples (S16Q15) */
+    Uint16  numInSamps      /* number of input samples */
+);
+
+#define DIGGAIN_UNITY           ( (Uint16)1<<8 )    /* 1.0 (0 dB) in U16Q8 */
+
+#define DIGGAIN_RAMP_LIN        ( 0 )   /* linear gain ramp over rampLen samples */
+#define DIGGAIN_RAMP_EXP        ( 1 )   /* exponential gain ramp, expCoef per segment */
+#define DIGGAIN_EXP_SEG_LEN     ( 16 )  /* exponential ramp segment length, linear within segment */
+
+/* Digital gain stage state */
+typedef struct
+{
+    Uint32 curGain;         /* current gain (U16Q24) */
+    Uint32 tgtGain;         /* target gain (U16Q24) */
+    Uint16 rampMode;        /* DIGGAIN_RAMP_LIN or DIGGAIN_RAMP_EXP */
+    Uint16 rampLen;         /* linear ramp length in samples */
+    Uint16 rampRem;         /* linear ramp remaining samples */
+    Int32 rampStep;         /* linear ramp gain step per sample (S16Q24) */
+    Uint16 expCoef;         /* exponential ramp remaining gain error fraction per segment (U0Q16) */
+    DiggainFxn constKernel; /* constant gain kernel */
+    Uint16 agcEnable;       /* AGC enable */
+    Uint16 agcTgtPeak;      /* AGC target output peak (U15Q15) */
+    Uint16 agcMinGain;      /* AGC minimum gain (U16Q8) */
+    Uint16 agcMaxGain;      /* AGC maximum gain (U16Q8) */
+    Uint16 agcAttack;       /* AGC attack, gain decrease smoothing shift */
+    Uint16 agcRelease;      /* AGC release, gain increase smoothing shift */
+    Uint32 agcGain;         /* AGC smoothed gain (U16Q24) */
+} DiggainState;
+
+/* Initializes digital gain stage at constant gain diggain. */
+/* Constant gain kernel NULL selects appDiggain(). */
+void diggainInit(
+    DiggainState *pState,   /* digital gain state */
+    Uint16  diggain,        /* initial digital gain (U16Q8) */
+    Uint16  rampMode,       /* DIGGAIN_RAMP_LIN or DIGGAIN_RAMP_EXP */
+    Uint16  rampLen,        /* linear ramp length in samples */
+    Uint16  expCoef,        /* exponential ramp remaining gain error fraction per segment (U0Q16) */
+    DiggainFxn constKernel  /* constant gain kernel */
+);
+
+/* Sets target gain, gain ramps from current to target gain. */
+void diggainSetGain(
+    DiggainState *pState,   /* digital gain state */
+    Uint16  diggain         /* target digital gain (U16Q8) */
+);
+
+/* Configures peak-tracking AGC. */
+/* Once per frame, target gain moves towards gain mapping frame input peak to tgtPeak, */
+/* smoothed by attack shift when decreasing & release shift when increasing, */
+/* limited to minGain->maxGain. */
+void diggainAgcConfig(
+    DiggainState *pState,   /* digital gain state */
+    Uint16  enable,         /* AGC enable */
+    Uint16  tgtPeak,        /* target output peak (U15Q15) */
+    Uint16  minGain,        /* minimum gain (U16Q8) */
+    Uint16  maxGain,        /* maximum gain (U16Q8) */
+    Uint16  attack,         /* gain decrease smoothing shift */
+    Uint16  release         /* gain increase smoothing shift */
+);
+
+/* Applies ramped digital gain and saturates output. */
+/* S18Q16 input data, S16Q15 output data. */
+/* Per-sample gain interpolated in U16Q24, applied rounded to U16Q8. */
+/* Constant gain runs constant gain kernel, unity gain runs multiply-free bypass, */
+/* both bit-exact with appDiggain(). */
+void diggainProcess(
+    DiggainState *pState,   /* digital gain state */
+    Int32   *inSamps,       /* input samples (S18Q16) */
+    Int16   *outSamps,      /* output samples (S16Q15) */
+    Uint16  numInSamps      /* number of input samples */
+);
+
 #endif /* __DIGGAIN_H__ */
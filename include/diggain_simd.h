@@ -0,0 +1,62 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+#ifndef __DIGGAIN_SIMD_H__
+#define __DIGGAIN_SIMD_H__
+
+#include "data_types.h"
+
+/* SIMD digital gain kernels. */
+/* Applies digital gain and saturates output. */
+/* S18Q16 input data, S16Q15 output data. */
+/* U16Q8 digital gain. */
+/* Output bit-exact with appDiggain(). */
+/* Kernels must only be called if cpuFeatures() reports required ISA, */
+/* on non-x86-64 builds they run appDiggainHost(). */
+
+/* SSE2, 8 samples per iteration */
+void appDiggainSse2(
+    Int32   *inSamps,   /* input samples (S18Q16) */
+    Uint16  diggain,    /* digital gain (U16Q8) */
+    Int16   *outSamps,  /* output samples (S16Q15) */
+    Uint16  numInSamps  /* number of input samples */
+);
+
+/* AVX2, 16 samples per iteration */
+void appDiggainAvx2(
+    Int32   *inSamps,   /* input samples (S18Q16) */
+    Uint16  diggain,    /* digital gain (U16Q8) */
+    Int16   *outSamps,  /* output samples (S16Q15) */
+    Uint16  numInSamps  /* number of input samples */
+);
+
+#endif /* __DIGGAIN_SIMD_H__ */
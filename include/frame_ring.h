@@ -0,0 +1,132 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+#ifndef __FRAME_RING_H__
+#define __FRAME_RING_H__
+
+#include "data_types.h"
+
+/* Lock-free frame descriptor ring between DMA completion (producer) */
+/* & processing loop (consumer). */
+/* One producer & one consumer: DMA ISR & main loop on target, */
+/* threads on host. Head written by producer only, tail by consumer only. */
+/* Producer tracks per channel DMA completions, so a late consumer */
+/* cannot desynchronize left & right channels. */
+
+#define FRAME_RING_LEN          ( 4 )   /* number of descriptors, power of 2 */
+#define FRAME_RING_MAX_BUFS     ( 16 )  /* maximum number of DMA frame buffers per channel */
+
+#define FRAME_RING_CHAN_LEFT    ( 0x1 ) /* "left" channel DMA transfer complete */
+#define FRAME_RING_CHAN_RIGHT   ( 0x2 ) /* "right" channel DMA transfer complete */
+
+#define FRAME_RING_OK           ( 0 )   /* success */
+#define FRAME_RING_ERR_BUFS     ( -1 )  /* invalid number of DMA frame buffers */
+#define FRAME_RING_ERR_FULL     ( -2 )  /* ring full, frame dropped */
+
+/* Frame descriptor */
+typedef struct
+{
+    Uint32 *lData;          /* "left" channel 32-bit packed input data */
+    Uint32 *rData;          /* "right" channel 32-bit packed input data */
+    Uint32 seq;             /* frame sequence number */
+    Uint32 timestamp;       /* DMA completion time, producer time base */
+} FrameDesc;
+
+/* Frame ring */
+typedef struct
+{
+    FrameDesc desc[FRAME_RING_LEN]; /* descriptors */
+    Uint16 head;            /* number of descriptors pushed, producer only */
+    Uint16 tail;            /* number of descriptors popped, consumer only */
+    Uint32 *bufLeft;        /* "left" channel DMA frame buffers */
+    Uint32 *bufRight;       /* "right" channel DMA frame buffers */
+    Uint16 frameLen;        /* number of words per channel per frame */
+    Uint16 numBufs;         /* number of DMA frame buffers per channel, 2 for ping/pong */
+    Uint16 numLeft;         /* number of "left" DMA transfers completed, producer only */
+    Uint16 numRight;        /* number of "right" DMA transfers completed, producer only */
+    Uint16 numComplete;     /* number of frames complete in both channels, low 16 bits of seq */
+    Uint32 seq;             /* next frame sequence number, producer only */
+    Uint32 numOverruns;     /* number of frames dropped on full ring, producer only */
+    Uint32 numStale;        /* number of frames overwritten before or during processing, consumer only */
+    Uint32 numFrames;       /* number of frames processed, consumer only */
+} FrameRing;
+
+/* Initializes frame ring for numBufs DMA frame buffers per channel. */
+/* Frame buffer i of channel starts at word i*frameLen. */
+Int16 frameRingInit(
+    FrameRing *pRing,       /* frame ring */
+    Uint32 *bufLeft,        /* "left" channel DMA frame buffers */
+    Uint32 *bufRight,       /* "right" channel DMA frame buffers */
+    Uint16 frameLen,        /* number of words per channel per frame */
+    Uint16 numBufs          /* number of DMA frame buffers per channel */
+);
+
+/* Pushes frame descriptor. Producer only. */
+/* Returns FRAME_RING_OK, or FRAME_RING_ERR_FULL & counts overrun. */
+Int16 frameRingPush(
+    FrameRing *pRing,       /* frame ring */
+    Uint32 *lData,          /* "left" channel 32-bit packed input data */
+    Uint32 *rData,          /* "right" channel 32-bit packed input data */
+    Uint32 timestamp        /* DMA completion time */
+);
+
+/* Records DMA transfer completions, pushes frames complete in both channels. */
+/* Producer only, called from DMA ISR. */
+void frameRingDmaDone(
+    FrameRing *pRing,       /* frame ring */
+    Uint16 chanMask,        /* FRAME_RING_CHAN_xxx completed */
+    Uint32 timestamp        /* DMA completion time */
+);
+
+/* Pops oldest frame still held in DMA frame buffer, stale frames skipped & counted. */
+/* Consumer only. Returns 1 if frame popped, 0 if ring empty. */
+Uint16 frameRingPop(
+    FrameRing *pRing,       /* frame ring */
+    FrameDesc *pDesc        /* popped frame descriptor */
+);
+
+/* Completes processing of popped frame. Consumer only. */
+/* Returns 1 if frame intact, 0 & counts stale frame if DMA overwrote it during processing. */
+Uint16 frameRingRelease(
+    FrameRing *pRing,       /* frame ring */
+    FrameDesc *pDesc        /* processed frame descriptor */
+);
+
+/* Reads counters. Consumer only. */
+void frameRingGetStats(
+    FrameRing *pRing,       /* frame ring */
+    Uint32 *pNumFrames,     /* number of frames processed */
+    Uint32 *pNumOverruns,   /* number of frames dropped on full ring */
+    Uint32 *pNumStale       /* number of stale frames */
+);
+
+#endif /* __FRAME_RING_H__ */
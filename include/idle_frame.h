@@ -0,0 +1,59 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+#ifndef __IDLE_FRAME_H__
+#define __IDLE_FRAME_H__
+
+#include "data_types.h"
+#include "frame_ring.h"
+#include "decim_pipe.h"
+
+/* IdleLoop frame schedule, shared by IdleLoop.c UserAlgorithm() & host idle_loop_sim. */
+
+#define IDLE_FRAME_NONE         ( 0 )   /* frame ring empty */
+#define IDLE_FRAME_OK           ( 1 )   /* frame processed, output valid */
+#define IDLE_FRAME_STALE        ( 2 )   /* DMA overwrote frame during processing, output invalid */
+
+/* Pops next frame from ring, runs it through numPipes pipelines & releases it to DMA. */
+/* Pipelines write same output frame, with numPipes > 1 (host load test running */
+/* copies of one pipeline) output is that of last pipeline. */
+/* Returns IDLE_FRAME_xxx. */
+Uint16 idleFrameNext(
+    FrameRing *pRing,       /* frame ring */
+    DecimPipe *pipes,       /* pipeline instances */
+    Uint16 numPipes,        /* number of pipelines */
+    Int16 *outSamps,        /* output samples (S16Q15) */
+    Uint16 *pNumOutSamps,   /* number of output samples */
+    FrameDesc *pFrame       /* processed frame descriptor */
+);
+
+#endif /* __IDLE_FRAME_H__ */
@@ -0,0 +1,118 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+
+#ifndef __PDM_FIR_H__
+#define __PDM_FIR_H__
+
+#include "data_types.h"
+
+#define PDM_FIR_BITS_PER_BYTE   ( 8 )
+#define PDM_FIR_NUM_BYTE_VALS   ( 256 )
+#define PDM_FIR_MAX_COEFS       ( 512 ) /* maximum number of coefficients */
+#define PDM_FIR_MAX_TBL_ROWS    ( PDM_FIR_MAX_COEFS/PDM_FIR_BITS_PER_BYTE )
+#define PDM_FIR_MIN_COEF_Q      ( 16 )  /* coefficient fraction bits >= output fraction bits */
+#define PDM_FIR_MAX_COEF_Q      ( 30 )
+
+#define PDM_FIR_OK              ( 0 )   /* success */
+#define PDM_FIR_ERR_NUM_COEFS   ( -1 )  /* numCoefs not a multiple of 8 or out of range */
+#define PDM_FIR_ERR_COEF_Q      ( -2 )  /* coefQ out of range */
+#define PDM_FIR_ERR_DF          ( -3 )  /* unsupported decimation factor */
+
+/* Typical front end replacing CIC + FIR1: */
+/* 256 coefficients, cutoff 16 kHz at 1.024 MHz (0.015625), decimation by 32. */
+/* Output at 32 kHz feeds blkFirDecim2() FIR2 stage directly. */
+
+/* Per-byte coefficient partial sums, shared by all channels using the same filter. */
+/* Row g holds, for each byte value, sum of coefs[8g+b]*(+1/-1) over bits b, */
+/* b = 0 being the LS (most recent) bit. */
+typedef struct
+{
+    Int32 tbl[PDM_FIR_MAX_TBL_ROWS][PDM_FIR_NUM_BYTE_VALS];
+    Uint16 numCoefs;        /* number of coefficients, multiple of 8 */
+    Uint16 numRows;         /* numCoefs/8 */
+    Uint16 decimFact;       /* decimation factor: 8, 16, 32 or 64 */
+    Uint16 outShift;        /* coefQ-16 */
+} PdmFirTbl;
+
+/* Per-channel input history. */
+/* Byte history is mirrored (stored twice, numRows apart) */
+/* so the newest numRows bytes are always contiguous from histIdx. */
+typedef struct
+{
+    Uint16 hist[2*PDM_FIR_MAX_TBL_ROWS];    /* byte history, newest first */
+    Uint16 histIdx;                         /* index of newest byte */
+} PdmFirState;
+
+/* Builds per-byte partial sum table. */
+/* Coefficients are S16Q(coefQ), coefs[0] applies to the most recent input bit. */
+/* Returns PDM_FIR_OK or PDM_FIR_ERR_xxx. */
+Int16 pdmFirTblInit(
+    PdmFirTbl *pTbl,        /* per-byte partial sum table */
+    const Int16 *coefs,     /* filter coefficients (S16Q(coefQ)) */
+    Uint16 numCoefs,        /* number of coefficients, multiple of 8 */
+    Uint16 coefQ,           /* coefficient fraction bits */
+    Uint16 decimFact        /* decimation factor: 8, 16, 32 or 64 */
+);
+
+/* Initializes input history to idle pattern (alternating 0/1, zero mean). */
+void pdmFirStateInit(
+    PdmFirState *pState     /* per-channel input history */
+);
+
+/* Decimating FIR applied directly to 1-bit PDM input, */
+/* same input contract as pickBitsCic(), */
+/* S18Q16 output data. */
+/* Number of output samples is inDataLen*64/decimFact. */
+void pdmFirDecim(
+    Uint32 *lData,          /* "left" channel 32-bit packed input data */
+    Uint32 *rData,          /* "right" channel 32-bit packed input data */
+    Uint16 inDataLen,       /* length of "left" or "right" input data in 32-bit words */
+    const PdmFirTbl *pTbl,  /* per-byte partial sum table */
+    PdmFirState *pState,    /* per-channel input history */
+    Int32 *outSamps,        /* output samples (S18Q16) */
+    Uint16 *pNumOutSamps    /* number of output samples */
+);
+
+/* Designs Blackman-windowed sinc low-pass filter with unity DC gain. */
+/* Cutoff is normalized to PDM bit rate (0 < cutoff < 0.5). */
+/* Coefficient fraction bits are chosen to maximize precision, */
+/* returned in *pCoefQ for pdmFirTblInit(). */
+/* Returns PDM_FIR_OK or PDM_FIR_ERR_xxx. */
+Int16 pdmFirDesign(
+    Int16 *coefs,           /* designed coefficients (S16Q(*pCoefQ)) */
+    Uint16 numCoefs,        /* number of coefficients, multiple of 8 */
+    Float64 cutoff,         /* cutoff frequency / PDM bit rate */
+    Uint16 *pCoefQ          /* coefficient fraction bits */
+);
+
+#endif /* __PDM_FIR_H__ */
@@ -50,6 +50,31 @@ void pickBitsCic(
     Uint16 *pNumOutSamps    /* CIC number of output samples */
 );
 
+#define CIC_MAX_NS          ( 6 )   /* maximum number of stages supported by per-byte CIC table */
+#define CIC_NUM_BYTE_VALS   ( 256 ) /* number of entries in per-byte CIC table */
+
+/* Per-byte integrator contribution table, built by pickBitsCicTblInit(). */
+/* Stage contributions do not depend on number of stages, */
+/* so first N entries of each row serve an N-stage CIC. */
+extern Int32 cicByteTbl[CIC_NUM_BYTE_VALS][CIC_MAX_NS];
+
+/* Builds per-byte integrator contribution table used by pickBitsCicTbl(). */
+/* Must be called before first call to pickBitsCicTbl(). */
+/* On host table built on first call only, safe to call from concurrent threads. */
+void pickBitsCicTblInit(void);
+
+/* Unpacks "left" and "right" 32-bit packed DMA buffers containing output from digital mic. */
+/* Performs CIC on unpacked data, DS = 16 & NS = 4. */
+/* Table-driven: integrates 8 input bits per step, bit-exact with pickBitsCic(). */
+void pickBitsCicTbl(
+    Uint32 *lData,          /* "left" channel 32-bit packed input data */
+    Uint32 *rData,          /* "right" channel 32-bit packed input data */
+    Uint16 inDataLen,       /* length of "left" or "right" input data in 32-bit words */
+    Int32 *cicState,        /* CIC state. First NS values are integrator state, next NS values are differentiator delay buffer */
+    Int32 *outSamps,        /* CIC output samples */
+    Uint16 *pNumOutSamps    /* CIC number of output samples */
+);
+
 #endif  
 
 /* __PICK_BITS_CIC_H__ */
@@ -0,0 +1,93 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+
+#ifndef __PICK_BITS_CIC_CFG_H__
+#define __PICK_BITS_CIC_CFG_H__
+
+#include "data_types.h"
+#include "pick_bits_cic.h"
+
+#define CIC_CFG_MIN_NS          ( 3 )   /* minimum number of stages */
+#define CIC_CFG_MAX_NS          ( CIC_MAX_NS )  /* maximum number of stages */
+#define CIC_CFG_MAX_GAIN_LOG2   ( 31 )  /* max. log2(R^N), CIC output must fit in Int32 */
+
+#define CIC_CFG_OK              ( 0 )   /* success */
+#define CIC_CFG_ERR_DF          ( -1 )  /* unsupported decimation factor */
+#define CIC_CFG_ERR_NS          ( -2 )  /* unsupported number of stages */
+#define CIC_CFG_ERR_GAIN        ( -3 )  /* CIC gain R^N overflows Int32 */
+
+/* CIC kernel, same calling convention as pickBitsCic() */
+typedef void (*CicKernelFxn)(
+    Uint32 *lData,          /* "left" channel 32-bit packed input data */
+    Uint32 *rData,          /* "right" channel 32-bit packed input data */
+    Uint16 inDataLen,       /* length of "left" or "right" input data in 32-bit words */
+    Int32 *cicState,        /* CIC state. First NS values are integrator state, next NS values are differentiator delay buffer */
+    Int32 *outSamps,        /* CIC output samples */
+    Uint16 *pNumOutSamps    /* CIC number of output samples */
+);
+
+/* CIC configuration */
+typedef struct
+{
+    Uint16 decimFact;       /* decimation factor R: 8, 16, 32 or 64 */
+    Uint16 numStages;       /* number of stages N: 3..6 */
+    Uint16 gainLog2;        /* CIC DC gain R^N = 2^gainLog2 */
+    CicKernelFxn kernel;    /* unrolled kernel for (R, N) */
+} CicCfg;
+
+/* Selects CIC decimation factor & number of stages. */
+/* Binds fully unrolled kernel for (R, N) and builds per-byte CIC table. */
+/* CIC state passed to cicCfgProcess() holds 2*N values, */
+/* first N are integrator state, next N are differentiator delay buffer. */
+/* Returns CIC_CFG_OK or CIC_CFG_ERR_xxx. */
+Int16 cicCfgInit(
+    CicCfg *pCfg,           /* CIC configuration */
+    Uint16 decimFact,       /* decimation factor R */
+    Uint16 numStages        /* number of stages N */
+);
+
+/* Unpacks "left" and "right" 32-bit packed DMA buffers containing output from digital mic. */
+/* Performs CIC on unpacked data, R & N as configured. */
+/* Number of output samples is inDataLen*64/R. */
+/* CIC_DF = 16 & CIC_NS = 4 is bit-exact with pickBitsCic(). */
+void cicCfgProcess(
+    CicCfg *pCfg,           /* CIC configuration */
+    Uint32 *lData,          /* "left" channel 32-bit packed input data */
+    Uint32 *rData,          /* "right" channel 32-bit packed input data */
+    Uint16 inDataLen,       /* length of "left" or "right" input data in 32-bit words */
+    Int32 *cicState,        /* CIC state, 2*N values */
+    Int32 *outSamps,        /* CIC output samples */
+    Uint16 *pNumOutSamps    /* CIC number of output samples */
+);
+
+#endif /* __PICK_BITS_CIC_CFG_H__ */
@@ -0,0 +1,73 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+
+#ifndef __PICK_BITS_CIC_MC_H__
+#define __PICK_BITS_CIC_MC_H__
+
+#include "data_types.h"
+#include "pick_bits_cic.h"
+
+#define CIC_MC_MAX_CH   ( 16 )  /* maximum number of channels */
+
+/* Multi-channel CIC state, structure-of-arrays: */
+/* one row per stage, one column per channel. */
+typedef struct
+{
+    Int32 acc[CIC_NS][CIC_MC_MAX_CH];       /* integrator state */
+    Int32 diffDly[CIC_NS][CIC_MC_MAX_CH];   /* differentiator delay buffer */
+    Uint16 numCh;                           /* number of channels */
+} CicMcState;
+
+/* Initializes multi-channel CIC state. */
+/* Clears integrator & differentiator state and builds per-byte CIC table. */
+/* Returns 0 on success, -1 if numCh out of range. */
+Int16 pickBitsCicMcInit(
+    CicMcState *pState,     /* multi-channel CIC state */
+    Uint16 numCh            /* number of channels, 1..CIC_MC_MAX_CH */
+);
+
+/* Multi-channel pickBitsCic(). */
+/* Each channel has its own "left" and "right" 32-bit packed input buffers, */
+/* CIC_DF = 16 & CIC_NS = 4. */
+/* Channels are processed in SIMD lanes (AVX2: 8, SSE2: 4), remaining channels are scalar. */
+/* Output of each channel is bit-exact with pickBitsCic(). */
+void pickBitsCicMc(
+    Uint32 **lData,         /* per-channel "left" 32-bit packed input data */
+    Uint32 **rData,         /* per-channel "right" 32-bit packed input data */
+    Uint16 inDataLen,       /* length of "left" or "right" input data in 32-bit words */
+    CicMcState *pState,     /* multi-channel CIC state */
+    Int32 **outSamps,       /* per-channel CIC output samples */
+    Uint16 *pNumOutSamps    /* CIC number of output samples per channel */
+);
+
+#endif /* __PICK_BITS_CIC_MC_H__ */
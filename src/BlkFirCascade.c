@@ -0,0 +1,237 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+
+#include <stddef.h>
+#include "data_types.h"
+#include "BlkFirDecim.h"
+#include "diggain.h"
+#include "BlkFirCascade.h"
+#include "decim_prof.h"
+
+/* Initializes cascade of numStages decimate-by-2 FIR stages. */
+Int16 blkFirCascadeInit(
+    BlkFirCascade *pCasc,   /* FIR cascade */
+    Uint16 numStages,       /* number of stages */
+    Uint16 tileLen          /* number of 1st stage input samples per tile */
+)
+{
+    Uint16 i;
+
+    if ((numStages == 0) || (numStages > BLK_FIR_CASC_MAX_STAGES))
+    {
+        return BLK_FIR_CASC_ERR_NS;
+    }
+
+    /* Every stage needs even number of outputs per tile */
+    if ((tileLen == 0) || (tileLen > BLK_FIR_CASC_MAX_TILE_LEN) ||
+        (tileLen % (4<<(numStages-1)) != 0))
+    {
+        return BLK_FIR_CASC_ERR_TILE;
+    }
+
+    for (i = 0; i < BLK_FIR_CASC_MAX_STAGES; i++)
+    {
+        pCasc->stage[i].coefs = NULL;
+        pCasc->stage[i].numCoefs = 0;
+        pCasc->stage[i].dlyBuf = NULL;
+        pCasc->stage[i].kernel = blkFirDecim2;
+    }
+    pCasc->numStages = numStages;
+    pCasc->tileLen = tileLen;
+    pCasc->diggain = (Uint16)1<<8; /* 1.0 (0 dB) in U16Q8 */
+    pCasc->gainKernel = appDiggain;
+    pCasc->pProf = NULL;
+
+    return BLK_FIR_CASC_OK;
+}
+
+/* Sets FIR stage. */
+Int16 blkFirCascadeSetStage(
+    BlkFirCascade *pCasc,   /* FIR cascade */
+    Uint16 stageIdx,        /* stage index */
+    Int16 *coefs,           /* filter coefficients (S16Q15) */
+    Uint16 numCoefs,        /* number of coefficients */
+    Int32 *dlyBuf,          /* delay buffer */
+    BlkFirDecim2Fxn kernel  /* stage kernel */
+)
+{
+    if (stageIdx >= pCasc->numStages)
+    {
+        return BLK_FIR_CASC_ERR_NS;
+    }
+
+    pCasc->stage[stageIdx].coefs = coefs;
+    pCasc->stage[stageIdx].numCoefs = numCoefs;
+    pCasc->stage[stageIdx].dlyBuf = dlyBuf;
+    pCasc->stage[stageIdx].kernel = (kernel != NULL) ? kernel : blkFirDecim2;
+
+    return BLK_FIR_CASC_OK;
+}
+
+/* Sets digital gain applied by blkFirCascadeProcessGain(). */
+void blkFirCascadeSetGain(
+    BlkFirCascade *pCasc,   /* FIR cascade */
+    Uint16 diggain,         /* digital gain (U16Q8) */
+    DiggainFxn gainKernel   /* digital gain kernel */
+)
+{
+    pCasc->diggain = diggain;
+    pCasc->gainKernel = (gainKernel != NULL) ? gainKernel : appDiggain;
+}
+
+/* Returns fused FIR & gain kernel with same delay buffer layout as stage kernel, NULL if none. */
+/* On target, asm FIR & asm gain outrun C fused kernel, so none is fused. */
+static BlkFirDecim2GainFxn blkFirCascadeFusedKernel(
+    BlkFirDecim2Fxn kernel  /* stage kernel */
+)
+{
+#ifdef __TMS320C55X__
+    (void)kernel;
+#else
+    if (kernel == blkFirDecim2)
+    {
+        return blkFirDecim2Gain;
+    }
+    if (kernel == blkFirDecim2Host)
+    {
+        return blkFirDecim2GainHost;
+    }
+#endif
+
+    return NULL;
+}
+
+/* Runs all FIR stages tile by tile, */
+/* last stage writes outSamps, or if gainOutSamps not NULL, */
+/* runs fused with gain or writes tile buffer followed by gain epilogue. */
+static Int16 blkFirCascadeRun(
+    BlkFirCascade *pCasc,   /* FIR cascade */
+    Int32 *inSamps,         /* input samples (S18Q16) */
+    Int32 *outSamps,        /* output samples (S18Q16) */
+    Int16 *gainOutSamps,    /* gain output samples (S16Q15) */
+    Uint16 numInSamps       /* number of input samples */
+)
+{
+    BlkFirStage *pStage;
+    BlkFirDecim2GainFxn fusedKernel;
+    Uint16 numStages;
+    Uint16 tileLen;
+    Uint16 stageInLen;
+    Int32 *pIn, *pOut;
+    Uint16 inSampIdx;
+    Uint16 j;
+    DECIM_PROF_DECL(t)
+
+    numStages = pCasc->numStages;
+
+    if (numInSamps % (4<<(numStages-1)) != 0)
+    {
+        return BLK_FIR_CASC_ERR_LEN;
+    }
+
+    fusedKernel = NULL;
+    if (gainOutSamps != NULL)
+    {
+        fusedKernel = blkFirCascadeFusedKernel(pCasc->stage[numStages-1].kernel);
+    }
+
+    inSampIdx = 0;
+    while (inSampIdx < numInSamps)
+    {
+        /* Last tile may be short */
+        tileLen = numInSamps - inSampIdx;
+        if (tileLen > pCasc->tileLen)
+        {
+            tileLen = pCasc->tileLen;
+        }
+
+        /* Pass tile through all stages, */
+        /* stage j writes tile buffer j&1, last stage writes output */
+        pIn = &inSamps[inSampIdx];
+        stageInLen = tileLen;
+        pStage = &pCasc->stage[0];
+        for (j = 0; j < numStages; j++)
+        {
+            if ((j == numStages-1) && (fusedKernel != NULL))
+            {
+                /* Last stage & gain in one pass, profiled as last FIR stage */
+                DECIM_PROF_START(t);
+                fusedKernel(pIn, pStage->coefs, &gainOutSamps[inSampIdx>>numStages], pStage->dlyBuf,
+                    pCasc->diggain, stageInLen, pStage->numCoefs);
+                DECIM_PROF_STOP(pCasc->pProf, DECIM_PROF_STAGE_FIR1 + j, t);
+                break;
+            }
+            pOut = ((j == numStages-1) && (gainOutSamps == NULL)) ? &outSamps[inSampIdx>>numStages] : pCasc->tileBuf[j&1];
+            DECIM_PROF_START(t);
+            pStage->kernel(pIn, pStage->coefs, pOut, pStage->dlyBuf, stageInLen, pStage->numCoefs);
+            DECIM_PROF_STOP(pCasc->pProf, DECIM_PROF_STAGE_FIR1 + j, t);
+            pIn = pOut;
+            stageInLen >>= 1;
+            pStage++;
+        }
+
+        /* Apply gain to last stage output while in tile buffer */
+        if ((gainOutSamps != NULL) && (fusedKernel == NULL))
+        {
+            DECIM_PROF_START(t);
+            pCasc->gainKernel(pIn, pCasc->diggain, &gainOutSamps[inSampIdx>>numStages], stageInLen);
+            DECIM_PROF_STOP(pCasc->pProf, DECIM_PROF_STAGE_GAIN, t);
+        }
+
+        inSampIdx += tileLen;
+    }
+
+    return BLK_FIR_CASC_OK;
+}
+
+/* Runs all FIR stages tile by tile. */
+Int16 blkFirCascadeProcess(
+    BlkFirCascade *pCasc,   /* FIR cascade */
+    Int32 *inSamps,         /* input samples (S18Q16) */
+    Int32 *outSamps,        /* output samples (S18Q16) */
+    Uint16 numInSamps       /* number of input samples */
+)
+{
+    return blkFirCascadeRun(pCasc, inSamps, outSamps, NULL, numInSamps);
+}
+
+/* Runs all FIR stages tile by tile, digital gain applied to last stage output tiles. */
+Int16 blkFirCascadeProcessGain(
+    BlkFirCascade *pCasc,   /* FIR cascade */
+    Int32 *inSamps,         /* input samples (S18Q16) */
+    Int16 *outSamps,        /* output samples (S16Q15) */
+    Uint16 numInSamps       /* number of input samples */
+)
+{
+    return blkFirCascadeRun(pCasc, inSamps, NULL, outSamps, numInSamps);
+}
@@ -33,6 +33,8 @@
 
 #include "data_types.h"
 #include "BlkFirDecim.h"
+#include "BlkAcc40.h"
+#include "BlkFirDotHost.h"
 
 #define DECIM_FACT          ( 2 )   /* decimation factor */
 
@@ -207,9 +209,9 @@ void blkFirDecim2(
         acc2_40b += (Uint16)1<<14; /* round to infinite */
         acc0_40b += (Uint16)1<<14; /* round to infinite */
 #endif
-        acc2_40b >>= 15; /* truncate */
+        acc2_40b = ACC40(acc2_40b) >> 15; /* truncate */
         outSamps[outSampIdx++] = (Int32)acc2_40b;
-        acc0_40b >>= 15; /* truncate */
+        acc0_40b = ACC40(acc0_40b) >> 15; /* truncate */
         outSamps[outSampIdx++] = (Int32)acc0_40b;
 
         /* Place D-1=1 samples in delay line at lagging index */
@@ -224,3 +226,895 @@ void blkFirDecim2(
     /* Write delay index of oldest sample */
     dlyBuf[0] = dlyBufIdx_2-1; // adjust index to 0->numDlySamps-1
 }
+
+/* Checks coefficients for even symmetry, coefs[i] == coefs[numCoefs-1-i]. */
+Int16 blkFirCoefsSym(
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Uint16  numCoefs        /* number of coefficients */
+)
+{
+    Uint16 i;
+
+    for (i = 0; i < numCoefs/2; i++)
+    {
+        if (coefs[i] != coefs[numCoefs-1-i])
+        {
+            return BLK_FIR_ERR_NOT_SYM;
+        }
+    }
+
+    return BLK_FIR_OK;
+}
+
+/* Block decimating FIR, symmetric (linear-phase) coefficients, */
+/* S18Q16 input and output data, */
+/* S16Q15 coefficients. */
+/* Decimation factor fixed at 2. */
+/* Computes two outputs per inner loop (assumes even number of outputs). */
+/* Pre-adds mirrored delay line samples, one multiply per coefficient pair. */
+Int16 blkFirDecim2Sym(
+    Int32   *inSamps,       /* input samples (S18Q16) */
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Int32   *outSamps,      /* output samples (S18Q16) */
+    Int32   *dlyBuf,        /* delay buffer */
+    Uint16  numInSamps,     /* number of input samples*/
+    Uint16  numCoefs        /* number of coefficients */
+)
+{
+    Uint16 numOutSamps;
+    Uint16 numDlySamps;
+    Int32 preAdd_1, preAdd_2;
+    Uint16 dataL_1, dataL_2;
+    Int16 dataH_1, dataH_2;
+    Int32 prdLL_1, prdLL_2;
+    Int32 prdLH_1, prdLH_2;
+    Int64 acc0_40b, acc1_40b, acc2_40b, acc3_40b;
+    Uint16 wrIdx;           // write index
+    Uint16 fwdIdx_1, bwdIdx_1; // leading output, newest/oldest tap
+    Uint16 fwdIdx_2, bwdIdx_2; // lagging output, newest/oldest tap
+    Uint16 inSampIdx, outSampIdx;
+    Uint16 outSampCnt;
+    Uint16 i;
+
+    if (blkFirCoefsSym(coefs, numCoefs) != BLK_FIR_OK)
+    {
+        return BLK_FIR_ERR_NOT_SYM;
+    }
+
+    /* Compute number of output samples */
+    numOutSamps = numInSamps>>1;
+
+    /* Compute number of delay buffer samples */
+    numDlySamps = numCoefs+2;
+
+    /* Read delay index of oldest sample */
+    wrIdx = dlyBuf[0]; // index of oldest sample stored in 0th location of delay buffer
+    wrIdx++; // adjust index to 1->numDlySamps
+    if (wrIdx > numDlySamps)
+    {
+        wrIdx = 1;
+    }
+
+    /* Samples are placed at decreasing indices, */
+    /* tap k of output with newest sample at index n is at index n+k (modulo numDlySamps). */
+
+    inSampIdx = 0;
+    outSampIdx = 0;
+    for (outSampCnt = 0; outSampCnt < numOutSamps/2; outSampCnt++)
+    {
+        /* Place 1 sample in delay line for lagging output */
+        fwdIdx_2 = wrIdx;
+        dlyBuf[fwdIdx_2] = inSamps[inSampIdx++];
+
+        /* Place D=2 samples in delay line for leading output */
+        fwdIdx_1 = fwdIdx_2-1;
+        if (fwdIdx_1 < 1)
+        {
+            fwdIdx_1 = numDlySamps;
+        }
+        dlyBuf[fwdIdx_1] = inSamps[inSampIdx++];
+        fwdIdx_1--;
+        if (fwdIdx_1 < 1)
+        {
+            fwdIdx_1 = numDlySamps;
+        }
+        dlyBuf[fwdIdx_1] = inSamps[inSampIdx++];
+        wrIdx = fwdIdx_1;
+
+        /* Oldest taps */
+        bwdIdx_2 = fwdIdx_2+numCoefs-1;
+        if (bwdIdx_2 > numDlySamps)
+        {
+            bwdIdx_2 -= numDlySamps;
+        }
+        bwdIdx_1 = fwdIdx_1+numCoefs-1;
+        if (bwdIdx_1 > numDlySamps)
+        {
+            bwdIdx_1 -= numDlySamps;
+        }
+
+        acc0_40b = 0;
+        acc1_40b = 0;
+        acc2_40b = 0;
+        acc3_40b = 0;
+
+        for (i = 0; i < numCoefs/2; i++)
+        {
+            /* Compute lagging output */
+            /* S18Q16 + S18Q16 = S19Q16 */
+            preAdd_2 = dlyBuf[fwdIdx_2++] + dlyBuf[bwdIdx_2--];
+            if (fwdIdx_2 > numDlySamps)
+            {
+                fwdIdx_2 = 1;
+            }
+            if (bwdIdx_2 < 1)
+            {
+                bwdIdx_2 = numDlySamps;
+            }
+            dataL_2 = (Uint16)preAdd_2;
+            dataH_2 = (Int16)(preAdd_2 >> 16);
+            /* S19Q16 * S16Q15 = S35Q31 */
+            prdLL_2 = (Uint32)dataL_2 * (Int32)coefs[i];
+            prdLH_2 = (Int32)dataH_2 * coefs[i];
+            /* S40Q31 + S35Q31 = S40Q31 */
+            acc2_40b += (Int64)prdLL_2;
+            acc3_40b += (Int64)prdLH_2;
+
+            /* Compute leading output */
+            /* S18Q16 + S18Q16 = S19Q16 */
+            preAdd_1 = dlyBuf[fwdIdx_1++] + dlyBuf[bwdIdx_1--];
+            if (fwdIdx_1 > numDlySamps)
+            {
+                fwdIdx_1 = 1;
+            }
+            if (bwdIdx_1 < 1)
+            {
+                bwdIdx_1 = numDlySamps;
+            }
+            dataL_1 = (Uint16)preAdd_1;
+            dataH_1 = (Int16)(preAdd_1 >> 16);
+            /* S19Q16 * S16Q15 = S35Q31 */
+            prdLL_1 = (Uint32)dataL_1 * (Int32)coefs[i];
+            prdLH_1 = (Int32)dataH_1 * coefs[i];
+            /* S40Q31 + S35Q31 = S40Q31 */
+            acc0_40b += (Int64)prdLL_1;
+            acc1_40b += (Int64)prdLH_1;
+        }
+
+        /* Center tap for odd number of coefficients */
+        if (numCoefs & 0x1)
+        {
+            /* S18Q16 */
+            dataL_2 = (Uint16)dlyBuf[fwdIdx_2];
+            dataH_2 = (Int16)(dlyBuf[fwdIdx_2] >> 16);
+            /* S18Q16 * S16Q15 = S34Q31 */
+            prdLL_2 = (Uint32)dataL_2 * (Int32)coefs[i];
+            prdLH_2 = (Int32)dataH_2 * coefs[i];
+            /* S40Q31 + S34Q31 = S40Q31 */
+            acc2_40b += (Int64)prdLL_2;
+            acc3_40b += (Int64)prdLH_2;
+
+            /* S18Q16 */
+            dataL_1 = (Uint16)dlyBuf[fwdIdx_1];
+            dataH_1 = (Int16)(dlyBuf[fwdIdx_1] >> 16);
+            /* S18Q16 * S16Q15 = S34Q31 */
+            prdLL_1 = (Uint32)dataL_1 * (Int32)coefs[i];
+            prdLH_1 = (Int32)dataH_1 * coefs[i];
+            /* S40Q31 + S34Q31 = S40Q31 */
+            acc0_40b += (Int64)prdLL_1;
+            acc1_40b += (Int64)prdLH_1;
+        }
+
+        acc2_40b += acc3_40b << 16;
+        acc0_40b += acc1_40b << 16;
+
+#if (QUANT_MODE == QUANT_RND_INF)
+        acc2_40b += (Uint16)1<<14; /* round to infinite */
+        acc0_40b += (Uint16)1<<14; /* round to infinite */
+#endif
+        acc2_40b = ACC40(acc2_40b) >> 15; /* truncate */
+        outSamps[outSampIdx++] = (Int32)acc2_40b;
+        acc0_40b = ACC40(acc0_40b) >> 15; /* truncate */
+        outSamps[outSampIdx++] = (Int32)acc0_40b;
+
+        /* Place D-1=1 samples in delay line, overwrites oldest tap of lagging output */
+        wrIdx--;
+        if (wrIdx < 1)
+        {
+            wrIdx = numDlySamps;
+        }
+        dlyBuf[wrIdx] = inSamps[inSampIdx++];
+        wrIdx--;
+        if (wrIdx < 1)
+        {
+            wrIdx = numDlySamps;
+        }
+    }
+
+    /* Write delay index of oldest sample */
+    dlyBuf[0] = wrIdx-1; // adjust index to 0->numDlySamps-1
+
+    return BLK_FIR_OK;
+}
+
+/* Extracts half-band coefficients from full coefficient set. */
+Int16 blkFirHbCoefs(
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Uint16  numCoefs,       /* number of coefficients */
+    Int16   *hbCoefs        /* half-band coefficients (S16Q15), K+1 values */
+)
+{
+    Uint16 numHbCoefs;
+    Uint16 i;
+
+    if ((numCoefs < 3) || ((numCoefs+1) % 4 != 0))
+    {
+        return BLK_FIR_ERR_NOT_HB;
+    }
+    if (blkFirCoefsSym(coefs, numCoefs) != BLK_FIR_OK)
+    {
+        return BLK_FIR_ERR_NOT_HB;
+    }
+
+    /* Center tap is at odd index (numCoefs-1)/2, zero taps are at the other odd indices */
+    for (i = 1; i < numCoefs; i += 2)
+    {
+        if ((i != (numCoefs-1)/2) && (coefs[i] != 0))
+        {
+            return BLK_FIR_ERR_NOT_HB;
+        }
+    }
+
+    numHbCoefs = (numCoefs+1)/4;
+    for (i = 0; i < numHbCoefs; i++)
+    {
+        hbCoefs[i] = coefs[2*i];
+    }
+    hbCoefs[numHbCoefs] = coefs[(numCoefs-1)/2];
+
+    return BLK_FIR_OK;
+}
+
+/* Block decimating half-band FIR, */
+/* S18Q16 input and output data, */
+/* S16Q15 coefficients. */
+/* Decimation factor fixed at 2. */
+/* Computes two outputs per inner loop (assumes even number of outputs). */
+/* Skips zero taps and pre-adds mirrored samples: K+1 multiplies per output. */
+void blkFirDecim2Hb(
+    Int32   *inSamps,       /* input samples (S18Q16) */
+    Int16   *hbCoefs,       /* half-band coefficients (S16Q15), from blkFirHbCoefs() */
+    Int32   *outSamps,      /* output samples (S18Q16) */
+    Int32   *dlyBuf,        /* delay buffer, sized as for blkFirDecim2() */
+    Uint16  numInSamps,     /* number of input samples */
+    Uint16  numCoefs        /* number of coefficients of full set, 4K-1 */
+)
+{
+    Uint16 numOutSamps;
+    Uint16 numDlySamps;
+    Uint16 numHbCoefs;
+    Int16 ctrCoef;
+    Uint16 ctrShift;        // non-zero if center coefficient is 0.5
+    Int32 preAdd_1, preAdd_2;
+    Uint16 dataL_1, dataL_2;
+    Int16 dataH_1, dataH_2;
+    Int32 prdLL_1, prdLL_2;
+    Int32 prdLH_1, prdLH_2;
+    Int64 acc0_40b, acc1_40b, acc2_40b, acc3_40b;
+    Uint16 wrIdx;           // write index
+    Uint16 fwdIdx_1, bwdIdx_1, ctrIdx_1; // leading output, newest/oldest/center tap
+    Uint16 fwdIdx_2, bwdIdx_2, ctrIdx_2; // lagging output, newest/oldest/center tap
+    Uint16 inSampIdx, outSampIdx;
+    Uint16 outSampCnt;
+    Uint16 i;
+
+    /* Compute number of output samples */
+    numOutSamps = numInSamps>>1;
+
+    /* Compute number of delay buffer samples */
+    numDlySamps = numCoefs+2;
+
+    numHbCoefs = (numCoefs+1)/4;
+    ctrCoef = hbCoefs[numHbCoefs];
+    ctrShift = (ctrCoef == (Int16)1<<14) ? 14 : 0;
+
+    /* Read delay index of oldest sample */
+    wrIdx = dlyBuf[0]; // index of oldest sample stored in 0th location of delay buffer
+    wrIdx++; // adjust index to 1->numDlySamps
+    if (wrIdx > numDlySamps)
+    {
+        wrIdx = 1;
+    }
+
+    /* Samples are placed at decreasing indices, */
+    /* tap k of output with newest sample at index n is at index n+k (modulo numDlySamps). */
+
+    inSampIdx = 0;
+    outSampIdx = 0;
+    for (outSampCnt = 0; outSampCnt < numOutSamps/2; outSampCnt++)
+    {
+        /* Place 1 sample in delay line for lagging output */
+        fwdIdx_2 = wrIdx;
+        dlyBuf[fwdIdx_2] = inSamps[inSampIdx++];
+
+        /* Place D=2 samples in delay line for leading output */
+        fwdIdx_1 = fwdIdx_2-1;
+        if (fwdIdx_1 < 1)
+        {
+            fwdIdx_1 = numDlySamps;
+        }
+        dlyBuf[fwdIdx_1] = inSamps[inSampIdx++];
+        fwdIdx_1--;
+        if (fwdIdx_1 < 1)
+        {
+            fwdIdx_1 = numDlySamps;
+        }
+        dlyBuf[fwdIdx_1] = inSamps[inSampIdx++];
+        wrIdx = fwdIdx_1;
+
+        /* Oldest & center taps */
+        bwdIdx_2 = fwdIdx_2+numCoefs-1;
+        if (bwdIdx_2 > numDlySamps)
+        {
+            bwdIdx_2 -= numDlySamps;
+        }
+        bwdIdx_1 = fwdIdx_1+numCoefs-1;
+        if (bwdIdx_1 > numDlySamps)
+        {
+            bwdIdx_1 -= numDlySamps;
+        }
+        ctrIdx_2 = fwdIdx_2+(numCoefs-1)/2;
+        if (ctrIdx_2 > numDlySamps)
+        {
+            ctrIdx_2 -= numDlySamps;
+        }
+        ctrIdx_1 = fwdIdx_1+(numCoefs-1)/2;
+        if (ctrIdx_1 > numDlySamps)
+        {
+            ctrIdx_1 -= numDlySamps;
+        }
+
+        acc0_40b = 0;
+        acc1_40b = 0;
+        acc2_40b = 0;
+        acc3_40b = 0;
+
+        /* Non-zero tap pairs, every other tap */
+        for (i = 0; i < numHbCoefs; i++)
+        {
+            /* Compute lagging output */
+            /* S18Q16 + S18Q16 = S19Q16 */
+            preAdd_2 = dlyBuf[fwdIdx_2] + dlyBuf[bwdIdx_2];
+            fwdIdx_2 += 2;
+            if (fwdIdx_2 > numDlySamps)
+            {
+                fwdIdx_2 -= numDlySamps;
+            }
+            if (bwdIdx_2 <= 2)
+            {
+                bwdIdx_2 += numDlySamps;
+            }
+            bwdIdx_2 -= 2;
+            dataL_2 = (Uint16)preAdd_2;
+            dataH_2 = (Int16)(preAdd_2 >> 16);
+            /* S19Q16 * S16Q15 = S35Q31 */
+            prdLL_2 = (Uint32)dataL_2 * (Int32)hbCoefs[i];
+            prdLH_2 = (Int32)dataH_2 * hbCoefs[i];
+            /* S40Q31 + S35Q31 = S40Q31 */
+            acc2_40b += (Int64)prdLL_2;
+            acc3_40b += (Int64)prdLH_2;
+
+            /* Compute leading output */
+            /* S18Q16 + S18Q16 = S19Q16 */
+            preAdd_1 = dlyBuf[fwdIdx_1] + dlyBuf[bwdIdx_1];
+            fwdIdx_1 += 2;
+            if (fwdIdx_1 > numDlySamps)
+            {
+                fwdIdx_1 -= numDlySamps;
+            }
+            if (bwdIdx_1 <= 2)
+            {
+                bwdIdx_1 += numDlySamps;
+            }
+            bwdIdx_1 -= 2;
+            dataL_1 = (Uint16)preAdd_1;
+            dataH_1 = (Int16)(preAdd_1 >> 16);
+            /* S19Q16 * S16Q15 = S35Q31 */
+            prdLL_1 = (Uint32)dataL_1 * (Int32)hbCoefs[i];
+            prdLH_1 = (Int32)dataH_1 * hbCoefs[i];
+            /* S40Q31 + S35Q31 = S40Q31 */
+            acc0_40b += (Int64)prdLL_1;
+            acc1_40b += (Int64)prdLH_1;
+        }
+
+        acc2_40b += acc3_40b << 16;
+        acc0_40b += acc1_40b << 16;
+
+        /* Center tap */
+        /* S18Q16 * S16Q15 = S34Q31 */
+        if (ctrShift)
+        {
+            acc2_40b += (Int64)dlyBuf[ctrIdx_2] << ctrShift;
+            acc0_40b += (Int64)dlyBuf[ctrIdx_1] << ctrShift;
+        }
+        else
+        {
+            acc2_40b += (Int64)dlyBuf[ctrIdx_2] * ctrCoef;
+            acc0_40b += (Int64)dlyBuf[ctrIdx_1] * ctrCoef;
+        }
+
+#if (QUANT_MODE == QUANT_RND_INF)
+        acc2_40b += (Uint16)1<<14; /* round to infinite */
+        acc0_40b += (Uint16)1<<14; /* round to infinite */
+#endif
+        acc2_40b = ACC40(acc2_40b) >> 15; /* truncate */
+        outSamps[outSampIdx++] = (Int32)acc2_40b;
+        acc0_40b = ACC40(acc0_40b) >> 15; /* truncate */
+        outSamps[outSampIdx++] = (Int32)acc0_40b;
+
+        /* Place D-1=1 samples in delay line, overwrites oldest tap of lagging output */
+        wrIdx--;
+        if (wrIdx < 1)
+        {
+            wrIdx = numDlySamps;
+        }
+        dlyBuf[wrIdx] = inSamps[inSampIdx++];
+        wrIdx--;
+        if (wrIdx < 1)
+        {
+            wrIdx = numDlySamps;
+        }
+    }
+
+    /* Write delay index of oldest sample */
+    dlyBuf[0] = wrIdx-1; // adjust index to 0->numDlySamps-1
+}
+
+/* Converts blkFirDecim2() delay buffer to blkFirDecim2Lin() delay buffer. */
+void blkFirDlyToLin(
+    Int32   *dlyBuf,        /* delay buffer, blkFirDecim2() layout */
+    Int32   *linDlyBuf,     /* delay buffer, blkFirDecim2Lin() layout, BLK_FIR_LIN_DLY_LEN(numCoefs) */
+    Uint16  numCoefs        /* number of coefficients */
+)
+{
+    Uint16 numDlySamps;
+    Uint16 dlyBufIdx;
+    Uint16 i;
+
+    /* Compute number of delay buffer samples */
+    numDlySamps = numCoefs+2;
+
+    /* Newest sample follows oldest sample */
+    dlyBufIdx = dlyBuf[0]+1; // adjust index to 1->numDlySamps
+    if (dlyBufIdx > numDlySamps)
+    {
+        dlyBufIdx = 1;
+    }
+
+    /* Copy newest to oldest into both halves, newest at 0 */
+    for (i = 0; i < numDlySamps; i++)
+    {
+        dlyBufIdx++;
+        if (dlyBufIdx > numDlySamps)
+        {
+            dlyBufIdx = 1;
+        }
+        linDlyBuf[1+i] = dlyBuf[dlyBufIdx];
+        linDlyBuf[1+numDlySamps+i] = dlyBuf[dlyBufIdx];
+    }
+    linDlyBuf[0] = 0;
+}
+
+/* Converts blkFirDecim2Lin() delay buffer to blkFirDecim2() delay buffer. */
+void blkFirLinToDly(
+    Int32   *linDlyBuf,     /* delay buffer, blkFirDecim2Lin() layout */
+    Int32   *dlyBuf,        /* delay buffer, blkFirDecim2() layout */
+    Uint16  numCoefs        /* number of coefficients */
+)
+{
+    Uint16 numDlySamps;
+    Uint16 i;
+
+    /* Compute number of delay buffer samples */
+    numDlySamps = numCoefs+2;
+
+    /* Newest at index 2, oldest at index 1 */
+    for (i = 0; i < numDlySamps; i++)
+    {
+        dlyBuf[2+i-(i == numDlySamps-1 ? numDlySamps : 0)] = linDlyBuf[1+linDlyBuf[0]+i];
+    }
+    dlyBuf[0] = 0; // index of oldest sample
+}
+
+/* Block decimating FIR, linear delay buffer, */
+/* S18Q16 input and output data, */
+/* S16Q15 coefficients. */
+/* Decimation factor fixed at 2. */
+/* Computes two outputs per inner loop (assumes even number of outputs). */
+void blkFirDecim2Lin(
+    Int32   *inSamps,       /* input samples (S18Q16) */
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Int32   *outSamps,      /* output samples (S18Q16) */
+    Int32   *dlyBuf,        /* delay buffer, BLK_FIR_LIN_DLY_LEN(numCoefs) */
+    Uint16  numInSamps,     /* number of input samples*/
+    Uint16  numCoefs        /* number of coefficients */
+)
+{
+    Uint16 numOutSamps;
+    Uint16 numDlySamps;
+    Int32 *dly;             // first copy of delay line
+    Int32 *dlyMirror;       // second copy of delay line
+    Int32 *pDly_1;          // leading output taps
+    Int32 *pDly_2;          // lagging output taps
+    Uint16 dataL_1, dataL_2;
+    Int16 dataH_1, dataH_2;
+    Int32 prdLL_1, prdLL_2;
+    Int32 prdLH_1, prdLH_2;
+    Int64 acc0_40b, acc1_40b, acc2_40b, acc3_40b;
+    Uint16 dlyBufIdx;       // index of newest sample
+    Uint16 inSampIdx, outSampIdx;
+    Uint16 outSampCnt;
+    Uint16 i;
+
+    /* Compute number of output samples */
+    numOutSamps = numInSamps>>1;
+
+    /* Compute number of delay buffer samples */
+    numDlySamps = numCoefs+2;
+
+    dly = &dlyBuf[1];
+    dlyMirror = &dlyBuf[1+numDlySamps];
+
+    /* Read index of newest sample */
+    dlyBufIdx = dlyBuf[0];
+
+    /* Samples are placed at decreasing indices in both copies, */
+    /* tap k of output with newest sample at index n is at dly[n+k]. */
+
+    inSampIdx = 0;
+    outSampIdx = 0;
+    for (outSampCnt = 0; outSampCnt < numOutSamps/2; outSampCnt++)
+    {
+        /* Place 3 samples in delay line, lagging output newest at 1st, leading at 3rd */
+        for (i = 0; i < 3; i++)
+        {
+            if (dlyBufIdx == 0)
+            {
+                dlyBufIdx = numDlySamps;
+            }
+            dlyBufIdx--;
+            dly[dlyBufIdx] = inSamps[inSampIdx];
+            dlyMirror[dlyBufIdx] = inSamps[inSampIdx++];
+        }
+
+        pDly_1 = &dly[dlyBufIdx];
+        pDly_2 = &dly[dlyBufIdx+2];
+
+        acc0_40b = 0;
+        acc1_40b = 0;
+        acc2_40b = 0;
+        acc3_40b = 0;
+
+        for (i = 0; i < numCoefs; i++)
+        {
+            /* Compute lagging output */
+            /* S18Q16 */
+            dataL_2 = (Uint16)pDly_2[i];
+            dataH_2 = (Int16)(pDly_2[i] >> 16);
+            /* S18Q16 * S16Q15 = S34Q31 */
+            prdLL_2 = (Uint32)dataL_2 * (Int32)coefs[i];
+            prdLH_2 = (Int32)dataH_2 * coefs[i];
+            /* S40Q31 + S34Q31 = S40Q31 */
+            acc2_40b += (Int64)prdLL_2;
+            acc3_40b += (Int64)prdLH_2;
+
+            /* Compute leading output */
+            /* S18Q16 */
+            dataL_1 = (Uint16)pDly_1[i];
+            dataH_1 = (Int16)(pDly_1[i] >> 16);
+            /* S18Q16 * S16Q15 = S34Q31 */
+            prdLL_1 = (Uint32)dataL_1 * (Int32)coefs[i];
+            prdLH_1 = (Int32)dataH_1 * coefs[i];
+            /* S40Q31 + S34Q31 = S40Q31 */
+            acc0_40b += (Int64)prdLL_1;
+            acc1_40b += (Int64)prdLH_1;
+        }
+
+        acc2_40b += acc3_40b << 16;
+        acc0_40b += acc1_40b << 16;
+
+#if (QUANT_MODE == QUANT_RND_INF)
+        acc2_40b += (Uint16)1<<14; /* round to infinite */
+        acc0_40b += (Uint16)1<<14; /* round to infinite */
+#endif
+        acc2_40b = ACC40(acc2_40b) >> 15; /* truncate */
+        outSamps[outSampIdx++] = (Int32)acc2_40b;
+        acc0_40b = ACC40(acc0_40b) >> 15; /* truncate */
+        outSamps[outSampIdx++] = (Int32)acc0_40b;
+
+        /* Place D-1=1 samples in delay line */
+        if (dlyBufIdx == 0)
+        {
+            dlyBufIdx = numDlySamps;
+        }
+        dlyBufIdx--;
+        dly[dlyBufIdx] = inSamps[inSampIdx];
+        dlyMirror[dlyBufIdx] = inSamps[inSampIdx++];
+    }
+
+    /* Write index of newest sample */
+    dlyBuf[0] = dlyBufIdx;
+}
+
+/* Block decimating FIR, reference, */
+/* S18Q16 input and output data, */
+/* S16Q15 coefficients. */
+/* Arbitrary integer decimation factor M, y(m) = sum h(k)*x(M*m-k). */
+/* Number of input samples must be multiple of M. */
+Int16 blkFirDecimMRef(
+    Int32   *inSamps,       /* input samples (S18Q16) */
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Int32   *outSamps,      /* output samples (S18Q16) */
+    Int32   *dlyBuf,        /* delay buffer, BLK_FIR_M_DLY_LEN(numCoefs) */
+    Uint16  numInSamps,     /* number of input samples */
+    Uint16  numCoefs,       /* number of coefficients */
+    Uint16  decimFact       /* decimation factor M */
+)
+{
+    Uint16 numOutSamps;
+    Int32 *dly;             // first copy of delay line
+    Int32 *dlyMirror;       // second copy of delay line
+    Uint16 dataL;
+    Int16 dataH;
+    Int32 prdLL, prdLH;
+    Int64 acc0_40b, acc1_40b;
+    Uint16 dlyBufIdx;       // index of newest sample
+    Uint16 inSampIdx;
+    Uint16 outSampCnt;
+    Uint16 i;
+
+    if ((decimFact == 0) || (numInSamps % decimFact != 0))
+    {
+        return BLK_FIR_ERR_DF;
+    }
+
+    /* Compute number of output samples */
+    numOutSamps = numInSamps / decimFact;
+
+    dly = &dlyBuf[1];
+    dlyMirror = &dlyBuf[1+numCoefs];
+
+    /* Read index of newest sample */
+    dlyBufIdx = dlyBuf[0];
+
+    inSampIdx = 0;
+    for (outSampCnt = 0; outSampCnt < numOutSamps; outSampCnt++)
+    {
+        /* Place 1 sample in delay line */
+        dlyBufIdx = (dlyBufIdx + numCoefs - 1) % numCoefs;
+        dly[dlyBufIdx] = inSamps[inSampIdx];
+        dlyMirror[dlyBufIdx] = inSamps[inSampIdx++];
+
+        /* Compute output */
+        acc0_40b = 0;
+        acc1_40b = 0;
+        for (i = 0; i < numCoefs; i++)
+        {
+            /* S18Q16 */
+            dataL = (Uint16)dly[(dlyBufIdx + i) % numCoefs];
+            dataH = (Int16)(dly[(dlyBufIdx + i) % numCoefs] >> 16);
+            /* S18Q16 * S16Q15 = S34Q31 */
+            prdLL = (Uint32)dataL * (Int32)coefs[i];
+            prdLH = (Int32)dataH * coefs[i];
+            /* S40Q31 + S34Q31 = S40Q31 */
+            acc0_40b += (Int64)prdLL;
+            acc1_40b += (Int64)prdLH;
+        }
+        acc0_40b += acc1_40b << 16;
+
+#if (QUANT_MODE == QUANT_RND_INF)
+        acc0_40b += (Uint16)1<<14; /* round to infinite */
+#endif
+        acc0_40b = ACC40(acc0_40b) >> 15; /* truncate */
+        outSamps[outSampCnt] = (Int32)acc0_40b;
+
+        /* Place M-1 samples in delay line */
+        for (i = 1; i < decimFact; i++)
+        {
+            dlyBufIdx = (dlyBufIdx + numCoefs - 1) % numCoefs;
+            dly[dlyBufIdx] = inSamps[inSampIdx];
+            dlyMirror[dlyBufIdx] = inSamps[inSampIdx++];
+        }
+    }
+
+    /* Write index of newest sample */
+    dlyBuf[0] = dlyBufIdx;
+
+    return BLK_FIR_OK;
+}
+
+/* Block decimating FIR, */
+/* S18Q16 input and output data, */
+/* S16Q15 coefficients. */
+/* Arbitrary integer decimation factor M. */
+/* Delay line is stored twice so taps are contiguous, tap loop unrolled by 4. */
+Int16 blkFirDecimM(
+    Int32   *inSamps,       /* input samples (S18Q16) */
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Int32   *outSamps,      /* output samples (S18Q16) */
+    Int32   *dlyBuf,        /* delay buffer, BLK_FIR_M_DLY_LEN(numCoefs) */
+    Uint16  numInSamps,     /* number of input samples */
+    Uint16  numCoefs,       /* number of coefficients */
+    Uint16  decimFact       /* decimation factor M */
+)
+{
+    Uint16 numOutSamps;
+    Uint16 numCoefs4;       // number of coefficients rounded down to multiple of 4
+    Int32 *dly;             // first copy of delay line
+    Int32 *dlyMirror;       // second copy of delay line
+    Int32 *pDly;
+    Int32 inSamp;
+    Int64 accL0_40b, accL1_40b, accL2_40b, accL3_40b; // low parts, per tap phase
+    Int64 accH0_40b, accH1_40b, accH2_40b, accH3_40b; // high parts, per tap phase
+    Uint16 dlyBufIdx;       // index of newest sample
+    Uint16 inSampIdx;
+    Uint16 outSampCnt;
+    Uint16 i;
+
+    if ((decimFact == 0) || (numInSamps % decimFact != 0))
+    {
+        return BLK_FIR_ERR_DF;
+    }
+
+    /* Compute number of output samples */
+    numOutSamps = numInSamps / decimFact;
+
+    numCoefs4 = numCoefs & ~3;
+
+    dly = &dlyBuf[1];
+    dlyMirror = &dlyBuf[1+numCoefs];
+
+    /* Read index of newest sample */
+    dlyBufIdx = dlyBuf[0];
+
+    inSampIdx = 0;
+    for (outSampCnt = 0; outSampCnt < numOutSamps; outSampCnt++)
+    {
+        /* Place 1 sample in delay line */
+        if (dlyBufIdx == 0)
+        {
+            dlyBufIdx = numCoefs;
+        }
+        dlyBufIdx--;
+        inSamp = inSamps[inSampIdx++];
+        dly[dlyBufIdx] = inSamp;
+        dlyMirror[dlyBufIdx] = inSamp;
+
+        /* Compute output, tap k at pDly[k] */
+        pDly = &dly[dlyBufIdx];
+        accL0_40b = 0; accL1_40b = 0; accL2_40b = 0; accL3_40b = 0;
+        accH0_40b = 0; accH1_40b = 0; accH2_40b = 0; accH3_40b = 0;
+        for (i = 0; i < numCoefs4; i += 4)
+        {
+            /* S18Q16 * S16Q15 = S34Q31, S40Q31 + S34Q31 = S40Q31 */
+            accL0_40b += (Int64)(Int32)((Uint32)(Uint16)pDly[i]   * (Int32)coefs[i]);
+            accH0_40b += (Int64)((Int32)(Int16)(pDly[i]   >> 16) * coefs[i]);
+            accL1_40b += (Int64)(Int32)((Uint32)(Uint16)pDly[i+1] * (Int32)coefs[i+1]);
+            accH1_40b += (Int64)((Int32)(Int16)(pDly[i+1] >> 16) * coefs[i+1]);
+            accL2_40b += (Int64)(Int32)((Uint32)(Uint16)pDly[i+2] * (Int32)coefs[i+2]);
+            accH2_40b += (Int64)((Int32)(Int16)(pDly[i+2] >> 16) * coefs[i+2]);
+            accL3_40b += (Int64)(Int32)((Uint32)(Uint16)pDly[i+3] * (Int32)coefs[i+3]);
+            accH3_40b += (Int64)((Int32)(Int16)(pDly[i+3] >> 16) * coefs[i+3]);
+        }
+        for ( ; i < numCoefs; i++)
+        {
+            accL0_40b += (Int64)(Int32)((Uint32)(Uint16)pDly[i] * (Int32)coefs[i]);
+            accH0_40b += (Int64)((Int32)(Int16)(pDly[i] >> 16) * coefs[i]);
+        }
+        accL0_40b += accL1_40b + accL2_40b + accL3_40b;
+        accH0_40b += accH1_40b + accH2_40b + accH3_40b;
+        accL0_40b += accH0_40b << 16;
+
+#if (QUANT_MODE == QUANT_RND_INF)
+        accL0_40b += (Uint16)1<<14; /* round to infinite */
+#endif
+        accL0_40b = ACC40(accL0_40b) >> 15; /* truncate */
+        outSamps[outSampCnt] = (Int32)accL0_40b;
+
+        /* Place M-1 samples in delay line */
+        for (i = 1; i < decimFact; i++)
+        {
+            if (dlyBufIdx == 0)
+            {
+                dlyBufIdx = numCoefs;
+            }
+            dlyBufIdx--;
+            inSamp = inSamps[inSampIdx++];
+            dly[dlyBufIdx] = inSamp;
+            dlyMirror[dlyBufIdx] = inSamp;
+        }
+    }
+
+    /* Write index of newest sample */
+    dlyBuf[0] = dlyBufIdx;
+
+    return BLK_FIR_OK;
+}
+
+/* Block decimating FIR, host native multiply, */
+/* S18Q16 input and output data, */
+/* S16Q15 coefficients. */
+/* Decimation factor fixed at 2. */
+/* Computes two outputs per inner loop (assumes even number of outputs). */
+void blkFirDecim2Host(
+    Int32   *inSamps,       /* input samples (S18Q16) */
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Int32   *outSamps,      /* output samples (S18Q16) */
+    Int32   *dlyBuf,        /* delay buffer */
+    Uint16  numInSamps,     /* number of input samples */
+    Uint16  numCoefs        /* number of coefficients */
+)
+{
+    Uint16 numOutSamps;
+    Uint16 numDlySamps;
+    Int64 acc0_40b, acc2_40b;
+    Uint16 dlyBufIdx_1; // leading index
+    Uint16 dlyBufIdx_2; // lagging index
+    Uint16 inSampIdx, outSampIdx;
+    Uint16 outSampCnt;
+
+    /* Compute number of output samples */
+    numOutSamps = numInSamps>>1;
+
+    /* Compute number of delay buffer samples */
+    numDlySamps = numCoefs+2;
+
+    /* Read delay index of oldest sample */
+    dlyBufIdx_2 = dlyBuf[0]; // index of oldest sample stored in 0th location of delay buffer
+
+    /* Initialize lagging delay index */
+    dlyBufIdx_2++; // adjust index to 1->numDlySamps
+    if (dlyBufIdx_2 > numDlySamps)
+    {
+        dlyBufIdx_2 = 1;
+    }
+
+    inSampIdx = 0;
+    outSampIdx = 0;
+    for (outSampCnt = 0; outSampCnt < numOutSamps/2; outSampCnt++)
+    {
+        /* Place 1 sample in delay line at lagging index */
+        dlyBuf[dlyBufIdx_2] = inSamps[inSampIdx++];
+
+        /* Place D=2 samples in delay line at leading index */
+        dlyBufIdx_1 = (dlyBufIdx_2 > 1) ? dlyBufIdx_2-1 : numDlySamps;
+        dlyBuf[dlyBufIdx_1] = inSamps[inSampIdx++];
+        dlyBufIdx_1 = (dlyBufIdx_1 > 1) ? dlyBufIdx_1-1 : numDlySamps;
+        dlyBuf[dlyBufIdx_1] = inSamps[inSampIdx++];
+
+        /* Compute lagging & leading outputs */
+        acc2_40b = blkFirDotHost(dlyBuf, coefs, dlyBufIdx_2, numDlySamps, numCoefs);
+        acc0_40b = blkFirDotHost(dlyBuf, coefs, dlyBufIdx_1, numDlySamps, numCoefs);
+
+#if (QUANT_MODE == QUANT_RND_INF)
+        acc2_40b += (Uint16)1<<14; /* round to infinite */
+        acc0_40b += (Uint16)1<<14; /* round to infinite */
+#endif
+        acc2_40b = ACC40(acc2_40b) >> 15; /* truncate */
+        outSamps[outSampIdx++] = (Int32)acc2_40b;
+        acc0_40b = ACC40(acc0_40b) >> 15; /* truncate */
+        outSamps[outSampIdx++] = (Int32)acc0_40b;
+
+        /* Place D-1=1 samples in delay line, last tap of lagging output */
+        dlyBufIdx_2 = (dlyBufIdx_1 > 1) ? dlyBufIdx_1-1 : numDlySamps;
+        dlyBuf[dlyBufIdx_2] = inSamps[inSampIdx++];
+        dlyBufIdx_2--;
+        if (dlyBufIdx_2 < 1)
+        {
+            dlyBufIdx_2 = numDlySamps;
+        }
+    }
+
+    /* Write delay index of oldest sample */
+    dlyBuf[0] = dlyBufIdx_2-1; // adjust index to 0->numDlySamps-1
+}
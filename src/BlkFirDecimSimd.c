@@ -0,0 +1,379 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+
+#include <string.h>
+#include "data_types.h"
+#include "BlkFirDecim.h"
+#include "BlkFirDecimSimd.h"
+#include "BlkAcc40.h"
+#include "cpu_features.h"
+
+#define QUANT_TRUNC         ( 0 )   /* truncate */
+#define QUANT_RND_INF       ( 1 )   /* round to infinite */
+#define QUANT_MODE          ( QUANT_RND_INF )
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define BLK_FIR_SIMD_X86    ( 1 )   /* x86-64 kernels, per-function ISA target */
+#include <immintrin.h>
+#define BLK_FIR_TARGET(isa) __attribute__((target(isa)))
+#else
+#define BLK_FIR_SIMD_X86    ( 0 )   /* no SIMD kernels */
+#endif
+
+#if (BLK_FIR_SIMD_X86 == 1)
+
+#define BLK_FIR_SIMD_BLK_LEN    ( 256 ) /* input samples per block */
+#define BLK_FIR_SIMD_MAX_COEFS  ( 256 ) /* maximum number of coefficients, longer filters run blkFirDecim2Lin() */
+#define BLK_FIR_SIMD_HIST_LEN   ( BLK_FIR_SIMD_MAX_COEFS+2 )    /* maximum number of delay line samples */
+
+#if (QUANT_MODE == QUANT_RND_INF)
+#define BLK_FIR_RND             ( (Int64)1<<14 ) /* round to infinite */
+#else
+#define BLK_FIR_RND             ( 0 ) /* truncate */
+#endif
+
+/* Rounded accumulators of 64-bit lanes to outputs, output in 32-bit lane BLK_FIR_OUT_LANE of each. */
+#if (ACC_WRAP_40B == 1)
+/* acc<<24 puts bit 39 at bit 63, arithmetic shift of high 32 bits by 7 */
+/* gives low 32 bits of 40-bit wrapped acc >> 15 as ACC40() */
+#define BLK_FIR_OUT_LANE        ( 1 )
+#define BLK_FIR_OUT_SSE41(acc)  _mm_srai_epi32(_mm_slli_epi64(_mm_add_epi64((acc), rnd), 24), 7)
+#define BLK_FIR_OUT_AVX2(acc)   _mm256_srai_epi32(_mm256_slli_epi64(_mm256_add_epi64((acc), rnd), 24), 7)
+#define BLK_FIR_OUT_AVX512(acc) _mm512_srai_epi64(_mm512_slli_epi64(_mm512_add_epi64((acc), rnd), 24), 24+15)
+#define BLK_FIR_SSE41_OUT_SHUF  _MM_SHUFFLE(3, 1, 3, 1)
+#else
+/* Low 32 bits of acc >> 15, logical shift leaves them as arithmetic */
+#define BLK_FIR_OUT_LANE        ( 0 )
+#define BLK_FIR_OUT_SSE41(acc)  _mm_srli_epi64(_mm_add_epi64((acc), rnd), 15)
+#define BLK_FIR_OUT_AVX2(acc)   _mm256_srli_epi64(_mm256_add_epi64((acc), rnd), 15)
+#define BLK_FIR_OUT_AVX512(acc) _mm512_srai_epi64(_mm512_add_epi64((acc), rnd), 15)
+#define BLK_FIR_SSE41_OUT_SHUF  _MM_SHUFFLE(2, 0, 2, 0)
+#endif
+
+/* Generates decimate-by-2 FIR kernel on linear delay buffer. */
+/* Delay line & input block are copied oldest first into one buffer, */
+/* so output k of block is sum of coefs[i]*x[2k-i] over contiguous x. */
+/* blkFxn(x, coefs, outSamps, numOutSamps, numCoefs) computes outputs of one block, */
+/* delay line is rewritten as blkFirDecim2Lin() leaves it. */
+#define BLK_FIR_DEFINE_LIN_KERNEL(name, isa, blkFxn)                        \
+BLK_FIR_TARGET(isa) void name(                                              \
+    Int32   *inSamps,                                                       \
+    Int16   *coefs,                                                         \
+    Int32   *outSamps,                                                      \
+    Int32   *dlyBuf,                                                        \
+    Uint16  numInSamps,                                                     \
+    Uint16  numCoefs                                                        \
+)                                                                           \
+{                                                                           \
+    Int32 x[BLK_FIR_SIMD_HIST_LEN + BLK_FIR_SIMD_BLK_LEN];                  \
+    Uint16 numDlySamps;                                                     \
+    Int32 *dly;                                                             \
+    Int32 *dlyMirror;                                                       \
+    Uint16 dlyBufIdx;                                                       \
+    Uint16 blkLen;                                                          \
+    Uint16 inSampIdx;                                                       \
+    Uint16 i, j;                                                            \
+                                                                            \
+    if (numCoefs > BLK_FIR_SIMD_MAX_COEFS)                                  \
+    {                                                                       \
+        blkFirDecim2Lin(inSamps, coefs, outSamps, dlyBuf, numInSamps, numCoefs); \
+        return;                                                             \
+    }                                                                       \
+                                                                            \
+    /* Two outputs per 4 input samples as blkFirDecim2Lin() */              \
+    numInSamps &= ~3;                                                       \
+    numDlySamps = numCoefs+2;                                               \
+    dly = &dlyBuf[1];                                                       \
+    dlyMirror = &dlyBuf[1+numDlySamps];                                     \
+    dlyBufIdx = dlyBuf[0];                                                  \
+                                                                            \
+    /* Delay line, newest at dlyBufIdx, to oldest first */                  \
+    for (i = 0; i < numDlySamps; i++)                                       \
+    {                                                                       \
+        x[numDlySamps-1-i] = dly[dlyBufIdx+i];                              \
+    }                                                                       \
+                                                                            \
+    for (inSampIdx = 0; inSampIdx < numInSamps; inSampIdx += blkLen)        \
+    {                                                                       \
+        blkLen = numInSamps - inSampIdx;                                    \
+        if (blkLen > BLK_FIR_SIMD_BLK_LEN)                                  \
+        {                                                                   \
+            blkLen = BLK_FIR_SIMD_BLK_LEN;                                  \
+        }                                                                   \
+        memcpy(&x[numDlySamps], &inSamps[inSampIdx], blkLen*sizeof(Int32)); \
+        blkFxn(&x[numDlySamps], coefs, &outSamps[inSampIdx>>1], blkLen>>1, numCoefs); \
+        memmove(x, &x[blkLen], numDlySamps*sizeof(Int32));                  \
+    }                                                                       \
+                                                                            \
+    /* Newest sample at index moved back once per input sample */           \
+    dlyBufIdx = (Uint16)((dlyBufIdx + numDlySamps - numInSamps % numDlySamps) % numDlySamps); \
+    for (i = 0; i < numDlySamps; i++)                                       \
+    {                                                                       \
+        j = (dlyBufIdx+i < numDlySamps) ? dlyBufIdx+i : dlyBufIdx+i-numDlySamps; \
+        dly[j] = x[numDlySamps-1-i];                                        \
+        dlyMirror[j] = x[numDlySamps-1-i];                                  \
+    }                                                                       \
+    dlyBuf[0] = dlyBufIdx;                                                  \
+}
+
+/* Scalar outputs k..numOutSamps-1 */
+#define BLK_FIR_BLK_TAIL(k)                                                 \
+    for ( ; (k) < numOutSamps; (k)++)                                       \
+    {                                                                       \
+        acc = 0;                                                            \
+        for (i = 0; i < numCoefs; i++)                                      \
+        {                                                                   \
+            acc += (Int64)x[2*(k)-i] * coefs[i];                            \
+        }                                                                   \
+        outSamps[k] = (Int32)(ACC40(acc + BLK_FIR_RND) >> 15);              \
+    }
+
+/* SSE4.1 block, x[2k-i] of 2 outputs in even 32-bit lanes of one load */
+static BLK_FIR_TARGET("sse4.1") inline void blkFirBlkSse41(
+    const Int32 *x,         /* block input, numCoefs-1 delay line samples before x[0] */
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Int32   *outSamps,      /* output samples (S18Q16) */
+    Uint16  numOutSamps,    /* number of output samples */
+    Uint16  numCoefs        /* number of coefficients */
+)
+{
+    __m128i c, rnd;
+    __m128i acc0, acc1, acc2, acc3;
+    Int64 acc;
+    const Int32 *p;
+    Uint16 i, k;
+
+    rnd = _mm_set1_epi64x(BLK_FIR_RND);
+    for (k = 0; k+8 <= numOutSamps; k += 8)
+    {
+        acc0 = _mm_setzero_si128();
+        acc1 = _mm_setzero_si128();
+        acc2 = _mm_setzero_si128();
+        acc3 = _mm_setzero_si128();
+        for (i = 0; i < numCoefs; i++)
+        {
+            /* S18Q16 * S16Q15 = S34Q31, S40Q31 + S34Q31 = S40Q31 */
+            c = _mm_set1_epi64x(coefs[i]);
+            p = &x[2*k-i];
+            acc0 = _mm_add_epi64(acc0, _mm_mul_epi32(_mm_loadu_si128((const __m128i *)p), c));
+            acc1 = _mm_add_epi64(acc1, _mm_mul_epi32(_mm_loadu_si128((const __m128i *)(p+4)), c));
+            acc2 = _mm_add_epi64(acc2, _mm_mul_epi32(_mm_loadu_si128((const __m128i *)(p+8)), c));
+            acc3 = _mm_add_epi64(acc3, _mm_mul_epi32(_mm_loadu_si128((const __m128i *)(p+12)), c));
+        }
+
+        acc0 = BLK_FIR_OUT_SSE41(acc0);
+        acc1 = BLK_FIR_OUT_SSE41(acc1);
+        acc2 = BLK_FIR_OUT_SSE41(acc2);
+        acc3 = BLK_FIR_OUT_SSE41(acc3);
+        _mm_storeu_si128((__m128i *)&outSamps[k], _mm_castps_si128(_mm_shuffle_ps(
+            _mm_castsi128_ps(acc0), _mm_castsi128_ps(acc1), BLK_FIR_SSE41_OUT_SHUF)));
+        _mm_storeu_si128((__m128i *)&outSamps[k+4], _mm_castps_si128(_mm_shuffle_ps(
+            _mm_castsi128_ps(acc2), _mm_castsi128_ps(acc3), BLK_FIR_SSE41_OUT_SHUF)));
+    }
+    for ( ; k+2 <= numOutSamps; k += 2)
+    {
+        acc0 = _mm_setzero_si128();
+        for (i = 0; i < numCoefs; i++)
+        {
+            acc0 = _mm_add_epi64(acc0, _mm_mul_epi32(_mm_loadu_si128((const __m128i *)&x[2*k-i]), _mm_set1_epi64x(coefs[i])));
+        }
+        acc0 = BLK_FIR_OUT_SSE41(acc0);
+        _mm_storel_epi64((__m128i *)&outSamps[k], _mm_shuffle_epi32(acc0, BLK_FIR_SSE41_OUT_SHUF));
+    }
+
+    BLK_FIR_BLK_TAIL(k);
+}
+
+/* AVX2 block, x[2k-i] of 4 outputs in even 32-bit lanes of one load */
+static BLK_FIR_TARGET("avx2") inline void blkFirBlkAvx2(
+    const Int32 *x,         /* block input, numCoefs-1 delay line samples before x[0] */
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Int32   *outSamps,      /* output samples (S18Q16) */
+    Uint16  numOutSamps,    /* number of output samples */
+    Uint16  numCoefs        /* number of coefficients */
+)
+{
+    __m256i c, rnd, outSel;
+    __m256i acc0, acc1, acc2, acc3;
+    Int64 acc;
+    const Int32 *p;
+    Uint16 i, k;
+
+    rnd = _mm256_set1_epi64x(BLK_FIR_RND);
+    outSel = _mm256_setr_epi32(0+BLK_FIR_OUT_LANE, 2+BLK_FIR_OUT_LANE, 4+BLK_FIR_OUT_LANE, 6+BLK_FIR_OUT_LANE,
+        1-BLK_FIR_OUT_LANE, 3-BLK_FIR_OUT_LANE, 5-BLK_FIR_OUT_LANE, 7-BLK_FIR_OUT_LANE);
+    for (k = 0; k+16 <= numOutSamps; k += 16)
+    {
+        acc0 = _mm256_setzero_si256();
+        acc1 = _mm256_setzero_si256();
+        acc2 = _mm256_setzero_si256();
+        acc3 = _mm256_setzero_si256();
+        for (i = 0; i < numCoefs; i++)
+        {
+            /* S18Q16 * S16Q15 = S34Q31, S40Q31 + S34Q31 = S40Q31 */
+            c = _mm256_set1_epi64x(coefs[i]);
+            p = &x[2*k-i];
+            acc0 = _mm256_add_epi64(acc0, _mm256_mul_epi32(_mm256_loadu_si256((const __m256i *)p), c));
+            acc1 = _mm256_add_epi64(acc1, _mm256_mul_epi32(_mm256_loadu_si256((const __m256i *)(p+8)), c));
+            acc2 = _mm256_add_epi64(acc2, _mm256_mul_epi32(_mm256_loadu_si256((const __m256i *)(p+16)), c));
+            acc3 = _mm256_add_epi64(acc3, _mm256_mul_epi32(_mm256_loadu_si256((const __m256i *)(p+24)), c));
+        }
+
+        acc0 = _mm256_permutevar8x32_epi32(BLK_FIR_OUT_AVX2(acc0), outSel);
+        acc1 = _mm256_permutevar8x32_epi32(BLK_FIR_OUT_AVX2(acc1), outSel);
+        acc2 = _mm256_permutevar8x32_epi32(BLK_FIR_OUT_AVX2(acc2), outSel);
+        acc3 = _mm256_permutevar8x32_epi32(BLK_FIR_OUT_AVX2(acc3), outSel);
+        _mm256_storeu_si256((__m256i *)&outSamps[k], _mm256_permute2x128_si256(acc0, acc1, 0x20));
+        _mm256_storeu_si256((__m256i *)&outSamps[k+8], _mm256_permute2x128_si256(acc2, acc3, 0x20));
+    }
+    for ( ; k+4 <= numOutSamps; k += 4)
+    {
+        acc0 = _mm256_setzero_si256();
+        for (i = 0; i < numCoefs; i++)
+        {
+            acc0 = _mm256_add_epi64(acc0, _mm256_mul_epi32(_mm256_loadu_si256((const __m256i *)&x[2*k-i]), _mm256_set1_epi64x(coefs[i])));
+        }
+        acc0 = _mm256_permutevar8x32_epi32(BLK_FIR_OUT_AVX2(acc0), outSel);
+        _mm_storeu_si128((__m128i *)&outSamps[k], _mm256_castsi256_si128(acc0));
+    }
+
+    BLK_FIR_BLK_TAIL(k);
+}
+
+/* AVX-512F block, x[2k-i] of 8 outputs in even 32-bit lanes of one load */
+static BLK_FIR_TARGET("avx512f") inline void blkFirBlkAvx512(
+    const Int32 *x,         /* block input, numCoefs-1 delay line samples before x[0] */
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Int32   *outSamps,      /* output samples (S18Q16) */
+    Uint16  numOutSamps,    /* number of output samples */
+    Uint16  numCoefs        /* number of coefficients */
+)
+{
+    __m512i c, rnd;
+    __m512i acc0, acc1, acc2, acc3;
+    Int64 acc;
+    const Int32 *p;
+    Uint16 i, k;
+
+    rnd = _mm512_set1_epi64(BLK_FIR_RND);
+    for (k = 0; k+32 <= numOutSamps; k += 32)
+    {
+        acc0 = _mm512_setzero_si512();
+        acc1 = _mm512_setzero_si512();
+        acc2 = _mm512_setzero_si512();
+        acc3 = _mm512_setzero_si512();
+        for (i = 0; i < numCoefs; i++)
+        {
+            /* S18Q16 * S16Q15 = S34Q31, S40Q31 + S34Q31 = S40Q31 */
+            c = _mm512_set1_epi64(coefs[i]);
+            p = &x[2*k-i];
+            acc0 = _mm512_add_epi64(acc0, _mm512_mul_epi32(_mm512_loadu_si512((const void *)p), c));
+            acc1 = _mm512_add_epi64(acc1, _mm512_mul_epi32(_mm512_loadu_si512((const void *)(p+16)), c));
+            acc2 = _mm512_add_epi64(acc2, _mm512_mul_epi32(_mm512_loadu_si512((const void *)(p+32)), c));
+            acc3 = _mm512_add_epi64(acc3, _mm512_mul_epi32(_mm512_loadu_si512((const void *)(p+48)), c));
+        }
+
+        _mm256_storeu_si256((__m256i *)&outSamps[k], _mm512_cvtepi64_epi32(BLK_FIR_OUT_AVX512(acc0)));
+        _mm256_storeu_si256((__m256i *)&outSamps[k+8], _mm512_cvtepi64_epi32(BLK_FIR_OUT_AVX512(acc1)));
+        _mm256_storeu_si256((__m256i *)&outSamps[k+16], _mm512_cvtepi64_epi32(BLK_FIR_OUT_AVX512(acc2)));
+        _mm256_storeu_si256((__m256i *)&outSamps[k+24], _mm512_cvtepi64_epi32(BLK_FIR_OUT_AVX512(acc3)));
+    }
+    for ( ; k+8 <= numOutSamps; k += 8)
+    {
+        acc0 = _mm512_setzero_si512();
+        for (i = 0; i < numCoefs; i++)
+        {
+            acc0 = _mm512_add_epi64(acc0, _mm512_mul_epi32(_mm512_loadu_si512((const void *)&x[2*k-i]), _mm512_set1_epi64(coefs[i])));
+        }
+        _mm256_storeu_si256((__m256i *)&outSamps[k], _mm512_cvtepi64_epi32(BLK_FIR_OUT_AVX512(acc0)));
+    }
+
+    BLK_FIR_BLK_TAIL(k);
+}
+
+BLK_FIR_DEFINE_LIN_KERNEL(blkFirDecim2LinSse41, "sse4.1", blkFirBlkSse41)
+BLK_FIR_DEFINE_LIN_KERNEL(blkFirDecim2LinAvx2, "avx2", blkFirBlkAvx2)
+BLK_FIR_DEFINE_LIN_KERNEL(blkFirDecim2LinAvx512, "avx512f", blkFirBlkAvx512)
+
+#else
+
+/* SSE4.1 kernel, not available */
+void blkFirDecim2LinSse41(Int32 *inSamps, Int16 *coefs, Int32 *outSamps, Int32 *dlyBuf, Uint16 numInSamps, Uint16 numCoefs)
+{
+    blkFirDecim2Lin(inSamps, coefs, outSamps, dlyBuf, numInSamps, numCoefs);
+}
+
+/* AVX2 kernel, not available */
+void blkFirDecim2LinAvx2(Int32 *inSamps, Int16 *coefs, Int32 *outSamps, Int32 *dlyBuf, Uint16 numInSamps, Uint16 numCoefs)
+{
+    blkFirDecim2Lin(inSamps, coefs, outSamps, dlyBuf, numInSamps, numCoefs);
+}
+
+/* AVX-512F kernel, not available */
+void blkFirDecim2LinAvx512(Int32 *inSamps, Int16 *coefs, Int32 *outSamps, Int32 *dlyBuf, Uint16 numInSamps, Uint16 numCoefs)
+{
+    blkFirDecim2Lin(inSamps, coefs, outSamps, dlyBuf, numInSamps, numCoefs);
+}
+
+#endif
+
+/* Runs widest kernel supported by host CPU. */
+void blkFirDecim2LinSimd(
+    Int32   *inSamps,       /* input samples (S18Q16) */
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Int32   *outSamps,      /* output samples (S18Q16) */
+    Int32   *dlyBuf,        /* delay buffer, BLK_FIR_LIN_DLY_LEN(numCoefs) */
+    Uint16  numInSamps,     /* number of input samples */
+    Uint16  numCoefs        /* number of coefficients */
+)
+{
+    Uint16 features;
+
+    features = cpuFeatures();
+    if (features & CPU_FEAT_AVX512F)
+    {
+        blkFirDecim2LinAvx512(inSamps, coefs, outSamps, dlyBuf, numInSamps, numCoefs);
+    }
+    else if (features & CPU_FEAT_AVX2)
+    {
+        blkFirDecim2LinAvx2(inSamps, coefs, outSamps, dlyBuf, numInSamps, numCoefs);
+    }
+    else if (features & CPU_FEAT_SSE41)
+    {
+        blkFirDecim2LinSse41(inSamps, coefs, outSamps, dlyBuf, numInSamps, numCoefs);
+    }
+    else
+    {
+        blkFirDecim2Lin(inSamps, coefs, outSamps, dlyBuf, numInSamps, numCoefs);
+    }
+}
@@ -33,6 +33,7 @@
 
 #include "data_types.h"
 #include "BlkIir.h"
+#include "BlkAcc40.h"
 
 #define QUANT_TRUNC         ( 0 )   /* truncate */
 #define QUANT_RND_INF       ( 1 )   /* round to infinite */
@@ -126,7 +127,7 @@ void blkIirDf2(
 #if (QUANT_MODE == QUANT_RND_INF)
             acc_40b += (Uint16)1<<(14+1); /* round to infinite */
 #endif
-            dlyBuf[dlyBufIdx] = (Int32)(acc_40b>>(15+1));
+            dlyBuf[dlyBufIdx] = (Int32)(ACC40(acc_40b)>>(15+1));
 
             /* Compute y(n) */
             // acc = b2*d(n-2)
@@ -319,7 +320,7 @@ void blkIirDf1(
 #if (QUANT_MODE == QUANT_RND_INF)
             acc_40b += (Uint16)1<<14; /* round to infinite */
 #endif
-            tIn = (Int32)(acc_40b >> 15); // S18Q16
+            tIn = (Int32)(ACC40(acc_40b) >> 15); // S18Q16
 
             // update y(n-2)
             fbDlyBuf[fbDlyBufIdx] = tIn;
@@ -337,3 +338,351 @@ void blkIirDf1(
     /* Update current delay index */
     dlyBuf[0] = ffDlyBufIdx;
 }
+
+/* Converts blkIirDf2() delay buffer to blkIirDf2Lin() delay buffer. */
+void blkIirDf2DlyToLin(
+    Int32   *dlyBuf,        /* delay buffer, blkIirDf2() layout */
+    Int32   *linDlyBuf,     /* delay buffer, blkIirDf2Lin() layout */
+    Uint16  numBiquads      /* number of biquads */
+)
+{
+    Uint16 numDlySamps;
+    Uint16 dlyBufIdx;
+    Uint16 j;
+
+    /* Compute number of delay buffer samples */
+    numDlySamps = 2*numBiquads;
+
+    /* Initialize delay index */
+    dlyBufIdx = dlyBuf[0]+1; // adjust index to 1->numDlySamps
+    if (dlyBufIdx > numDlySamps)
+    {
+        dlyBufIdx -= numDlySamps;
+    }
+
+    for (j = 0; j < numBiquads; j++)
+    {
+        linDlyBuf[2*j+1] = dlyBuf[dlyBufIdx]; // d(n-1)
+        dlyBufIdx += numBiquads;
+        if (dlyBufIdx > numDlySamps)
+        {
+            dlyBufIdx -= numDlySamps;
+        }
+        linDlyBuf[2*j+2] = dlyBuf[dlyBufIdx]; // d(n-2)
+        dlyBufIdx += numBiquads+1;
+        if (dlyBufIdx > numDlySamps)
+        {
+            dlyBufIdx -= numDlySamps;
+        }
+    }
+    linDlyBuf[0] = 0;
+}
+
+/* Converts blkIirDf2Lin() delay buffer to blkIirDf2() delay buffer. */
+void blkIirDf2LinToDly(
+    Int32   *linDlyBuf,     /* delay buffer, blkIirDf2Lin() layout */
+    Int32   *dlyBuf,        /* delay buffer, blkIirDf2() layout */
+    Uint16  numBiquads      /* number of biquads */
+)
+{
+    Uint16 j;
+
+    /* d(n-1) in 1st half, d(n-2) in 2nd half, delay index at start */
+    for (j = 0; j < numBiquads; j++)
+    {
+        dlyBuf[1+j] = linDlyBuf[2*j+1];
+        dlyBuf[1+numBiquads+j] = linDlyBuf[2*j+2];
+    }
+    dlyBuf[0] = 0;
+}
+
+/* Block IIR, Direct Form II, linear delay buffer */
+/* S18Q16 input and output data */
+/* Fixed-point format of coefficients determined by coefficient integer wordlength parameter */
+/* Input gain applied to input signal */
+void blkIirDf2Lin(
+    Int32   *inSamps,       /* input samples (S18Q16) */
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Int32   *outSamps,      /* output samples (S18Q16) */
+    Int32   *dlyBuf,        /* delay buffer */
+    Uint16  inGain,         /* input gain (U16Q16) */
+    Uint16  numInSamps,     /* number of input samples */
+    Uint16  numBiquads,     /* number of biquads */
+    Uint16  coefIWL         /* coefficient integer wordlength */
+)
+{
+    Uint16 dataL;
+    Int16 dataH;
+    Uint32 uPrdLL;
+    Int32 prdLL, prdLH;
+    Int64 acc_40b;
+    Int32 *pDly;            // d(n-1), d(n-2) of current biquad
+    Int32 d0;
+    Uint16 coefIdx;
+    Uint16 i, j;
+
+    for (i = 0; i < numInSamps; i++)
+    {
+        coefIdx = 0;
+        pDly = &dlyBuf[1];
+
+        // acc = G*x(n)
+        dataL = (Uint16)inSamps[i];
+        dataH = (Int16)(inSamps[i] >> 16);
+        /* S18Q16 * U16Q16 = S34Q32 */
+        uPrdLL = (Uint32)dataL * inGain;
+        prdLH = (Int32)dataH * (Uint32)inGain;
+        acc_40b = (Uint64)uPrdLL;
+        acc_40b += ((Int64)prdLH << 16);
+
+        for (j = 0; j < numBiquads; j++)
+        {
+            /* Compute current biquad output */
+
+            /* Compute d(n) */
+            // acc = x(n) - a1*d(n-1)
+            dataL = (Uint16)pDly[0]; // d(n-1)
+            dataH = (Int16)(pDly[0] >> 16);
+            /* S18Q16 * S16Q(16-1-IWL) = S34Q(32-1-IWL) */
+            prdLL = (Uint32)dataL * (Int32)coefs[coefIdx]; // a1
+            prdLH = (Int32)dataH * coefs[coefIdx++];
+            /* S40Q31 + S34Q(32-1-IWL) = S40Q31 */
+            acc_40b -= ((Int64)prdLL << (1+coefIWL));
+            acc_40b -= ((Int64)prdLH << (16+1+coefIWL));
+
+            // acc = x(n) - a1*d(n-1) - a2*d(n-2)
+            dataL = (Uint16)pDly[1]; // d(n-2)
+            dataH = (Int16)(pDly[1] >> 16);
+            /* S18Q16 * S16Q(16-1-IWL) = S34Q(32-1-IWL) */
+            prdLL = (Uint32)dataL * (Int32)coefs[coefIdx]; //a2
+            prdLH = (Int32)dataH * coefs[coefIdx++];
+            /* S40Q31 + S34Q(32-1-IWL) = S40Q31 */
+            acc_40b -= ((Int64)prdLL << (1+coefIWL));
+            acc_40b -= ((Int64)prdLH << (16+1+coefIWL));
+
+            /* Compute d(n) */
+#if (QUANT_MODE == QUANT_RND_INF)
+            acc_40b += (Uint16)1<<(14+1); /* round to infinite */
+#endif
+            d0 = (Int32)(ACC40(acc_40b)>>(15+1));
+
+            /* Compute y(n) */
+            // acc = b2*d(n-2)
+            /* S18Q16 * S16Q(16-1-IWL) = S34Q(32-1-IWL) */
+            prdLL = (Uint32)dataL * (Int32)coefs[coefIdx]; // b2
+            prdLH = (Int32)dataH * coefs[coefIdx++];
+            /* S40Q31 + S34Q(32-1-IWL) = S40Q31 */
+            acc_40b = ((Int64)prdLL << (1+coefIWL));
+            acc_40b += ((Int64)prdLH << (16+1+coefIWL));
+
+            // acc = b0*d(n) + b2*d(n-2)
+            dataL = (Uint16)d0; // d(n)
+            dataH = (Int16)(d0 >> 16);
+            /* S18Q16 * S16Q(16-1-IWL) = S34Q(32-1-IWL) */
+            prdLL = (Uint32)dataL * (Int32)coefs[coefIdx]; // b0
+            prdLH = (Int32)dataH * coefs[coefIdx++];
+            /* S40Q31 + S34Q(32-1-IWL) = S40Q31 */
+            acc_40b += ((Int64)prdLL << (1+coefIWL));
+            acc_40b += ((Int64)prdLH << (16+1+coefIWL));
+
+            // acc = b0*d(n) + b1*d(n-1) + b2*d(n-2)
+            dataL = (Uint16)pDly[0]; // d(n-1)
+            dataH = (Int16)(pDly[0] >> 16);
+            /* S18Q16 * S16Q(16-1-IWL) = S34Q(32-1-IWL) */
+            prdLL = (Uint32)dataL * (Int32)coefs[coefIdx]; // b1
+            prdLH = (Int32)dataH * coefs[coefIdx++];
+            /* S40Q31 + S34Q(32-1-IWL) = S40Q31 */
+            acc_40b += ((Int64)prdLL << (1+coefIWL));
+            acc_40b += ((Int64)prdLH << (16+1+coefIWL));
+
+            /* Shift delay line */
+            pDly[1] = pDly[0];
+            pDly[0] = d0;
+            pDly += 2;
+        }
+
+#if (QUANT_MODE == QUANT_RND_INF)
+        acc_40b += 1<<14;
+#endif
+
+        outSamps[i] = (Int32)acc_40b>>(15+1);
+    }
+}
+
+/* Block IIR, Direct Form II, host native multiply */
+/* S18Q16 input and output data */
+/* Fixed-point format of coefficients determined by coefficient integer wordlength parameter */
+/* Input gain applied to input signal */
+void blkIirDf2Host(
+    Int32   *inSamps,       /* input samples (S18Q16) */
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Int32   *outSamps,      /* output samples (S18Q16) */
+    Int32   *dlyBuf,        /* delay buffer */
+    Uint16  inGain,         /* input gain (U16Q16) */
+    Uint16  numInSamps,     /* number of input samples */
+    Uint16  numBiquads,     /* number of biquads */
+    Uint16  coefIWL         /* coefficient integer wordlength */
+)
+{
+    Uint16 numDlySamps;
+    Int64 acc_40b;
+    Int32 d0, d1, d2;       // d(n), d(n-1), d(n-2)
+    Int16 *pCoefs;
+    Uint16 dlyBufIdx;
+    Uint16 i, j;
+
+
+    /* Compute number of delay buffer samples */
+    numDlySamps = 2*numBiquads;
+
+    /* Read current delay index */
+    dlyBufIdx = dlyBuf[0];
+
+    /* Initialize delay index */
+    dlyBufIdx++; // adjust index to 1->numDlySamps
+    if (dlyBufIdx > numDlySamps)
+    {
+        dlyBufIdx -= numDlySamps;
+    }
+
+    for (i = 0; i < numInSamps; i++)
+    {
+        pCoefs = coefs;
+
+        // acc = G*x(n)
+        /* S18Q16 * U16Q16 = S34Q32 */
+        acc_40b = (Int64)inSamps[i] * inGain;
+
+        for (j = 0; j < numBiquads; j++)
+        {
+            /* Compute current biquad output, d(n) replaces d(n-2) */
+            d1 = dlyBuf[dlyBufIdx];
+            dlyBufIdx += numBiquads;
+            if (dlyBufIdx > numDlySamps)
+            {
+                dlyBufIdx -= numDlySamps;
+            }
+            d2 = dlyBuf[dlyBufIdx];
+
+            /* Compute d(n) */
+            // acc = x(n) - a1*d(n-1) - a2*d(n-2)
+            /* S18Q16 * S16Q(16-1-IWL) = S34Q(32-1-IWL) */
+            acc_40b -= ((Int64)d1 * pCoefs[0] + (Int64)d2 * pCoefs[1]) << (1+coefIWL);
+#if (QUANT_MODE == QUANT_RND_INF)
+            acc_40b += (Uint16)1<<(14+1); /* round to infinite */
+#endif
+            d0 = (Int32)(ACC40(acc_40b)>>(15+1));
+            dlyBuf[dlyBufIdx] = d0;
+
+            /* Compute y(n) */
+            // acc = b0*d(n) + b1*d(n-1) + b2*d(n-2)
+            acc_40b = ((Int64)d2 * pCoefs[2] + (Int64)d0 * pCoefs[3] + (Int64)d1 * pCoefs[4]) << (1+coefIWL);
+            pCoefs += 5;
+
+            dlyBufIdx += numBiquads+1; // point to d(n-1) for next biquad
+            if (dlyBufIdx > numDlySamps)
+            {
+                dlyBufIdx -= numDlySamps;
+            }
+        }
+
+#if (QUANT_MODE == QUANT_RND_INF)
+        acc_40b += 1<<14;
+#endif
+
+        outSamps[i] = (Int32)acc_40b>>(15+1);
+    }
+
+    /* Update current delay index */
+    dlyBuf[0] = dlyBufIdx-1; // adjust index to 0->numDlySamps-1
+}
+
+/* Block IIR, Direct Form I, host native multiply */
+/* S18Q16 input and output data */
+/* Fixed-point format of coefficients determined by coefficient integer wordlength parameter */
+/* Input gain applied to input signal */
+void blkIirDf1Host(
+    Int32   *inSamps,       /* input samples (S18Q16) */
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Int32   *outSamps,      /* output samples (S18Q16) */
+    Int32   *dlyBuf,        /* delay buffer */
+    Uint16  inGain,         /* input gain (U16Q16) */
+    Uint16  numInSamps,     /* number of input samples */
+    Uint16  numBiquads,     /* number of biquads */
+    Uint16  coefIWL         /* coefficient integer wordlength */
+)
+{
+    Uint16 numDlySamps;
+    Int64 acc_40b;
+    Int32 tIn;
+    Int32 *ffDlyBuf, *fbDlyBuf;
+    Int16 *pCoefs;
+    Uint16 dlyBufIdx1;      // x(n-1), y(n-1) delay index
+    Uint16 dlyBufIdx2;      // x(n-2), y(n-2) delay index
+    Uint16 i, j;
+
+
+    /* Compute number of delay buffer samples */
+    numDlySamps = 2*numBiquads;
+
+    /* Initialize feed forward & feed back delay buffer pointers, */
+    /* both use same index */
+    ffDlyBuf = &dlyBuf[1];
+    fbDlyBuf = &dlyBuf[numDlySamps+1];
+    dlyBufIdx1 = dlyBuf[0];
+
+    for (i = 0; i < numInSamps; i++)
+    {
+        pCoefs = coefs;
+
+        /* Compute G*x(n) */
+        /* S18Q16 * U16Q16 = S34Q32 */
+        acc_40b = (Int64)inSamps[i] * inGain;
+#if (QUANT_MODE == QUANT_RND_INF)
+        acc_40b += (Uint16)1<<15; /* round to infinite */
+#endif
+        tIn = (Int32)(acc_40b >> 16); // S18Q16
+
+        for (j = 0; j < numBiquads; j++)
+        {
+            dlyBufIdx2 = dlyBufIdx1 + numBiquads;
+            if (dlyBufIdx2 > numDlySamps-1)
+            {
+                dlyBufIdx2 -= numDlySamps;
+            }
+
+            /* Compute current biquad output */
+            // acc = b0*x(n) + b1*x(n-1) + b2*x(n-2) - a1*y(n-1) - a2*y(n-2)
+            /* S18Q16 * S16Q(16-1-IWL) = S34Q(32-1-IWL) */
+            acc_40b = (Int64)tIn * pCoefs[0] +
+                (Int64)ffDlyBuf[dlyBufIdx1] * pCoefs[1] +
+                (Int64)ffDlyBuf[dlyBufIdx2] * pCoefs[2] -
+                (Int64)fbDlyBuf[dlyBufIdx1] * pCoefs[3] -
+                (Int64)fbDlyBuf[dlyBufIdx2] * pCoefs[4];
+            acc_40b <<= coefIWL;
+            pCoefs += 5;
+
+            // update x(n-2)
+            ffDlyBuf[dlyBufIdx2] = tIn;
+
+#if (QUANT_MODE == QUANT_RND_INF)
+            acc_40b += (Uint16)1<<14; /* round to infinite */
+#endif
+            tIn = (Int32)(ACC40(acc_40b) >> 15); // S18Q16
+
+            // update y(n-2)
+            fbDlyBuf[dlyBufIdx2] = tIn;
+
+            dlyBufIdx1++; // point to x(n-1), y(n-1) for next biquad
+            if (dlyBufIdx1 > numDlySamps-1)
+            {
+                dlyBufIdx1 -= numDlySamps;
+            }
+        }
+
+        outSamps[i] = tIn;
+    }
+
+    /* Update current delay index */
+    dlyBuf[0] = dlyBufIdx1;
+}
@@ -0,0 +1,444 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+
+#include "data_types.h"
+#include "BlkIirMc.h"
+#include "BlkAcc40.h"
+#include "cpu_features.h"
+
+#define QUANT_TRUNC         ( 0 )   /* truncate */
+#define QUANT_RND_INF       ( 1 )   /* round to infinite */
+#define QUANT_MODE          ( QUANT_RND_INF )
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define IIR_MC_SIMD_X86     ( 1 )   /* x86-64 AVX2 kernels, per-function ISA target */
+#include <immintrin.h>
+#define IIR_MC_TARGET(isa)  __attribute__((target(isa)))
+#define IIR_MC_LANES        ( 8 )   /* channels per AVX2 group */
+#else
+#define IIR_MC_SIMD_X86     ( 0 )   /* scalar only */
+#endif
+
+/* Initializes multi-channel biquad cascade state. */
+Int16 blkIirMcInit(
+    BlkIirMcState *pState,  /* multi-channel biquad state */
+    Uint16 numCh,           /* number of channels, 1..IIR_MC_MAX_CH */
+    Uint16 numBiquads       /* number of biquads, 1..IIR_MC_MAX_BIQUADS */
+)
+{
+    Uint16 i, j, k;
+
+    if ((numCh < 1) || (numCh > IIR_MC_MAX_CH))
+    {
+        return IIR_MC_ERR_CH;
+    }
+    if ((numBiquads < 1) || (numBiquads > IIR_MC_MAX_BIQUADS))
+    {
+        return IIR_MC_ERR_BIQUADS;
+    }
+
+    for (i = 0; i < IIR_MC_MAX_BIQUADS; i++)
+    {
+        for (j = 0; j < IIR_MC_NUM_SLOTS; j++)
+        {
+            for (k = 0; k < IIR_MC_MAX_CH; k++)
+            {
+                pState->dly[i][j][k] = 0;
+            }
+        }
+    }
+    pState->numCh = numCh;
+    pState->numBiquads = numBiquads;
+
+    return IIR_MC_OK;
+}
+
+/* Single channel DF2, same arithmetic as blkIirDf2() with native multiplies */
+static void blkIirDf2McCh(
+    Int32   *inSamps,       /* input samples (S18Q16) */
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Int32   *outSamps,      /* output samples (S18Q16) */
+    BlkIirMcState *pState,  /* multi-channel biquad state */
+    Uint16  ch,             /* channel */
+    Uint16  inGain,         /* input gain (U16Q16) */
+    Uint16  numInSamps,     /* number of input samples */
+    Uint16  coefIWL         /* coefficient integer wordlength */
+)
+{
+    Int64 acc_40b;
+    Int32 d0, d1, d2;       // d(n), d(n-1), d(n-2)
+    Int16 *pCoefs;
+    Uint16 i, j;
+
+    for (i = 0; i < numInSamps; i++)
+    {
+        pCoefs = coefs;
+
+        // acc = G*x(n)
+        /* S18Q16 * U16Q16 = S34Q32 */
+        acc_40b = (Int64)inSamps[i] * inGain;
+
+        for (j = 0; j < pState->numBiquads; j++)
+        {
+            d1 = pState->dly[j][IIR_MC_D1][ch];
+            d2 = pState->dly[j][IIR_MC_D2][ch];
+
+            // acc = x(n) - a1*d(n-1) - a2*d(n-2)
+            acc_40b -= ((Int64)d1 * pCoefs[0] + (Int64)d2 * pCoefs[1]) << (1+coefIWL);
+#if (QUANT_MODE == QUANT_RND_INF)
+            acc_40b += (Uint16)1<<(14+1); /* round to infinite */
+#endif
+            d0 = (Int32)(ACC40(acc_40b)>>(15+1));
+
+            // acc = b0*d(n) + b1*d(n-1) + b2*d(n-2)
+            acc_40b = ((Int64)d2 * pCoefs[2] + (Int64)d0 * pCoefs[3] + (Int64)d1 * pCoefs[4]) << (1+coefIWL);
+            pCoefs += 5;
+
+            pState->dly[j][IIR_MC_D2][ch] = d1;
+            pState->dly[j][IIR_MC_D1][ch] = d0;
+        }
+
+#if (QUANT_MODE == QUANT_RND_INF)
+        acc_40b += 1<<14;
+#endif
+
+        outSamps[i] = (Int32)acc_40b>>(15+1);
+    }
+}
+
+/* Single channel DF1, same arithmetic as blkIirDf1() with native multiplies */
+static void blkIirDf1McCh(
+    Int32   *inSamps,       /* input samples (S18Q16) */
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Int32   *outSamps,      /* output samples (S18Q16) */
+    BlkIirMcState *pState,  /* multi-channel biquad state */
+    Uint16  ch,             /* channel */
+    Uint16  inGain,         /* input gain (U16Q16) */
+    Uint16  numInSamps,     /* number of input samples */
+    Uint16  coefIWL         /* coefficient integer wordlength */
+)
+{
+    Int64 acc_40b;
+    Int32 tIn, tOut;
+    Int16 *pCoefs;
+    Uint16 i, j;
+
+    for (i = 0; i < numInSamps; i++)
+    {
+        pCoefs = coefs;
+
+        /* Compute G*x(n) */
+        /* S18Q16 * U16Q16 = S34Q32 */
+        acc_40b = (Int64)inSamps[i] * inGain;
+#if (QUANT_MODE == QUANT_RND_INF)
+        acc_40b += (Uint16)1<<15; /* round to infinite */
+#endif
+        tIn = (Int32)(acc_40b >> 16); // S18Q16
+
+        for (j = 0; j < pState->numBiquads; j++)
+        {
+            // acc = b0*x(n) + b1*x(n-1) + b2*x(n-2) - a1*y(n-1) - a2*y(n-2)
+            acc_40b = (Int64)tIn * pCoefs[0] +
+                (Int64)pState->dly[j][IIR_MC_D1][ch] * pCoefs[1] +
+                (Int64)pState->dly[j][IIR_MC_D2][ch] * pCoefs[2] -
+                (Int64)pState->dly[j][IIR_MC_Y1][ch] * pCoefs[3] -
+                (Int64)pState->dly[j][IIR_MC_Y2][ch] * pCoefs[4];
+            acc_40b <<= coefIWL;
+            pCoefs += 5;
+#if (QUANT_MODE == QUANT_RND_INF)
+            acc_40b += (Uint16)1<<14; /* round to infinite */
+#endif
+            tOut = (Int32)(ACC40(acc_40b) >> 15); // S18Q16
+
+            pState->dly[j][IIR_MC_D2][ch] = pState->dly[j][IIR_MC_D1][ch];
+            pState->dly[j][IIR_MC_D1][ch] = tIn;
+            pState->dly[j][IIR_MC_Y2][ch] = pState->dly[j][IIR_MC_Y1][ch];
+            pState->dly[j][IIR_MC_Y1][ch] = tOut;
+            tIn = tOut;
+        }
+
+        outSamps[i] = tIn;
+    }
+}
+
+#if (IIR_MC_SIMD_X86 == 1)
+
+/* 8 channels of Int32 per vector. */
+/* mul_epi32 multiplies even channels, odd channels shifted down first, */
+/* so each vector op runs as even & odd 64-bit accumulator pair. */
+/* Only bits 16..47 (15..46) of accumulators are kept, so logical 64-bit shifts suffice. */
+#define IIR_MC_MUL_E(v, c)      _mm256_mul_epi32((v), (c))
+#define IIR_MC_MUL_O(v, c)      _mm256_mul_epi32(_mm256_srli_epi64((v), 32), (c))
+/* Low 32 bits of even & odd accumulators back to 8 channels */
+#define IIR_MC_LO32(e, o)       _mm256_blend_epi32((e), _mm256_slli_epi64((o), 32), 0xAA)
+#if (ACC_WRAP_40B == 1)
+/* Low 32 bits of even & odd accumulators wrapped to 40 bits >> n, n >= 8: */
+/* acc<<24 puts bit 39 at bit 63, arithmetic shift of high 32 bits by n-8 */
+#define IIR_MC_SHR_LO32(e, o, n)    _mm256_blend_epi32(                 \
+    _mm256_srli_epi64(_mm256_srai_epi32(_mm256_slli_epi64((e), 24), (n)-8), 32), \
+    _mm256_srai_epi32(_mm256_slli_epi64((o), 24), (n)-8), 0xAA)
+#else
+/* Low 32 bits of even & odd accumulators >> n */
+#define IIR_MC_SHR_LO32(e, o, n)    IIR_MC_LO32(_mm256_srli_epi64((e), (n)), _mm256_srli_epi64((o), (n)))
+#endif
+
+/* Loads sample i of 8 channels */
+#define IIR_MC_LOAD_CH(p, ch, i)  _mm256_setr_epi32(                    \
+    (p)[(ch)][i], (p)[(ch)+1][i], (p)[(ch)+2][i], (p)[(ch)+3][i],       \
+    (p)[(ch)+4][i], (p)[(ch)+5][i], (p)[(ch)+6][i], (p)[(ch)+7][i])
+
+/* Stores sample i of 8 channels */
+#define IIR_MC_STORE_CH(p, ch, i, v)                                    \
+{                                                                       \
+    Int32 tmp_[IIR_MC_LANES];                                           \
+    Uint16 k_;                                                          \
+    _mm256_storeu_si256((__m256i *)tmp_, (v));                          \
+    for (k_ = 0; k_ < IIR_MC_LANES; k_++)                               \
+    {                                                                   \
+        (p)[(ch)+k_][i] = tmp_[k_];                                     \
+    }                                                                   \
+}
+
+/* DF2, group of 8 channels starting at ch */
+static IIR_MC_TARGET("avx2") void blkIirDf2McAvx2(
+    Int32   **inSamps,      /* per-channel input samples (S18Q16) */
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Int32   **outSamps,     /* per-channel output samples (S18Q16) */
+    BlkIirMcState *pState,  /* multi-channel biquad state */
+    Uint16  ch,             /* first channel of group */
+    Uint16  inGain,         /* input gain (U16Q16) */
+    Uint16  numInSamps,     /* number of input samples */
+    Uint16  coefIWL         /* coefficient integer wordlength */
+)
+{
+    __m256i c[IIR_MC_MAX_BIQUADS*5];
+    __m256i g, rndD, rndY;
+    __m128i shift;
+    __m256i x, d0, d1, d2;
+    __m256i accE, accO, tE, tO;
+    Uint16 numBiquads;
+    Uint16 i, j;
+
+    numBiquads = pState->numBiquads;
+    for (j = 0; j < 5*numBiquads; j++)
+    {
+        c[j] = _mm256_set1_epi64x(coefs[j]);
+    }
+    g = _mm256_set1_epi64x(inGain);
+    shift = _mm_cvtsi32_si128(1+coefIWL);
+#if (QUANT_MODE == QUANT_RND_INF)
+    rndD = _mm256_set1_epi64x((Uint16)1<<(14+1)); /* round to infinite */
+    rndY = _mm256_set1_epi64x(1<<14);
+#else
+    rndD = _mm256_setzero_si256();
+    rndY = _mm256_setzero_si256();
+#endif
+
+    for (i = 0; i < numInSamps; i++)
+    {
+        // acc = G*x(n)
+        /* S18Q16 * U16Q16 = S34Q32 */
+        x = IIR_MC_LOAD_CH(inSamps, ch, i);
+        accE = IIR_MC_MUL_E(x, g);
+        accO = IIR_MC_MUL_O(x, g);
+
+        for (j = 0; j < numBiquads; j++)
+        {
+            d1 = _mm256_loadu_si256((const __m256i *)&pState->dly[j][IIR_MC_D1][ch]);
+            d2 = _mm256_loadu_si256((const __m256i *)&pState->dly[j][IIR_MC_D2][ch]);
+
+            // acc = x(n) - a1*d(n-1) - a2*d(n-2)
+            tE = _mm256_add_epi64(IIR_MC_MUL_E(d1, c[5*j]), IIR_MC_MUL_E(d2, c[5*j+1]));
+            tO = _mm256_add_epi64(IIR_MC_MUL_O(d1, c[5*j]), IIR_MC_MUL_O(d2, c[5*j+1]));
+            accE = _mm256_add_epi64(_mm256_sub_epi64(accE, _mm256_sll_epi64(tE, shift)), rndD);
+            accO = _mm256_add_epi64(_mm256_sub_epi64(accO, _mm256_sll_epi64(tO, shift)), rndD);
+            d0 = IIR_MC_SHR_LO32(accE, accO, 15+1);
+
+            // acc = b0*d(n) + b1*d(n-1) + b2*d(n-2)
+            tE = _mm256_add_epi64(_mm256_add_epi64(IIR_MC_MUL_E(d2, c[5*j+2]),
+                IIR_MC_MUL_E(d0, c[5*j+3])), IIR_MC_MUL_E(d1, c[5*j+4]));
+            tO = _mm256_add_epi64(_mm256_add_epi64(IIR_MC_MUL_O(d2, c[5*j+2]),
+                IIR_MC_MUL_O(d0, c[5*j+3])), IIR_MC_MUL_O(d1, c[5*j+4]));
+            accE = _mm256_sll_epi64(tE, shift);
+            accO = _mm256_sll_epi64(tO, shift);
+
+            _mm256_storeu_si256((__m256i *)&pState->dly[j][IIR_MC_D2][ch], d1);
+            _mm256_storeu_si256((__m256i *)&pState->dly[j][IIR_MC_D1][ch], d0);
+        }
+
+        /* (Int32)acc >> 16 as blkIirDf2(), low 32 bits then arithmetic shift */
+        accE = _mm256_add_epi64(accE, rndY);
+        accO = _mm256_add_epi64(accO, rndY);
+        x = _mm256_srai_epi32(IIR_MC_LO32(accE, accO), 15+1);
+        IIR_MC_STORE_CH(outSamps, ch, i, x);
+    }
+}
+
+/* DF1, group of 8 channels starting at ch */
+static IIR_MC_TARGET("avx2") void blkIirDf1McAvx2(
+    Int32   **inSamps,      /* per-channel input samples (S18Q16) */
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Int32   **outSamps,     /* per-channel output samples (S18Q16) */
+    BlkIirMcState *pState,  /* multi-channel biquad state */
+    Uint16  ch,             /* first channel of group */
+    Uint16  inGain,         /* input gain (U16Q16) */
+    Uint16  numInSamps,     /* number of input samples */
+    Uint16  coefIWL         /* coefficient integer wordlength */
+)
+{
+    __m256i c[IIR_MC_MAX_BIQUADS*5];
+    __m256i g, rndIn, rndY;
+    __m128i shift;
+    __m256i x, tIn, tOut, x1, x2, y1, y2;
+    __m256i accE, accO;
+    Uint16 numBiquads;
+    Uint16 i, j;
+
+    numBiquads = pState->numBiquads;
+    for (j = 0; j < 5*numBiquads; j++)
+    {
+        c[j] = _mm256_set1_epi64x(coefs[j]);
+    }
+    g = _mm256_set1_epi64x(inGain);
+    shift = _mm_cvtsi32_si128(coefIWL);
+#if (QUANT_MODE == QUANT_RND_INF)
+    rndIn = _mm256_set1_epi64x((Uint16)1<<15); /* round to infinite */
+    rndY = _mm256_set1_epi64x((Uint16)1<<14);
+#else
+    rndIn = _mm256_setzero_si256();
+    rndY = _mm256_setzero_si256();
+#endif
+
+    for (i = 0; i < numInSamps; i++)
+    {
+        /* Compute G*x(n) */
+        /* S18Q16 * U16Q16 = S34Q32 */
+        x = IIR_MC_LOAD_CH(inSamps, ch, i);
+        accE = _mm256_add_epi64(IIR_MC_MUL_E(x, g), rndIn);
+        accO = _mm256_add_epi64(IIR_MC_MUL_O(x, g), rndIn);
+        tIn = IIR_MC_LO32(_mm256_srli_epi64(accE, 16), _mm256_srli_epi64(accO, 16));
+
+        for (j = 0; j < numBiquads; j++)
+        {
+            x1 = _mm256_loadu_si256((const __m256i *)&pState->dly[j][IIR_MC_D1][ch]);
+            x2 = _mm256_loadu_si256((const __m256i *)&pState->dly[j][IIR_MC_D2][ch]);
+            y1 = _mm256_loadu_si256((const __m256i *)&pState->dly[j][IIR_MC_Y1][ch]);
+            y2 = _mm256_loadu_si256((const __m256i *)&pState->dly[j][IIR_MC_Y2][ch]);
+
+            // acc = b0*x(n) + b1*x(n-1) + b2*x(n-2) - a1*y(n-1) - a2*y(n-2)
+            accE = _mm256_add_epi64(_mm256_add_epi64(IIR_MC_MUL_E(tIn, c[5*j]),
+                IIR_MC_MUL_E(x1, c[5*j+1])), IIR_MC_MUL_E(x2, c[5*j+2]));
+            accE = _mm256_sub_epi64(_mm256_sub_epi64(accE,
+                IIR_MC_MUL_E(y1, c[5*j+3])), IIR_MC_MUL_E(y2, c[5*j+4]));
+            accO = _mm256_add_epi64(_mm256_add_epi64(IIR_MC_MUL_O(tIn, c[5*j]),
+                IIR_MC_MUL_O(x1, c[5*j+1])), IIR_MC_MUL_O(x2, c[5*j+2]));
+            accO = _mm256_sub_epi64(_mm256_sub_epi64(accO,
+                IIR_MC_MUL_O(y1, c[5*j+3])), IIR_MC_MUL_O(y2, c[5*j+4]));
+            accE = _mm256_add_epi64(_mm256_sll_epi64(accE, shift), rndY);
+            accO = _mm256_add_epi64(_mm256_sll_epi64(accO, shift), rndY);
+            tOut = IIR_MC_SHR_LO32(accE, accO, 15);
+
+            _mm256_storeu_si256((__m256i *)&pState->dly[j][IIR_MC_D2][ch], x1);
+            _mm256_storeu_si256((__m256i *)&pState->dly[j][IIR_MC_D1][ch], tIn);
+            _mm256_storeu_si256((__m256i *)&pState->dly[j][IIR_MC_Y2][ch], y1);
+            _mm256_storeu_si256((__m256i *)&pState->dly[j][IIR_MC_Y1][ch], tOut);
+            tIn = tOut;
+        }
+
+        IIR_MC_STORE_CH(outSamps, ch, i, tIn);
+    }
+}
+
+#endif
+
+/* Multi-channel blkIirDf2(), all channels share coefficients. */
+void blkIirDf2Mc(
+    Int32   **inSamps,      /* per-channel input samples (S18Q16) */
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Int32   **outSamps,     /* per-channel output samples (S18Q16) */
+    BlkIirMcState *pState,  /* multi-channel biquad state */
+    Uint16  inGain,         /* input gain (U16Q16) */
+    Uint16  numInSamps,     /* number of input samples per channel */
+    Uint16  coefIWL         /* coefficient integer wordlength */
+)
+{
+    Uint16 ch;
+
+    ch = 0;
+#if (IIR_MC_SIMD_X86 == 1)
+    if (cpuFeatures() & CPU_FEAT_AVX2)
+    {
+        for ( ; ch+IIR_MC_LANES <= pState->numCh; ch += IIR_MC_LANES)
+        {
+            blkIirDf2McAvx2(inSamps, coefs, outSamps, pState, ch, inGain, numInSamps, coefIWL);
+        }
+    }
+#endif
+
+    /* Remaining channels */
+    for ( ; ch < pState->numCh; ch++)
+    {
+        blkIirDf2McCh(inSamps[ch], coefs, outSamps[ch], pState, ch, inGain, numInSamps, coefIWL);
+    }
+}
+
+/* Multi-channel blkIirDf1(), all channels share coefficients. */
+void blkIirDf1Mc(
+    Int32   **inSamps,      /* per-channel input samples (S18Q16) */
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Int32   **outSamps,     /* per-channel output samples (S18Q16) */
+    BlkIirMcState *pState,  /* multi-channel biquad state */
+    Uint16  inGain,         /* input gain (U16Q16) */
+    Uint16  numInSamps,     /* number of input samples per channel */
+    Uint16  coefIWL         /* coefficient integer wordlength */
+)
+{
+    Uint16 ch;
+
+    ch = 0;
+#if (IIR_MC_SIMD_X86 == 1)
+    if (cpuFeatures() & CPU_FEAT_AVX2)
+    {
+        for ( ; ch+IIR_MC_LANES <= pState->numCh; ch += IIR_MC_LANES)
+        {
+            blkIirDf1McAvx2(inSamps, coefs, outSamps, pState, ch, inGain, numInSamps, coefIWL);
+        }
+    }
+#endif
+
+    /* Remaining channels */
+    for ( ; ch < pState->numCh; ch++)
+    {
+        blkIirDf1McCh(inSamps[ch], coefs, outSamps[ch], pState, ch, inGain, numInSamps, coefIWL);
+    }
+}
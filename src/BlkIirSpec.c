@@ -0,0 +1,392 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+
+#include "data_types.h"
+#include "BlkIir.h"
+#include "BlkIirSpec.h"
+#include "BlkAcc40.h"
+
+#define QUANT_TRUNC         ( 0 )   /* truncate */
+#define QUANT_RND_INF       ( 1 )   /* round to infinite */
+#define QUANT_MODE          ( QUANT_RND_INF )
+
+#if (QUANT_MODE == QUANT_RND_INF)
+#define IIR_SPEC_RND(n)     ( (Int64)1<<(n) )   /* round to infinite */
+#else
+#define IIR_SPEC_RND(n)     ( 0 )               /* truncate */
+#endif
+
+/* Loads blkIirDf2() delay buffer to d(n-1), d(n-2) of each biquad */
+static void iirDf2RingLoad(
+    Int32   *dlyBuf,        /* delay buffer */
+    Uint16  numBiquads,     /* number of biquads */
+    Int32   *d1,            /* d(n-1) of each biquad */
+    Int32   *d2             /* d(n-2) of each biquad */
+)
+{
+    Uint16 numDlySamps;
+    Uint16 dlyBufIdx;
+    Uint16 j;
+
+    numDlySamps = 2*numBiquads;
+
+    dlyBufIdx = dlyBuf[0]+1; // adjust index to 1->numDlySamps
+    if (dlyBufIdx > numDlySamps)
+    {
+        dlyBufIdx -= numDlySamps;
+    }
+
+    for (j = 0; j < numBiquads; j++)
+    {
+        d1[j] = dlyBuf[dlyBufIdx];
+        d2[j] = dlyBuf[(dlyBufIdx+numBiquads > numDlySamps) ? dlyBufIdx+numBiquads-numDlySamps : dlyBufIdx+numBiquads];
+        dlyBufIdx = (dlyBufIdx == numDlySamps) ? 1 : dlyBufIdx+1;
+    }
+}
+
+/* Stores d(n-1), d(n-2) of each biquad to blkIirDf2() delay buffer, */
+/* delay index advanced as by numInSamps samples of blkIirDf2() */
+static void iirDf2RingStore(
+    Int32   *dlyBuf,        /* delay buffer */
+    Uint16  numBiquads,     /* number of biquads */
+    Int32   *d1,            /* d(n-1) of each biquad */
+    Int32   *d2,            /* d(n-2) of each biquad */
+    Uint16  numInSamps      /* number of input samples processed */
+)
+{
+    Uint16 numDlySamps;
+    Uint16 dlyBufIdx;
+    Uint16 j;
+
+    numDlySamps = 2*numBiquads;
+
+    dlyBufIdx = dlyBuf[0]+1; // adjust index to 1->numDlySamps
+    if (dlyBufIdx > numDlySamps)
+    {
+        dlyBufIdx -= numDlySamps;
+    }
+
+    /* Index advances by numBiquads per sample */
+    if (numInSamps & 1)
+    {
+        dlyBufIdx += numBiquads;
+        if (dlyBufIdx > numDlySamps)
+        {
+            dlyBufIdx -= numDlySamps;
+        }
+    }
+    dlyBuf[0] = dlyBufIdx-1; // adjust index to 0->numDlySamps-1
+
+    for (j = 0; j < numBiquads; j++)
+    {
+        dlyBuf[dlyBufIdx] = d1[j];
+        dlyBuf[(dlyBufIdx+numBiquads > numDlySamps) ? dlyBufIdx+numBiquads-numDlySamps : dlyBufIdx+numBiquads] = d2[j];
+        dlyBufIdx = (dlyBufIdx == numDlySamps) ? 1 : dlyBufIdx+1;
+    }
+}
+
+/* Loads blkIirDf1() delay buffer to x(n-1), x(n-2), y(n-1), y(n-2) of each biquad */
+static void iirDf1RingLoad(
+    Int32   *dlyBuf,        /* delay buffer */
+    Uint16  numBiquads,     /* number of biquads */
+    Int32   *x1,            /* x(n-1) of each biquad */
+    Int32   *x2,            /* x(n-2) of each biquad */
+    Int32   *y1,            /* y(n-1) of each biquad */
+    Int32   *y2             /* y(n-2) of each biquad */
+)
+{
+    Uint16 numDlySamps;
+    Int32 *ffDlyBuf, *fbDlyBuf;
+    Uint16 dlyBufIdx1, dlyBufIdx2;
+    Uint16 j;
+
+    numDlySamps = 2*numBiquads;
+    ffDlyBuf = &dlyBuf[1];
+    fbDlyBuf = &dlyBuf[numDlySamps+1];
+
+    dlyBufIdx1 = dlyBuf[0];
+    for (j = 0; j < numBiquads; j++)
+    {
+        dlyBufIdx2 = (dlyBufIdx1+numBiquads > numDlySamps-1) ? dlyBufIdx1+numBiquads-numDlySamps : dlyBufIdx1+numBiquads;
+        x1[j] = ffDlyBuf[dlyBufIdx1];
+        x2[j] = ffDlyBuf[dlyBufIdx2];
+        y1[j] = fbDlyBuf[dlyBufIdx1];
+        y2[j] = fbDlyBuf[dlyBufIdx2];
+        dlyBufIdx1 = (dlyBufIdx1 == numDlySamps-1) ? 0 : dlyBufIdx1+1;
+    }
+}
+
+/* Stores x(n-1), x(n-2), y(n-1), y(n-2) of each biquad to blkIirDf1() delay buffer, */
+/* delay index advanced as by numInSamps samples of blkIirDf1() */
+static void iirDf1RingStore(
+    Int32   *dlyBuf,        /* delay buffer */
+    Uint16  numBiquads,     /* number of biquads */
+    Int32   *x1,            /* x(n-1) of each biquad */
+    Int32   *x2,            /* x(n-2) of each biquad */
+    Int32   *y1,            /* y(n-1) of each biquad */
+    Int32   *y2,            /* y(n-2) of each biquad */
+    Uint16  numInSamps      /* number of input samples processed */
+)
+{
+    Uint16 numDlySamps;
+    Int32 *ffDlyBuf, *fbDlyBuf;
+    Uint16 dlyBufIdx1, dlyBufIdx2;
+    Uint16 j;
+
+    numDlySamps = 2*numBiquads;
+    ffDlyBuf = &dlyBuf[1];
+    fbDlyBuf = &dlyBuf[numDlySamps+1];
+
+    /* Index advances by numBiquads per sample */
+    dlyBufIdx1 = dlyBuf[0];
+    if (numInSamps & 1)
+    {
+        dlyBufIdx1 += numBiquads;
+        if (dlyBufIdx1 > numDlySamps-1)
+        {
+            dlyBufIdx1 -= numDlySamps;
+        }
+    }
+    dlyBuf[0] = dlyBufIdx1;
+
+    for (j = 0; j < numBiquads; j++)
+    {
+        dlyBufIdx2 = (dlyBufIdx1+numBiquads > numDlySamps-1) ? dlyBufIdx1+numBiquads-numDlySamps : dlyBufIdx1+numBiquads;
+        ffDlyBuf[dlyBufIdx1] = x1[j];
+        ffDlyBuf[dlyBufIdx2] = x2[j];
+        fbDlyBuf[dlyBufIdx1] = y1[j];
+        fbDlyBuf[dlyBufIdx2] = y2[j];
+        dlyBufIdx1 = (dlyBufIdx1 == numDlySamps-1) ? 0 : dlyBufIdx1+1;
+    }
+}
+
+/* Generates DF2 kernel for NB biquads & coefficient integer wordlength IWL. */
+/* Constant trip counts & shifts, loops fully unrolled by compiler, */
+/* delay line held in locals for whole block. */
+#define IIR_DF2_DEFINE_KERNEL(NB, IWL)                                      \
+static void blkIirDf2_B##NB##_I##IWL(                                       \
+    Int32   *inSamps,                                                       \
+    Int16   *coefs,                                                         \
+    Int32   *outSamps,                                                      \
+    Int32   *dlyBuf,                                                        \
+    Uint16  inGain,                                                         \
+    Uint16  numInSamps,                                                     \
+    Uint16  numBiquads,                                                     \
+    Uint16  coefIWL                                                         \
+)                                                                           \
+{                                                                           \
+    Int32 d1[NB], d2[NB];                                                   \
+    Int32 d0;                                                               \
+    Int64 acc_40b;                                                          \
+    Uint16 i, j;                                                            \
+                                                                            \
+    (void)numBiquads;                                                       \
+    (void)coefIWL;                                                          \
+    iirDf2RingLoad(dlyBuf, NB, d1, d2);                                     \
+                                                                            \
+    for (i = 0; i < numInSamps; i++)                                        \
+    {                                                                       \
+        /* acc = G*x(n), S34Q32 */                                          \
+        acc_40b = (Int64)inSamps[i] * inGain;                               \
+        for (j = 0; j < NB; j++)                                            \
+        {                                                                   \
+            /* acc = x(n) - a1*d(n-1) - a2*d(n-2) */                        \
+            acc_40b -= ((Int64)d1[j] * coefs[5*j] +                         \
+                (Int64)d2[j] * coefs[5*j+1]) << (1+IWL);                    \
+            acc_40b += IIR_SPEC_RND(14+1);                                  \
+            d0 = (Int32)(ACC40(acc_40b) >> (15+1));                         \
+            /* acc = b0*d(n) + b1*d(n-1) + b2*d(n-2) */                     \
+            acc_40b = ((Int64)d2[j] * coefs[5*j+2] +                        \
+                (Int64)d0 * coefs[5*j+3] +                                  \
+                (Int64)d1[j] * coefs[5*j+4]) << (1+IWL);                    \
+            d2[j] = d1[j];                                                  \
+            d1[j] = d0;                                                     \
+        }                                                                   \
+        acc_40b += IIR_SPEC_RND(14);                                        \
+        outSamps[i] = (Int32)acc_40b >> (15+1);                             \
+    }                                                                       \
+                                                                            \
+    iirDf2RingStore(dlyBuf, NB, d1, d2, numInSamps);                        \
+}
+
+/* Generates DF1 kernel for NB biquads & coefficient integer wordlength IWL. */
+/* Constant trip counts & shifts, loops fully unrolled by compiler, */
+/* delay line held in locals for whole block. */
+#define IIR_DF1_DEFINE_KERNEL(NB, IWL)                                      \
+static void blkIirDf1_B##NB##_I##IWL(                                       \
+    Int32   *inSamps,                                                       \
+    Int16   *coefs,                                                         \
+    Int32   *outSamps,                                                      \
+    Int32   *dlyBuf,                                                        \
+    Uint16  inGain,                                                         \
+    Uint16  numInSamps,                                                     \
+    Uint16  numBiquads,                                                     \
+    Uint16  coefIWL                                                         \
+)                                                                           \
+{                                                                           \
+    Int32 x1[NB], x2[NB], y1[NB], y2[NB];                                   \
+    Int32 tIn, tOut;                                                        \
+    Int64 acc_40b;                                                          \
+    Uint16 i, j;                                                            \
+                                                                            \
+    (void)numBiquads;                                                       \
+    (void)coefIWL;                                                          \
+    iirDf1RingLoad(dlyBuf, NB, x1, x2, y1, y2);                             \
+                                                                            \
+    for (i = 0; i < numInSamps; i++)                                        \
+    {                                                                       \
+        /* G*x(n), S34Q32 -> S18Q16 */                                      \
+        acc_40b = (Int64)inSamps[i] * inGain + IIR_SPEC_RND(15);            \
+        tIn = (Int32)(acc_40b >> 16);                                       \
+        for (j = 0; j < NB; j++)                                            \
+        {                                                                   \
+            /* acc = b0*x(n) + b1*x(n-1) + b2*x(n-2) - a1*y(n-1) - a2*y(n-2) */ \
+            acc_40b = ((Int64)tIn * coefs[5*j] +                            \
+                (Int64)x1[j] * coefs[5*j+1] +                               \
+                (Int64)x2[j] * coefs[5*j+2] -                               \
+                (Int64)y1[j] * coefs[5*j+3] -                               \
+                (Int64)y2[j] * coefs[5*j+4]) << IWL;                        \
+            acc_40b += IIR_SPEC_RND(14);                                    \
+            tOut = (Int32)(ACC40(acc_40b) >> 15);                           \
+            x2[j] = x1[j];                                                  \
+            x1[j] = tIn;                                                    \
+            y2[j] = y1[j];                                                  \
+            y1[j] = tOut;                                                   \
+            tIn = tOut;                                                     \
+        }                                                                   \
+        outSamps[i] = tIn;                                                  \
+    }                                                                       \
+                                                                            \
+    iirDf1RingStore(dlyBuf, NB, x1, x2, y1, y2, numInSamps);                \
+}
+
+IIR_DF2_DEFINE_KERNEL(1, 0)
+IIR_DF2_DEFINE_KERNEL(1, 1)
+IIR_DF2_DEFINE_KERNEL(1, 2)
+IIR_DF2_DEFINE_KERNEL(2, 0)
+IIR_DF2_DEFINE_KERNEL(2, 1)
+IIR_DF2_DEFINE_KERNEL(2, 2)
+IIR_DF2_DEFINE_KERNEL(3, 0)
+IIR_DF2_DEFINE_KERNEL(3, 1)
+IIR_DF2_DEFINE_KERNEL(3, 2)
+IIR_DF2_DEFINE_KERNEL(4, 0)
+IIR_DF2_DEFINE_KERNEL(4, 1)
+IIR_DF2_DEFINE_KERNEL(4, 2)
+
+IIR_DF1_DEFINE_KERNEL(1, 0)
+IIR_DF1_DEFINE_KERNEL(1, 1)
+IIR_DF1_DEFINE_KERNEL(1, 2)
+IIR_DF1_DEFINE_KERNEL(2, 0)
+IIR_DF1_DEFINE_KERNEL(2, 1)
+IIR_DF1_DEFINE_KERNEL(2, 2)
+IIR_DF1_DEFINE_KERNEL(3, 0)
+IIR_DF1_DEFINE_KERNEL(3, 1)
+IIR_DF1_DEFINE_KERNEL(3, 2)
+IIR_DF1_DEFINE_KERNEL(4, 0)
+IIR_DF1_DEFINE_KERNEL(4, 1)
+IIR_DF1_DEFINE_KERNEL(4, 2)
+
+/* Specialized kernels, indexed by [numBiquads-1][coefIWL] */
+static const BlkIirFxn iirDf2KernelTbl[IIR_SPEC_MAX_BIQUADS][IIR_SPEC_MAX_IWL+1] =
+{
+    { blkIirDf2_B1_I0, blkIirDf2_B1_I1, blkIirDf2_B1_I2 },
+    { blkIirDf2_B2_I0, blkIirDf2_B2_I1, blkIirDf2_B2_I2 },
+    { blkIirDf2_B3_I0, blkIirDf2_B3_I1, blkIirDf2_B3_I2 },
+    { blkIirDf2_B4_I0, blkIirDf2_B4_I1, blkIirDf2_B4_I2 }
+};
+
+static const BlkIirFxn iirDf1KernelTbl[IIR_SPEC_MAX_BIQUADS][IIR_SPEC_MAX_IWL+1] =
+{
+    { blkIirDf1_B1_I0, blkIirDf1_B1_I1, blkIirDf1_B1_I2 },
+    { blkIirDf1_B2_I0, blkIirDf1_B2_I1, blkIirDf1_B2_I2 },
+    { blkIirDf1_B3_I0, blkIirDf1_B3_I1, blkIirDf1_B3_I2 },
+    { blkIirDf1_B4_I0, blkIirDf1_B4_I1, blkIirDf1_B4_I2 }
+};
+
+/* Returns DF2 kernel specialized for (numBiquads, coefIWL). */
+BlkIirFxn blkIirDf2Select(
+    Uint16  numBiquads,     /* number of biquads */
+    Uint16  coefIWL         /* coefficient integer wordlength */
+)
+{
+    if ((numBiquads < 1) || (numBiquads > IIR_SPEC_MAX_BIQUADS) || (coefIWL > IIR_SPEC_MAX_IWL))
+    {
+        return blkIirDf2;
+    }
+
+    return iirDf2KernelTbl[numBiquads-1][coefIWL];
+}
+
+/* Returns DF1 kernel specialized for (numBiquads, coefIWL). */
+BlkIirFxn blkIirDf1Select(
+    Uint16  numBiquads,     /* number of biquads */
+    Uint16  coefIWL         /* coefficient integer wordlength */
+)
+{
+    if ((numBiquads < 1) || (numBiquads > IIR_SPEC_MAX_BIQUADS) || (coefIWL > IIR_SPEC_MAX_IWL))
+    {
+        return blkIirDf1;
+    }
+
+    return iirDf1KernelTbl[numBiquads-1][coefIWL];
+}
+
+/* Block IIR, Direct Form II, runs kernel specialized for (numBiquads, coefIWL). */
+void blkIirDf2Spec(
+    Int32   *inSamps,       /* input samples (S18Q16) */
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Int32   *outSamps,      /* output samples (S18Q16) */
+    Int32   *dlyBuf,        /* delay buffer */
+    Uint16  inGain,         /* input gain (U16Q16) */
+    Uint16  numInSamps,     /* number of input samples */
+    Uint16  numBiquads,     /* number of biquads */
+    Uint16  coefIWL         /* coefficient integer wordlength */
+)
+{
+    blkIirDf2Select(numBiquads, coefIWL)(inSamps, coefs, outSamps, dlyBuf, inGain, numInSamps, numBiquads, coefIWL);
+}
+
+/* Block IIR, Direct Form I, runs kernel specialized for (numBiquads, coefIWL). */
+void blkIirDf1Spec(
+    Int32   *inSamps,       /* input samples (S18Q16) */
+    Int16   *coefs,         /* filter coefficients (S16Q15) */
+    Int32   *outSamps,      /* output samples (S18Q16) */
+    Int32   *dlyBuf,        /* delay buffer */
+    Uint16  inGain,         /* input gain (U16Q16) */
+    Uint16  numInSamps,     /* number of input samples */
+    Uint16  numBiquads,     /* number of biquads */
+    Uint16  coefIWL         /* coefficient integer wordlength */
+)
+{
+    blkIirDf1Select(numBiquads, coefIWL)(inSamps, coefs, outSamps, dlyBuf, inGain, numInSamps, numBiquads, coefIWL);
+}
@@ -0,0 +1,350 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+
+#include <math.h>
+#include "data_types.h"
+#include "BlkIirSs.h"
+
+#define QUANT_TRUNC         ( 0 )   /* truncate */
+#define QUANT_RND_INF       ( 1 )   /* round to infinite */
+#define QUANT_MODE          ( QUANT_RND_INF )
+
+#define IIR_SS_FLT_MARGIN   ( 1.0/(1L<<20) )    /* floating-point error margin per unit noise gain, LSBs */
+#define IIR_SS_DECAY_THR    ( 1.0e-13 )         /* impulse response decay threshold */
+
+/* Initializes block state-space IIR from blkIirDf1() or blkIirDf2() coefficients. */
+Int16 blkIirSsInit(
+    BlkIirSsState *pState,  /* block state-space IIR state */
+    Int16   *coefs,         /* filter coefficients, blkIirDf1() or blkIirDf2() order */
+    Uint16  numBiquads,     /* number of biquads, 1..IIR_SS_MAX_BIQUADS */
+    Uint16  coefIWL,        /* coefficient integer wordlength */
+    Uint16  inGain,         /* input gain (U16Q16) */
+    Uint16  form            /* IIR_SS_DF1 or IIR_SS_DF2 */
+)
+{
+    BlkIirSsBiquad *pBq;
+    Float64 scale;
+    Float64 ak[2][2];       // A^k
+    Float64 t[2][2];
+    Float64 h[IIR_SS_BLK_LEN]; // impulse response
+    Float64 c0, c1;         // C
+    Uint16 i, j, k;
+
+    if ((numBiquads < 1) || (numBiquads > IIR_SS_MAX_BIQUADS))
+    {
+        return IIR_SS_ERR_BIQUADS;
+    }
+    if ((form != IIR_SS_DF1) && (form != IIR_SS_DF2))
+    {
+        return IIR_SS_ERR_FORM;
+    }
+
+    /* S16Q(16-1-IWL) */
+    scale = (Float64)(1L<<coefIWL) / 32768.0;
+
+    for (i = 0; i < numBiquads; i++)
+    {
+        pBq = &pState->bq[i];
+
+        if (form == IIR_SS_DF1)
+        {
+            pBq->b0 = coefs[5*i] * scale;
+            pBq->b1 = coefs[5*i+1] * scale;
+            pBq->b2 = coefs[5*i+2] * scale;
+            pBq->a1 = coefs[5*i+3] * scale;
+            pBq->a2 = coefs[5*i+4] * scale;
+        }
+        else
+        {
+            pBq->a1 = coefs[5*i] * scale;
+            pBq->a2 = coefs[5*i+1] * scale;
+            pBq->b2 = coefs[5*i+2] * scale;
+            pBq->b0 = coefs[5*i+3] * scale;
+            pBq->b1 = coefs[5*i+4] * scale;
+        }
+
+        /* A = [-a1 -a2; 1 0], B = [1; 0], C = [b1-b0*a1 b2-b0*a2], D = b0 */
+        c0 = pBq->b1 - pBq->b0*pBq->a1;
+        c1 = pBq->b2 - pBq->b0*pBq->a2;
+
+        /* C A^k & impulse response h(k) = C A^(k-1) B */
+        ak[0][0] = 1.0; ak[0][1] = 0.0;
+        ak[1][0] = 0.0; ak[1][1] = 1.0;
+        h[0] = pBq->b0;
+        for (k = 0; k < IIR_SS_BLK_LEN; k++)
+        {
+            pBq->c[k][0] = c0*ak[0][0] + c1*ak[1][0];
+            pBq->c[k][1] = c0*ak[0][1] + c1*ak[1][1];
+            if (k+1 < IIR_SS_BLK_LEN)
+            {
+                h[k+1] = pBq->c[k][0]; // C A^k B, B selects 1st column
+            }
+
+            /* A^(k+1) = A A^k */
+            t[0][0] = -pBq->a1*ak[0][0] - pBq->a2*ak[1][0];
+            t[0][1] = -pBq->a1*ak[0][1] - pBq->a2*ak[1][1];
+            t[1][0] = ak[0][0];
+            t[1][1] = ak[0][1];
+            ak[0][0] = t[0][0]; ak[0][1] = t[0][1];
+            ak[1][0] = t[1][0]; ak[1][1] = t[1][1];
+
+            /* A^(k+1) B feeds state from input L-2-k */
+            if (k+1 < IIR_SS_BLK_LEN)
+            {
+                pBq->b[0][IIR_SS_BLK_LEN-2-k] = ak[0][0];
+                pBq->b[1][IIR_SS_BLK_LEN-2-k] = ak[1][0];
+            }
+        }
+        pBq->b[0][IIR_SS_BLK_LEN-1] = 1.0;
+        pBq->b[1][IIR_SS_BLK_LEN-1] = 0.0;
+
+        /* A^L */
+        pBq->a[0][0] = ak[0][0]; pBq->a[0][1] = ak[0][1];
+        pBq->a[1][0] = ak[1][0]; pBq->a[1][1] = ak[1][1];
+
+        /* D_kj = h(k-j) */
+        for (k = 0; k < IIR_SS_BLK_LEN; k++)
+        {
+            for (j = 0; j < IIR_SS_BLK_LEN; j++)
+            {
+                pBq->d[k][j] = (j <= k) ? h[k-j] : 0.0;
+            }
+        }
+
+        pBq->s[0] = 0.0;
+        pBq->s[1] = 0.0;
+    }
+
+    pState->numBiquads = numBiquads;
+    pState->form = form;
+    pState->inGain = inGain;
+
+    return IIR_SS_OK;
+}
+
+/* Computes block state-space IIR input from input sample, */
+/* DF1 input rounding reproduced exactly */
+static Float64 blkIirSsIn(
+    BlkIirSsState *pState,  /* block state-space IIR state */
+    Int32   inSamp          /* input sample (S18Q16) */
+)
+{
+    Int64 acc;
+
+    /* S18Q16 * U16Q16 = S34Q32 */
+    acc = (Int64)inSamp * pState->inGain;
+    if (pState->form == IIR_SS_DF1)
+    {
+#if (QUANT_MODE == QUANT_RND_INF)
+        acc += (Uint16)1<<15; /* round to infinite */
+#endif
+        return (Float64)(Int32)(acc >> 16);
+    }
+    return (Float64)acc / 65536.0;
+}
+
+/* Computes output sample from block state-space IIR output */
+static Int32 blkIirSsOut(
+    BlkIirSsState *pState,  /* block state-space IIR state */
+    Float64 y               /* output, S18Q16 LSBs */
+)
+{
+    if (pState->form == IIR_SS_DF1)
+    {
+#if (QUANT_MODE == QUANT_RND_INF)
+        y += 0.5; /* round to infinite */
+#endif
+        return (Int32)floor(y);
+    }
+
+    /* (Int32)acc >> 16 of blkIirDf2() keeps 16 bits */
+#if (QUANT_MODE == QUANT_RND_INF)
+    y += 0.25;
+#endif
+    return (Int32)(Int16)(Int64)floor(y);
+}
+
+/* Block IIR, block state-space (look-ahead) form, 64-bit floating-point. */
+void blkIirSs(
+    Int32   *inSamps,       /* input samples (S18Q16) */
+    Int32   *outSamps,      /* output samples (S18Q16) */
+    BlkIirSsState *pState,  /* block state-space IIR state */
+    Uint16  numInSamps      /* number of input samples */
+)
+{
+    BlkIirSsBiquad *pBq;
+    Float64 u[IIR_SS_BLK_LEN], y[IIR_SS_BLK_LEN];
+    Float64 s0, s1, d0;
+    Uint16 i, j, k;
+
+    i = 0;
+    for ( ; i+IIR_SS_BLK_LEN <= numInSamps; i += IIR_SS_BLK_LEN)
+    {
+        for (k = 0; k < IIR_SS_BLK_LEN; k++)
+        {
+            u[k] = blkIirSsIn(pState, inSamps[i+k]);
+        }
+
+        for (j = 0; j < pState->numBiquads; j++)
+        {
+            pBq = &pState->bq[j];
+            s0 = pBq->s[0];
+            s1 = pBq->s[1];
+
+            /* Outputs are independent of each other */
+            y[0] = pBq->c[0][0]*s0 + pBq->c[0][1]*s1 + pBq->d[0][0]*u[0];
+            y[1] = pBq->c[1][0]*s0 + pBq->c[1][1]*s1 + pBq->d[1][0]*u[0] + pBq->d[1][1]*u[1];
+            y[2] = pBq->c[2][0]*s0 + pBq->c[2][1]*s1 + pBq->d[2][0]*u[0] + pBq->d[2][1]*u[1] +
+                pBq->d[2][2]*u[2];
+            y[3] = pBq->c[3][0]*s0 + pBq->c[3][1]*s1 + pBq->d[3][0]*u[0] + pBq->d[3][1]*u[1] +
+                pBq->d[3][2]*u[2] + pBq->d[3][3]*u[3];
+
+            /* Advance state by IIR_SS_BLK_LEN samples */
+            pBq->s[0] = pBq->a[0][0]*s0 + pBq->a[0][1]*s1 +
+                pBq->b[0][0]*u[0] + pBq->b[0][1]*u[1] + pBq->b[0][2]*u[2] + pBq->b[0][3]*u[3];
+            pBq->s[1] = pBq->a[1][0]*s0 + pBq->a[1][1]*s1 +
+                pBq->b[1][0]*u[0] + pBq->b[1][1]*u[1] + pBq->b[1][2]*u[2] + pBq->b[1][3]*u[3];
+
+            for (k = 0; k < IIR_SS_BLK_LEN; k++)
+            {
+                u[k] = y[k];
+            }
+        }
+
+        for (k = 0; k < IIR_SS_BLK_LEN; k++)
+        {
+            outSamps[i+k] = blkIirSsOut(pState, u[k]);
+        }
+    }
+
+    /* Remaining samples, sample by sample */
+    for ( ; i < numInSamps; i++)
+    {
+        u[0] = blkIirSsIn(pState, inSamps[i]);
+        for (j = 0; j < pState->numBiquads; j++)
+        {
+            pBq = &pState->bq[j];
+            d0 = u[0] - pBq->a1*pBq->s[0] - pBq->a2*pBq->s[1];
+            u[0] = pBq->b0*d0 + pBq->b1*pBq->s[0] + pBq->b2*pBq->s[1];
+            pBq->s[1] = pBq->s[0];
+            pBq->s[0] = d0;
+        }
+        outSamps[i] = blkIirSsOut(pState, u[0]);
+    }
+}
+
+/* Returns l1 norm of impulse response from rounding point of biquad bqIdx to output, */
+/* -1 if not decayed within IIR_SS_MAX_IMP_LEN. */
+/* Rounding point is input of 1/A(z) of biquad, followed by B(z) if withNum. */
+static Float64 blkIirSsImpL1(
+    BlkIirSsState *pState,  /* block state-space IIR state */
+    Uint16 bqIdx,           /* biquad index */
+    Uint16 withNum          /* non-zero to include numerator of biquad */
+)
+{
+    BlkIirSsBiquad *pBq;
+    Float64 s[IIR_SS_MAX_BIQUADS][2];
+    Float64 u, d0, mag, l1;
+    Uint32 n;
+    Uint16 j;
+
+    for (j = 0; j < pState->numBiquads; j++)
+    {
+        s[j][0] = 0.0;
+        s[j][1] = 0.0;
+    }
+
+    l1 = 0.0;
+    for (n = 0; n < IIR_SS_MAX_IMP_LEN; n++)
+    {
+        u = (n == 0) ? 1.0 : 0.0;
+        mag = 0.0;
+        for (j = bqIdx; j < pState->numBiquads; j++)
+        {
+            pBq = &pState->bq[j];
+            d0 = u - pBq->a1*s[j][0] - pBq->a2*s[j][1];
+            if ((j == bqIdx) && (withNum == 0))
+            {
+                u = d0;
+            }
+            else
+            {
+                u = pBq->b0*d0 + pBq->b1*s[j][0] + pBq->b2*s[j][1];
+            }
+            s[j][1] = s[j][0];
+            s[j][0] = d0;
+            mag += fabs(s[j][0]) + fabs(s[j][1]);
+        }
+        l1 += fabs(u);
+
+        if (mag < IIR_SS_DECAY_THR)
+        {
+            return l1;
+        }
+    }
+
+    return -1.0;
+}
+
+/* Returns bound on |blkIirSs() output - reference output| in S18Q16 LSBs. */
+Float64 blkIirSsErrBound(
+    BlkIirSsState *pState   /* block state-space IIR state */
+)
+{
+    Float64 l1, sumL1;
+    Float64 bound;
+    Uint16 j;
+
+    /* DF2 rounds d(n): seen through whole biquad. */
+    /* DF1 rounds y(n) inside feedback loop: seen through 1/A(z) only. */
+    sumL1 = 0.0;
+    for (j = 0; j < pState->numBiquads; j++)
+    {
+        l1 = blkIirSsImpL1(pState, j, (pState->form == IIR_SS_DF2));
+        if (l1 < 0.0)
+        {
+            return -1.0;
+        }
+        sumL1 += l1;
+    }
+
+    /* Difference before output rounding */
+    bound = 0.5*sumL1 + IIR_SS_FLT_MARGIN*(1.0 + sumL1);
+
+    /* Both outputs rounded by same rule (DF2) or reference output already on grid (DF1) */
+    if (pState->form == IIR_SS_DF2)
+    {
+        return ceil(bound);
+    }
+    return floor(bound + 0.5);
+}
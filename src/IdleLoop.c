@@ -50,6 +50,10 @@
 #include "pick_bits_cic.h"
 #include "BlkFirDecim.h"
 #include "diggain.h"
+#include "decim_pipe.h"
+#include "frame_ring.h"
+#include "idle_frame.h"
+#include "decim_prof.h"
 
 
 #define MAX_LINE_LEN                ( 80 )  /* maximum line length */
@@ -63,18 +67,6 @@ Uint32 inCircBufLeft[IN_CIRCBUF_LEN];
 /* Input circular data buffer right */
 Uint32 inCircBufRight[IN_CIRCBUF_LEN];
 #endif
-#if 0 
-/* CIC output circular buffer */
-Int32 cicOutCircBuf[CIC_OUT_CIRCBUF_LEN];
-#endif
-#if 0
-/* FIR1 output circular buffer */
-Int32 fir1OutCircBuf[FIR1_OUT_CIRCBUF_LEN];
-#endif 
-#if 0
-/* FIR2 output circular buffer */
-Int32 fir2OutCircBuf[FIR2_OUT_CIRCBUF_LEN];
-#endif
 
 /* Digital gain output circular buffer */
 Int16 digGainOutCircBuf[DIGGAIN_OUT_CIRCBUF_LEN];
@@ -87,7 +79,6 @@ CSL_DMA_Handle dmaLeftRxHandle;
 CSL_DMA_Handle dmaRightRxHandle;
 CSL_DMA_Config dmaConfig;
 CSL_DMA_ChannelObj dmaObj0, dmaObj1;
-Uint16 dmaFrameCount = 0;
 
 #pragma DATA_ALIGN(i2sDmaReadBufLeft, 2);
 #pragma DATA_SECTION(i2sDmaReadBufLeft, ".i2sDmaReadBufLeft")
@@ -95,50 +86,23 @@ Uint32 i2sDmaReadBufLeft[I2S_DMA_BUF_LEN];
 #pragma DATA_ALIGN(i2sDmaReadBufRight, 2);
 #pragma DATA_SECTION(i2sDmaReadBufRight, ".i2sDmaReadBufRight")
 Uint32 i2sDmaReadBufRight[I2S_DMA_BUF_LEN];
-Uint16 pingPongFlag = 0;
-
-/* CIC output frame */
-#pragma DATA_SECTION(cicOutFrame, ".cicOutFrame")
-Int32 cicOutFrame[CIC_OUT_FRAME_LEN];
-
-/* CIC state */
-Int32 cicState[2*CIC_NS];
-
-/* FIR1 Coefficients (S16Q15) */
-#pragma DATA_SECTION(fir1Coefs, ".fir1Coefs")
-const Int16 fir1Coefs[FIR1_NUM_COEFS] = 
-{     -98,        0,      609,        0,    -2288,        0,     9968,    16386,     
-     9968,        0,    -2288,        0,      609,        0,      -98
-};
-
-/* Delay line */
-#pragma DATA_SECTION(fir1DlyBuf, ".fir1DlyBuf")
-Int32 fir1DlyBuf[FIR1_NUM_COEFS+2+1]; // +2 for input samples req'd for 2 output samples computed per outer loop, +1 for index of oldest sample
-
-/* FIR1 Output frame */
-#pragma DATA_SECTION(fir1OutFrame, ".fir1OutFrame")
-Int32 fir1OutFrame[FIR1_OUT_FRAME_LEN];
-
-/* FIR2 Coefficients (S16Q15) */
-#pragma DATA_SECTION(fir2Coefs, ".fir2Coefs")
-const Int16 fir2Coefs[FIR2_NUM_COEFS] = 
-{      -4,        2,       10,       -3,      -27,       -2,       51,       15,
-      -89,      -50,      135,      114,     -185,     -222,      226,      386,    
-     -241,     -623,      198,      947,      -56,    -1396,     -266,     2043,
-      959,    -3164,    -2809,     6281,    16481,    16481,     6281,    -2809,    
-    -3164,      959,     2043,     -266,    -1396,      -56,      947,      198,    
-     -623,     -241,      386,      226,     -222,     -185,      114,      135,    
-      -50,      -89,       15,       51,       -2,      -27,       -3,       10,        
-        2,       -4
-};
-
-/* Delay line */
-#pragma DATA_SECTION(fir2DlyBuf, ".fir2DlyBuf")
-Int32 fir2DlyBuf[FIR2_NUM_COEFS+2+1]; // +2 for input samples req'd for 2 output samples computed per outer loop, +1 for index of oldest sample
-
-/* FIR2 Output frame */
-#pragma DATA_SECTION(fir2OutFrame, ".fir2OutFrame")
-Int32 fir2OutFrame[FIR2_OUT_FRAME_LEN];
+
+/* DMA frame descriptors, DmaIsr to UserAlgorithm */
+FrameRing dmaFrameRing;
+
+/* Decimation pipeline: CIC, FIR1, FIR2 & digital gain state */
+#pragma DATA_SECTION(decimPipe, ".decimPipe")
+DecimPipe decimPipe;
+
+#ifdef DECIM_PROF_ENABLE
+/* Decimation pipeline profiling state */
+#pragma DATA_SECTION(decimProf, ".decimProf")
+DecimProf decimProf;
+
+/* Per-stage profile & worst frame, refreshed every NUM_FRAMES_PER_CIRCBUF frames (watch window) */
+DecimProfStats decimProfStats[DECIM_PROF_NUM_STAGES];
+DecimProfWorst decimProfWorst;
+#endif
 
 /* Digital gain output frame */
 #pragma DATA_SECTION(digGainOutFrame, ".digGainOutFrame")
@@ -180,6 +144,7 @@ void main(void)
 {
 
     CSL_Status status;
+    DecimPipeCfg decimPipeCfg;
     
     printf("Start the IdleLoop\n");
     
@@ -200,6 +165,31 @@ void main(void)
     /* Turn off the USB LDO */
     UsbLdoSwitch(0);
 
+    /* Start profiling time base */
+    DECIM_PROF_INIT();
+
+    /* Initialize decimation pipeline */
+    decimPipeCfgDefault(&decimPipeCfg);
+    decimPipeCfg.inFrameLen = IN_FRAME_LEN_PER_CH;
+    decimPipeCfg.cicKernel = pickBitsCic;
+    decimPipeCfg.diggain = DIGGAIN;
+    if (decimPipeInit(&decimPipe, &decimPipeCfg) != DECIM_PIPE_OK)
+    {
+        printf("ERROR: Unable to initialize decimation pipeline\n");
+        exit(1);
+    }
+#ifdef DECIM_PROF_ENABLE
+    decimProfReset(&decimProf);
+    decimPipeSetProf(&decimPipe, &decimProf);
+#endif
+
+    /* Initialize DMA frame ring for ping/pong buffers */
+    if (frameRingInit(&dmaFrameRing, i2sDmaReadBufLeft, i2sDmaReadBufRight, IN_FRAME_LEN_PER_CH, 2) != FRAME_RING_OK)
+    {
+        printf("ERROR: Unable to initialize DMA frame ring\n");
+        exit(1);
+    }
+
     /* Initialize I2S and DMA engine */
     status = I2sDmaInit();
     if (status != CSL_SOK)
@@ -574,25 +564,19 @@ volatile long LoopCount = 0;
 // user defined algorithm
 void UserAlgorithm(void)
 {
-    volatile int i, numFrame, offset;
+    volatile int i, numFrame;
+    FrameDesc frame;
     Uint16 numOutSamps;
+    Uint16 status;
 
-    if (dmaFrameCount >= 2)
+    /* Drain all frames completed since last wakeup, stale frames skipped */
+    while ((status = idleFrameNext(&dmaFrameRing, &decimPipe, 1, digGainOutFrame, &numOutSamps, &frame)) != IDLE_FRAME_NONE)
     {
-        /* Determine which frame to use ping or pong */
-        offset = pingPongFlag*IN_FRAME_LEN_PER_CH;
-
-        /* Perform CIC */
-        pickBitsCic(&i2sDmaReadBufLeft[offset], &i2sDmaReadBufRight[offset], IN_FRAME_LEN_PER_CH, cicState, cicOutFrame, &numOutSamps);
-
-        /* Compute FIR1 output */
-        blkFirDecim2(cicOutFrame, (Int16 *)fir1Coefs, fir1OutFrame, fir1DlyBuf, CIC_OUT_FRAME_LEN, FIR1_NUM_COEFS);
-
-        /* Compute FIR2 output */
-        blkFirDecim2(fir1OutFrame, (Int16 *)fir2Coefs, fir2OutFrame, fir2DlyBuf, FIR1_OUT_FRAME_LEN, FIR2_NUM_COEFS);
-
-        /* Apply digital gain */
-       appDiggain(fir2OutFrame, DIGGAIN, digGainOutFrame, FIR2_OUT_FRAME_LEN);
+        /* Drop output if DMA overwrote frame during processing */
+        if (status == IDLE_FRAME_STALE)
+        {
+            continue;
+        }
 
         /* Get current frame number */
         numFrame = LoopCount%NUM_FRAMES_PER_CIRCBUF;
@@ -608,37 +592,15 @@ void UserAlgorithm(void)
         for (i=0; i<IN_FRAME_LEN_PER_CH; i++)
         {
             /* Write left channel */
-            inCircBufLeft[numFrame*IN_FRAME_LEN_PER_CH+i] = i2sDmaReadBufLeft[offset+i];
+            inCircBufLeft[numFrame*IN_FRAME_LEN_PER_CH+i] = frame.lData[i];
             /* Write right channel */
-            inCircBufRight[numFrame*IN_FRAME_LEN_PER_CH+i] = i2sDmaReadBufRight[offset+i];
+            inCircBufRight[numFrame*IN_FRAME_LEN_PER_CH+i] = frame.rData[i];
         }
 #endif
 
-#if 0 // write CIC output into circular buffers
-        for (i=0; i<CIC_OUT_FRAME_LEN; i++)
-        {
-            cicOutCircBuf[numFrame*CIC_OUT_FRAME_LEN+i] = cicOutFrame[i];
-        }
-#endif        
-
-#if 0 // write FIR1 output into circular buffers
-        for (i=0; i<FIR1_OUT_FRAME_LEN; i++)
-        {
-            fir1OutCircBuf[numFrame*FIR1_OUT_FRAME_LEN+i] = fir1OutFrame[i];
-        }
-#endif        
-
-#if 0 // write FIR2 output into circular buffers
-        /* Copy the current frame from ping or pong frame into input circular buffers */
-        for (i=0; i<FIR2_OUT_FRAME_LEN; i++)
-        {
-            fir2OutCircBuf[numFrame*FIR2_OUT_FRAME_LEN+i] = fir2OutFrame[i];
-        }
-#endif        
-
 #if 0 // debug -- stop DMAs on frame boundary
         /* Stop DMAs to get consistent DMA transfers from digital mic */
-        if ((pingPongFlag == 0) && (LoopCount > 500)) // 500*20e-3 = 10 sec. 
+        if (((frame.seq & 1) == 0) && (LoopCount > 500)) // 500*20e-3 = 10 sec. 
         {
             *((ioport volatile unsigned int *)0x0C05) &= ~0x8000; // disable DMA
             *((ioport volatile unsigned int *)0x0C25) &= ~0x8000; // disable DMA
@@ -646,11 +608,17 @@ void UserAlgorithm(void)
         }
 #endif
 
-        /* Toggle ping/pong flag */
-        pingPongFlag ^= 1;
-        
-        /* Clear DMA frame count */
-        dmaFrameCount = 0;
+#ifdef DECIM_PROF_ENABLE
+        /* Refresh profile */
+        if (numFrame == NUM_FRAMES_PER_CIRCBUF-1)
+        {
+            for (i=0; i<DECIM_PROF_NUM_STAGES; i++)
+            {
+                decimProfGetStats(&decimProf, i, &decimProfStats[i]);
+            }
+            decimProfGetWorst(&decimProf, &decimProfWorst);
+        }
+#endif
 
         LoopCount++;
     }
@@ -673,19 +641,9 @@ interrupt void DmaIsr(void)
     ifrValue = CSL_SYSCTRL_REGS->DMAIFR;
     CSL_SYSCTRL_REGS->DMAIFR = ifrValue;
     
-    // wait for the DMA0 CH0 transfer to complete
-    // if left frame is in
-    if (ifrValue & 0x1)    
-    {
-        dmaFrameCount++;
-    }
-    
-    // wait for the DMA0 CH1 transfer to complete
-    // if the right frame is in
-    if (ifrValue & 0x2)
-    {
-        dmaFrameCount++;
-    }    
+    // DMA0 CH0 (left) & CH1 (right) transfer complete flags,
+    // frame queued once both channels complete it
+    frameRingDmaDone(&dmaFrameRing, ifrValue & (FRAME_RING_CHAN_LEFT | FRAME_RING_CHAN_RIGHT), dmaIntCount);
 
     dmaIntCount++;
 }
@@ -0,0 +1,79 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+
+#include "data_types.h"
+#include "cpu_features.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define CPU_FEAT_DETECT     ( 1 )   /* CPU detection via __builtin_cpu_supports() */
+#else
+#define CPU_FEAT_DETECT     ( 0 )   /* no CPU detection */
+#endif
+
+static Uint16 gCpuFeatures;         /* detected CPU_FEAT_xxx flags */
+static Uint16 gCpuFeaturesValid;    /* non-zero once detected */
+
+/* Returns CPU_FEAT_xxx flags of host CPU, detected at first call. */
+Uint16 cpuFeatures(void)
+{
+    Uint16 features;
+
+    if (gCpuFeaturesValid == 0)
+    {
+        features = 0;
+#if (CPU_FEAT_DETECT == 1)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("sse2"))
+        {
+            features |= CPU_FEAT_SSE2;
+        }
+        if (__builtin_cpu_supports("sse4.1"))
+        {
+            features |= CPU_FEAT_SSE41;
+        }
+        if (__builtin_cpu_supports("avx2"))
+        {
+            features |= CPU_FEAT_AVX2;
+        }
+        if (__builtin_cpu_supports("avx512f"))
+        {
+            features |= CPU_FEAT_AVX512F;
+        }
+#endif
+        /* Detection is idempotent, racing first calls store same value */
+        gCpuFeatures = features;
+        gCpuFeaturesValid = 1;
+    }
+
+    return gCpuFeatures;
+}
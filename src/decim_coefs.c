@@ -0,0 +1,61 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+
+#include "data_types.h"
+#include "decim_coefs.h"
+
+/* Coefficient tables are shared by all decimation pipeline instances */
+
+/* FIR1 coefficients (S16Q15) */
+#ifdef __TMS320C55X__
+#pragma DATA_SECTION(decimFir1Coefs, ".fir1Coefs")
+#endif
+const Int16 decimFir1Coefs[DECIM_FIR1_NUM_COEFS] =
+{     -98,        0,      609,        0,    -2288,        0,     9968,    16386,
+     9968,        0,    -2288,        0,      609,        0,      -98
+};
+
+/* FIR2 coefficients (S16Q15) */
+#ifdef __TMS320C55X__
+#pragma DATA_SECTION(decimFir2Coefs, ".fir2Coefs")
+#endif
+const Int16 decimFir2Coefs[DECIM_FIR2_NUM_COEFS] =
+{      -4,        2,       10,       -3,      -27,       -2,       51,       15,
+      -89,      -50,      135,      114,     -185,     -222,      226,      386,
+     -241,     -623,      198,      947,      -56,    -1396,     -266,     2043,
+      959,    -3164,    -2809,     6281,    16481,    16481,     6281,    -2809,
+    -3164,      959,     2043,     -266,    -1396,      -56,      947,      198,
+     -623,     -241,      386,      226,     -222,     -185,      114,      135,
+      -50,      -89,       15,       51,       -2,      -27,       -3,       10,
+        2,       -4
+};
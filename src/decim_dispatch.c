@@ -0,0 +1,251 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "data_types.h"
+#include "pick_bits_cic.h"
+#include "BlkFirDecim.h"
+#include "BlkFirDecimSimd.h"
+#include "BlkIir.h"
+#include "diggain.h"
+#include "diggain_simd.h"
+#include "cpu_features.h"
+#include "decim_pipe.h"
+#include "decim_dispatch.h"
+
+/* Variants of each slot, highest ISA level first, last entry DECIM_ISA_REF */
+typedef struct { Uint16 isa; CicKernelFxn fxn; const char *name; } CicVariant;
+typedef struct { Uint16 isa; BlkFirDecim2Fxn fxn; const char *name; } FirVariant;
+typedef struct { Uint16 isa; BlkIirFxn fxn; const char *name; } IirVariant;
+typedef struct { Uint16 isa; DiggainFxn fxn; const char *name; } DiggainVariant;
+
+static const CicVariant cicVariants[] =
+{
+    { DECIM_ISA_SCALAR, pickBitsCicTbl, "table" },
+    { DECIM_ISA_REF, pickBitsCic, "bitserial" }
+};
+
+/* No DECIM_ISA_SCALAR entry, blkFirDecim2Host() has circular delay buffer layout */
+static const FirVariant firVariants[] =
+{
+    { DECIM_ISA_AVX512, blkFirDecim2LinAvx512, "avx512" },
+    { DECIM_ISA_AVX2, blkFirDecim2LinAvx2, "avx2" },
+    { DECIM_ISA_SSE41, blkFirDecim2LinSse41, "sse4.1" },
+    { DECIM_ISA_REF, blkFirDecim2Lin, "lin" }
+};
+
+static const IirVariant iirDf1Variants[] =
+{
+    { DECIM_ISA_SCALAR, blkIirDf1Host, "native" },
+    { DECIM_ISA_REF, blkIirDf1, "ref" }
+};
+
+static const IirVariant iirDf2Variants[] =
+{
+    { DECIM_ISA_SCALAR, blkIirDf2Host, "native" },
+    { DECIM_ISA_REF, blkIirDf2, "ref" }
+};
+
+static const DiggainVariant diggainVariants[] =
+{
+    { DECIM_ISA_AVX2, appDiggainAvx2, "avx2" },
+    { DECIM_ISA_SSE2, appDiggainSse2, "sse2" },
+    { DECIM_ISA_SCALAR, appDiggainHost, "native" },
+    { DECIM_ISA_REF, appDiggain, "ref" }
+};
+
+static const char *isaNames[DECIM_NUM_ISA] =
+{
+    "ref", "scalar", "sse2", "sse4.1", "avx2", "avx512"
+};
+
+static DecimKernels gDecimKernels;  /* selected kernels */
+static Uint16 gDecimKernelsValid;   /* non-zero once selected */
+static pthread_once_t gDecimKernelsOnce = PTHREAD_ONCE_INIT;    /* first use selection */
+
+/* Returns highest ISA level supported by host CPU */
+static Uint16 decimCpuIsa(void)
+{
+    Uint16 features;
+
+    features = cpuFeatures();
+    if (features & CPU_FEAT_AVX512F)
+    {
+        return DECIM_ISA_AVX512;
+    }
+    else if (features & CPU_FEAT_AVX2)
+    {
+        return DECIM_ISA_AVX2;
+    }
+    else if (features & CPU_FEAT_SSE41)
+    {
+        return DECIM_ISA_SSE41;
+    }
+    else if (features & CPU_FEAT_SSE2)
+    {
+        return DECIM_ISA_SSE2;
+    }
+    return DECIM_ISA_SCALAR;
+}
+
+/* Selects kernels for ISA level, capped by host CPU. */
+Uint16 decimDispatchSetIsa(
+    Uint16 isa              /* ISA level, DECIM_ISA_xxx */
+)
+{
+    DecimKernels *pK;
+    Uint16 cpuIsa;
+    Uint16 i;
+
+    cpuIsa = decimCpuIsa();
+    if (isa > cpuIsa)
+    {
+        isa = cpuIsa;
+    }
+
+    pK = &gDecimKernels;
+
+    /* Table is needed by pickBitsCicTbl(), built on first call only */
+    pickBitsCicTblInit();
+
+    /* Pick first variant not above ISA level, REF entry always matches */
+    for (i = 0; cicVariants[i].isa > isa; i++);
+    pK->cic = cicVariants[i].fxn;
+    pK->name[DECIM_KERNEL_CIC] = cicVariants[i].name;
+
+    for (i = 0; firVariants[i].isa > isa; i++);
+    pK->fir = firVariants[i].fxn;
+    pK->name[DECIM_KERNEL_FIR] = firVariants[i].name;
+
+    for (i = 0; iirDf1Variants[i].isa > isa; i++);
+    pK->iirDf1 = iirDf1Variants[i].fxn;
+    pK->name[DECIM_KERNEL_IIR_DF1] = iirDf1Variants[i].name;
+
+    for (i = 0; iirDf2Variants[i].isa > isa; i++);
+    pK->iirDf2 = iirDf2Variants[i].fxn;
+    pK->name[DECIM_KERNEL_IIR_DF2] = iirDf2Variants[i].name;
+
+    for (i = 0; diggainVariants[i].isa > isa; i++);
+    pK->diggain = diggainVariants[i].fxn;
+    pK->name[DECIM_KERNEL_DIGGAIN] = diggainVariants[i].name;
+
+    pK->isa = isa;
+    gDecimKernelsValid = 1;
+
+    return isa;
+}
+
+/* Selects kernels for host CPU, capped by DECIM_ISA_ENV if set. */
+Uint16 decimDispatchInit(void)
+{
+    const char *env;
+    Uint16 isa;
+    Uint16 i;
+
+    isa = DECIM_ISA_AVX512;
+
+    env = getenv(DECIM_ISA_ENV);
+    if (env != NULL)
+    {
+        /* Unknown names are ignored */
+        for (i = 0; i < DECIM_NUM_ISA; i++)
+        {
+            if (strcmp(env, isaNames[i]) == 0)
+            {
+                isa = i;
+                break;
+            }
+        }
+    }
+
+    return decimDispatchSetIsa(isa);
+}
+
+/* Selects kernels on first use unless already selected */
+static void decimDispatchOnce(void)
+{
+    if (gDecimKernelsValid == 0)
+    {
+        decimDispatchInit();
+    }
+}
+
+/* Returns selected kernels, calls decimDispatchInit() on first use. */
+const DecimKernels *decimKernels(void)
+{
+    pthread_once(&gDecimKernelsOnce, decimDispatchOnce);
+
+    return &gDecimKernels;
+}
+
+/* Sets CIC, FIR & constant gain kernels of pipeline configuration to selected kernels. */
+void decimDispatchPipeCfg(
+    DecimPipeCfg *pCfg      /* pipeline configuration */
+)
+{
+    const DecimKernels *pK;
+
+    pK = decimKernels();
+    pCfg->cicKernel = pK->cic;
+    pCfg->firKernel = pK->fir;
+    pCfg->gainKernel = pK->diggain;
+}
+
+/* Returns name of selected variant for kernel slot. */
+const char *decimKernelName(
+    Uint16 kernelId         /* kernel slot, DECIM_KERNEL_xxx */
+)
+{
+    if (kernelId >= DECIM_NUM_KERNELS)
+    {
+        return NULL;
+    }
+
+    return decimKernels()->name[kernelId];
+}
+
+/* Returns name of ISA level. */
+const char *decimIsaName(
+    Uint16 isa              /* ISA level, DECIM_ISA_xxx */
+)
+{
+    if (isa >= DECIM_NUM_ISA)
+    {
+        return NULL;
+    }
+
+    return isaNames[isa];
+}
@@ -0,0 +1,275 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+
+#include <stddef.h>
+#include "data_types.h"
+#include "pick_bits_cic.h"
+#include "pick_bits_cic_cfg.h"
+#include "BlkFirDecim.h"
+#include "BlkFirCascade.h"
+#include "diggain.h"
+#include "decim_coefs.h"
+#include "decim_pipe.h"
+#include "decim_prof.h"
+
+#define PDM_BITS_PER_WORD   ( 64 )  /* PDM bits per channel in one "left" & "right" 32-bit word pair */
+
+/* Records R & N of supplied CIC kernel, per-byte CIC table not built. */
+/* Returns DECIM_PIPE_OK or DECIM_PIPE_ERR_CIC if R or N unsupported. */
+static Int16 decimPipeCicBind(
+    CicCfg *pCic,           /* CIC configuration */
+    Uint16 decimFact,       /* decimation factor R, kernel must implement it */
+    Uint16 numStages,       /* number of stages N, kernel must implement it */
+    CicKernelFxn kernel     /* CIC kernel */
+)
+{
+    Uint16 dfLog2;
+
+    for (dfLog2 = 3; (dfLog2 <= 6) && (((Uint16)1<<dfLog2) != decimFact); dfLog2++);
+    if ((dfLog2 > 6) || (numStages < 1) || (numStages > CIC_MAX_NS) ||
+        (dfLog2*numStages > CIC_CFG_MAX_GAIN_LOG2))
+    {
+        return DECIM_PIPE_ERR_CIC;
+    }
+
+    pCic->decimFact = decimFact;
+    pCic->numStages = numStages;
+    pCic->gainLog2 = dfLog2*numStages;
+    pCic->kernel = kernel;
+
+    return DECIM_PIPE_OK;
+}
+
+/* Fills configuration of IdleLoop chain. */
+void decimPipeCfgDefault(
+    DecimPipeCfg *pCfg      /* pipeline configuration */
+)
+{
+    Uint16 i;
+
+    pCfg->pdmRate = 1024000;
+    pCfg->inFrameLen = 320;             /* 20 ms */
+    pCfg->cicDecimFact = CIC_DF;
+    pCfg->cicNumStages = CIC_NS;
+    pCfg->cicKernel = NULL;
+    pCfg->numFirStages = 2;
+    for (i = 0; i < BLK_FIR_CASC_MAX_STAGES; i++)
+    {
+        pCfg->firCoefs[i] = NULL;
+        pCfg->firNumCoefs[i] = 0;
+    }
+    pCfg->firCoefs[0] = decimFir1Coefs;
+    pCfg->firNumCoefs[0] = DECIM_FIR1_NUM_COEFS;
+    pCfg->firCoefs[1] = decimFir2Coefs;
+    pCfg->firNumCoefs[1] = DECIM_FIR2_NUM_COEFS;
+    pCfg->firKernel = NULL;
+    pCfg->diggain = (Uint16)10<<8;     /* 10.0 (20 dB) in U16Q8 */
+    pCfg->rampMode = DIGGAIN_RAMP_LIN;
+    pCfg->rampLen = 320;                /* 20 ms at 16 kHz */
+    pCfg->expCoef = 0;
+    pCfg->gainKernel = NULL;
+}
+
+/* Initializes pipeline instance from configuration, clears all state. */
+Int16 decimPipeInit(
+    DecimPipe *pPipe,       /* pipeline instance */
+    const DecimPipeCfg *pCfg    /* pipeline configuration */
+)
+{
+    Uint16 numStages;
+    Uint32 cicOutLen;
+    Uint16 i, j;
+
+    if (pCfg->cicKernel != NULL)
+    {
+        if (decimPipeCicBind(&pPipe->cic, pCfg->cicDecimFact, pCfg->cicNumStages, pCfg->cicKernel) != DECIM_PIPE_OK)
+        {
+            return DECIM_PIPE_ERR_CIC;
+        }
+    }
+    else
+    {
+#ifdef __TMS320C55X__
+        /* Unrolled kernels & per-byte CIC table not linked on target */
+        return DECIM_PIPE_ERR_CIC;
+#else
+        if (cicCfgInit(&pPipe->cic, pCfg->cicDecimFact, pCfg->cicNumStages) != CIC_CFG_OK)
+        {
+            return DECIM_PIPE_ERR_CIC;
+        }
+#endif
+    }
+
+    numStages = pCfg->numFirStages;
+    if (blkFirCascadeInit(&pPipe->fir, numStages, DECIM_PIPE_CIC_BUF_LEN) != BLK_FIR_CASC_OK)
+    {
+        return DECIM_PIPE_ERR_FIR;
+    }
+
+    /* Every CIC chunk & frame must give even number of outputs at every FIR stage */
+    cicOutLen = (Uint32)pCfg->inFrameLen * PDM_BITS_PER_WORD / pCfg->cicDecimFact;
+    if ((cicOutLen == 0) || (cicOutLen % (4<<(numStages-1)) != 0) ||
+        ((cicOutLen >> numStages) > DECIM_PIPE_MAX_OUT_LEN))
+    {
+        return DECIM_PIPE_ERR_LEN;
+    }
+
+    for (i = 0; i < numStages; i++)
+    {
+        if ((pCfg->firCoefs[i] == NULL) || (pCfg->firNumCoefs[i] < 2) ||
+            (pCfg->firNumCoefs[i] > DECIM_PIPE_MAX_COEFS))
+        {
+            return DECIM_PIPE_ERR_FIR;
+        }
+
+        /* Coefficient table shared, kernels do not write coefficients */
+        blkFirCascadeSetStage(&pPipe->fir, i, (Int16 *)pCfg->firCoefs[i], pCfg->firNumCoefs[i],
+            pPipe->firDlyBuf[i], pCfg->firKernel);
+
+        /* Zero state valid for circular & linear delay buffer layouts */
+        for (j = 0; j < DECIM_PIPE_FIR_DLY_LEN; j++)
+        {
+            pPipe->firDlyBuf[i][j] = 0;
+        }
+    }
+
+    for (i = 0; i < 2*CIC_MAX_NS; i++)
+    {
+        pPipe->cicState[i] = 0;
+    }
+
+    diggainInit(&pPipe->gain, pCfg->diggain, pCfg->rampMode, pCfg->rampLen, pCfg->expCoef, pCfg->gainKernel);
+    blkFirCascadeSetGain(&pPipe->fir, pCfg->diggain, pPipe->gain.constKernel);
+
+    pPipe->inFrameLen = pCfg->inFrameLen;
+    pPipe->chunkLen = DECIM_PIPE_CIC_BUF_LEN * pCfg->cicDecimFact / PDM_BITS_PER_WORD;
+    pPipe->outFrameLen = (Uint16)(cicOutLen >> numStages);
+    pPipe->outRate = pCfg->pdmRate / ((Uint32)pCfg->cicDecimFact << numStages);
+    pPipe->pProf = NULL;
+
+    return DECIM_PIPE_OK;
+}
+
+/* Sets target digital gain, gain ramps as configured. */
+void decimPipeSetGain(
+    DecimPipe *pPipe,       /* pipeline instance */
+    Uint16 diggain          /* digital gain (U16Q8) */
+)
+{
+    diggainSetGain(&pPipe->gain, diggain);
+}
+
+/* Attaches profiling state, NULL detaches. */
+void decimPipeSetProf(
+    DecimPipe *pPipe,       /* pipeline instance */
+    DecimProf *pProf        /* profiling state, may be NULL */
+)
+{
+    pPipe->pProf = pProf;
+    pPipe->fir.pProf = pProf;
+}
+
+/* Processes one frame: CIC, FIR cascade & digital gain. */
+void decimPipeProcess(
+    DecimPipe *pPipe,       /* pipeline instance */
+    Uint32 *lData,          /* "left" channel 32-bit packed input data */
+    Uint32 *rData,          /* "right" channel 32-bit packed input data */
+    Int16 *outSamps,        /* output samples (S16Q15) */
+    Uint16 *pNumOutSamps    /* number of output samples */
+)
+{
+    DiggainState *pGain;
+    Uint16 constGain;
+    Uint16 numStages;
+    Uint16 inWordIdx;
+    Uint16 numInWords;
+    Uint16 numCicSamps;
+    Uint16 outSampIdx;
+    DECIM_PROF_DECL(tFrame)
+    DECIM_PROF_DECL(t)
+
+    DECIM_PROF_START(tFrame);
+
+    pGain = &pPipe->gain;
+    numStages = pPipe->fir.numStages;
+
+    /* Constant gain fused into FIR cascade output epilogue */
+    constGain = (pGain->agcEnable == 0) && (pGain->curGain == pGain->tgtGain);
+    if (constGain)
+    {
+        pPipe->fir.diggain = (Uint16)((pGain->curGain + ((Uint32)1<<15)) >> 16);
+    }
+
+    inWordIdx = 0;
+    outSampIdx = 0;
+    while (inWordIdx < pPipe->inFrameLen)
+    {
+        /* Last chunk may be short */
+        numInWords = pPipe->inFrameLen - inWordIdx;
+        if (numInWords > pPipe->chunkLen)
+        {
+            numInWords = pPipe->chunkLen;
+        }
+
+        /* Perform CIC */
+        DECIM_PROF_START(t);
+        pPipe->cic.kernel(&lData[inWordIdx], &rData[inWordIdx], numInWords, pPipe->cicState, pPipe->cicBuf, &numCicSamps);
+        DECIM_PROF_STOP(pPipe->pProf, DECIM_PROF_STAGE_CIC, t);
+
+        /* Compute FIR outputs */
+        if (constGain)
+        {
+            blkFirCascadeProcessGain(&pPipe->fir, pPipe->cicBuf, &outSamps[outSampIdx], numCicSamps);
+        }
+        else
+        {
+            blkFirCascadeProcess(&pPipe->fir, pPipe->cicBuf, &pPipe->firOutBuf[outSampIdx], numCicSamps);
+        }
+
+        inWordIdx += numInWords;
+        outSampIdx += numCicSamps >> numStages;
+    }
+
+    /* Apply ramped digital gain */
+    if (!constGain)
+    {
+        DECIM_PROF_START(t);
+        diggainProcess(pGain, pPipe->firOutBuf, outSamps, outSampIdx);
+        DECIM_PROF_STOP(pPipe->pProf, DECIM_PROF_STAGE_GAIN, t);
+    }
+
+    *pNumOutSamps = outSampIdx;
+
+    DECIM_PROF_STOP(pPipe->pProf, DECIM_PROF_STAGE_FRAME, tFrame);
+    DECIM_PROF_FRAME_END(pPipe->pProf);
+}
@@ -0,0 +1,405 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+#include <sched.h>
+#include <pthread.h>
+#include "data_types.h"
+#include "host_clock.h"
+#include "decim_pipe.h"
+#include "decim_pipe_mt.h"
+
+#define ATOMIC_LOAD(p)          __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define ATOMIC_STORE(p, v)      __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define ATOMIC_ADD(p, v)        __atomic_add_fetch((p), (v), __ATOMIC_ACQ_REL)
+
+#define ATOMIC_XCHG(p, v)       __atomic_exchange_n((p), (v), __ATOMIC_ACQ_REL)
+
+#define PDM_BITS_PER_WORD       ( 64 )      /* PDM bits per channel in one "left" & "right" 32-bit word pair */
+#define DECIM_PIPE_MT_SPIN      ( 64 )      /* number of yielding polls before sleeping */
+#define DECIM_PIPE_MT_SLEEP_NS  ( 20000 )   /* poll sleep (ns) */
+#define DECIM_PIPE_MT_GAIN_PEND ( 0x10000 ) /* pending gain flag */
+
+/* Backs off while polling ring: yields first, then sleeps */
+static void decimPipeMtBackoff(
+    Uint16 *pSpin           /* number of polls so far */
+)
+{
+    if (*pSpin < DECIM_PIPE_MT_SPIN)
+    {
+        (*pSpin)++;
+        sched_yield();
+    }
+    else
+    {
+        hostClockSleepNs(DECIM_PIPE_MT_SLEEP_NS);
+    }
+}
+
+/* Returns producer slot of ring, or NULL if ring full. Producer only. */
+static DecimPipeMtFrame *decimPipeMtRingSlot(
+    DecimPipeMtRing *pRing  /* ring */
+)
+{
+    Uint32 head;
+
+    head = pRing->head;
+    if (head - ATOMIC_LOAD(&pRing->tail) >= DECIM_PIPE_MT_RING_LEN)
+    {
+        return NULL;
+    }
+    return &pRing->frame[head & (DECIM_PIPE_MT_RING_LEN-1)];
+}
+
+/* Publishes producer slot to consumer. Producer only. */
+static void decimPipeMtRingPublish(
+    DecimPipeMtRing *pRing  /* ring */
+)
+{
+    ATOMIC_STORE(&pRing->head, pRing->head + 1);
+}
+
+/* Returns oldest published frame of ring, or NULL if ring empty. Consumer only. */
+static DecimPipeMtFrame *decimPipeMtRingPeek(
+    DecimPipeMtRing *pRing  /* ring */
+)
+{
+    Uint32 tail;
+
+    tail = pRing->tail;
+    if (ATOMIC_LOAD(&pRing->head) == tail)
+    {
+        return NULL;
+    }
+    return &pRing->frame[tail & (DECIM_PIPE_MT_RING_LEN-1)];
+}
+
+/* Returns oldest frame slot to producer. Consumer only. */
+static void decimPipeMtRingRelease(
+    DecimPipeMtRing *pRing  /* ring */
+)
+{
+    ATOMIC_STORE(&pRing->tail, pRing->tail + 1);
+}
+
+/* Runs one stage on one frame */
+static void decimPipeMtStageRun(
+    DecimPipeMt *pMt,       /* pipeline-parallel instance */
+    Uint16 stageId,         /* DECIM_PIPE_MT_STAGE_xxx */
+    DecimPipeMtFrame *pIn,  /* input frame, slot of stage input ring */
+    DecimPipeMtFrame *pOut  /* output frame, slot of next stage input ring, NULL for last stage */
+)
+{
+    DecimPipe *pPipe;
+    Uint16 inSlot;
+    Uint16 outSlot;
+    Uint16 numOutSamps;
+    Uint32 pendGain;
+
+    pPipe = pMt->pPipe;
+    inSlot = (Uint16)(pIn - pMt->ring[stageId].frame);
+
+    switch (stageId)
+    {
+    case DECIM_PIPE_MT_STAGE_CIC:
+        /* CIC buffer belongs to output slot of FIR ring */
+        outSlot = (Uint16)(pOut - pMt->ring[DECIM_PIPE_MT_STAGE_FIR].frame);
+        *pOut = *pIn;
+        pPipe->cic.kernel(pIn->lData, pIn->rData, pPipe->inFrameLen, pPipe->cicState,
+            pMt->cicBuf[outSlot], &pOut->numSamps);
+        break;
+
+    case DECIM_PIPE_MT_STAGE_FIR:
+        /* FIR buffer belongs to output slot of gain ring */
+        outSlot = (Uint16)(pOut - pMt->ring[DECIM_PIPE_MT_STAGE_GAIN].frame);
+        *pOut = *pIn;
+        pOut->numSamps = pIn->numSamps >> pPipe->fir.numStages;
+        blkFirCascadeProcess(&pPipe->fir, pMt->cicBuf[inSlot], pMt->firBuf[outSlot], pIn->numSamps);
+        break;
+
+    default:
+        /* Gain state owned by gain stage thread, take pending gain change */
+        pendGain = ATOMIC_XCHG(&pMt->pendGain, 0);
+        if (pendGain & DECIM_PIPE_MT_GAIN_PEND)
+        {
+            diggainSetGain(&pPipe->gain, (Uint16)pendGain);
+        }
+
+        /* Constant gain uses constant gain kernel, bit-exact with fused FIR epilogue */
+        numOutSamps = pIn->numSamps;
+        diggainProcess(&pPipe->gain, pMt->firBuf[inSlot], pIn->outSamps, numOutSamps);
+        if (pMt->done != NULL)
+        {
+            pMt->done(pMt->pArg, pIn->seq, pIn->outSamps, numOutSamps);
+        }
+        break;
+    }
+}
+
+/* Stage thread: waits for input frame & free output slot, runs stage */
+static void *decimPipeMtStage(
+    void *pArg              /* DecimPipeMtStage */
+)
+{
+    DecimPipeMt *pMt;
+    DecimPipeMtStage *pStage;
+    DecimPipeMtRing *pInRing;
+    DecimPipeMtRing *pOutRing;
+    DecimPipeMtFrame *pIn;
+    DecimPipeMtFrame *pOut;
+    Uint16 stageId;
+    Uint16 spin;
+    Uint64 t0, t1;
+    Uint64 latNs;
+
+    pStage = (DecimPipeMtStage *)pArg;
+    pMt = pStage->pMt;
+    stageId = pStage->stageId;
+    pInRing = &pMt->ring[stageId];
+    pOutRing = (stageId < DECIM_PIPE_MT_NUM_STAGES-1) ? &pMt->ring[stageId+1] : NULL;
+
+    for (;;)
+    {
+        /* Wait for input frame */
+        t0 = hostClockNowNs();
+        spin = 0;
+        while ((pIn = decimPipeMtRingPeek(pInRing)) == NULL)
+        {
+            if (ATOMIC_LOAD(&pMt->stop))
+            {
+                return NULL;
+            }
+            decimPipeMtBackoff(&spin);
+        }
+
+        /* Wait for free output slot, backpressure from next stage */
+        t1 = hostClockNowNs();
+        ATOMIC_ADD(&pStage->starveNs, t1 - t0);
+        pOut = NULL;
+        if (pOutRing != NULL)
+        {
+            spin = 0;
+            while ((pOut = decimPipeMtRingSlot(pOutRing)) == NULL)
+            {
+                if (ATOMIC_LOAD(&pMt->stop))
+                {
+                    return NULL;
+                }
+                decimPipeMtBackoff(&spin);
+            }
+        }
+
+        t0 = hostClockNowNs();
+        ATOMIC_ADD(&pStage->blockNs, t0 - t1);
+        decimPipeMtStageRun(pMt, stageId, pIn, pOut);
+        t1 = hostClockNowNs();
+        ATOMIC_ADD(&pStage->busyNs, t1 - t0);
+        ATOMIC_ADD(&pStage->numFrames, 1);
+
+        if (pOutRing != NULL)
+        {
+            decimPipeMtRingPublish(pOutRing);
+        }
+        else
+        {
+            latNs = t1 - pIn->submitNs;
+            ATOMIC_ADD(&pMt->latSumNs, latNs);
+            if (latNs > pMt->latMaxNs)
+            {
+                ATOMIC_STORE(&pMt->latMaxNs, latNs);
+            }
+            ATOMIC_ADD(&pMt->numDone, 1);
+        }
+        decimPipeMtRingRelease(pInRing);
+    }
+}
+
+/* Starts stage threads running initialized pipeline instance pPipe. */
+Int16 decimPipeMtInit(
+    DecimPipeMt *pMt,       /* pipeline-parallel instance */
+    DecimPipe *pPipe,       /* pipeline instance */
+    DecimPipeMtDoneFxn done,    /* frame completion callback, may be NULL */
+    void *pArg              /* callback argument */
+)
+{
+    Uint32 cicOutLen;
+    Uint16 i;
+
+    cicOutLen = (Uint32)pPipe->inFrameLen * PDM_BITS_PER_WORD / pPipe->cic.decimFact;
+    if (cicOutLen > DECIM_PIPE_MT_MAX_CIC_LEN)
+    {
+        return DECIM_PIPE_MT_ERR_LEN;
+    }
+
+    /* Stage threads would add to one profile frame concurrently */
+    decimPipeSetProf(pPipe, NULL);
+
+    pMt->pPipe = pPipe;
+    pMt->done = done;
+    pMt->pArg = pArg;
+    for (i = 0; i < DECIM_PIPE_MT_NUM_STAGES; i++)
+    {
+        pMt->ring[i].head = 0;
+        pMt->ring[i].tail = 0;
+        pMt->stage[i].pMt = pMt;
+        pMt->stage[i].stageId = i;
+        pMt->stage[i].numFrames = 0;
+        pMt->stage[i].busyNs = 0;
+        pMt->stage[i].starveNs = 0;
+        pMt->stage[i].blockNs = 0;
+    }
+    pMt->numThreads = 0;
+    pMt->stop = 0;
+    pMt->pendGain = 0;
+    pMt->numSubmitted = 0;
+    pMt->numDone = 0;
+    pMt->latSumNs = 0;
+    pMt->latMaxNs = 0;
+    pMt->startNs = hostClockNowNs();
+
+    for (i = 0; i < DECIM_PIPE_MT_NUM_STAGES; i++)
+    {
+        if (pthread_create(&pMt->thread[i], NULL, decimPipeMtStage, &pMt->stage[i]) != 0)
+        {
+            decimPipeMtStop(pMt);
+            return DECIM_PIPE_MT_ERR_THREAD;
+        }
+        pMt->numThreads++;
+    }
+
+    return DECIM_PIPE_MT_OK;
+}
+
+/* Submits frame, returns immediately. Single submitting thread only. */
+Int16 decimPipeMtSubmit(
+    DecimPipeMt *pMt,       /* pipeline-parallel instance */
+    Uint32 *lData,          /* "left" channel 32-bit packed input data */
+    Uint32 *rData,          /* "right" channel 32-bit packed input data */
+    Int16 *outSamps         /* output samples (S16Q15) */
+)
+{
+    DecimPipeMtFrame *pFrame;
+
+    pFrame = decimPipeMtRingSlot(&pMt->ring[DECIM_PIPE_MT_STAGE_CIC]);
+    if (pFrame == NULL)
+    {
+        return DECIM_PIPE_MT_ERR_FULL;
+    }
+
+    pFrame->lData = lData;
+    pFrame->rData = rData;
+    pFrame->outSamps = outSamps;
+    pFrame->numSamps = 0;
+    pFrame->seq = pMt->numSubmitted;
+    pFrame->submitNs = hostClockNowNs();
+    ATOMIC_ADD(&pMt->numSubmitted, 1);
+    decimPipeMtRingPublish(&pMt->ring[DECIM_PIPE_MT_STAGE_CIC]);
+
+    return DECIM_PIPE_MT_OK;
+}
+
+/* Sets target digital gain, applied by gain stage from next frame. */
+void decimPipeMtSetGain(
+    DecimPipeMt *pMt,       /* pipeline-parallel instance */
+    Uint16 diggain          /* digital gain (U16Q8) */
+)
+{
+    ATOMIC_STORE(&pMt->pendGain, DECIM_PIPE_MT_GAIN_PEND | diggain);
+}
+
+/* Waits until all submitted frames are completed. */
+void decimPipeMtDrain(
+    DecimPipeMt *pMt        /* pipeline-parallel instance */
+)
+{
+    Uint16 spin;
+
+    spin = 0;
+    while (ATOMIC_LOAD(&pMt->numDone) != ATOMIC_LOAD(&pMt->numSubmitted))
+    {
+        decimPipeMtBackoff(&spin);
+    }
+}
+
+/* Reads statistics. */
+void decimPipeMtGetStats(
+    DecimPipeMt *pMt,       /* pipeline-parallel instance */
+    DecimPipeMtStats *pStats    /* statistics */
+)
+{
+    DecimPipeMtRing *pRing;
+    Float64 elapsedNs;
+    Uint32 numDone;
+    Uint16 i;
+
+    elapsedNs = (Float64)(hostClockNowNs() - pMt->startNs);
+    if (elapsedNs <= 0.0)
+    {
+        elapsedNs = 1.0;
+    }
+
+    numDone = ATOMIC_LOAD(&pMt->numDone);
+    pStats->numSubmitted = ATOMIC_LOAD(&pMt->numSubmitted);
+    pStats->numDone = numDone;
+    for (i = 0; i < DECIM_PIPE_MT_NUM_STAGES; i++)
+    {
+        pRing = &pMt->ring[i];
+        pStats->numFrames[i] = ATOMIC_LOAD(&pMt->stage[i].numFrames);
+        pStats->busy[i] = (Float64)ATOMIC_LOAD(&pMt->stage[i].busyNs) / elapsedNs;
+        pStats->starve[i] = (Float64)ATOMIC_LOAD(&pMt->stage[i].starveNs) / elapsedNs;
+        pStats->block[i] = (Float64)ATOMIC_LOAD(&pMt->stage[i].blockNs) / elapsedNs;
+        pStats->ringDepth[i] = (Uint16)(ATOMIC_LOAD(&pRing->head) - ATOMIC_LOAD(&pRing->tail));
+    }
+    pStats->latMeanUs = (numDone > 0) ? (Float64)ATOMIC_LOAD(&pMt->latSumNs) / numDone / 1000.0 : 0.0;
+    pStats->latMaxUs = (Float64)ATOMIC_LOAD(&pMt->latMaxNs) / 1000.0;
+    pStats->elapsedSec = elapsedNs / 1e9;
+}
+
+/* Drains & stops stage threads. */
+void decimPipeMtStop(
+    DecimPipeMt *pMt        /* pipeline-parallel instance */
+)
+{
+    Uint16 i;
+
+    /* Threads may be partially started on init failure, nothing submitted then */
+    if (pMt->numThreads == DECIM_PIPE_MT_NUM_STAGES)
+    {
+        decimPipeMtDrain(pMt);
+    }
+
+    ATOMIC_STORE(&pMt->stop, 1);
+    for (i = 0; i < pMt->numThreads; i++)
+    {
+        pthread_join(pMt->thread[i], NULL);
+    }
+    pMt->numThreads = 0;
+}
@@ -0,0 +1,307 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+/* Needed for clock_gettime() time base with -std=c99 */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stddef.h>
+#include "data_types.h"
+#include "decim_prof.h"
+
+#if defined(__TMS320C55X__)
+#include "soc.h"
+#include "cslr.h"
+#include "cslr_sysctrl.h"
+#include "csl_gpt.h"
+#define DECIM_PROF_CYCLES_PER_TICK  ( 2 )   /* GPT prescaler divides CPU clock by 2 */
+#elif (defined(__GNUC__)||defined(__clang__)) && defined(__x86_64__)
+#include <x86intrin.h>
+#else
+#include <time.h>
+#endif
+
+#ifdef __TMS320C55X__
+static CSL_GptObj decimProfGptObj;
+static CSL_Handle decimProfGpt;
+#endif
+
+/* Returns histogram bin of time: exact below 8, 8 log-linear bins per octave above */
+static Uint16 decimProfBin(
+    Uint32 t                /* time */
+)
+{
+    Uint16 oct;
+
+    if (t < DECIM_PROF_HIST_SUB_BINS)
+    {
+        return (Uint16)t;
+    }
+
+    oct = 3;
+    while ((t >> oct) > 1)
+    {
+        oct++;
+    }
+    if (oct - 2 > DECIM_PROF_HIST_OCTAVES)
+    {
+        return DECIM_PROF_HIST_LEN - 1;
+    }
+
+    return (Uint16)((oct - 2)*DECIM_PROF_HIST_SUB_BINS + ((t >> (oct - 3)) & (DECIM_PROF_HIST_SUB_BINS-1)));
+}
+
+/* Returns largest time of histogram bin */
+static Uint32 decimProfBinMax(
+    Uint16 bin              /* histogram bin */
+)
+{
+    Uint16 oct;
+    Uint16 sub;
+
+    if (bin < DECIM_PROF_HIST_SUB_BINS)
+    {
+        return bin;
+    }
+
+    oct = bin/DECIM_PROF_HIST_SUB_BINS + 2;
+    sub = bin%DECIM_PROF_HIST_SUB_BINS;
+
+    return ((Uint32)(DECIM_PROF_HIST_SUB_BINS + sub + 1) << (oct - 3)) - 1;
+}
+
+/* Starts time base, shared by all instances. */
+void decimProfInit(void)
+{
+#ifdef __TMS320C55X__
+    CSL_Config gptCfg;
+    CSL_Status status;
+
+    /* Timer 0 clock gated by ClockGatingAll() */
+    CSL_FINST(CSL_SYSCTRL_REGS->PCGCR1, SYS_PCGCR1_TMR0CG, ACTIVE);
+
+    /* Free running, auto reload, counts down from 2^32-1 at CPU clock/2 */
+    decimProfGpt = GPT_open(GPT_0, &decimProfGptObj, &status);
+    GPT_reset(decimProfGpt);
+    gptCfg.autoLoad = GPT_AUTO_ENABLE;
+    gptCfg.ctrlTim = GPT_TIMER_ENABLE;
+    gptCfg.preScaleDiv = GPT_PRE_SC_DIV_0;
+    gptCfg.prdLow = 0xFFFF;
+    gptCfg.prdHigh = 0xFFFF;
+    GPT_config(decimProfGpt, &gptCfg);
+    GPT_start(decimProfGpt);
+#endif
+}
+
+/* Clears statistics. */
+void decimProfReset(
+    DecimProf *pProf        /* profiling state */
+)
+{
+    Uint16 i, j;
+
+    pProf->frame = 0;
+    for (i = 0; i < DECIM_PROF_NUM_STAGES; i++)
+    {
+        pProf->cur[i] = 0;
+        pProf->used[i] = 0;
+        pProf->numFrames[i] = 0;
+        pProf->minTime[i] = 0xFFFFFFFF;
+        pProf->maxTime[i] = 0;
+        pProf->maxFrame[i] = 0;
+        pProf->sumTime[i] = 0;
+        for (j = 0; j < DECIM_PROF_HIST_LEN; j++)
+        {
+            pProf->hist[i][j] = 0;
+        }
+        pProf->worst.time[i] = 0;
+    }
+    pProf->worst.frame = 0;
+}
+
+/* Returns current time, up counting, wraps at 2^32. */
+Uint32 decimProfNow(void)
+{
+#if defined(__TMS320C55X__)
+    Uint32 count;
+
+    GPT_readCount(decimProfGpt, &count);
+    return ~count;
+#elif (defined(__GNUC__)||defined(__clang__)) && defined(__x86_64__)
+    return (Uint32)__rdtsc();
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (Uint32)((Uint64)ts.tv_sec*1000000000 + (Uint64)ts.tv_nsec);
+#endif
+}
+
+/* Adds time to stage in current frame. */
+void decimProfAdd(
+    DecimProf *pProf,       /* profiling state, may be NULL */
+    Uint16 stage,           /* DECIM_PROF_STAGE_xxx */
+    Uint32 ticks            /* elapsed time base ticks */
+)
+{
+    if (pProf == NULL)
+    {
+        return;
+    }
+
+#ifdef __TMS320C55X__
+    ticks *= DECIM_PROF_CYCLES_PER_TICK;
+#endif
+    pProf->cur[stage] += ticks;
+    pProf->used[stage] = 1;
+}
+
+/* Records current frame stage times & starts next frame. */
+void decimProfFrameEnd(
+    DecimProf *pProf        /* profiling state, may be NULL */
+)
+{
+    Uint32 t;
+    Uint16 i;
+
+    if (pProf == NULL)
+    {
+        return;
+    }
+
+    for (i = 0; i < DECIM_PROF_NUM_STAGES; i++)
+    {
+        if (!pProf->used[i])
+        {
+            continue;
+        }
+
+        t = pProf->cur[i];
+        pProf->numFrames[i]++;
+        pProf->sumTime[i] += t;
+        pProf->hist[i][decimProfBin(t)]++;
+        if (t < pProf->minTime[i])
+        {
+            pProf->minTime[i] = t;
+        }
+        if (t > pProf->maxTime[i])
+        {
+            pProf->maxTime[i] = t;
+            pProf->maxFrame[i] = pProf->frame;
+        }
+    }
+
+    /* Worst frame keeps stage breakdown of frame with largest frame time */
+    if (pProf->used[DECIM_PROF_STAGE_FRAME] &&
+        (pProf->cur[DECIM_PROF_STAGE_FRAME] >= pProf->maxTime[DECIM_PROF_STAGE_FRAME]))
+    {
+        pProf->worst.frame = pProf->frame;
+        for (i = 0; i < DECIM_PROF_NUM_STAGES; i++)
+        {
+            pProf->worst.time[i] = pProf->cur[i];
+        }
+    }
+
+    for (i = 0; i < DECIM_PROF_NUM_STAGES; i++)
+    {
+        pProf->cur[i] = 0;
+        pProf->used[i] = 0;
+    }
+    pProf->frame++;
+}
+
+/* Reads stage statistics. */
+void decimProfGetStats(
+    DecimProf *pProf,       /* profiling state */
+    Uint16 stage,           /* DECIM_PROF_STAGE_xxx */
+    DecimProfStats *pStats  /* stage statistics */
+)
+{
+    Uint32 numFrames;
+    Uint32 rank;
+    Uint32 cnt;
+    Uint16 bin;
+
+    numFrames = pProf->numFrames[stage];
+    pStats->numFrames = numFrames;
+    if (numFrames == 0)
+    {
+        pStats->minTime = 0;
+        pStats->meanTime = 0;
+        pStats->p99Time = 0;
+        pStats->maxTime = 0;
+        pStats->maxFrame = 0;
+        return;
+    }
+
+    pStats->minTime = pProf->minTime[stage];
+    pStats->meanTime = (Uint32)(pProf->sumTime[stage] / numFrames);
+    pStats->maxTime = pProf->maxTime[stage];
+    pStats->maxFrame = pProf->maxFrame[stage];
+
+    /* Smallest bin holding 99% of frames */
+    rank = numFrames - numFrames/100;
+    cnt = 0;
+    for (bin = 0; bin < DECIM_PROF_HIST_LEN-1; bin++)
+    {
+        cnt += pProf->hist[stage][bin];
+        if (cnt >= rank)
+        {
+            break;
+        }
+    }
+    pStats->p99Time = decimProfBinMax(bin);
+    if (pStats->p99Time > pStats->maxTime)
+    {
+        pStats->p99Time = pStats->maxTime;
+    }
+}
+
+/* Reads worst frame. */
+void decimProfGetWorst(
+    DecimProf *pProf,       /* profiling state */
+    DecimProfWorst *pWorst  /* worst frame */
+)
+{
+    *pWorst = pProf->worst;
+}
+
+/* Returns time unit name: "cycles", "tsc" or "ns". */
+const char *decimProfUnit(void)
+{
+#if defined(__TMS320C55X__)
+    return "cycles";
+#elif (defined(__GNUC__)||defined(__clang__)) && defined(__x86_64__)
+    return "tsc";
+#else
+    return "ns";
+#endif
+}
@@ -0,0 +1,475 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+
+#include <stddef.h>
+#include <pthread.h>
+#include "data_types.h"
+#include "host_clock.h"
+#include "decim_pipe.h"
+#include "decim_sched.h"
+
+#define ATOMIC_LOAD(p)          __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define ATOMIC_STORE(p, v)      __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define ATOMIC_ADD(p, v)        __atomic_add_fetch((p), (v), __ATOMIC_ACQ_REL)
+#define ATOMIC_SUB(p, v)        __atomic_sub_fetch((p), (v), __ATOMIC_ACQ_REL)
+
+/* Pushes stream ID at bottom of deque. */
+/* Cannot overflow, stream is in at most one deque. */
+static void decimSchedPush(
+    DecimSchedDeque *pDeque,    /* deque */
+    Uint16 streamId             /* stream ID */
+)
+{
+    Uint16 idx;
+
+    pthread_mutex_lock(&pDeque->lock);
+    idx = (pDeque->top + pDeque->count) % DECIM_SCHED_MAX_STREAMS;
+    pDeque->ids[idx] = streamId;
+    ATOMIC_ADD(&pDeque->count, 1);
+    pthread_mutex_unlock(&pDeque->lock);
+}
+
+/* Pops oldest stream ID from top of deque, owner & thieves alike. */
+/* Returns 1 if stream ID popped, 0 if deque empty. */
+static Uint16 decimSchedPop(
+    DecimSchedDeque *pDeque,    /* deque */
+    Uint16 *pStreamId           /* popped stream ID */
+)
+{
+    Uint16 found;
+
+    /* Unlocked peek, avoids taking locks of empty deques while stealing */
+    if (ATOMIC_LOAD(&pDeque->count) == 0)
+    {
+        return 0;
+    }
+
+    found = 0;
+    pthread_mutex_lock(&pDeque->lock);
+    if (pDeque->count > 0)
+    {
+        *pStreamId = pDeque->ids[pDeque->top];
+        pDeque->top = (pDeque->top + 1) % DECIM_SCHED_MAX_STREAMS;
+        ATOMIC_SUB(&pDeque->count, 1);
+        found = 1;
+    }
+    pthread_mutex_unlock(&pDeque->lock);
+
+    return found;
+}
+
+/* Makes stream ready in worker deque & wakes one sleeping worker */
+static void decimSchedReady(
+    DecimSched *pSched,     /* scheduler */
+    Uint16 workerId,        /* worker owning deque */
+    Uint16 streamId         /* stream ID */
+)
+{
+    /* Count before push, so numReady never drops below number of streams in deques */
+    ATOMIC_ADD(&pSched->numReady, 1);
+    decimSchedPush(&pSched->worker[workerId].deque, streamId);
+
+    /* Signal under lock, sleeping workers check numReady under same lock */
+    pthread_mutex_lock(&pSched->idleLock);
+    pthread_cond_signal(&pSched->workCond);
+    pthread_mutex_unlock(&pSched->idleLock);
+}
+
+/* Finds ready stream: own deque first, then steals from other workers. */
+/* Own deque runs in ready order, so a yielding stream waits behind all others. */
+/* Returns 1 if stream found, 0 if no stream ready. */
+static Uint16 decimSchedFind(
+    DecimSchedWorker *pWorker,  /* worker */
+    Uint16 *pStreamId           /* found stream ID */
+)
+{
+    DecimSched *pSched;
+    Uint16 numWorkers;
+    Uint16 victim;
+    Uint16 i;
+
+    pSched = pWorker->pSched;
+    numWorkers = pSched->numWorkers;
+
+    if (decimSchedPop(&pWorker->deque, pStreamId))
+    {
+        return 1;
+    }
+
+    /* Steal oldest ready stream, victims visited from next worker on */
+    for (i = 1; i < numWorkers; i++)
+    {
+        victim = (pWorker->workerId + i) % numWorkers;
+        if (decimSchedPop(&pSched->worker[victim].deque, pStreamId))
+        {
+            ATOMIC_ADD(&pWorker->numSteals, 1);
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/* Runs all pending frames of stream, */
+/* reschedules stream on own deque if frames arrived meanwhile */
+static void decimSchedRunStream(
+    DecimSchedWorker *pWorker,  /* worker */
+    Uint16 streamId             /* stream ID */
+)
+{
+    DecimSched *pSched;
+    DecimSchedStream *pStream;
+    DecimSchedFrame frame;
+    Uint16 numOutSamps;
+    Uint64 t0;
+    Uint32 depth;
+
+    pSched = pWorker->pSched;
+    pStream = &pSched->stream[streamId];
+
+    pthread_mutex_lock(&pStream->lock);
+    while (pStream->count > 0)
+    {
+        /* Frame stays in FIFO while processed, so FIFO depth bounds frames in flight */
+        frame = pStream->fifo[pStream->head];
+        pthread_mutex_unlock(&pStream->lock);
+
+        t0 = hostClockNowNs();
+        decimPipeProcess(pStream->pPipe, frame.lData, frame.rData, frame.outSamps, &numOutSamps);
+        ATOMIC_ADD(&pWorker->busyNs, hostClockNowNs() - t0);
+
+        if (pStream->done != NULL)
+        {
+            pStream->done(pStream->pArg, streamId, frame.outSamps, numOutSamps);
+        }
+        pStream->numFrames++;
+        ATOMIC_ADD(&pWorker->numFrames, 1);
+
+        pthread_mutex_lock(&pStream->lock);
+        pStream->head = (pStream->head + 1) % DECIM_SCHED_QUEUE_LEN;
+        pStream->count--;
+
+        depth = ATOMIC_SUB(&pSched->curDepth, 1);
+        if (depth == 0)
+        {
+            pthread_mutex_lock(&pSched->idleLock);
+            pthread_cond_broadcast(&pSched->drainCond);
+            pthread_mutex_unlock(&pSched->idleLock);
+        }
+
+        /* Yield to other streams of own deque after each frame, requeued behind them */
+        if ((pStream->count > 0) && (ATOMIC_LOAD(&pWorker->deque.count) > 0))
+        {
+            pthread_mutex_unlock(&pStream->lock);
+            decimSchedReady(pSched, pWorker->workerId, streamId);
+            return;
+        }
+    }
+    pStream->scheduled = 0;
+    pthread_mutex_unlock(&pStream->lock);
+}
+
+/* Worker thread */
+static void *decimSchedWorkerThread(
+    void *pArg              /* worker */
+)
+{
+    DecimSchedWorker *pWorker;
+    DecimSched *pSched;
+    Uint16 streamId;
+
+    pWorker = (DecimSchedWorker *)pArg;
+    pSched = pWorker->pSched;
+
+    for (;;)
+    {
+        if (decimSchedFind(pWorker, &streamId))
+        {
+            ATOMIC_SUB(&pSched->numReady, 1);
+            decimSchedRunStream(pWorker, streamId);
+            continue;
+        }
+
+        /* Sleep until stream becomes ready */
+        pthread_mutex_lock(&pSched->idleLock);
+        while ((ATOMIC_LOAD(&pSched->numReady) == 0) && !pSched->stop)
+        {
+            pthread_cond_wait(&pSched->workCond, &pSched->idleLock);
+        }
+        if (pSched->stop && (ATOMIC_LOAD(&pSched->numReady) == 0))
+        {
+            pthread_mutex_unlock(&pSched->idleLock);
+            break;
+        }
+        pthread_mutex_unlock(&pSched->idleLock);
+    }
+
+    return NULL;
+}
+
+/* Initializes scheduler & starts numWorkers worker threads. */
+Int16 decimSchedInit(
+    DecimSched *pSched,     /* scheduler */
+    Uint16 numWorkers       /* number of worker threads */
+)
+{
+    DecimSchedWorker *pWorker;
+    DecimSchedStream *pStream;
+    Uint16 i;
+
+    if ((numWorkers == 0) || (numWorkers > DECIM_SCHED_MAX_WORKERS))
+    {
+        return DECIM_SCHED_ERR_WORKERS;
+    }
+
+    for (i = 0; i < DECIM_SCHED_MAX_STREAMS; i++)
+    {
+        pStream = &pSched->stream[i];
+        pStream->pPipe = NULL;
+        pStream->done = NULL;
+        pStream->pArg = NULL;
+        pthread_mutex_init(&pStream->lock, NULL);
+        pStream->head = 0;
+        pStream->count = 0;
+        pStream->scheduled = 0;
+        pStream->numFrames = 0;
+    }
+
+    pSched->numWorkers = numWorkers;
+    pSched->stop = 0;
+    pSched->numReady = 0;
+    pSched->curDepth = 0;
+    pSched->maxDepth = 0;
+    pSched->numSubmitted = 0;
+    pSched->numRejected = 0;
+    pthread_mutex_init(&pSched->idleLock, NULL);
+    pthread_cond_init(&pSched->workCond, NULL);
+    pthread_cond_init(&pSched->drainCond, NULL);
+    pSched->startNs = hostClockNowNs();
+
+    for (i = 0; i < numWorkers; i++)
+    {
+        pWorker = &pSched->worker[i];
+        pWorker->pSched = pSched;
+        pWorker->workerId = i;
+        pthread_mutex_init(&pWorker->deque.lock, NULL);
+        pWorker->deque.top = 0;
+        pWorker->deque.count = 0;
+        pWorker->numFrames = 0;
+        pWorker->numSteals = 0;
+        pWorker->busyNs = 0;
+    }
+
+    for (i = 0; i < numWorkers; i++)
+    {
+        pWorker = &pSched->worker[i];
+        if (pthread_create(&pWorker->thread, NULL, decimSchedWorkerThread, pWorker) != 0)
+        {
+            /* Stop workers already started */
+            pSched->numWorkers = i;
+            decimSchedStop(pSched);
+            return DECIM_SCHED_ERR_THREAD;
+        }
+    }
+
+    return DECIM_SCHED_OK;
+}
+
+/* Adds stream running initialized pipeline instance pPipe. */
+Int16 decimSchedAddStream(
+    DecimSched *pSched,     /* scheduler */
+    Uint16 streamId,        /* stream ID, 0->DECIM_SCHED_MAX_STREAMS-1 */
+    DecimPipe *pPipe,       /* pipeline instance */
+    DecimSchedDoneFxn done, /* frame completion callback, may be NULL */
+    void *pArg              /* callback argument */
+)
+{
+    DecimSchedStream *pStream;
+
+    if ((streamId >= DECIM_SCHED_MAX_STREAMS) || (pPipe == NULL))
+    {
+        return DECIM_SCHED_ERR_STREAM;
+    }
+
+    pStream = &pSched->stream[streamId];
+    pthread_mutex_lock(&pStream->lock);
+    pStream->pPipe = pPipe;
+    pStream->done = done;
+    pStream->pArg = pArg;
+    pthread_mutex_unlock(&pStream->lock);
+
+    return DECIM_SCHED_OK;
+}
+
+/* Submits frame of stream, returns immediately. */
+Int16 decimSchedSubmit(
+    DecimSched *pSched,     /* scheduler */
+    Uint16 streamId,        /* stream ID */
+    Uint32 *lData,          /* "left" channel 32-bit packed input data */
+    Uint32 *rData,          /* "right" channel 32-bit packed input data */
+    Int16 *outSamps         /* output samples (S16Q15) */
+)
+{
+    DecimSchedStream *pStream;
+    DecimSchedFrame *pFrame;
+    Uint16 ready;
+    Uint32 depth, maxDepth;
+
+    if ((streamId >= DECIM_SCHED_MAX_STREAMS) || (pSched->stream[streamId].pPipe == NULL))
+    {
+        return DECIM_SCHED_ERR_STREAM;
+    }
+
+    pStream = &pSched->stream[streamId];
+    pthread_mutex_lock(&pStream->lock);
+    if (pStream->count == DECIM_SCHED_QUEUE_LEN)
+    {
+        pthread_mutex_unlock(&pStream->lock);
+        ATOMIC_ADD(&pSched->numRejected, 1);
+        return DECIM_SCHED_ERR_FULL;
+    }
+
+    pFrame = &pStream->fifo[(pStream->head + pStream->count) % DECIM_SCHED_QUEUE_LEN];
+    pFrame->lData = lData;
+    pFrame->rData = rData;
+    pFrame->outSamps = outSamps;
+    pStream->count++;
+
+    /* Unscheduled stream goes to its home worker */
+    ready = !pStream->scheduled;
+    pStream->scheduled = 1;
+
+    ATOMIC_ADD(&pSched->numSubmitted, 1);
+    depth = ATOMIC_ADD(&pSched->curDepth, 1);
+    pthread_mutex_unlock(&pStream->lock);
+
+    maxDepth = ATOMIC_LOAD(&pSched->maxDepth);
+    while ((depth > maxDepth) &&
+        !__atomic_compare_exchange_n(&pSched->maxDepth, &maxDepth, depth, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+    {
+    }
+
+    if (ready)
+    {
+        decimSchedReady(pSched, streamId % pSched->numWorkers, streamId);
+    }
+
+    return DECIM_SCHED_OK;
+}
+
+/* Waits until all submitted frames are processed. */
+void decimSchedDrain(
+    DecimSched *pSched      /* scheduler */
+)
+{
+    pthread_mutex_lock(&pSched->idleLock);
+    while (ATOMIC_LOAD(&pSched->curDepth) != 0)
+    {
+        pthread_cond_wait(&pSched->drainCond, &pSched->idleLock);
+    }
+    pthread_mutex_unlock(&pSched->idleLock);
+}
+
+/* Reads scheduler statistics. */
+void decimSchedGetStats(
+    DecimSched *pSched,     /* scheduler */
+    DecimSchedStats *pStats /* statistics */
+)
+{
+    DecimSchedWorker *pWorker;
+    Uint64 busyNs;
+    Uint32 numOutSamps;
+    Uint16 i;
+
+    pStats->numFrames = 0;
+    pStats->numSteals = 0;
+    busyNs = 0;
+    for (i = 0; i < pSched->numWorkers; i++)
+    {
+        pWorker = &pSched->worker[i];
+        pStats->numFrames += ATOMIC_LOAD(&pWorker->numFrames);
+        pStats->numSteals += ATOMIC_LOAD(&pWorker->numSteals);
+        busyNs += ATOMIC_LOAD(&pWorker->busyNs);
+    }
+    pStats->numSubmitted = ATOMIC_LOAD(&pSched->numSubmitted);
+    pStats->numRejected = ATOMIC_LOAD(&pSched->numRejected);
+    pStats->curDepth = ATOMIC_LOAD(&pSched->curDepth);
+    pStats->maxDepth = ATOMIC_LOAD(&pSched->maxDepth);
+    pStats->numReady = ATOMIC_LOAD(&pSched->numReady);
+
+    /* Output frame length of first stream stands for all streams */
+    numOutSamps = 0;
+    for (i = 0; i < DECIM_SCHED_MAX_STREAMS; i++)
+    {
+        if (pSched->stream[i].pPipe != NULL)
+        {
+            numOutSamps = pSched->stream[i].pPipe->outFrameLen;
+            break;
+        }
+    }
+
+    pStats->elapsedSec = (Float64)(hostClockNowNs() - pSched->startNs) * 1e-9;
+    if (pStats->elapsedSec > 0)
+    {
+        pStats->framesPerSec = pStats->numFrames / pStats->elapsedSec;
+        pStats->outSampsPerSec = pStats->framesPerSec * numOutSamps;
+        pStats->utilization = (Float64)busyNs * 1e-9 / (pStats->elapsedSec * pSched->numWorkers);
+    }
+    else
+    {
+        pStats->framesPerSec = 0;
+        pStats->outSampsPerSec = 0;
+        pStats->utilization = 0;
+    }
+}
+
+/* Drains scheduler & stops worker threads. */
+void decimSchedStop(
+    DecimSched *pSched      /* scheduler */
+)
+{
+    Uint16 i;
+
+    decimSchedDrain(pSched);
+
+    pthread_mutex_lock(&pSched->idleLock);
+    pSched->stop = 1;
+    pthread_cond_broadcast(&pSched->workCond);
+    pthread_mutex_unlock(&pSched->idleLock);
+
+    for (i = 0; i < pSched->numWorkers; i++)
+    {
+        pthread_join(pSched->worker[i].thread, NULL);
+    }
+    pSched->numWorkers = 0;
+}
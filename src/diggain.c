@@ -74,7 +74,7 @@ void appDiggain(
 #endif
         acc0_40b >>= 9; /* truncate */
 
-#ifdef _WIN32
+#ifndef __TMS320C55X__
         /* Saturate output */
         if (acc0_40b > (Int64)0x7FFF)
         {
@@ -101,3 +101,46 @@ void appDiggain(
     }
 }
 
+
+/* Applies digital gain and saturates output, host 32-bit arithmetic. */
+/* S18Q16 input data, S16Q15 output data. */
+/* U16Q8 digital gain. */
+void appDiggainHost(
+    Int32   *inSamps,   /* input samples (S18Q16) */
+    Uint16  diggain,    /* digital gain (U16Q8) */
+    Int16   *outSamps,  /* output samples (S16Q15) */
+    Uint16  numInSamps  /* number of input samples */
+)
+{
+    Uint32 prdLL;
+    Int32 prdLH;
+    Int32 acc;
+    Uint16 i;
+
+    for (i = 0; i < numInSamps; i++)
+    {
+        /* S18Q16 * U16Q8 = S34Q24 */
+        /* Low product unsigned, high product wraps at 32 bits as prdLH<<16 of appDiggain() */
+        prdLL = ((Uint32)inSamps[i] & 0xFFFF) * diggain;
+        prdLH = (Int32)(((Uint32)inSamps[i] & 0xFFFF0000) * diggain);
+
+        /* High product multiple of 1<<16, so shifts of both terms can be done separately */
+#if (QUANT_MODE == QUANT_RND_INF)
+        acc = (Int32)((prdLL + ((Uint16)1<<8)) >> 9) + (prdLH >> 9); /* round to infinite */
+#else
+        acc = (Int32)(prdLL >> 9) + (prdLH >> 9); /* truncate */
+#endif
+
+        /* Saturate output */
+        if (acc > (Int32)0x7FFF)
+        {
+            acc = (Int32)0x7FFF;
+        }
+        else if (acc < -(Int32)0x8000)
+        {
+            acc = -(Int32)0x8000;
+        }
+
+        outSamps[i] = (Int16)acc; /* S16Q15 */
+    }
+}
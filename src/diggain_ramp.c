@@ -0,0 +1,358 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+
+#include <stddef.h>
+#include "data_types.h"
+#include "diggain.h"
+
+#define QUANT_TRUNC         ( 0 )   /* truncate */
+#define QUANT_RND_INF       ( 1 )   /* round to infinite */
+#define QUANT_MODE          ( QUANT_RND_INF )
+
+/* Applies U16Q8 digital gain to one sample and saturates output, */
+/* host 32-bit arithmetic as appDiggainHost(), */
+/* saturation written as selects for vectorization. */
+static Int16 diggainSat(
+    Int32   inSamp,     /* input sample (S18Q16) */
+    Uint16  diggain     /* digital gain (U16Q8) */
+)
+{
+    Uint32 prdLL;
+    Int32 prdLH;
+    Int32 acc;
+
+    /* S18Q16 * U16Q8 = S34Q24 */
+    prdLL = ((Uint32)inSamp & 0xFFFF) * diggain;
+    prdLH = (Int32)(((Uint32)inSamp & 0xFFFF0000) * diggain);
+
+#if (QUANT_MODE == QUANT_RND_INF)
+    acc = (Int32)((prdLL + ((Uint16)1<<8)) >> 9) + (prdLH >> 9); /* round to infinite */
+#else
+    acc = (Int32)(prdLL >> 9) + (prdLH >> 9); /* truncate */
+#endif
+
+    /* Saturate output */
+    acc = (acc > (Int32)0x7FFF) ? (Int32)0x7FFF : acc;
+    acc = (acc < -(Int32)0x8000) ? -(Int32)0x8000 : acc;
+
+    return (Int16)acc; /* S16Q15 */
+}
+
+/* Applies linearly interpolated digital gain and saturates output. */
+/* Gain of sample i is gain+(i+1)*gainStep, rounded to U16Q8, */
+/* computed independently per sample so loop vectorizes. */
+static void diggainRamp(
+    Int32   *inSamps,   /* input samples (S18Q16) */
+    Int16   *outSamps,  /* output samples (S16Q15) */
+    Uint32  gain,       /* gain before 1st sample (U16Q24) */
+    Int32   gainStep,   /* gain step per sample (S16Q24) */
+    Uint16  numInSamps  /* number of input samples */
+)
+{
+    Uint32 sampGain;
+    Uint16 i;
+
+    for (i = 0; i < numInSamps; i++)
+    {
+        /* Modulo 2^32 arithmetic, result within gain->target gain */
+        sampGain = gain + (Uint32)gainStep * (Uint32)(i+1);
+        outSamps[i] = diggainSat(inSamps[i], (Uint16)((sampGain + ((Uint32)1<<15)) >> 16));
+    }
+}
+
+/* Applies unity digital gain and saturates output, no multiplies. */
+/* Output bit-exact with appDiggain() at DIGGAIN_UNITY. */
+static void diggainUnity(
+    Int32   *inSamps,   /* input samples (S18Q16) */
+    Int16   *outSamps,  /* output samples (S16Q15) */
+    Uint16  numInSamps  /* number of input samples */
+)
+{
+    Uint32 prdLL;
+    Int32 prdLH;
+    Int32 acc;
+    Uint16 i;
+
+    for (i = 0; i < numInSamps; i++)
+    {
+        /* S18Q16 * 1.0 (U16Q8) = S34Q24, high product wraps at 32 bits as appDiggain() */
+        prdLL = ((Uint32)inSamps[i] & 0xFFFF) << 8;
+        prdLH = (Int32)(((Uint32)inSamps[i] & 0xFFFF0000) << 8);
+
+#if (QUANT_MODE == QUANT_RND_INF)
+        acc = (Int32)((prdLL + ((Uint16)1<<8)) >> 9) + (prdLH >> 9); /* round to infinite */
+#else
+        acc = (Int32)(prdLL >> 9) + (prdLH >> 9); /* truncate */
+#endif
+
+        /* Saturate output */
+        acc = (acc > (Int32)0x7FFF) ? (Int32)0x7FFF : acc;
+        acc = (acc < -(Int32)0x8000) ? -(Int32)0x8000 : acc;
+
+        outSamps[i] = (Int16)acc; /* S16Q15 */
+    }
+}
+
+/* Sets target gain & restarts ramp */
+static void diggainSetTgt(
+    DiggainState *pState,   /* digital gain state */
+    Uint32  tgtGain         /* target gain (U16Q24) */
+)
+{
+    pState->tgtGain = tgtGain;
+
+    if (pState->rampMode == DIGGAIN_RAMP_LIN)
+    {
+        if (pState->rampLen == 0)
+        {
+            pState->curGain = tgtGain;
+            pState->rampRem = 0;
+            pState->rampStep = 0;
+        }
+        else
+        {
+            pState->rampRem = pState->rampLen;
+            pState->rampStep = (Int32)(((Int64)tgtGain - (Int64)pState->curGain) / pState->rampLen);
+        }
+    }
+}
+
+/* Updates AGC gain from frame input peak & sets it as target gain */
+static void diggainAgcUpdate(
+    DiggainState *pState,   /* digital gain state */
+    Int32   *inSamps,       /* input samples (S18Q16) */
+    Uint16  numInSamps      /* number of input samples */
+)
+{
+    Uint32 peak;
+    Uint32 mag;
+    Uint64 desGain;
+    Uint32 minGain, maxGain;
+    Uint16 i;
+
+    /* Frame peak, one's complement magnitude avoids overflow */
+    peak = 0;
+    for (i = 0; i < numInSamps; i++)
+    {
+        mag = (Uint32)(inSamps[i] ^ (inSamps[i] >> 31));
+        peak = (mag > peak) ? mag : peak;
+    }
+
+    minGain = (Uint32)pState->agcMinGain << 16;
+    maxGain = (Uint32)pState->agcMaxGain << 16;
+
+    /* Gain mapping peak to target peak: */
+    /* S18Q16 * U16Q24 >> 25 = S16Q15, so gain = tgtPeak<<25 / peak */
+    if (peak == 0)
+    {
+        desGain = maxGain;
+    }
+    else
+    {
+        desGain = ((Uint64)pState->agcTgtPeak << 25) / peak;
+    }
+    desGain = (desGain > maxGain) ? maxGain : desGain;
+    desGain = (desGain < minGain) ? minGain : desGain;
+
+    /* Attack when gain decreases, release when gain increases */
+    if ((Uint32)desGain < pState->agcGain)
+    {
+        pState->agcGain -= (pState->agcGain - (Uint32)desGain) >> pState->agcAttack;
+    }
+    else
+    {
+        pState->agcGain += ((Uint32)desGain - pState->agcGain) >> pState->agcRelease;
+    }
+
+    if (pState->agcGain != pState->tgtGain)
+    {
+        diggainSetTgt(pState, pState->agcGain);
+    }
+}
+
+/* Initializes digital gain stage at constant gain diggain. */
+void diggainInit(
+    DiggainState *pState,   /* digital gain state */
+    Uint16  diggain,        /* initial digital gain (U16Q8) */
+    Uint16  rampMode,       /* DIGGAIN_RAMP_LIN or DIGGAIN_RAMP_EXP */
+    Uint16  rampLen,        /* linear ramp length in samples */
+    Uint16  expCoef,        /* exponential ramp remaining gain error fraction per segment (U0Q16) */
+    DiggainFxn constKernel  /* constant gain kernel */
+)
+{
+    pState->curGain = (Uint32)diggain << 16;
+    pState->tgtGain = pState->curGain;
+    pState->rampMode = rampMode;
+    pState->rampLen = rampLen;
+    pState->rampRem = 0;
+    pState->rampStep = 0;
+    pState->expCoef = expCoef;
+    pState->constKernel = (constKernel != NULL) ? constKernel : appDiggain;
+    pState->agcEnable = 0;
+    pState->agcTgtPeak = 0;
+    pState->agcMinGain = diggain;
+    pState->agcMaxGain = diggain;
+    pState->agcAttack = 0;
+    pState->agcRelease = 0;
+    pState->agcGain = pState->curGain;
+}
+
+/* Sets target gain, gain ramps from current to target gain. */
+void diggainSetGain(
+    DiggainState *pState,   /* digital gain state */
+    Uint16  diggain         /* target digital gain (U16Q8) */
+)
+{
+    diggainSetTgt(pState, (Uint32)diggain << 16);
+}
+
+/* Configures peak-tracking AGC. */
+void diggainAgcConfig(
+    DiggainState *pState,   /* digital gain state */
+    Uint16  enable,         /* AGC enable */
+    Uint16  tgtPeak,        /* target output peak (U15Q15) */
+    Uint16  minGain,        /* minimum gain (U16Q8) */
+    Uint16  maxGain,        /* maximum gain (U16Q8) */
+    Uint16  attack,         /* gain decrease smoothing shift */
+    Uint16  release         /* gain increase smoothing shift */
+)
+{
+    Uint32 minLim, maxLim;
+    Uint32 agcGain;
+
+    pState->agcEnable = enable;
+    pState->agcTgtPeak = tgtPeak & 0x7FFF;
+    pState->agcMinGain = minGain;
+    pState->agcMaxGain = (maxGain < minGain) ? minGain : maxGain;
+    pState->agcAttack = attack;
+    pState->agcRelease = release;
+
+    /* Smoothing starts from target gain limited to minGain->maxGain */
+    minLim = (Uint32)pState->agcMinGain << 16;
+    maxLim = (Uint32)pState->agcMaxGain << 16;
+    agcGain = pState->tgtGain;
+    agcGain = (agcGain > maxLim) ? maxLim : agcGain;
+    agcGain = (agcGain < minLim) ? minLim : agcGain;
+    pState->agcGain = agcGain;
+}
+
+/* Applies ramped digital gain and saturates output. */
+void diggainProcess(
+    DiggainState *pState,   /* digital gain state */
+    Int32   *inSamps,       /* input samples (S18Q16) */
+    Int16   *outSamps,      /* output samples (S16Q15) */
+    Uint16  numInSamps      /* number of input samples */
+)
+{
+    Uint32 curGain, tgtGain, segGain;
+    Int64 gainErr;
+    Int64 gainRem;
+    Int32 gainStep;
+    Uint16 numSegSamps;
+    Uint16 diggain;
+    Uint16 i;
+
+    if (pState->agcEnable)
+    {
+        diggainAgcUpdate(pState, inSamps, numInSamps);
+    }
+
+    curGain = pState->curGain;
+    tgtGain = pState->tgtGain;
+
+    /* Ramp, one segment per loop */
+    i = 0;
+    while ((i < numInSamps) && (curGain != tgtGain))
+    {
+        numSegSamps = numInSamps - i;
+
+        if (pState->rampMode == DIGGAIN_RAMP_LIN)
+        {
+            /* Linear ramp to target over remaining ramp samples */
+            if (numSegSamps > pState->rampRem)
+            {
+                numSegSamps = pState->rampRem;
+            }
+            gainStep = pState->rampStep;
+            diggainRamp(&inSamps[i], &outSamps[i], curGain, gainStep, numSegSamps);
+
+            pState->rampRem -= numSegSamps;
+            curGain = (pState->rampRem == 0) ? tgtGain : curGain + (Uint32)gainStep * numSegSamps;
+        }
+        else
+        {
+            /* Exponential ramp, gain error multiplied by expCoef per segment, */
+            /* linear within segment */
+            if (numSegSamps > DIGGAIN_EXP_SEG_LEN)
+            {
+                numSegSamps = DIGGAIN_EXP_SEG_LEN;
+            }
+
+            gainErr = (Int64)tgtGain - (Int64)curGain;
+            if ((gainErr < ((Int32)1<<16)) && (gainErr > -((Int32)1<<16)))
+            {
+                /* Error below U16Q8 resolution, end ramp at segment end */
+                segGain = tgtGain;
+            }
+            else
+            {
+                /* gainErr*expCoef>>16, split so products fit 40-bit accumulator */
+                gainRem = (gainErr >> 16) * pState->expCoef +
+                    (Int64)((((Uint32)gainErr & 0xFFFF) * pState->expCoef) >> 16);
+                segGain = tgtGain - (Uint32)gainRem;
+            }
+            gainStep = (Int32)(((Int64)segGain - (Int64)curGain) / DIGGAIN_EXP_SEG_LEN);
+            diggainRamp(&inSamps[i], &outSamps[i], curGain, gainStep, numSegSamps);
+
+            curGain = (numSegSamps == DIGGAIN_EXP_SEG_LEN) ? segGain : curGain + (Uint32)gainStep * numSegSamps;
+        }
+
+        i += numSegSamps;
+    }
+
+    pState->curGain = curGain;
+
+    /* Constant gain */
+    if (i < numInSamps)
+    {
+        diggain = (Uint16)((curGain + ((Uint32)1<<15)) >> 16);
+        if (diggain == DIGGAIN_UNITY)
+        {
+            diggainUnity(&inSamps[i], &outSamps[i], numInSamps - i);
+        }
+        else
+        {
+            pState->constKernel(&inSamps[i], diggain, &outSamps[i], numInSamps - i);
+        }
+    }
+}
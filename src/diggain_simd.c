@@ -0,0 +1,174 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+
+#include "data_types.h"
+#include "diggain.h"
+#include "diggain_simd.h"
+
+#define QUANT_TRUNC         ( 0 )   /* truncate */
+#define QUANT_RND_INF       ( 1 )   /* round to infinite */
+#define QUANT_MODE          ( QUANT_RND_INF )
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define DIGGAIN_SIMD_X86    ( 1 )   /* x86-64 kernels, per-function ISA target */
+#include <immintrin.h>
+#define DIGGAIN_TARGET(isa) __attribute__((target(isa)))
+#else
+#define DIGGAIN_SIMD_X86    ( 0 )   /* no SIMD kernels */
+#endif
+
+#if (DIGGAIN_SIMD_X86 == 1)
+
+/* Input sample viewed as 16-bit lanes (dataL, dataH): */
+/* prdLL = dataL*G, unsigned 32 bits from mullo & mulhi_epu16 of dataL lane, */
+/* prdLH<<16 = low 16 bits of dataH*G from mullo of dataH lane, wraps as in appDiggain(). */
+/* High product multiple of 1<<16, so shifts of both terms can be done separately. */
+
+/* SSE2, 4 samples */
+static DIGGAIN_TARGET("sse2") inline __m128i diggainSse2(
+    __m128i x,              /* input samples (S18Q16) */
+    __m128i g,              /* digital gain in all 16-bit lanes */
+    __m128i maskL,          /* 0x0000FFFF in all 32-bit lanes */
+    __m128i rnd             /* rounding constant in all 32-bit lanes */
+)
+{
+    __m128i prdLo, prdHi;
+    __m128i prdLL, prdLH;
+
+    prdLo = _mm_mullo_epi16(x, g);
+    prdHi = _mm_mulhi_epu16(x, g);
+    /* S18Q16 * U16Q8 = S34Q24 */
+    prdLL = _mm_or_si128(_mm_and_si128(prdLo, maskL), _mm_slli_epi32(prdHi, 16));
+    prdLH = _mm_andnot_si128(maskL, prdLo);
+    /* round, truncate */
+    return _mm_add_epi32(_mm_srli_epi32(_mm_add_epi32(prdLL, rnd), 9), _mm_srai_epi32(prdLH, 9));
+}
+
+/* Applies digital gain and saturates output, SSE2. */
+DIGGAIN_TARGET("sse2") void appDiggainSse2(
+    Int32   *inSamps,   /* input samples (S18Q16) */
+    Uint16  diggain,    /* digital gain (U16Q8) */
+    Int16   *outSamps,  /* output samples (S16Q15) */
+    Uint16  numInSamps  /* number of input samples */
+)
+{
+    __m128i g, maskL, rnd;
+    __m128i acc0, acc1;
+    Uint16 i;
+
+    g = _mm_set1_epi16((short)diggain);
+    maskL = _mm_set1_epi32(0xFFFF);
+#if (QUANT_MODE == QUANT_RND_INF)
+    rnd = _mm_set1_epi32((Uint16)1<<8); /* round to infinite */
+#else
+    rnd = _mm_setzero_si128(); /* truncate */
+#endif
+
+    for (i = 0; i+8 <= numInSamps; i += 8)
+    {
+        acc0 = diggainSse2(_mm_loadu_si128((const __m128i *)&inSamps[i]), g, maskL, rnd);
+        acc1 = diggainSse2(_mm_loadu_si128((const __m128i *)&inSamps[i+4]), g, maskL, rnd);
+        /* Saturate output, S16Q15 */
+        _mm_storeu_si128((__m128i *)&outSamps[i], _mm_packs_epi32(acc0, acc1));
+    }
+
+    appDiggainHost(&inSamps[i], diggain, &outSamps[i], numInSamps-i);
+}
+
+/* AVX2, 8 samples */
+static DIGGAIN_TARGET("avx2") inline __m256i diggainAvx2(
+    __m256i x,              /* input samples (S18Q16) */
+    __m256i g,              /* digital gain in all 16-bit lanes */
+    __m256i maskL,          /* 0x0000FFFF in all 32-bit lanes */
+    __m256i rnd             /* rounding constant in all 32-bit lanes */
+)
+{
+    __m256i prdLo, prdHi;
+    __m256i prdLL, prdLH;
+
+    prdLo = _mm256_mullo_epi16(x, g);
+    prdHi = _mm256_mulhi_epu16(x, g);
+    /* S18Q16 * U16Q8 = S34Q24 */
+    prdLL = _mm256_or_si256(_mm256_and_si256(prdLo, maskL), _mm256_slli_epi32(prdHi, 16));
+    prdLH = _mm256_andnot_si256(maskL, prdLo);
+    /* round, truncate */
+    return _mm256_add_epi32(_mm256_srli_epi32(_mm256_add_epi32(prdLL, rnd), 9), _mm256_srai_epi32(prdLH, 9));
+}
+
+/* Applies digital gain and saturates output, AVX2. */
+DIGGAIN_TARGET("avx2") void appDiggainAvx2(
+    Int32   *inSamps,   /* input samples (S18Q16) */
+    Uint16  diggain,    /* digital gain (U16Q8) */
+    Int16   *outSamps,  /* output samples (S16Q15) */
+    Uint16  numInSamps  /* number of input samples */
+)
+{
+    __m256i g, maskL, rnd;
+    __m256i acc0, acc1;
+    Uint16 i;
+
+    g = _mm256_set1_epi16((short)diggain);
+    maskL = _mm256_set1_epi32(0xFFFF);
+#if (QUANT_MODE == QUANT_RND_INF)
+    rnd = _mm256_set1_epi32((Uint16)1<<8); /* round to infinite */
+#else
+    rnd = _mm256_setzero_si256(); /* truncate */
+#endif
+
+    for (i = 0; i+16 <= numInSamps; i += 16)
+    {
+        acc0 = diggainAvx2(_mm256_loadu_si256((const __m256i *)&inSamps[i]), g, maskL, rnd);
+        acc1 = diggainAvx2(_mm256_loadu_si256((const __m256i *)&inSamps[i+8]), g, maskL, rnd);
+        /* Saturate output, S16Q15, pack is per 128-bit lane so restore sample order */
+        _mm256_storeu_si256((__m256i *)&outSamps[i],
+            _mm256_permute4x64_epi64(_mm256_packs_epi32(acc0, acc1), 0xD8));
+    }
+
+    appDiggainHost(&inSamps[i], diggain, &outSamps[i], numInSamps-i);
+}
+
+#else
+
+/* SSE2 kernel, not available */
+void appDiggainSse2(Int32 *inSamps, Uint16 diggain, Int16 *outSamps, Uint16 numInSamps)
+{
+    appDiggainHost(inSamps, diggain, outSamps, numInSamps);
+}
+
+/* AVX2 kernel, not available */
+void appDiggainAvx2(Int32 *inSamps, Uint16 diggain, Int16 *outSamps, Uint16 numInSamps)
+{
+    appDiggainHost(inSamps, diggain, outSamps, numInSamps);
+}
+
+#endif
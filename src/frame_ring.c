@@ -0,0 +1,214 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+#include "data_types.h"
+#include "frame_ring.h"
+
+/* Indices shared between producer & consumer are 16-bit, */
+/* single word accesses are atomic on C55x, volatile keeps them in memory. */
+/* Host uses acquire/release atomics. */
+#ifdef __TMS320C55X__
+#define RING_LOAD(p)            ( *(volatile Uint16 *)(p) )
+#define RING_STORE(p, v)        ( *(volatile Uint16 *)(p) = (v) )
+#define RING_STORE32(p, v)      ( *(volatile Uint32 *)(p) = (v) )
+#else
+#define RING_LOAD(p)            __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define RING_STORE(p, v)        __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define RING_LOAD32(p)          __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define RING_STORE32(p, v)      __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#endif
+
+/* Returns 1 if DMA has not started overwriting frame buffer of frame seq */
+static Uint16 frameRingIntact(
+    FrameRing *pRing,       /* frame ring */
+    Uint32 seq              /* frame sequence number */
+)
+{
+    /* After frame k completes, DMA fills buffer of frame k+1-numBufs */
+    return (Uint16)(RING_LOAD(&pRing->numComplete) - (Uint16)seq) < pRing->numBufs;
+}
+
+/* Initializes frame ring for numBufs DMA frame buffers per channel. */
+Int16 frameRingInit(
+    FrameRing *pRing,       /* frame ring */
+    Uint32 *bufLeft,        /* "left" channel DMA frame buffers */
+    Uint32 *bufRight,       /* "right" channel DMA frame buffers */
+    Uint16 frameLen,        /* number of words per channel per frame */
+    Uint16 numBufs          /* number of DMA frame buffers per channel */
+)
+{
+    if ((numBufs < 2) || (numBufs > FRAME_RING_MAX_BUFS))
+    {
+        return FRAME_RING_ERR_BUFS;
+    }
+
+    pRing->head = 0;
+    pRing->tail = 0;
+    pRing->bufLeft = bufLeft;
+    pRing->bufRight = bufRight;
+    pRing->frameLen = frameLen;
+    pRing->numBufs = numBufs;
+    pRing->numLeft = 0;
+    pRing->numRight = 0;
+    pRing->numComplete = 0;
+    pRing->seq = 0;
+    pRing->numOverruns = 0;
+    pRing->numStale = 0;
+    pRing->numFrames = 0;
+
+    return FRAME_RING_OK;
+}
+
+/* Pushes frame descriptor. Producer only. */
+Int16 frameRingPush(
+    FrameRing *pRing,       /* frame ring */
+    Uint32 *lData,          /* "left" channel 32-bit packed input data */
+    Uint32 *rData,          /* "right" channel 32-bit packed input data */
+    Uint32 timestamp        /* DMA completion time */
+)
+{
+    FrameDesc *pDesc;
+    Uint16 head;
+    Uint32 seq;
+
+    /* Dropped frames still take sequence numbers, gaps visible to consumer */
+    head = pRing->head;
+    seq = pRing->seq++;
+    RING_STORE(&pRing->numComplete, (Uint16)pRing->seq);
+
+    if ((Uint16)(head - RING_LOAD(&pRing->tail)) >= FRAME_RING_LEN)
+    {
+        RING_STORE32(&pRing->numOverruns, pRing->numOverruns + 1);
+        return FRAME_RING_ERR_FULL;
+    }
+
+    pDesc = &pRing->desc[head & (FRAME_RING_LEN-1)];
+    pDesc->lData = lData;
+    pDesc->rData = rData;
+    pDesc->seq = seq;
+    pDesc->timestamp = timestamp;
+    RING_STORE(&pRing->head, head + 1);
+
+    return FRAME_RING_OK;
+}
+
+/* Records DMA transfer completions, pushes frames complete in both channels. */
+void frameRingDmaDone(
+    FrameRing *pRing,       /* frame ring */
+    Uint16 chanMask,        /* FRAME_RING_CHAN_xxx completed */
+    Uint32 timestamp        /* DMA completion time */
+)
+{
+    Uint16 bufIdx;
+
+    if (chanMask & FRAME_RING_CHAN_LEFT)
+    {
+        pRing->numLeft++;
+    }
+    if (chanMask & FRAME_RING_CHAN_RIGHT)
+    {
+        pRing->numRight++;
+    }
+
+    /* Frame complete once both channels completed it, */
+    /* buffer index follows auto-reload order of each channel */
+    while (((Uint16)(pRing->numLeft - pRing->numComplete) != 0) &&
+        ((Uint16)(pRing->numRight - pRing->numComplete) != 0))
+    {
+        bufIdx = (Uint16)(pRing->seq % pRing->numBufs);
+        frameRingPush(pRing, &pRing->bufLeft[(Uint32)bufIdx*pRing->frameLen],
+            &pRing->bufRight[(Uint32)bufIdx*pRing->frameLen], timestamp);
+    }
+}
+
+/* Pops oldest frame still held in DMA frame buffer, stale frames skipped & counted. */
+Uint16 frameRingPop(
+    FrameRing *pRing,       /* frame ring */
+    FrameDesc *pDesc        /* popped frame descriptor */
+)
+{
+    Uint16 tail;
+
+    tail = pRing->tail;
+    while (RING_LOAD(&pRing->head) != tail)
+    {
+        *pDesc = pRing->desc[tail & (FRAME_RING_LEN-1)];
+        tail++;
+        RING_STORE(&pRing->tail, tail);
+
+        if (frameRingIntact(pRing, pDesc->seq))
+        {
+            return 1;
+        }
+        pRing->numStale++;
+    }
+
+    return 0;
+}
+
+/* Completes processing of popped frame. Consumer only. */
+Uint16 frameRingRelease(
+    FrameRing *pRing,       /* frame ring */
+    FrameDesc *pDesc        /* processed frame descriptor */
+)
+{
+    if (!frameRingIntact(pRing, pDesc->seq))
+    {
+        pRing->numStale++;
+        return 0;
+    }
+
+    pRing->numFrames++;
+    return 1;
+}
+
+/* Reads counters. Consumer only. */
+void frameRingGetStats(
+    FrameRing *pRing,       /* frame ring */
+    Uint32 *pNumFrames,     /* number of frames processed */
+    Uint32 *pNumOverruns,   /* number of frames dropped on full ring */
+    Uint32 *pNumStale       /* number of stale frames */
+)
+{
+    *pNumFrames = pRing->numFrames;
+    *pNumStale = pRing->numStale;
+
+#ifdef __TMS320C55X__
+    /* Overrun count written by ISR in two words, reread until not torn */
+    do
+    {
+        *pNumOverruns = *(volatile Uint32 *)&pRing->numOverruns;
+    } while (*pNumOverruns != *(volatile Uint32 *)&pRing->numOverruns);
+#else
+    *pNumOverruns = RING_LOAD32(&pRing->numOverruns);
+#endif
+}
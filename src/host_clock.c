@@ -0,0 +1,72 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+/* clock_gettime(), clock_nanosleep() & CLOCK_MONOTONIC are POSIX, hidden under -std=c99 */
+#define _POSIX_C_SOURCE 200809L
+
+#include <time.h>
+#include "data_types.h"
+#include "host_clock.h"
+
+/* Returns monotonic time (ns) */
+Uint64 hostClockNowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (Uint64)ts.tv_sec*1000000000 + (Uint64)ts.tv_nsec;
+}
+
+/* Sleeps for ns nanoseconds. */
+void hostClockSleepNs(
+    Uint64 ns               /* sleep time (ns) */
+)
+{
+    hostClockSleepUntilNs(hostClockNowNs() + ns);
+}
+
+/* Sleeps until monotonic time dueNs. */
+void hostClockSleepUntilNs(
+    Uint64 dueNs            /* wake up time (ns), hostClockNowNs() time base */
+)
+{
+    struct timespec ts;
+
+    ts.tv_sec = (time_t)(dueNs / 1000000000);
+    ts.tv_nsec = (long)(dueNs % 1000000000);
+
+    /* Restart after signal, absolute deadline unchanged */
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) != 0)
+    {
+    }
+}
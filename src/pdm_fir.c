@@ -0,0 +1,241 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+#include <math.h>
+#include "data_types.h"
+#include "pdm_fir.h"
+
+#define PDM_FIR_IDLE_BYTE   ( 0x55 )    /* alternating 0/1 bits */
+#define PDM_FIR_PI          ( 3.14159265358979323846 )
+
+/* Builds per-byte partial sum table. */
+Int16 pdmFirTblInit(
+    PdmFirTbl *pTbl,        /* per-byte partial sum table */
+    const Int16 *coefs,     /* filter coefficients (S16Q(coefQ)) */
+    Uint16 numCoefs,        /* number of coefficients, multiple of 8 */
+    Uint16 coefQ,           /* coefficient fraction bits */
+    Uint16 decimFact        /* decimation factor: 8, 16, 32 or 64 */
+)
+{
+    Int32 sum;
+    Uint16 row, byteVal, b;
+
+    if ((numCoefs == 0) || (numCoefs > PDM_FIR_MAX_COEFS) || (numCoefs % PDM_FIR_BITS_PER_BYTE != 0))
+    {
+        return PDM_FIR_ERR_NUM_COEFS;
+    }
+    if ((coefQ < PDM_FIR_MIN_COEF_Q) || (coefQ > PDM_FIR_MAX_COEF_Q))
+    {
+        return PDM_FIR_ERR_COEF_Q;
+    }
+    if ((decimFact != 8) && (decimFact != 16) && (decimFact != 32) && (decimFact != 64))
+    {
+        return PDM_FIR_ERR_DF;
+    }
+
+    pTbl->numCoefs = numCoefs;
+    pTbl->numRows = numCoefs/PDM_FIR_BITS_PER_BYTE;
+    pTbl->decimFact = decimFact;
+    pTbl->outShift = coefQ-16;
+
+    for (row = 0; row < pTbl->numRows; row++)
+    {
+        for (byteVal = 0; byteVal < PDM_FIR_NUM_BYTE_VALS; byteVal++)
+        {
+            /* 0->-1, 1->+1 */
+            sum = 0;
+            for (b = 0; b < PDM_FIR_BITS_PER_BYTE; b++)
+            {
+                if ((byteVal>>b)&0x1)
+                {
+                    sum += coefs[row*PDM_FIR_BITS_PER_BYTE+b];
+                }
+                else
+                {
+                    sum -= coefs[row*PDM_FIR_BITS_PER_BYTE+b];
+                }
+            }
+            pTbl->tbl[row][byteVal] = sum;
+        }
+    }
+
+    return PDM_FIR_OK;
+}
+
+/* Initializes input history to idle pattern (alternating 0/1, zero mean). */
+void pdmFirStateInit(
+    PdmFirState *pState     /* per-channel input history */
+)
+{
+    Uint16 i;
+
+    for (i = 0; i < 2*PDM_FIR_MAX_TBL_ROWS; i++)
+    {
+        pState->hist[i] = PDM_FIR_IDLE_BYTE;
+    }
+    pState->histIdx = 0;
+}
+
+/* Decimating FIR applied directly to 1-bit PDM input. */
+void pdmFirDecim(
+    Uint32 *lData,          /* "left" channel 32-bit packed input data */
+    Uint32 *rData,          /* "right" channel 32-bit packed input data */
+    Uint16 inDataLen,       /* length of "left" or "right" input data in 32-bit words */
+    const PdmFirTbl *pTbl,  /* per-byte partial sum table */
+    PdmFirState *pState,    /* per-channel input history */
+    Int32 *outSamps,        /* output samples (S18Q16) */
+    Uint16 *pNumOutSamps    /* number of output samples */
+)
+{
+    Uint16 numRows;
+    Uint16 bytesPerOut;
+    Uint16 outShift;
+    Int32 rnd;
+    Uint16 histIdx;
+    Uint16 *hist;
+    Uint16 bytes[2*4];
+    Uint16 byteVal;
+    Int32 acc;
+    Int32 *pOutSamp;
+    Uint16 i, j, k;
+
+
+    numRows = pTbl->numRows;
+    bytesPerOut = pTbl->decimFact/PDM_FIR_BITS_PER_BYTE;
+    outShift = pTbl->outShift;
+    rnd = (outShift > 0) ? (Int32)1<<(outShift-1) : 0; /* round to infinite */
+
+    /* Compute number of output samples */
+    /* x32 for 32-bit word, x2 for 2 channels */
+    *pNumOutSamps = (Uint16)(((Uint32)inDataLen*64)/pTbl->decimFact);
+
+    hist = pState->hist;
+    histIdx = pState->histIdx;
+    pOutSamp = &outSamps[0];
+    for (i = 0; i < inDataLen; i++)
+    {
+        /* "left" then "right" 32-bit word, MS byte first */
+        bytes[0] = (lData[i]>>24)&0xFF;
+        bytes[1] = (lData[i]>>16)&0xFF;
+        bytes[2] = (lData[i]>>8)&0xFF;
+        bytes[3] = lData[i]&0xFF;
+        bytes[4] = (rData[i]>>24)&0xFF;
+        bytes[5] = (rData[i]>>16)&0xFF;
+        bytes[6] = (rData[i]>>8)&0xFF;
+        bytes[7] = rData[i]&0xFF;
+
+        for (j = 0; j < 8; j += bytesPerOut)
+        {
+            /* Place bytesPerOut bytes in history, newest at lowest index */
+            for (k = 0; k < bytesPerOut; k++)
+            {
+                byteVal = bytes[j+k];
+                if (histIdx == 0)
+                {
+                    histIdx = numRows;
+                }
+                histIdx--;
+                hist[histIdx] = byteVal;
+                hist[histIdx+numRows] = byteVal;
+            }
+
+            /* Sum per-byte partial sums over numRows most recent bytes */
+            acc = 0;
+            for (k = 0; k < numRows; k++)
+            {
+                acc += pTbl->tbl[k][hist[histIdx+k]];
+            }
+
+            /* S(coefQ) -> S18Q16 */
+            *pOutSamp++ = (acc + rnd) >> outShift;
+        }
+    }
+
+    pState->histIdx = histIdx;
+}
+
+/* Designs Blackman-windowed sinc low-pass filter with unity DC gain. */
+Int16 pdmFirDesign(
+    Int16 *coefs,           /* designed coefficients (S16Q(*pCoefQ)) */
+    Uint16 numCoefs,        /* number of coefficients, multiple of 8 */
+    Float64 cutoff,         /* cutoff frequency / PDM bit rate */
+    Uint16 *pCoefQ          /* coefficient fraction bits */
+)
+{
+    Float64 h[PDM_FIR_MAX_COEFS];
+    Float64 t, w, sum, maxAbs, scale;
+    Uint16 coefQ;
+    Uint16 i;
+
+    if ((numCoefs == 0) || (numCoefs > PDM_FIR_MAX_COEFS) || (numCoefs % PDM_FIR_BITS_PER_BYTE != 0))
+    {
+        return PDM_FIR_ERR_NUM_COEFS;
+    }
+
+    /* Windowed sinc */
+    sum = 0.0;
+    for (i = 0; i < numCoefs; i++)
+    {
+        t = (Float64)i - (numCoefs-1)/2.0;
+        h[i] = (t == 0.0) ? 2.0*cutoff : sin(2.0*PDM_FIR_PI*cutoff*t)/(PDM_FIR_PI*t);
+        w = 0.42 - 0.5*cos(2.0*PDM_FIR_PI*i/(numCoefs-1)) + 0.08*cos(4.0*PDM_FIR_PI*i/(numCoefs-1));
+        h[i] *= w;
+        sum += h[i];
+    }
+
+    /* Normalize to unity DC gain */
+    maxAbs = 0.0;
+    for (i = 0; i < numCoefs; i++)
+    {
+        h[i] /= sum;
+        if (fabs(h[i]) > maxAbs)
+        {
+            maxAbs = fabs(h[i]);
+        }
+    }
+
+    /* Largest Q for which peak coefficient fits in S16 */
+    coefQ = PDM_FIR_MAX_COEF_Q;
+    while ((coefQ > PDM_FIR_MIN_COEF_Q) && (maxAbs*((Int32)1<<coefQ) > 32767.0))
+    {
+        coefQ--;
+    }
+
+    scale = (Float64)((Int32)1<<coefQ);
+    for (i = 0; i < numCoefs; i++)
+    {
+        coefs[i] = (Int16)floor(h[i]*scale + 0.5);
+    }
+    *pCoefQ = coefQ;
+
+    return PDM_FIR_OK;
+}
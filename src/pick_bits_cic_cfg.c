@@ -0,0 +1,264 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+#include "data_types.h"
+#include "pick_bits_cic.h"
+#include "pick_bits_cic_cfg.h"
+
+#define CIC_NUM_DF      ( 4 )   /* number of supported decimation factors, 8..64 */
+#define CIC_NUM_NS      ( CIC_CFG_MAX_NS-CIC_CFG_MIN_NS+1 ) /* number of supported stage counts */
+
+/* Integrator growth over 8 input samples with zero input: */
+/* stage k picks up C(8+d-1, d) times stage k-d. */
+#define CIC_G1          ( 8 )   /* C(8,1) */
+#define CIC_G2          ( 36 )  /* C(9,2) */
+#define CIC_G3          ( 120 ) /* C(10,3) */
+#define CIC_G4          ( 330 ) /* C(11,4) */
+#define CIC_G5          ( 792 ) /* C(12,5) */
+
+/* Integrator update for stages k..0, given table row pTbl. */
+/* Stages updated last to first so each uses the previous state of the stages below it. */
+#define CIC_INT_0                                                                   \
+    acc0 += (Uint32)pTbl[0];
+#define CIC_INT_1                                                                   \
+    acc1 += CIC_G1*acc0 + (Uint32)pTbl[1];                                          \
+    CIC_INT_0
+#define CIC_INT_2                                                                   \
+    acc2 += CIC_G1*acc1 + CIC_G2*acc0 + (Uint32)pTbl[2];                            \
+    CIC_INT_1
+#define CIC_INT_3                                                                   \
+    acc3 += CIC_G1*acc2 + CIC_G2*acc1 + CIC_G3*acc0 + (Uint32)pTbl[3];              \
+    CIC_INT_2
+#define CIC_INT_4                                                                   \
+    acc4 += CIC_G1*acc3 + CIC_G2*acc2 + CIC_G3*acc1 + CIC_G4*acc0 + (Uint32)pTbl[4]; \
+    CIC_INT_3
+#define CIC_INT_5                                                                   \
+    acc5 += CIC_G1*acc4 + CIC_G2*acc3 + CIC_G3*acc2 + CIC_G4*acc1 + CIC_G5*acc0     \
+        + (Uint32)pTbl[5];                                                          \
+    CIC_INT_4
+
+/* Folds one input byte into N integrator stages */
+#define CIC_STEP_3(byteVal)     pTbl = cicByteTbl[(byteVal)]; CIC_INT_2
+#define CIC_STEP_4(byteVal)     pTbl = cicByteTbl[(byteVal)]; CIC_INT_3
+#define CIC_STEP_5(byteVal)     pTbl = cicByteTbl[(byteVal)]; CIC_INT_4
+#define CIC_STEP_6(byteVal)     pTbl = cicByteTbl[(byteVal)]; CIC_INT_5
+
+/* One differentiator stage */
+#define CIC_DIFF(s)                                                                 \
+    tmp = v - diffDly##s;                                                           \
+    diffDly##s = v;                                                                 \
+    v = tmp;
+
+/* Performs decimation & N differentiator stages, writes output sample */
+#define CIC_COMB_3                                                                  \
+    v = acc2;                                                                       \
+    CIC_DIFF(0) CIC_DIFF(1) CIC_DIFF(2)                                             \
+    *pOutSamp++ = (Int32)v;
+#define CIC_COMB_4                                                                  \
+    v = acc3;                                                                       \
+    CIC_DIFF(0) CIC_DIFF(1) CIC_DIFF(2) CIC_DIFF(3)                                 \
+    *pOutSamp++ = (Int32)v;
+#define CIC_COMB_5                                                                  \
+    v = acc4;                                                                       \
+    CIC_DIFF(0) CIC_DIFF(1) CIC_DIFF(2) CIC_DIFF(3) CIC_DIFF(4)                     \
+    *pOutSamp++ = (Int32)v;
+#define CIC_COMB_6                                                                  \
+    v = acc5;                                                                       \
+    CIC_DIFF(0) CIC_DIFF(1) CIC_DIFF(2) CIC_DIFF(3) CIC_DIFF(4) CIC_DIFF(5)         \
+    *pOutSamp++ = (Int32)v;
+
+/* State declaration, load & store for N stages */
+#define CIC_DECL_3  Uint32 acc0, acc1, acc2; Uint32 diffDly0, diffDly1, diffDly2;
+#define CIC_DECL_4  CIC_DECL_3 Uint32 acc3; Uint32 diffDly3;
+#define CIC_DECL_5  CIC_DECL_4 Uint32 acc4; Uint32 diffDly4;
+#define CIC_DECL_6  CIC_DECL_5 Uint32 acc5; Uint32 diffDly5;
+
+#define CIC_LD(s, N)    acc##s = (Uint32)cicState[s]; diffDly##s = (Uint32)cicState[(N)+s];
+#define CIC_LOAD_3(N)   CIC_LD(0, N) CIC_LD(1, N) CIC_LD(2, N)
+#define CIC_LOAD_4(N)   CIC_LOAD_3(N) CIC_LD(3, N)
+#define CIC_LOAD_5(N)   CIC_LOAD_4(N) CIC_LD(4, N)
+#define CIC_LOAD_6(N)   CIC_LOAD_5(N) CIC_LD(5, N)
+
+#define CIC_ST(s, N)    cicState[s] = (Int32)acc##s; cicState[(N)+s] = (Int32)diffDly##s;
+#define CIC_STORE_3(N)  CIC_ST(0, N) CIC_ST(1, N) CIC_ST(2, N)
+#define CIC_STORE_4(N)  CIC_STORE_3(N) CIC_ST(3, N)
+#define CIC_STORE_5(N)  CIC_STORE_4(N) CIC_ST(4, N)
+#define CIC_STORE_6(N)  CIC_STORE_5(N) CIC_ST(5, N)
+
+/* Processes one 32-bit input word, MS byte first, for R = 8, 16, 32 */
+#define CIC_WORD_R8(w, N)                                                           \
+    CIC_STEP_##N(((w)>>24)&0xFF) CIC_COMB_##N                                       \
+    CIC_STEP_##N(((w)>>16)&0xFF) CIC_COMB_##N                                       \
+    CIC_STEP_##N(((w)>>8)&0xFF)  CIC_COMB_##N                                       \
+    CIC_STEP_##N((w)&0xFF)       CIC_COMB_##N
+#define CIC_WORD_R16(w, N)                                                          \
+    CIC_STEP_##N(((w)>>24)&0xFF) CIC_STEP_##N(((w)>>16)&0xFF) CIC_COMB_##N          \
+    CIC_STEP_##N(((w)>>8)&0xFF)  CIC_STEP_##N((w)&0xFF)       CIC_COMB_##N
+#define CIC_WORD_R32(w, N)                                                          \
+    CIC_STEP_##N(((w)>>24)&0xFF) CIC_STEP_##N(((w)>>16)&0xFF)                       \
+    CIC_STEP_##N(((w)>>8)&0xFF)  CIC_STEP_##N((w)&0xFF)       CIC_COMB_##N
+
+/* Processes "left" then "right" 32-bit input word */
+#define CIC_PAIR_R8(N)      CIC_WORD_R8(lWord, N)  CIC_WORD_R8(rWord, N)
+#define CIC_PAIR_R16(N)     CIC_WORD_R16(lWord, N) CIC_WORD_R16(rWord, N)
+#define CIC_PAIR_R32(N)     CIC_WORD_R32(lWord, N) CIC_WORD_R32(rWord, N)
+#define CIC_PAIR_R64(N)                                                             \
+    CIC_STEP_##N((lWord>>24)&0xFF) CIC_STEP_##N((lWord>>16)&0xFF)                   \
+    CIC_STEP_##N((lWord>>8)&0xFF)  CIC_STEP_##N(lWord&0xFF)                         \
+    CIC_STEP_##N((rWord>>24)&0xFF) CIC_STEP_##N((rWord>>16)&0xFF)                   \
+    CIC_STEP_##N((rWord>>8)&0xFF)  CIC_STEP_##N(rWord&0xFF)                         \
+    CIC_COMB_##N
+
+/* Defines fully unrolled CIC kernel cicKernel_R<R>_N<N>() */
+/* Integrator/differentiator arithmetic is modulo 2^32, as in pickBitsCic(). */
+#define CIC_DEFINE_KERNEL(R, N)                                                     \
+static void cicKernel_R##R##_N##N(                                                  \
+    Uint32 *lData,                                                                  \
+    Uint32 *rData,                                                                  \
+    Uint16 inDataLen,                                                               \
+    Int32 *cicState,                                                                \
+    Int32 *outSamps,                                                                \
+    Uint16 *pNumOutSamps                                                            \
+)                                                                                   \
+{                                                                                   \
+    CIC_DECL_##N                                                                    \
+    Uint32 lWord, rWord;                                                            \
+    Uint32 v, tmp;                                                                  \
+    Int32 *pTbl;                                                                    \
+    Int32 *pOutSamp;                                                                \
+    Uint16 i;                                                                       \
+                                                                                    \
+    /* Compute number of output samples */                                          \
+    /* x32 for 32-bit word, x2 for 2 channels */                                    \
+    *pNumOutSamps = (Uint16)(((Uint32)inDataLen*64)/(R));                           \
+                                                                                    \
+    CIC_LOAD_##N(N)                                                                 \
+                                                                                    \
+    pOutSamp = &outSamps[0];                                                        \
+    for (i = 0; i < inDataLen; i++)                                                 \
+    {                                                                               \
+        lWord = lData[i];                                                           \
+        rWord = rData[i];                                                           \
+        CIC_PAIR_R##R(N)                                                            \
+    }                                                                               \
+                                                                                    \
+    CIC_STORE_##N(N)                                                                \
+}
+
+CIC_DEFINE_KERNEL(8, 3)
+CIC_DEFINE_KERNEL(8, 4)
+CIC_DEFINE_KERNEL(8, 5)
+CIC_DEFINE_KERNEL(8, 6)
+CIC_DEFINE_KERNEL(16, 3)
+CIC_DEFINE_KERNEL(16, 4)
+CIC_DEFINE_KERNEL(16, 5)
+CIC_DEFINE_KERNEL(16, 6)
+CIC_DEFINE_KERNEL(32, 3)
+CIC_DEFINE_KERNEL(32, 4)
+CIC_DEFINE_KERNEL(32, 5)
+CIC_DEFINE_KERNEL(32, 6)
+CIC_DEFINE_KERNEL(64, 3)
+CIC_DEFINE_KERNEL(64, 4)
+CIC_DEFINE_KERNEL(64, 5)
+
+/* Kernels indexed by [log2(R)-3][N-CIC_CFG_MIN_NS] */
+/* R = 64, N = 6 has gain 2^36 and is not supported. */
+static const CicKernelFxn cicKernelTbl[CIC_NUM_DF][CIC_NUM_NS] =
+{
+    { cicKernel_R8_N3,  cicKernel_R8_N4,  cicKernel_R8_N5,  cicKernel_R8_N6  },
+    { cicKernel_R16_N3, cicKernel_R16_N4, cicKernel_R16_N5, cicKernel_R16_N6 },
+    { cicKernel_R32_N3, cicKernel_R32_N4, cicKernel_R32_N5, cicKernel_R32_N6 },
+    { cicKernel_R64_N3, cicKernel_R64_N4, cicKernel_R64_N5, 0                }
+};
+
+/* Selects CIC decimation factor & number of stages. */
+Int16 cicCfgInit(
+    CicCfg *pCfg,           /* CIC configuration */
+    Uint16 decimFact,       /* decimation factor R */
+    Uint16 numStages        /* number of stages N */
+)
+{
+    Uint16 dfLog2;
+
+    switch (decimFact)
+    {
+    case 8:
+        dfLog2 = 3;
+        break;
+    case 16:
+        dfLog2 = 4;
+        break;
+    case 32:
+        dfLog2 = 5;
+        break;
+    case 64:
+        dfLog2 = 6;
+        break;
+    default:
+        return CIC_CFG_ERR_DF;
+    }
+
+    if ((numStages < CIC_CFG_MIN_NS) || (numStages > CIC_CFG_MAX_NS))
+    {
+        return CIC_CFG_ERR_NS;
+    }
+
+    /* Output magnitude is bounded by R^N, must fit in Int32 */
+    if (dfLog2*numStages > CIC_CFG_MAX_GAIN_LOG2)
+    {
+        return CIC_CFG_ERR_GAIN;
+    }
+
+    pCfg->decimFact = decimFact;
+    pCfg->numStages = numStages;
+    pCfg->gainLog2 = dfLog2*numStages;
+    pCfg->kernel = cicKernelTbl[dfLog2-3][numStages-CIC_CFG_MIN_NS];
+
+    pickBitsCicTblInit();
+
+    return CIC_CFG_OK;
+}
+
+/* Unpacks "left" and "right" 32-bit packed DMA buffers containing output from digital mic. */
+/* Performs CIC on unpacked data, R & N as configured. */
+void cicCfgProcess(
+    CicCfg *pCfg,           /* CIC configuration */
+    Uint32 *lData,          /* "left" channel 32-bit packed input data */
+    Uint32 *rData,          /* "right" channel 32-bit packed input data */
+    Uint16 inDataLen,       /* length of "left" or "right" input data in 32-bit words */
+    Int32 *cicState,        /* CIC state, 2*N values */
+    Int32 *outSamps,        /* CIC output samples */
+    Uint16 *pNumOutSamps    /* CIC number of output samples */
+)
+{
+    pCfg->kernel(lData, rData, inDataLen, cicState, outSamps, pNumOutSamps);
+}
@@ -0,0 +1,307 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+#include "data_types.h"
+#include "pick_bits_cic.h"
+#include "pick_bits_cic_mc.h"
+
+#if (CIC_NS != 4)
+#error "pickBitsCicMc() loads the four stage contributions of a table row as one 128-bit vector (CIC_NS = 4)"
+#endif
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define CIC_MC_LANES    ( 8 )   /* channels per SIMD group */
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define CIC_MC_LANES    ( 4 )   /* channels per SIMD group */
+#else
+#define CIC_MC_LANES    ( 0 )   /* no SIMD, all channels scalar */
+#endif
+
+/* Initializes multi-channel CIC state. */
+Int16 pickBitsCicMcInit(
+    CicMcState *pState,     /* multi-channel CIC state */
+    Uint16 numCh            /* number of channels, 1..CIC_MC_MAX_CH */
+)
+{
+    Uint16 i, j;
+
+    if ((numCh < 1) || (numCh > CIC_MC_MAX_CH))
+    {
+        return -1;
+    }
+
+    for (i = 0; i < CIC_NS; i++)
+    {
+        for (j = 0; j < CIC_MC_MAX_CH; j++)
+        {
+            pState->acc[i][j] = 0;
+            pState->diffDly[i][j] = 0;
+        }
+    }
+    pState->numCh = numCh;
+
+    pickBitsCicTblInit();
+
+    return 0;
+}
+
+#if (CIC_MC_LANES == 8)
+/* 8 channels per group, one channel per 32-bit lane. */
+/* Table rows for channels ch and ch+4 share a 256-bit register, */
+/* so a per-128-bit-lane 4x4 transpose yields one vector per stage. */
+
+/* Loads table rows of 8 channels and transposes to stage-major vectors */
+#define CIC_MC_GATHER(bytes, c0, c1, c2, c3)                                            \
+    r0 = _mm256_inserti128_si256(_mm256_castsi128_si256(                                \
+            _mm_loadu_si128((__m128i *)cicByteTbl[(bytes)[0]])),                        \
+            _mm_loadu_si128((__m128i *)cicByteTbl[(bytes)[4]]), 1);                     \
+    r1 = _mm256_inserti128_si256(_mm256_castsi128_si256(                                \
+            _mm_loadu_si128((__m128i *)cicByteTbl[(bytes)[1]])),                        \
+            _mm_loadu_si128((__m128i *)cicByteTbl[(bytes)[5]]), 1);                     \
+    r2 = _mm256_inserti128_si256(_mm256_castsi128_si256(                                \
+            _mm_loadu_si128((__m128i *)cicByteTbl[(bytes)[2]])),                        \
+            _mm_loadu_si128((__m128i *)cicByteTbl[(bytes)[6]]), 1);                     \
+    r3 = _mm256_inserti128_si256(_mm256_castsi128_si256(                                \
+            _mm_loadu_si128((__m128i *)cicByteTbl[(bytes)[3]])),                        \
+            _mm_loadu_si128((__m128i *)cicByteTbl[(bytes)[7]]), 1);                     \
+    t0 = _mm256_unpacklo_epi32(r0, r1);                                                 \
+    t1 = _mm256_unpacklo_epi32(r2, r3);                                                 \
+    t2 = _mm256_unpackhi_epi32(r0, r1);                                                 \
+    t3 = _mm256_unpackhi_epi32(r2, r3);                                                 \
+    c0 = _mm256_unpacklo_epi64(t0, t1);                                                 \
+    c1 = _mm256_unpackhi_epi64(t0, t1);                                                 \
+    c2 = _mm256_unpacklo_epi64(t2, t3);                                                 \
+    c3 = _mm256_unpackhi_epi64(t2, t3);
+
+typedef __m256i VecI32;
+#define VEC_LOAD(p)         _mm256_loadu_si256((__m256i *)(p))
+#define VEC_STORE(p, v)     _mm256_storeu_si256((__m256i *)(p), (v))
+#define VEC_ADD(a, b)       _mm256_add_epi32((a), (b))
+#define VEC_SUB(a, b)       _mm256_sub_epi32((a), (b))
+#define VEC_SHL(a, n)       _mm256_slli_epi32((a), (n))
+
+#elif (CIC_MC_LANES == 4)
+/* 4 channels per group, one channel per 32-bit lane. */
+
+/* Loads table rows of 4 channels and transposes to stage-major vectors */
+#define CIC_MC_GATHER(bytes, c0, c1, c2, c3)                                            \
+    r0 = _mm_loadu_si128((__m128i *)cicByteTbl[(bytes)[0]]);                            \
+    r1 = _mm_loadu_si128((__m128i *)cicByteTbl[(bytes)[1]]);                            \
+    r2 = _mm_loadu_si128((__m128i *)cicByteTbl[(bytes)[2]]);                            \
+    r3 = _mm_loadu_si128((__m128i *)cicByteTbl[(bytes)[3]]);                            \
+    t0 = _mm_unpacklo_epi32(r0, r1);                                                    \
+    t1 = _mm_unpacklo_epi32(r2, r3);                                                    \
+    t2 = _mm_unpackhi_epi32(r0, r1);                                                    \
+    t3 = _mm_unpackhi_epi32(r2, r3);                                                    \
+    c0 = _mm_unpacklo_epi64(t0, t1);                                                    \
+    c1 = _mm_unpackhi_epi64(t0, t1);                                                    \
+    c2 = _mm_unpacklo_epi64(t2, t3);                                                    \
+    c3 = _mm_unpackhi_epi64(t2, t3);
+
+typedef __m128i VecI32;
+#define VEC_LOAD(p)         _mm_loadu_si128((__m128i *)(p))
+#define VEC_STORE(p, v)     _mm_storeu_si128((__m128i *)(p), (v))
+#define VEC_ADD(a, b)       _mm_add_epi32((a), (b))
+#define VEC_SUB(a, b)       _mm_sub_epi32((a), (b))
+#define VEC_SHL(a, n)       _mm_slli_epi32((a), (n))
+
+#endif
+
+#if (CIC_MC_LANES > 0)
+/* x*8, x*36, x*120 (modulo 2^32) */
+#define VEC_MUL8(a)         VEC_SHL((a), 3)
+#define VEC_MUL36(a)        VEC_ADD(VEC_SHL((a), 5), VEC_SHL((a), 2))
+#define VEC_MUL120(a)       VEC_SUB(VEC_SHL((a), 7), VEC_SHL((a), 3))
+
+/* Folds one input byte per channel into the integrator stages */
+#define CIC_MC_BYTE_STEP(bytes)                                                         \
+    CIC_MC_GATHER(bytes, c0, c1, c2, c3);                                               \
+    acc3 = VEC_ADD(VEC_ADD(acc3, c3),                                                   \
+        VEC_ADD(VEC_ADD(VEC_MUL8(acc2), VEC_MUL36(acc1)), VEC_MUL120(acc0)));           \
+    acc2 = VEC_ADD(VEC_ADD(acc2, c2), VEC_ADD(VEC_MUL8(acc1), VEC_MUL36(acc0)));        \
+    acc1 = VEC_ADD(VEC_ADD(acc1, c1), VEC_MUL8(acc0));                                  \
+    acc0 = VEC_ADD(acc0, c0);
+
+/* Performs decimation & differentiator stages, writes one output sample per channel */
+#define CIC_MC_COMB_OUT()                                                               \
+    diff = VEC_SUB(acc3, diffDly0);                                                     \
+    diffDly0 = acc3;                                                                    \
+    tmp = VEC_SUB(diff, diffDly1);                                                      \
+    diffDly1 = diff;                                                                    \
+    diff = VEC_SUB(tmp, diffDly2);                                                      \
+    diffDly2 = tmp;                                                                     \
+    tmp = VEC_SUB(diff, diffDly3);                                                      \
+    diffDly3 = diff;                                                                    \
+    VEC_STORE(outVec, tmp);                                                             \
+    for (k = 0; k < CIC_MC_LANES; k++)                                                  \
+    {                                                                                   \
+        pOut[k][outSampIdx] = outVec[k];                                                \
+    }                                                                                   \
+    outSampIdx++;
+
+/* Performs CIC on one group of CIC_MC_LANES channels starting at channel ch0 */
+static void pickBitsCicMcGroup(
+    Uint32 **lData,
+    Uint32 **rData,
+    Uint16 inDataLen,
+    CicMcState *pState,
+    Int32 **outSamps,
+    Uint16 ch0
+)
+{
+    VecI32 acc0, acc1, acc2, acc3;
+    VecI32 diffDly0, diffDly1, diffDly2, diffDly3;
+    VecI32 diff, tmp;
+    VecI32 c0, c1, c2, c3;
+    VecI32 r0, r1, r2, r3;
+    VecI32 t0, t1, t2, t3;
+    Uint32 lWord[CIC_MC_LANES], rWord[CIC_MC_LANES];
+    Uint16 bytes[4][CIC_MC_LANES];
+    Int32 outVec[CIC_MC_LANES];
+    Int32 *pOut[CIC_MC_LANES];
+    Uint16 outSampIdx;
+    Uint16 i, k;
+
+    /* Load CIC state */
+    acc0 = VEC_LOAD(&pState->acc[0][ch0]);
+    acc1 = VEC_LOAD(&pState->acc[1][ch0]);
+    acc2 = VEC_LOAD(&pState->acc[2][ch0]);
+    acc3 = VEC_LOAD(&pState->acc[3][ch0]);
+    diffDly0 = VEC_LOAD(&pState->diffDly[0][ch0]);
+    diffDly1 = VEC_LOAD(&pState->diffDly[1][ch0]);
+    diffDly2 = VEC_LOAD(&pState->diffDly[2][ch0]);
+    diffDly3 = VEC_LOAD(&pState->diffDly[3][ch0]);
+
+    for (k = 0; k < CIC_MC_LANES; k++)
+    {
+        pOut[k] = outSamps[ch0+k];
+    }
+
+    outSampIdx = 0;
+    for (i = 0; i < inDataLen; i++)
+    {
+        for (k = 0; k < CIC_MC_LANES; k++)
+        {
+            lWord[k] = lData[ch0+k][i];
+            rWord[k] = rData[ch0+k][i];
+        }
+
+        /* Process "left" channel 32-bit word, MS 16-bit word first */
+        for (k = 0; k < CIC_MC_LANES; k++)
+        {
+            bytes[0][k] = (lWord[k]>>24)&0xFF;
+            bytes[1][k] = (lWord[k]>>16)&0xFF;
+            bytes[2][k] = (lWord[k]>>8)&0xFF;
+            bytes[3][k] = lWord[k]&0xFF;
+        }
+        CIC_MC_BYTE_STEP(bytes[0]);
+        CIC_MC_BYTE_STEP(bytes[1]);
+        CIC_MC_COMB_OUT();
+        CIC_MC_BYTE_STEP(bytes[2]);
+        CIC_MC_BYTE_STEP(bytes[3]);
+        CIC_MC_COMB_OUT();
+
+        /* Process "right" channel 32-bit word, MS 16-bit word first */
+        for (k = 0; k < CIC_MC_LANES; k++)
+        {
+            bytes[0][k] = (rWord[k]>>24)&0xFF;
+            bytes[1][k] = (rWord[k]>>16)&0xFF;
+            bytes[2][k] = (rWord[k]>>8)&0xFF;
+            bytes[3][k] = rWord[k]&0xFF;
+        }
+        CIC_MC_BYTE_STEP(bytes[0]);
+        CIC_MC_BYTE_STEP(bytes[1]);
+        CIC_MC_COMB_OUT();
+        CIC_MC_BYTE_STEP(bytes[2]);
+        CIC_MC_BYTE_STEP(bytes[3]);
+        CIC_MC_COMB_OUT();
+    }
+
+    /* Store CIC state */
+    VEC_STORE(&pState->acc[0][ch0], acc0);
+    VEC_STORE(&pState->acc[1][ch0], acc1);
+    VEC_STORE(&pState->acc[2][ch0], acc2);
+    VEC_STORE(&pState->acc[3][ch0], acc3);
+    VEC_STORE(&pState->diffDly[0][ch0], diffDly0);
+    VEC_STORE(&pState->diffDly[1][ch0], diffDly1);
+    VEC_STORE(&pState->diffDly[2][ch0], diffDly2);
+    VEC_STORE(&pState->diffDly[3][ch0], diffDly3);
+}
+#endif
+
+/* Multi-channel pickBitsCic(). */
+void pickBitsCicMc(
+    Uint32 **lData,         /* per-channel "left" 32-bit packed input data */
+    Uint32 **rData,         /* per-channel "right" 32-bit packed input data */
+    Uint16 inDataLen,       /* length of "left" or "right" input data in 32-bit words */
+    CicMcState *pState,     /* multi-channel CIC state */
+    Int32 **outSamps,       /* per-channel CIC output samples */
+    Uint16 *pNumOutSamps    /* CIC number of output samples per channel */
+)
+{
+    Int32 cicState[2*CIC_NS];
+    Uint16 ch, j;
+
+    ch = 0;
+
+#if (CIC_MC_LANES > 0)
+    /* Full SIMD groups */
+    for ( ; ch+CIC_MC_LANES <= pState->numCh; ch += CIC_MC_LANES)
+    {
+        pickBitsCicMcGroup(lData, rData, inDataLen, pState, outSamps, ch);
+    }
+#endif
+
+    /* Remaining channels, one at a time */
+    for ( ; ch < pState->numCh; ch++)
+    {
+        for (j = 0; j < CIC_NS; j++)
+        {
+            cicState[j] = pState->acc[j][ch];
+            cicState[CIC_NS+j] = pState->diffDly[j][ch];
+        }
+
+        pickBitsCicTbl(lData[ch], rData[ch], inDataLen, cicState, outSamps[ch], pNumOutSamps);
+
+        for (j = 0; j < CIC_NS; j++)
+        {
+            pState->acc[j][ch] = cicState[j];
+            pState->diffDly[j][ch] = cicState[CIC_NS+j];
+        }
+    }
+
+    /* Compute number of output samples */
+    /* x32 for 32-bit word, x2 for 2 channels */
+    *pNumOutSamps = inDataLen<<2;
+}
@@ -0,0 +1,191 @@
+/* ============================================================================
+ * Copyright (c) 2016 Texas Instruments Incorporated.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+  ===============================================================================*/
+#ifndef __TMS320C55X__
+#include <pthread.h>
+#endif
+#include "data_types.h"
+#include "pick_bits_cic.h"
+
+#define BITS_PER_BYTE   ( 8 )
+
+/* Integrator growth over 8 input samples with zero input: */
+/* stage k picks up C(8+k-j-1, k-j) times stage j. */
+#define CIC_G1          ( 8 )   /* C(8,1) */
+#define CIC_G2          ( 36 )  /* C(9,2) */
+#define CIC_G3          ( 120 ) /* C(10,3) */
+
+/* Contribution of one input byte (MS bit first) to each integrator stage, starting from zero state */
+Int32 cicByteTbl[CIC_NUM_BYTE_VALS][CIC_MAX_NS];
+
+#ifndef __TMS320C55X__
+static pthread_once_t cicByteTblOnce = PTHREAD_ONCE_INIT;   /* first use build */
+#endif
+
+/* Folds one input byte into the integrator stages. */
+/* Stages updated last to first so each uses the previous state of the stages below it. */
+#define CIC_BYTE_STEP(byteVal)                                      \
+    pTbl = cicByteTbl[(byteVal)];                                   \
+    acc3 += CIC_G1*acc2 + CIC_G2*acc1 + CIC_G3*acc0 + (Uint32)pTbl[3]; \
+    acc2 += CIC_G1*acc1 + CIC_G2*acc0 + (Uint32)pTbl[2];            \
+    acc1 += CIC_G1*acc0 + (Uint32)pTbl[1];                          \
+    acc0 += (Uint32)pTbl[0];
+
+/* Performs decimation & differentiator stages, writes output sample */
+#define CIC_COMB_OUT()                                              \
+    diff = acc3 - diffDly0;                                         \
+    diffDly0 = acc3;                                                \
+    tmp = diff - diffDly1;                                          \
+    diffDly1 = diff;                                                \
+    diff = tmp - diffDly2;                                          \
+    diffDly2 = tmp;                                                 \
+    tmp = diff - diffDly3;                                          \
+    diffDly3 = diff;                                                \
+    *pOutSamp++ = (Int32)tmp;
+
+/* Computes per-byte integrator contribution table */
+static void cicByteTblBuild(void)
+{
+    Int32 acc[CIC_MAX_NS];
+    Int16 input;
+    Uint16 byteVal;
+    Uint16 i, j;
+
+    for (byteVal = 0; byteVal < CIC_NUM_BYTE_VALS; byteVal++)
+    {
+        for (j = 0; j < CIC_MAX_NS; j++)
+        {
+            acc[j] = 0;
+        }
+
+        for (i = 0; i < BITS_PER_BYTE; i++)
+        {
+            /* 0->-1, 1->+1, MS bit first */
+            input = ((byteVal>>(BITS_PER_BYTE-1-i))&0x1)*2 - 1;
+
+            acc[0] += input;
+            for (j = 1; j < CIC_MAX_NS; j++)
+            {
+                acc[j] += acc[j-1];
+            }
+        }
+
+        for (j = 0; j < CIC_MAX_NS; j++)
+        {
+            cicByteTbl[byteVal][j] = acc[j];
+        }
+    }
+}
+
+/* Builds per-byte integrator contribution table used by pickBitsCicTbl(). */
+void pickBitsCicTblInit(void)
+{
+#ifdef __TMS320C55X__
+    cicByteTblBuild();
+#else
+    /* Built on first call only, later calls never rewrite table under running kernels */
+    pthread_once(&cicByteTblOnce, cicByteTblBuild);
+#endif
+}
+
+/* Unpacks "left" and "right" 32-bit packed DMA buffers containing output from digital mic. */
+/* Performs CIC on unpacked data, CIC_DF = 16 & CIC_NS = 4. */
+/* Table-driven: integrates 8 input bits per step, bit-exact with pickBitsCic(). */
+/* Integrator/differentiator arithmetic is modulo 2^32, as in pickBitsCic(). */
+void pickBitsCicTbl(
+    Uint32 *lData,          /* "left" channel 32-bit packed input data */
+    Uint32 *rData,          /* "right" channel 32-bit packed input data */
+    Uint16 inDataLen,       /* length of "left" or "right" input data in 32-bit words */
+    Int32 *cicState,        /* CIC state. First NS values are integrator state, next NS values are differentiator delay buffer */
+    Int32 *outSamps,        /* CIC output samples */
+    Uint16 *pNumOutSamps    /* CIC number of output samples */
+)
+{
+    Uint32 acc0, acc1, acc2, acc3;
+    Uint32 diffDly0, diffDly1, diffDly2, diffDly3;
+    Uint32 diff, tmp;
+    Uint32 cur32bW;
+    Int32 *pTbl;
+    Int32 *pOutSamp;
+    Uint16 i;
+
+
+    /* Compute number of output samples */
+    /* x32 for 32-bit word, x2 for 2 channels */
+    *pNumOutSamps = inDataLen<<2;
+
+    /* Load CIC state */
+    acc0 = cicState[0];
+    acc1 = cicState[1];
+    acc2 = cicState[2];
+    acc3 = cicState[3];
+    diffDly0 = cicState[CIC_NS+0];
+    diffDly1 = cicState[CIC_NS+1];
+    diffDly2 = cicState[CIC_NS+2];
+    diffDly3 = cicState[CIC_NS+3];
+
+    pOutSamp = &outSamps[0];
+    for (i = 0; i < inDataLen; i++)
+    {
+        /* Process "left" channel MS 16-bit word for current 32-bit word */
+        cur32bW = lData[i];
+        CIC_BYTE_STEP((cur32bW>>24)&0xFF);
+        CIC_BYTE_STEP((cur32bW>>16)&0xFF);
+        CIC_COMB_OUT();
+
+        /* Process "left" channel LS 16-bit word for current 32-bit word */
+        CIC_BYTE_STEP((cur32bW>>8)&0xFF);
+        CIC_BYTE_STEP(cur32bW&0xFF);
+        CIC_COMB_OUT();
+
+        /* Process "right" channel MS 16-bit word for current 32-bit word */
+        cur32bW = rData[i];
+        CIC_BYTE_STEP((cur32bW>>24)&0xFF);
+        CIC_BYTE_STEP((cur32bW>>16)&0xFF);
+        CIC_COMB_OUT();
+
+        /* Process "right" channel LS 16-bit word for current 32-bit word */
+        CIC_BYTE_STEP((cur32bW>>8)&0xFF);
+        CIC_BYTE_STEP(cur32bW&0xFF);
+        CIC_COMB_OUT();
+    }
+
+    /* Store CIC state */
+    cicState[0] = (Int32)acc0;
+    cicState[1] = (Int32)acc1;
+    cicState[2] = (Int32)acc2;
+    cicState[3] = (Int32)acc3;
+    cicState[CIC_NS+0] = (Int32)diffDly0;
+    cicState[CIC_NS+1] = (Int32)diffDly1;
+    cicState[CIC_NS+2] = (Int32)diffDly2;
+    cicState[CIC_NS+3] = (Int32)diffDly3;
+}
@@ -75,13 +75,10 @@ SECTIONS
     .fir1Coefs          : > SARAM
     .fir2Coefs          : > SARAM
     
-    .fir1DlyBuf         : > DARAM_2
-    .fir2DlyBuf         : > DARAM_2    
+    .decimPipe          : > DARAM_3
+    .decimProf          : > SARAM
 
     .i2sDmaReadBufLeft  : > SARAM
     .i2sDmaReadBufRight : > SARAM
-    .cicOutFrame        : > SARAM
-    .fir1OutFrame       : > SARAM
-    .fir2OutFrame       : > SARAM
     .digGainOutFrame    : > SARAM  
 }